@@ -0,0 +1,135 @@
+#-------------------------------------------------
+#
+# Headless audio renderer for FamiTracker modules.
+#
+#-------------------------------------------------
+
+# The tracker library is built on widgets, but nothing here shows any.
+QT += core \
+      gui
+
+greaterThan(QT_MAJOR_VERSION,4) {
+    QT += widgets
+}
+
+CONFIG += console
+CONFIG -= app_bundle
+
+TOP = ../..
+
+macx {
+    QMAKE_MAC_SDK = macosx10.15
+}
+
+CONFIG(release, debug|release) {
+   DESTDIR = release
+} else {
+   DESTDIR = debug
+}
+
+OBJECTS_DIR = $$DESTDIR
+MOC_DIR = $$DESTDIR
+RCC_DIR = $$DESTDIR
+UI_DIR = $$DESTDIR
+
+DEFINES -= UNICODE
+
+TARGET = "ftm-render"
+
+win32 {
+   DEPENDENCYROOTPATH = $$TOP/deps
+   DEPENDENCYPATH = $$DEPENDENCYROOTPATH/Windows
+}
+mac {
+   DEPENDENCYROOTPATH = $$TOP/deps
+   DEPENDENCYPATH = $$DEPENDENCYROOTPATH/osx
+}
+unix:!mac {
+   DEPENDENCYROOTPATH = $$TOP/deps
+   DEPENDENCYPATH = $$DEPENDENCYROOTPATH/linux
+}
+
+TEMPLATE = app
+
+# set platform specific cxxflags and libs
+#########################################
+
+FAMITRACKER_LIBS = -L$$TOP/libs/famitracker/$$DESTDIR -lfamitracker
+FAMITRACKER_CXXFLAGS = -I$$TOP/libs/famitracker
+
+RTMIDI_LIBS = -L$$DEPENDENCYROOTPATH/rtmidi/$$DESTDIR -lrtmidi
+
+win32 {
+    contains(QT_ARCH, i386) {
+        arch = x86
+    } else {
+        arch = x64
+    }
+
+   SDL_CXXFLAGS = -I$$DEPENDENCYPATH/SDL
+   SDL_LIBS =  -L$$DEPENDENCYPATH/SDL/$$arch -lsdl
+
+   QMAKE_LFLAGS += -static-libgcc
+}
+
+mac {
+   SDL_CXXFLAGS = -I$$DEPENDENCYPATH/SDL.framework/Headers
+   SDL_LIBS = -F$$DEPENDENCYPATH -framework SDL
+
+   QMAKE_POST_LINK += install_name_tool -change libfamitracker.1.dylib \
+       @executable_path/../../../libs/famitracker/$$DESTDIR/libfamitracker.1.dylib \
+       $$DESTDIR/$${TARGET} $$escape_expand(\n\t)
+   QMAKE_POST_LINK += install_name_tool -change librtmidi.1.dylib \
+       @executable_path/../../../deps/rtmidi/$$DESTDIR/librtmidi.1.dylib \
+       $$DESTDIR/$${TARGET} $$escape_expand(\n\t)
+}
+
+unix:!mac {
+   FAMITRACKER_LFLAGS  = -Wl,-rpath=\"$$PWD/$$TOP/libs/famitracker\"
+
+    # if the user didnt set cxxflags and libs then use defaults
+    ###########################################################
+
+    isEmpty (SDL_CXXFLAGS) {
+       SDL_CXXFLAGS = $$system(sdl-config --cflags)
+    }
+
+    isEmpty (SDL_LIBS) {
+            SDL_LIBS = $$system(sdl-config --libs)
+    }
+
+   PREFIX = $$(PREFIX)
+   isEmpty (PREFIX) {
+      PREFIX = /usr/local
+   }
+
+   BINDIR = $$(BINDIR)
+   isEmpty (BINDIR) {
+      BINDIR=$$PREFIX/bin
+   }
+
+   target.path = $$BINDIR
+   INSTALLS += target
+}
+
+QMAKE_CFLAGS += -w
+QMAKE_CXXFLAGS += -w
+
+QMAKE_CXXFLAGS += $$FAMITRACKER_CXXFLAGS \
+                  $$SDL_CXXFLAGS
+
+QMAKE_LFLAGS += $$FAMITRACKER_LFLAGS
+LIBS += $$FAMITRACKER_LIBS \
+        $$SDL_LIBS \
+        $$RTMIDI_LIBS
+
+unix {
+   QMAKE_CFLAGS += -I $$DEPENDENCYROOTPATH/wine/include -DWINE_UNICODE_NATIVE
+   QMAKE_CXXFLAGS += -I $$DEPENDENCYROOTPATH/wine/include -DWINE_UNICODE_NATIVE
+}
+
+INCLUDEPATH += \
+   $$TOP/common
+
+SOURCES += \
+   main.cpp
@@ -0,0 +1,354 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+
+#include <stdio.h>
+
+#include "cqtmfc.h"
+#include "cqtmfc_famitracker.h"
+
+#include "Source/FamiTracker.h"
+#include "Source/FamiTrackerDoc.h"
+#include "Source/SoundGen.h"
+
+// One track of one module to one file.
+struct RenderJob
+{
+   QString modulePath;
+   QString outputPath;
+   int track;
+   bool ok;
+};
+
+// How every job is rendered.
+struct RenderOptions
+{
+   bool wav;
+   int sampleRate;
+   int sampleSize;
+   render_end_t endType;
+   int endParam;
+};
+
+// Loading and closing a module go through the application's sound
+// generator and channel map, so only one thread does either at a time.
+// Rendering only reads the settings and doesn't need the lock.
+static QMutex loadMutex;
+
+static CFamiTrackerDoc* loadModule(QString modulePath)
+{
+   QMutexLocker locker(&loadMutex);
+   CFamiTrackerDoc* pDoc;
+
+   pDoc = static_cast<CFamiTrackerDoc*>(RUNTIME_CLASS(CFamiTrackerDoc)->CreateObject());
+   if ( !pDoc->OnOpenDocument(CString(modulePath)) )
+   {
+      delete pDoc;
+      return NULL;
+   }
+   return pDoc;
+}
+
+static void unloadModule(CFamiTrackerDoc* pDoc)
+{
+   QMutexLocker locker(&loadMutex);
+
+   delete pDoc;
+}
+
+// Each job has a document of its own since rendering plays through it.
+static bool renderJob(CSoundGen* pSoundGen,const RenderJob& job,const RenderOptions& options)
+{
+   QElapsedTimer timer;
+   CFamiTrackerDoc* pDoc;
+   bool ok;
+
+   pDoc = loadModule(job.modulePath);
+   if ( !pDoc )
+   {
+      fprintf(stderr,"%s: cannot load module\n",qPrintable(job.modulePath));
+      return false;
+   }
+   if ( (job.track < 1) || (job.track > (int)pDoc->GetTrackCount()) )
+   {
+      fprintf(stderr,"%s: track must be between 1 and %u\n",qPrintable(job.modulePath),pDoc->GetTrackCount());
+      unloadModule(pDoc);
+      return false;
+   }
+
+   timer.start();
+
+   ok = pSoundGen->RenderDocument(pDoc,CString(job.outputPath),!options.wav,options.sampleRate,options.sampleSize,
+                                  options.endType,options.endParam,job.track-1);
+   if ( ok )
+   {
+      fprintf(stderr,"%s: track %d rendered to %s at %d Hz, %d bits in %lld ms\n",
+              qPrintable(job.modulePath),job.track,qPrintable(job.outputPath),
+              options.sampleRate,options.sampleSize,timer.elapsed());
+   }
+   else
+   {
+      fprintf(stderr,"%s: cannot render to %s\n",qPrintable(job.modulePath),qPrintable(job.outputPath));
+   }
+
+   unloadModule(pDoc);
+
+   return ok;
+}
+
+// Takes jobs off a shared list until there are none left.  Every job gets
+// a fresh sound generator, so no emulation state carries over from the
+// previous track and the output is the same as rendering it on its own.
+class RenderWorker : public QThread
+{
+public:
+   RenderWorker(QList<RenderJob>* pJobs,int* pNextJob,QMutex* pJobMutex,const RenderOptions* pOptions)
+      : m_pJobs(pJobs),
+        m_pNextJob(pNextJob),
+        m_pJobMutex(pJobMutex),
+        m_pOptions(pOptions)
+   {
+   }
+
+protected:
+   void run()
+   {
+      for ( ;; )
+      {
+         CSoundGen* pSoundGen;
+         int job;
+
+         m_pJobMutex->lock();
+         job = (*m_pNextJob)++;
+         m_pJobMutex->unlock();
+
+         if ( job >= m_pJobs->count() )
+         {
+            break;
+         }
+
+         pSoundGen = new CSoundGen();
+         (*m_pJobs)[job].ok = renderJob(pSoundGen,m_pJobs->at(job),*m_pOptions);
+         delete pSoundGen;
+      }
+   }
+
+private:
+   QList<RenderJob>* m_pJobs;
+   int* m_pNextJob;
+   QMutex* m_pJobMutex;
+   const RenderOptions* m_pOptions;
+};
+
+// Renders a FamiTracker module to a wave or raw PCM file headless, as fast
+// as it emulates.  The module plays from the start of the track the same
+// way File > Create WAV does in the tracker, without the tracker.
+//
+// Given an output directory or --all-tracks, every module named is
+// rendered to <output-dir>/<module>-<track>.<format>, spread over as many
+// threads as there are cores.
+int main(int argc, char* argv[])
+{
+   QCoreApplication renderApplication(argc, argv);
+   QCommandLineParser parser;
+   QElapsedTimer timer;
+   QList<RenderJob> jobs;
+   QList<RenderWorker*> workers;
+   QMutex jobMutex;
+   RenderOptions options;
+   QString outputDir;
+   bool batch;
+   int nextJob = 0;
+   int numJobs;
+   int failedModules = 0;
+   int failedJobs = 0;
+
+   QCoreApplication::setOrganizationName("CSPSoftware");
+   QCoreApplication::setOrganizationDomain("nesicide.com");
+   QCoreApplication::setApplicationName("ftm-render");
+
+   parser.setApplicationDescription("Renders a FamiTracker module to audio headless, faster than real time.");
+   parser.addHelpOption();
+   parser.addPositionalArgument("module","FamiTracker module (.ftm), or modules with --output-dir.");
+   parser.addPositionalArgument("output","Audio file to write, unless --output-dir is given.");
+   QCommandLineOption trackOption(QStringList() << "t" << "track","Track to render, from 1.","N","1");
+   parser.addOption(trackOption);
+   QCommandLineOption allTracksOption(QStringList() << "a" << "all-tracks","Render every track of each module.");
+   parser.addOption(allTracksOption);
+   QCommandLineOption outputDirOption(QStringList() << "o" << "output-dir","Render the modules into DIR, one file per track.","DIR");
+   parser.addOption(outputDirOption);
+   QCommandLineOption jobsOption(QStringList() << "j" << "jobs","Tracks to render at the same time.  By default one per core.","N");
+   parser.addOption(jobsOption);
+   QCommandLineOption loopsOption(QStringList() << "l" << "loops","Play the track N times through.","N","1");
+   parser.addOption(loopsOption);
+   QCommandLineOption secondsOption(QStringList() << "s" << "seconds","Play the track for N seconds instead of a number of loops.","N");
+   parser.addOption(secondsOption);
+   QCommandLineOption rateOption(QStringList() << "r" << "rate","Output sample rate in Hz.","HZ","44100");
+   parser.addOption(rateOption);
+   QCommandLineOption bitsOption(QStringList() << "b" << "bits","Output sample size, 8 or 16 bits.","BITS","16");
+   parser.addOption(bitsOption);
+   QCommandLineOption formatOption("format","Output format, wav or raw (mono, 16-bit signed little-endian or 8-bit unsigned).  By default raw if the output file name ends in .raw or .pcm.","FORMAT");
+   parser.addOption(formatOption);
+   parser.process(renderApplication);
+
+   batch = parser.isSet(outputDirOption) || parser.isSet(allTracksOption);
+
+   if ( batch )
+   {
+      if ( parser.positionalArguments().isEmpty() )
+      {
+         parser.showHelp(1);
+      }
+      outputDir = parser.isSet(outputDirOption) ? parser.value(outputDirOption) : QString(".");
+      if ( !QDir().mkpath(outputDir) )
+      {
+         fprintf(stderr,"%s: cannot create directory\n",qPrintable(outputDir));
+         return 1;
+      }
+   }
+   else if ( parser.positionalArguments().count() != 2 )
+   {
+      parser.showHelp(1);
+   }
+
+   if ( parser.isSet(formatOption) )
+   {
+      if ( (parser.value(formatOption) != "wav") && (parser.value(formatOption) != "raw") )
+      {
+         fprintf(stderr,"%s: unknown format\n",qPrintable(parser.value(formatOption)));
+         return 1;
+      }
+      options.wav = (parser.value(formatOption) == "wav");
+   }
+   else if ( batch )
+   {
+      options.wav = true;
+   }
+   else
+   {
+      QString outputPath = parser.positionalArguments().at(1);
+      options.wav = (QFileInfo(outputPath).suffix().toLower() != "raw") &&
+                    (QFileInfo(outputPath).suffix().toLower() != "pcm");
+   }
+
+   options.sampleRate = parser.value(rateOption).toInt();
+   if ( (options.sampleRate < 11025) || (options.sampleRate > 96000) )
+   {
+      fprintf(stderr,"sample rate must be between 11025 and 96000 Hz\n");
+      return 1;
+   }
+   options.sampleSize = parser.value(bitsOption).toInt();
+   if ( (options.sampleSize != 8) && (options.sampleSize != 16) )
+   {
+      fprintf(stderr,"sample size must be 8 or 16 bits\n");
+      return 1;
+   }
+
+   if ( parser.isSet(secondsOption) )
+   {
+      options.endType = SONG_TIME_LIMIT;
+      options.endParam = parser.value(secondsOption).toInt();
+   }
+   else
+   {
+      options.endType = SONG_LOOP_LIMIT;
+      options.endParam = parser.value(loopsOption).toInt();
+   }
+   if ( options.endParam < 1 )
+   {
+      fprintf(stderr,"nothing to render\n");
+      return 1;
+   }
+
+   numJobs = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : QThread::idealThreadCount();
+   if ( numJobs < 1 )
+   {
+      numJobs = 1;
+   }
+
+   // Just enough of the tracker to load and play a module.
+   qtMfcInitHeadless();
+   theApp.InitHeadless();
+
+   if ( !batch )
+   {
+      RenderJob job;
+
+      job.modulePath = parser.positionalArguments().at(0);
+      job.outputPath = parser.positionalArguments().at(1);
+      job.track = parser.value(trackOption).toInt();
+
+      return renderJob(theApp.GetSoundGenerator(),job,options) ? 0 : 1;
+   }
+
+   // Output names only depend on the module and track, never on which
+   // thread got there first.
+   foreach ( const QString& modulePath, parser.positionalArguments() )
+   {
+      RenderJob job;
+      int firstTrack = parser.value(trackOption).toInt();
+      int lastTrack = firstTrack;
+
+      if ( parser.isSet(allTracksOption) )
+      {
+         CFamiTrackerDoc* pDoc = loadModule(modulePath);
+
+         if ( !pDoc )
+         {
+            fprintf(stderr,"%s: cannot load module\n",qPrintable(modulePath));
+            failedModules++;
+            continue;
+         }
+         firstTrack = 1;
+         lastTrack = pDoc->GetTrackCount();
+         unloadModule(pDoc);
+      }
+
+      for ( int track = firstTrack; track <= lastTrack; track++ )
+      {
+         job.modulePath = modulePath;
+         job.outputPath = QDir(outputDir).filePath(QString("%1-%2.%3")
+                                                   .arg(QFileInfo(modulePath).completeBaseName())
+                                                   .arg(track,2,10,QChar('0'))
+                                                   .arg(options.wav ? "wav" : "raw"));
+         job.track = track;
+         job.ok = false;
+         jobs.append(job);
+      }
+   }
+
+   timer.start();
+
+   if ( numJobs > jobs.count() )
+   {
+      numJobs = jobs.count();
+   }
+   for ( int worker = 0; worker < numJobs; worker++ )
+   {
+      workers.append(new RenderWorker(&jobs,&nextJob,&jobMutex,&options));
+      workers.last()->start();
+   }
+   foreach ( RenderWorker* pWorker, workers )
+   {
+      pWorker->wait();
+      delete pWorker;
+   }
+
+   foreach ( const RenderJob& job, jobs )
+   {
+      if ( !job.ok )
+      {
+         failedJobs++;
+      }
+   }
+
+   fprintf(stderr,"%d of %d tracks rendered on %d threads in %lld ms\n",
+           jobs.count()-failedJobs,jobs.count(),numJobs,timer.elapsed());
+
+   return (failedModules || failedJobs) ? 1 : 0;
+}
@@ -10,6 +10,11 @@
 cc65_dbginfo        CCC65Interface::dbgInfo = NULL;
 QStringList         CCC65Interface::errors;
 QString             CCC65Interface::targetMachine = "none";
+QVector<CCC65Interface::CC65IndexedSpan> CCC65Interface::indexedSpans;
+QVector<int>        CCC65Interface::spanBuckets;
+QVector<int>        CCC65Interface::spanBucketEntries;
+QStringList         CCC65Interface::indexedSourceNames;
+QHash<QString,QHash<int,QVector<int> > > CCC65Interface::indexedLineSpans;
 
 // This utility compares two file paths regardless of original slashery.
 bool fileNamesAreIdentical(QString file1, QString file2)
@@ -43,11 +48,20 @@ CCC65Interface::~CCC65Interface()
 
 void CCC65Interface::updateTargetMachine(QString target)
 {
+   bool changed = (targetMachine.compare(target,Qt::CaseInsensitive) != 0);
+
    targetMachine = target;
+
+   // Absolute addresses depend on the target.
+   if ( changed && dbgInfo )
+   {
+      buildDebugInfoIndex();
+   }
 }
 
 void CCC65Interface::clear()
 {
+   clearDebugInfoIndex();
    cc65_free_dbginfo(dbgInfo);
    dbgInfo = 0;
 }
@@ -381,12 +395,283 @@ bool CCC65Interface::captureDebugInfo()
       return false;
    }
 
+   buildDebugInfoIndex();
+
    // Check consistency of debug information when it's loaded.
    CCC65Interface::isBuildUpToDate();
 
    return true;
 }
 
+// Spans are bucketed by absolute address in buckets of this many bytes.
+static const int SPAN_BUCKET_SHIFT = 4;
+
+int64_t CCC65Interface::getSpanAbsoluteAddress(const cc65_spandata* span)
+{
+   const cc65_segmentinfo* dbgSegments;
+   int64_t absAddr = -1;
+
+   if ( !targetMachine.compare("nes",Qt::CaseInsensitive) )
+   {
+      dbgSegments = cc65_segment_byid(dbgInfo,span->segment_id);
+
+      if ( dbgSegments && (dbgSegments->count == 1) )
+      {
+         absAddr = (int64_t)dbgSegments->data[0].output_offs+(span->span_start-dbgSegments->data[0].segment_start);
+
+         // Segments in the output file are offset by the iNES header.
+         if ( dbgSegments->data[0].output_name )
+         {
+            absAddr -= 0x10;
+         }
+      }
+      if ( dbgSegments )
+      {
+         cc65_free_segmentinfo(dbgInfo,dbgSegments);
+      }
+   }
+   else if ( !targetMachine.compare("c64",Qt::CaseInsensitive) )
+   {
+      absAddr = span->span_start;
+   }
+
+   return absAddr;
+}
+
+void CCC65Interface::clearDebugInfoIndex()
+{
+   indexedSpans.clear();
+   spanBuckets.clear();
+   spanBucketEntries.clear();
+   indexedSourceNames.clear();
+   indexedLineSpans.clear();
+}
+
+void CCC65Interface::buildDebugInfoIndex()
+{
+   const cc65_spaninfo* dbgSpans;
+   const cc65_lineinfo* dbgLines;
+   const cc65_sourceinfo* dbgSources;
+   const cc65_spaninfo* dbgLineSpans;
+   QHash<unsigned,int> spanIndexes;
+   QHash<unsigned,int> sourceIndexes;
+   QHash<int,int>      lineCounts;
+   QVector<int>        bucketFill;
+   CC65IndexedSpan indexedSpan;
+   int64_t  absAddr;
+   uint32_t absEnd = 0;
+   int      span;
+   int      line;
+   int      source;
+   int      bucket;
+   int      idx;
+
+   clearDebugInfoIndex();
+
+   if ( !dbgInfo )
+   {
+      return;
+   }
+
+   dbgSources = cc65_get_sourcelist(dbgInfo);
+   if ( dbgSources )
+   {
+      for ( source = 0; source < dbgSources->count; source++ )
+      {
+         sourceIndexes.insert(dbgSources->data[source].source_id,indexedSourceNames.count());
+         indexedSourceNames.append(QDir::fromNativeSeparators(dbgSources->data[source].source_name));
+      }
+   }
+
+   // Index the spans and the line with the highest preference of each.
+   // MACRO expansions are preferred over C language over assembly...
+   dbgSpans = cc65_get_spanlist(dbgInfo);
+   if ( dbgSpans )
+   {
+      for ( span = 0; span < dbgSpans->count; span++ )
+      {
+         absAddr = getSpanAbsoluteAddress(&dbgSpans->data[span]);
+
+         indexedSpan.spanStart = dbgSpans->data[span].span_start;
+         indexedSpan.spanEnd = dbgSpans->data[span].span_end;
+         indexedSpan.absStart = absAddr;
+         indexedSpan.mapped = (absAddr >= 0);
+         indexedSpan.lineType = -1;
+         indexedSpan.sourceLine = -1;
+         indexedSpan.sourceIndex = -1;
+
+         if ( dbgSpans->data[span].line_count )
+         {
+            dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
+
+            if ( dbgLines )
+            {
+               for ( line = 0; line < dbgLines->count; line++ )
+               {
+                  if ( (int)dbgLines->data[line].line_type >= indexedSpan.lineType )
+                  {
+                     indexedSpan.lineType = dbgLines->data[line].line_type;
+                     indexedSpan.sourceLine = dbgLines->data[line].source_line;
+                     indexedSpan.sourceIndex = sourceIndexes.value(dbgLines->data[line].source_id,-1);
+                  }
+               }
+
+               cc65_free_lineinfo(dbgInfo,dbgLines);
+            }
+         }
+
+         spanIndexes.insert(dbgSpans->data[span].span_id,indexedSpans.count());
+         indexedSpans.append(indexedSpan);
+
+         if ( indexedSpan.mapped &&
+              (indexedSpan.absStart+(indexedSpan.spanEnd-indexedSpan.spanStart) >= absEnd) )
+         {
+            absEnd = indexedSpan.absStart+(indexedSpan.spanEnd-indexedSpan.spanStart)+1;
+         }
+      }
+
+      cc65_free_spaninfo(dbgInfo,dbgSpans);
+   }
+
+   // Count the spans overlapping each bucket, then fill the buckets.  Spans
+   // that don't land anywhere, like the iNES header, can't be looked up.
+   spanBuckets.fill(0,(absEnd>>SPAN_BUCKET_SHIFT)+2);
+   for ( idx = 0; idx < indexedSpans.count(); idx++ )
+   {
+      const CC65IndexedSpan& indexed = indexedSpans.at(idx);
+      if ( !indexed.mapped )
+      {
+         continue;
+      }
+      for ( bucket = indexed.absStart>>SPAN_BUCKET_SHIFT;
+            bucket <= (int)((indexed.absStart+(indexed.spanEnd-indexed.spanStart))>>SPAN_BUCKET_SHIFT);
+            bucket++ )
+      {
+         spanBuckets[bucket+1]++;
+      }
+   }
+   for ( bucket = 1; bucket < spanBuckets.count(); bucket++ )
+   {
+      spanBuckets[bucket] += spanBuckets[bucket-1];
+   }
+   spanBucketEntries.resize(spanBuckets.last());
+   bucketFill = spanBuckets;
+   for ( idx = 0; idx < indexedSpans.count(); idx++ )
+   {
+      const CC65IndexedSpan& indexed = indexedSpans.at(idx);
+      if ( !indexed.mapped )
+      {
+         continue;
+      }
+      for ( bucket = indexed.absStart>>SPAN_BUCKET_SHIFT;
+            bucket <= (int)((indexed.absStart+(indexed.spanEnd-indexed.spanStart))>>SPAN_BUCKET_SHIFT);
+            bucket++ )
+      {
+         spanBucketEntries[bucketFill[bucket]++] = idx;
+      }
+   }
+
+   // Index the spans of each line of each source file.  Only line numbers
+   // with exactly one line record in a file are looked up.
+   if ( dbgSources )
+   {
+      for ( source = 0; source < dbgSources->count; source++ )
+      {
+         dbgLines = cc65_line_bysource(dbgInfo,dbgSources->data[source].source_id);
+
+         if ( dbgLines )
+         {
+            QHash<int,QVector<int> >& lineSpans = indexedLineSpans[indexedSourceNames.at(source)];
+
+            lineCounts.clear();
+            for ( line = 0; line < dbgLines->count; line++ )
+            {
+               lineCounts[dbgLines->data[line].source_line]++;
+            }
+
+            for ( line = 0; line < dbgLines->count; line++ )
+            {
+               if ( lineCounts.value(dbgLines->data[line].source_line) == 1 )
+               {
+                  QVector<int>& spans = lineSpans[dbgLines->data[line].source_line];
+
+                  dbgLineSpans = cc65_span_byline(dbgInfo,dbgLines->data[line].line_id);
+
+                  if ( dbgLineSpans )
+                  {
+                     for ( span = 0; span < dbgLineSpans->count; span++ )
+                     {
+                        idx = spanIndexes.value(dbgLineSpans->data[span].span_id,-1);
+                        if ( idx >= 0 )
+                        {
+                           spans.append(idx);
+                        }
+                     }
+
+                     cc65_free_spaninfo(dbgInfo,dbgLineSpans);
+                  }
+               }
+            }
+
+            cc65_free_lineinfo(dbgInfo,dbgLines);
+         }
+      }
+
+      cc65_free_sourceinfo(dbgInfo,dbgSources);
+   }
+}
+
+const CCC65Interface::CC65IndexedSpan* CCC65Interface::findIndexedSpan(uint32_t addr,uint32_t absAddr)
+{
+   const CC65IndexedSpan* found = NULL;
+   int bucket = absAddr>>SPAN_BUCKET_SHIFT;
+   int idx;
+
+   if ( bucket+1 < spanBuckets.count() )
+   {
+      // Pick the span with the highest preference line containing both addresses.
+      for ( idx = spanBuckets.at(bucket); idx < spanBuckets.at(bucket+1); idx++ )
+      {
+         const CC65IndexedSpan& indexed = indexedSpans.at(spanBucketEntries.at(idx));
+
+         if ( (indexed.lineType >= 0) &&
+              (absAddr >= indexed.absStart) &&
+              (absAddr <= indexed.absStart+(indexed.spanEnd-indexed.spanStart)) &&
+              (addr >= indexed.spanStart) &&
+              (addr <= indexed.spanEnd) &&
+              ((!found) || (indexed.lineType >= found->lineType)) )
+         {
+            found = &indexed;
+         }
+      }
+   }
+
+   return found;
+}
+
+int CCC65Interface::findIndexedSpanForLine(QString file,int source_line,int entry)
+{
+   QHash<QString,QHash<int,QVector<int> > >::const_iterator fileIter;
+   QHash<int,QVector<int> >::const_iterator lineIter;
+
+   fileIter = indexedLineSpans.constFind(QDir::fromNativeSeparators(file));
+   if ( fileIter != indexedLineSpans.constEnd() )
+   {
+      lineIter = fileIter.value().constFind(source_line);
+      if ( (lineIter != fileIter.value().constEnd()) && (!lineIter.value().isEmpty()) )
+      {
+         // The requested entry, or the last one if the entry doesn't exist.
+         if ( (entry >= 0) && (entry < lineIter.value().count()) )
+         {
+            return lineIter.value().at(entry);
+         }
+         return lineIter.value().last();
+      }
+   }
+
+   return -1;
+}
+
 bool CCC65Interface::isBuildUpToDate()
 {
    QProcess                     make;
@@ -926,170 +1211,26 @@ QString CCC65Interface::getSourceFileFromAbsoluteAddress(uint32_t addr,uint32_t
 
 QString CCC65Interface::nesGetSourceFileFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
 {
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   const cc65_lineinfo* dbgLines;
-   const cc65_sourceinfo* dbgSources;
-   int span;
-   int line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
    QString file = "";
 
-   if ( dbgInfo )
+   if ( indexed && (indexed->sourceIndex >= 0) )
    {
-      // Get the span containing this virtual address.
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-      if ( dbgSpans )
-      {
-         for ( span = 0; span < dbgSpans->count; span++ )
-         {
-            if ( dbgSpans->data[span].line_count )
-            {
-               // Get the segment potentially containing this absolute address.
-               dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-               // Get the line potentially containing this absolute address.
-               dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-               if ( dbgSegments && (dbgSegments->count == 1) &&
-                    dbgLines && (dbgLines->count > 0) )
-               {
-                  if ( dbgSegments->data[0].output_name )
-                  {
-                     if ( (absAddr >= dbgSegments->data[0].output_offs-0x10) &&
-                          (absAddr < (dbgSegments->data[0].output_offs-0x10+dbgSegments->data[0].segment_size)) )
-                     {
-                        for ( line = 0; line < dbgLines->count; line++ )
-                        {
-                           if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                           {
-                              highestTypeMatch = dbgLines->data[line].line_type;
-                              indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                           }
-                        }
-                     }
-                  }
-                  else
-                  {
-                     if ( (absAddr >= dbgSegments->data[0].output_offs) &&
-                          (absAddr < (dbgSegments->data[0].output_offs+dbgSegments->data[0].segment_size)) )
-                     {
-                        for ( line = 0; line < dbgLines->count; line++ )
-                        {
-                           if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                           {
-                              highestTypeMatch = dbgLines->data[line].line_type;
-                              indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                           }
-                        }
-                     }
-                  }
-               }
-               if ( dbgSegments )
-               {
-                  cc65_free_segmentinfo(dbgInfo,dbgSegments);
-               }
-               if ( dbgLines )
-               {
-                  cc65_free_lineinfo(dbgInfo,dbgLines);
-               }
-            }
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get the picked line.
-            dbgLines = cc65_line_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            // Get the source file of the picked line.
-            dbgSources = cc65_source_byid(dbgInfo,dbgLines->data[0].source_id);
-            file = dbgSources->data[0].source_name;
-
-            cc65_free_sourceinfo(dbgInfo,dbgSources);
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-      }
+      file = indexedSourceNames.at(indexed->sourceIndex);
    }
-   return QDir::fromNativeSeparators(file);
+   return file;
 }
 
 QString CCC65Interface::c64GetSourceFileFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
 {
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   const cc65_lineinfo* dbgLines;
-   const cc65_sourceinfo* dbgSources;
-   int span;
-   int line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
    QString file = "";
 
-   if ( dbgInfo )
+   if ( indexed && (indexed->sourceIndex >= 0) )
    {
-      // Get the span containing this virtual address.
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-      if ( dbgSpans )
-      {
-         for ( span = 0; span < dbgSpans->count; span++ )
-         {
-            if ( dbgSpans->data[span].line_count )
-            {
-               // Get the segment potentially containing this absolute address.
-               dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-               // Get the line potentially containing this absolute address.
-               dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-               if ( dbgSegments && (dbgSegments->count == 1) &&
-                    dbgLines && (dbgLines->count > 0) )
-               {
-                  if ( (absAddr >= dbgSegments->data[0].segment_start) &&
-                       (absAddr < (dbgSegments->data[0].segment_start+dbgSegments->data[0].segment_size)) )
-                  {
-                     for ( line = 0; line < dbgLines->count; line++ )
-                     {
-                        if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                        {
-                           highestTypeMatch = dbgLines->data[line].line_type;
-                           indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                        }
-                     }
-                  }
-               }
-               if ( dbgSegments )
-               {
-                  cc65_free_segmentinfo(dbgInfo,dbgSegments);
-               }
-               if ( dbgLines )
-               {
-                  cc65_free_lineinfo(dbgInfo,dbgLines);
-               }
-            }
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get the picked line.
-            dbgLines = cc65_line_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            // Get the source file of the picked line.
-            dbgSources = cc65_source_byid(dbgInfo,dbgLines->data[0].source_id);
-            file = dbgSources->data[0].source_name;
-
-            cc65_free_sourceinfo(dbgInfo,dbgSources);
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-      }
+      file = indexedSourceNames.at(indexed->sourceIndex);
    }
-   return QDir::fromNativeSeparators(file);
+   return file;
 }
 
 int CCC65Interface::getSourceLineFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
@@ -1107,178 +1248,48 @@ int CCC65Interface::getSourceLineFromAbsoluteAddress(uint32_t addr,uint32_t absA
 
 int CCC65Interface::nesGetSourceLineFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
 {
-   const cc65_spaninfo* dbgSpans;
-   const cc65_lineinfo* dbgLines;
-   const cc65_segmentinfo* dbgSegments;
-   int span;
-   int line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
+   int source_line = -1;
+
+   if ( indexed )
+   {
+      source_line = indexed->sourceLine;
+   }
+   return source_line;
+}
+
+int CCC65Interface::c64GetSourceLineFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
+{
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
    int source_line = -1;
 
+   if ( indexed )
+   {
+      source_line = indexed->sourceLine;
+   }
+   return source_line;
+}
+
+QString CCC65Interface::getSourceFileFromSymbol(QString symbol)
+{
+   const cc65_symbolinfo* dbgSymbols;
+   const cc65_lineinfo* dbgLines;
+   const cc65_sourceinfo* dbgSources;
+   int sym;
+   QString file = "";
+
    if ( dbgInfo )
    {
-      // Get the span containing this virtual address.
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
+      dbgSymbols = cc65_symbol_byname(dbgInfo,symbol.toLatin1().constData());
 
-      if ( dbgSpans )
+      // Getting a symbol by name gets all the def and ref entries for the symbol, so
+      // we need to ignore the symbol count.  Move the 'sym' reference variable to the
+      // proper symbol in the returned pile.
+      if ( dbgSymbols )
       {
-         for ( span = 0; span < dbgSpans->count; span++ )
+         for ( sym = 0; sym < dbgSymbols->count; sym++ )
          {
-            if ( dbgSpans->data[span].line_count )
-            {
-               // Get the segment potentially containing this absolute address.
-               dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-               // Get the line potentially containing this absolute address.
-               dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-               if ( dbgSegments && (dbgSegments->count == 1) &&
-                    dbgLines && (dbgLines->count > 0) )
-               {
-                  if ( dbgSegments->data[0].output_name )
-                  {
-                     if ( (absAddr >= dbgSegments->data[0].output_offs-0x10) &&
-                          (absAddr < (dbgSegments->data[0].output_offs-0x10+dbgSegments->data[0].segment_size)) )
-                     {
-                        for ( line = 0; line < dbgLines->count; line++ )
-                        {
-                           if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                           {
-                              highestTypeMatch = dbgLines->data[line].line_type;
-                              indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                           }
-                        }
-                     }
-                  }
-                  else
-                  {
-                     if ( (absAddr >= dbgSegments->data[0].output_offs) &&
-                          (absAddr < (dbgSegments->data[0].output_offs+dbgSegments->data[0].segment_size)) )
-                     {
-                        for ( line = 0; line < dbgLines->count; line++ )
-                        {
-                           if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                           {
-                              highestTypeMatch = dbgLines->data[line].line_type;
-                              indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                           }
-                        }
-                     }
-                  }
-               }
-               if ( dbgSegments )
-               {
-                  cc65_free_segmentinfo(dbgInfo,dbgSegments);
-               }
-               if ( dbgLines )
-               {
-                  cc65_free_lineinfo(dbgInfo,dbgLines);
-               }
-            }
-         }
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get the picked line.
-            dbgLines = cc65_line_byid(dbgInfo,indexOfHighestTypeMatch);
-            source_line = dbgLines->data[0].source_line;
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-      }
-   }
-   return source_line;
-}
-
-int CCC65Interface::c64GetSourceLineFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
-{
-   const cc65_spaninfo* dbgSpans;
-   const cc65_lineinfo* dbgLines;
-   const cc65_segmentinfo* dbgSegments;
-   int span;
-   int line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
-   int source_line = -1;
-
-   if ( dbgInfo )
-   {
-      // Get the span containing this virtual address.
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-      if ( dbgSpans )
-      {
-         for ( span = 0; span < dbgSpans->count; span++ )
-         {
-            if ( dbgSpans->data[span].line_count )
-            {
-               // Get the segment potentially containing this absolute address.
-               dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-               // Get the line potentially containing this absolute address.
-               dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-               if ( dbgSegments && (dbgSegments->count == 1) &&
-                    dbgLines && (dbgLines->count > 0) )
-               {
-                  if ( (absAddr >= dbgSegments->data[0].segment_start) &&
-                       (absAddr < (dbgSegments->data[0].segment_start+dbgSegments->data[0].segment_size)) )
-                  {
-                     for ( line = 0; line < dbgLines->count; line++ )
-                     {
-                        if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                        {
-                           highestTypeMatch = dbgLines->data[line].line_type;
-                           indexOfHighestTypeMatch = dbgLines->data[line].line_id;
-                        }
-                     }
-                  }
-               }
-               if ( dbgSegments )
-               {
-                  cc65_free_segmentinfo(dbgInfo,dbgSegments);
-               }
-               if ( dbgLines )
-               {
-                  cc65_free_lineinfo(dbgInfo,dbgLines);
-               }
-            }
-         }
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get the picked line.
-            dbgLines = cc65_line_byid(dbgInfo,indexOfHighestTypeMatch);
-            source_line = dbgLines->data[0].source_line;
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-      }
-   }
-   return source_line;
-}
-
-QString CCC65Interface::getSourceFileFromSymbol(QString symbol)
-{
-   const cc65_symbolinfo* dbgSymbols;
-   const cc65_lineinfo* dbgLines;
-   const cc65_sourceinfo* dbgSources;
-   int sym;
-   QString file = "";
-
-   if ( dbgInfo )
-   {
-      dbgSymbols = cc65_symbol_byname(dbgInfo,symbol.toLatin1().constData());
-
-      // Getting a symbol by name gets all the def and ref entries for the symbol, so
-      // we need to ignore the symbol count.  Move the 'sym' reference variable to the
-      // proper symbol in the returned pile.
-      if ( dbgSymbols )
-      {
-         for ( sym = 0; sym < dbgSymbols->count; sym++ )
-         {
-            if ( dbgSymbols->data[sym].export_id == CC65_INV_ID )
+            if ( dbgSymbols->data[sym].export_id == CC65_INV_ID )
             {
                break;
             }
@@ -1376,46 +1387,13 @@ int CCC65Interface::getSourceLineFromFileAndSymbol(QString file,QString symbol)
 
 int CCC65Interface::getLineMatchCount(QString file, int source_line)
 {
-   const cc65_sourceinfo* dbgSources;
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   int fidx;
+   QHash<QString,QHash<int,QVector<int> > >::const_iterator fileIter;
    int count = 0;
 
-   if ( dbgInfo )
+   fileIter = indexedLineSpans.constFind(QDir::fromNativeSeparators(file));
+   if ( fileIter != indexedLineSpans.constEnd() )
    {
-      // Get source ID from file.
-      dbgSources = cc65_get_sourcelist(dbgInfo);
-
-      // Get the appropriate file.
-      for ( fidx = 0; fidx < dbgSources->count; fidx++ )
-      {
-         if ( fileNamesAreIdentical(dbgSources->data[fidx].source_name,file) )
-         {
-            break;
-         }
-      }
-
-      dbgLines = cc65_line_bynumber(dbgInfo,dbgSources->data[fidx].source_id,source_line);
-      if ( dbgLines && (dbgLines->count == 1) )
-      {
-         // Get the spans for this line.
-         dbgSpans = cc65_span_byline(dbgInfo,dbgLines->data[0].line_id);
-
-         if ( dbgSpans )
-         {
-            count = dbgSpans->count;
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-         }
-      }
-
-      if ( dbgLines )
-      {
-         cc65_free_lineinfo(dbgInfo,dbgLines);
-      }
-
-      cc65_free_sourceinfo(dbgInfo,dbgSources);
+      count = fileIter.value().value(source_line).count();
    }
 
    return count;
@@ -1423,82 +1401,12 @@ int CCC65Interface::getLineMatchCount(QString file, int source_line)
 
 unsigned int CCC65Interface::getAddressFromFileAndLine(QString file,int source_line,int entry)
 {
-   const cc65_sourceinfo* dbgSources;
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
-   int span;
-   int fidx;
-   int count = 0;
+   int idx = findIndexedSpanForLine(file,source_line,entry);
    int addr = -1;
 
-   if ( dbgInfo )
+   if ( idx >= 0 )
    {
-      dbgSources = cc65_get_sourcelist(dbgInfo);
-
-      if ( dbgSources )
-      {
-         // Get the appropriate file.
-         for ( fidx = 0; fidx < dbgSources->count; fidx++ )
-         {
-            if ( fileNamesAreIdentical(dbgSources->data[fidx].source_name,file) )
-            {
-               break;
-            }
-         }
-
-         // Get line information from source file.
-         dbgLines = cc65_line_bynumber(dbgInfo,dbgSources->data[fidx].source_id,source_line);
-
-         if ( dbgLines && (dbgLines->count == 1) )
-         {
-            // Get the spans for this line.
-            dbgSpans = cc65_span_byline(dbgInfo,dbgLines->data[0].line_id);
-
-            if ( dbgSpans )
-            {
-               for ( span = 0; span < dbgSpans->count; span++ )
-               {
-                  // Inject preference for MACRO expansions over C language over assembly...
-                  if ( dbgLines->data[0].line_type >= highestTypeMatch )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                  }
-
-                  if ( count == entry )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                     break;
-                  }
-
-                  // Keep track of when to return data if asked to break early.
-                  count++;
-               }
-
-               cc65_free_spaninfo(dbgInfo,dbgSpans);
-            }
-         }
-
-         if ( dbgLines )
-         {
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-
-         cc65_free_sourceinfo(dbgInfo,dbgSources);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get span information to return.
-            dbgSpans = cc65_span_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            addr = dbgSpans->data[0].span_start;
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-         }
-      }
+      addr = indexedSpans.at(idx).spanStart;
    }
    return addr;
 }
@@ -1518,179 +1426,24 @@ unsigned int CCC65Interface::getAbsoluteAddressFromFileAndLine(QString file,int
 
 unsigned int CCC65Interface::nesGetAbsoluteAddressFromFileAndLine(QString file,int source_line,int entry)
 {
-   const cc65_sourceinfo* dbgSources;
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
-   int span;
-   int fidx;
-   int count = 0;
+   int idx = findIndexedSpanForLine(file,source_line,entry);
    int absAddr = -1;
-   
-   if ( dbgInfo )
-   {
-      dbgSources = cc65_get_sourcelist(dbgInfo);
-
-      if ( dbgSources )
-      {
-         // Get the appropriate file.
-         for ( fidx = 0; fidx < dbgSources->count; fidx++ )
-         {
-            if ( fileNamesAreIdentical(dbgSources->data[fidx].source_name,file) )
-            {
-               break;
-            }
-         }
-
-         // Get line information from source file.
-         dbgLines = cc65_line_bynumber(dbgInfo,dbgSources->data[fidx].source_id,source_line);
-
-         if ( dbgLines && (dbgLines->count == 1) )
-         {
-            // Get the spans for this line.
-            dbgSpans = cc65_span_byline(dbgInfo,dbgLines->data[0].line_id);
-
-            if ( dbgSpans )
-            {
-               for ( span = 0; span < dbgSpans->count; span++ )
-               {
-                  // Inject preference for MACRO expansions over C language over assembly...
-                  if ( dbgLines->data[0].line_type >= highestTypeMatch )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                  }
-
-                  if ( count == entry )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                     break;
-                  }
-
-                  // Keep track of when to return data if asked to break early.
-                  count++;
-               }
 
-               cc65_free_spaninfo(dbgInfo,dbgSpans);
-            }
-         }
-
-         if ( dbgLines )
-         {
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-
-         cc65_free_sourceinfo(dbgInfo,dbgSources);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get span information.
-            dbgSpans = cc65_span_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            // Get segment information from span.
-            dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[0].segment_id);
-            if ( dbgSegments->data[0].output_name )
-            {
-               absAddr = dbgSegments->data[0].output_offs+(dbgSpans->data[0].span_start-dbgSegments->data[0].segment_start)-0x10;
-            }
-            else
-            {
-               absAddr = dbgSegments->data[0].output_offs+(dbgSpans->data[0].span_start-dbgSegments->data[0].segment_start);
-            }
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-            cc65_free_segmentinfo(dbgInfo,dbgSegments);
-         }
-      }
+   if ( idx >= 0 )
+   {
+      absAddr = indexedSpans.at(idx).absStart;
    }
    return absAddr;
 }
 
 unsigned int CCC65Interface::c64GetAbsoluteAddressFromFileAndLine(QString file,int source_line,int entry)
 {
-   const cc65_sourceinfo* dbgSources;
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
-   int span;
-   int fidx;
-   int count = 0;
+   int idx = findIndexedSpanForLine(file,source_line,entry);
    int absAddr = -1;
 
-   if ( dbgInfo )
+   if ( idx >= 0 )
    {
-      dbgSources = cc65_get_sourcelist(dbgInfo);
-
-      if ( dbgSources )
-      {
-         // Get the appropriate file.
-         for ( fidx = 0; fidx < dbgSources->count; fidx++ )
-         {
-            if ( fileNamesAreIdentical(dbgSources->data[fidx].source_name,file) )
-            {
-               break;
-            }
-         }
-
-         // Get line information from source file.
-         dbgLines = cc65_line_bynumber(dbgInfo,dbgSources->data[fidx].source_id,source_line);
-
-         if ( dbgLines && (dbgLines->count == 1) )
-         {
-            // Get the spans for this line.
-            dbgSpans = cc65_span_byline(dbgInfo,dbgLines->data[0].line_id);
-
-            if ( dbgSpans )
-            {
-               for ( span = 0; span < dbgSpans->count; span++ )
-               {
-                  // Inject preference for MACRO expansions over C language over assembly...
-                  if ( dbgLines->data[0].line_type >= highestTypeMatch )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                  }
-
-                  if ( count == entry )
-                  {
-                     highestTypeMatch = dbgLines->data[0].line_type;
-                     indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                     break;
-                  }
-
-                  // Keep track of when to return data if asked to break early.
-                  count++;
-               }
-
-               cc65_free_spaninfo(dbgInfo,dbgSpans);
-            }
-         }
-
-         if ( dbgLines )
-         {
-            cc65_free_lineinfo(dbgInfo,dbgLines);
-         }
-
-         cc65_free_sourceinfo(dbgInfo,dbgSources);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            // Get span information.
-            dbgSpans = cc65_span_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            // Get segment information from span.
-            dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[0].segment_id);
-            absAddr = dbgSegments->data[0].segment_start+(dbgSpans->data[0].span_start-dbgSegments->data[0].segment_start);
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-            cc65_free_segmentinfo(dbgInfo,dbgSegments);
-         }
-      }
+      absAddr = indexedSpans.at(idx).absStart;
    }
    return absAddr;
 }
@@ -1710,83 +1463,12 @@ unsigned int CCC65Interface::getEndAddressFromAbsoluteAddress(uint32_t addr,uint
 
 unsigned int CCC65Interface::nesGetEndAddressFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
 {
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   int      span;
-   int      line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
    int endAddr = -1;
 
-   if ( dbgInfo )
+   if ( indexed )
    {
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-      if ( dbgSpans )
-      {
-         for ( span = 0; span < dbgSpans->count; span++ )
-         {
-            dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-            dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-            if ( dbgSegments && (dbgSegments->count == 1) &&
-                 dbgLines && (dbgLines->count > 0) )
-            {
-               if ( dbgSegments->data[0].output_name )
-               {
-                  if ( (absAddr >= dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start)-0x10) &&
-                       (absAddr <= dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_end-dbgSegments->data[0].segment_start)-0x10) )
-                  {
-                     for ( line = 0; line < dbgLines->count; line++ )
-                     {
-                        if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                        {
-                           highestTypeMatch = dbgLines->data[line].line_type;
-                           indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                        }
-                     }
-                  }
-               }
-               else
-               {
-                  if ( (absAddr >= dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start)) &&
-                       (absAddr <= dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_end-dbgSegments->data[0].segment_start)) )
-                  {
-                     for ( line = 0; line < dbgLines->count; line++ )
-                     {
-                        if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                        {
-                           highestTypeMatch = dbgLines->data[line].line_type;
-                           indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                        }
-                     }
-                  }
-               }
-            }
-
-            if ( dbgLines )
-            {
-               cc65_free_lineinfo(dbgInfo,dbgLines);
-            }
-            if ( dbgSegments )
-            {
-               cc65_free_segmentinfo(dbgInfo,dbgSegments);
-            }
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            dbgSpans = cc65_span_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            endAddr = dbgSpans->data[0].span_end;
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-         }
-      }
+      endAddr = indexed->spanEnd;
    }
 
    return endAddr;
@@ -1794,65 +1476,12 @@ unsigned int CCC65Interface::nesGetEndAddressFromAbsoluteAddress(uint32_t addr,u
 
 unsigned int CCC65Interface::c64GetEndAddressFromAbsoluteAddress(uint32_t addr,uint32_t absAddr)
 {
-   const cc65_lineinfo* dbgLines;
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   int      span;
-   int      line;
-   int highestTypeMatch = 0;
-   int indexOfHighestTypeMatch = -1;
+   const CC65IndexedSpan* indexed = findIndexedSpan(addr,absAddr);
    int endAddr = -1;
 
-   if ( dbgInfo )
+   if ( indexed )
    {
-      dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-      if ( dbgSpans )
-      {
-         for ( span = 0; span < dbgSpans->count; span++ )
-         {
-            dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-            dbgLines = cc65_line_byspan(dbgInfo,dbgSpans->data[span].span_id);
-
-            if ( dbgSegments && (dbgSegments->count == 1) &&
-                 dbgLines && (dbgLines->count > 0) )
-            {
-               if ( (absAddr >= dbgSegments->data[0].segment_start+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start)) &&
-                    (absAddr <= dbgSegments->data[0].segment_start+(dbgSpans->data[span].span_end-dbgSegments->data[0].segment_start)) )
-               {
-                  for ( line = 0; line < dbgLines->count; line++ )
-                  {
-                     if ( dbgLines->data[line].line_type >= highestTypeMatch )
-                     {
-                        highestTypeMatch = dbgLines->data[line].line_type;
-                        indexOfHighestTypeMatch = dbgSpans->data[span].span_id;
-                     }
-                  }
-               }
-            }
-
-            if ( dbgLines )
-            {
-               cc65_free_lineinfo(dbgInfo,dbgLines);
-            }
-            if ( dbgSegments )
-            {
-               cc65_free_segmentinfo(dbgInfo,dbgSegments);
-            }
-         }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
-
-         if ( indexOfHighestTypeMatch >= 0 )
-         {
-            dbgSpans = cc65_span_byid(dbgInfo,indexOfHighestTypeMatch);
-
-            endAddr = dbgSpans->data[0].span_end;
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
-         }
-      }
+      endAddr = indexed->spanEnd;
    }
 
    return endAddr;
@@ -1874,51 +1503,18 @@ bool CCC65Interface::isAbsoluteAddressAnOpcode(uint32_t absAddr)
 
 bool CCC65Interface::nesIsAbsoluteAddressAnOpcode(uint32_t absAddr)
 {
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   uint32_t addr;
-   int      span;
-   bool     opcode = false;
+   int bucket = absAddr>>SPAN_BUCKET_SHIFT;
+   int idx;
+   bool opcode = false;
 
-   if ( dbgInfo )
+   if ( bucket+1 < spanBuckets.count() )
    {
-      // Make addresses for where code might be in PRG-ROM space.
-      addr = (absAddr&MASK_8KB);
-      for ( ; addr < MEM_64KB; addr += MEM_8KB )
+      for ( idx = spanBuckets.at(bucket); idx < spanBuckets.at(bucket+1); idx++ )
       {
-         dbgSpans = cc65_span_byaddr(dbgInfo,addr);
-
-         if ( dbgSpans )
+         if ( absAddr == indexedSpans.at(spanBucketEntries.at(idx)).absStart )
          {
-            for ( span = 0; span < dbgSpans->count; span++ )
-            {
-               dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-               if ( dbgSegments && (dbgSegments->count == 1) )
-               {
-                  if ( dbgSegments->data[0].output_name )
-                  {
-                     if ( absAddr == dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start)-0x10 )
-                     {
-                        opcode = true;
-                     }
-                  }
-                  else
-                  {
-                     if ( absAddr == dbgSegments->data[0].output_offs+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start) )
-                     {
-                        opcode = true;
-                     }
-                  }
-               }
-
-               if ( dbgSegments )
-               {
-                  cc65_free_segmentinfo(dbgInfo,dbgSegments);
-               }
-            }
-
-            cc65_free_spaninfo(dbgInfo,dbgSpans);
+            opcode = true;
+            break;
          }
       }
    }
@@ -1928,38 +1524,19 @@ bool CCC65Interface::nesIsAbsoluteAddressAnOpcode(uint32_t absAddr)
 
 bool CCC65Interface::c64IsAbsoluteAddressAnOpcode(uint32_t absAddr)
 {
-   const cc65_spaninfo* dbgSpans;
-   const cc65_segmentinfo* dbgSegments;
-   uint32_t addr;
-   int      span;
-   bool     opcode = false;
+   int bucket = absAddr>>SPAN_BUCKET_SHIFT;
+   int idx;
+   bool opcode = false;
 
-   if ( dbgInfo )
+   if ( bucket+1 < spanBuckets.count() )
    {
-      // Make addresses for where code might be in PRG-ROM space.
-      dbgSpans = cc65_span_byaddr(dbgInfo,absAddr);
-
-      if ( dbgSpans )
+      for ( idx = spanBuckets.at(bucket); idx < spanBuckets.at(bucket+1); idx++ )
       {
-         for ( span = 0; span < dbgSpans->count; span++ )
+         if ( absAddr == indexedSpans.at(spanBucketEntries.at(idx)).absStart )
          {
-            dbgSegments = cc65_segment_byid(dbgInfo,dbgSpans->data[span].segment_id);
-
-            if ( dbgSegments && (dbgSegments->count == 1) )
-            {
-               if ( absAddr == dbgSegments->data[0].segment_start+(dbgSpans->data[span].span_start-dbgSegments->data[0].segment_start) )
-               {
-                  opcode = true;
-               }
-            }
-
-            if ( dbgSegments )
-            {
-               cc65_free_segmentinfo(dbgInfo,dbgSegments);
-            }
+            opcode = true;
+            break;
          }
-
-         cc65_free_spaninfo(dbgInfo,dbgSpans);
       }
    }
 
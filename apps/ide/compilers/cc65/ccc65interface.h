@@ -2,6 +2,8 @@
 #define CCC65INTERFACE_H
 
 #include <QProcess>
+#include <QHash>
+#include <QVector>
 
 #include "stdint.h"
 
@@ -73,9 +75,40 @@ public:
    static unsigned int c64GetSymbolAbsoluteAddress(QString symbol,int index = 0);
 
 protected:
+   // The debug information is indexed once when it is read so the editors
+   // and debuggers, which look up every line of every open file, don't have
+   // to walk the span and line lists of the debug information each time.
+   typedef struct
+   {
+      uint32_t spanStart;
+      uint32_t spanEnd;
+      uint32_t absStart;
+      bool     mapped;      // false if the span has no absolute address
+      int      lineType;    // -1 if no line is attached to the span
+      int      sourceLine;
+      int      sourceIndex; // Index into indexedSourceNames
+   } CC65IndexedSpan;
+
+   static void buildDebugInfoIndex();
+   static void clearDebugInfoIndex();
+   static int64_t getSpanAbsoluteAddress(const cc65_spandata* span);
+   static const CC65IndexedSpan* findIndexedSpan(uint32_t addr,uint32_t absAddr);
+   static int findIndexedSpanForLine(QString file,int source_line,int entry);
+
    static cc65_dbginfo        dbgInfo;
    static QStringList         errors;
    static QString             targetMachine;
+
+   // Spans, and the spans overlapping each bucket of absolute addresses.
+   // The spans overlapping bucket n are spanBucketEntries[spanBuckets[n]]
+   // up to spanBucketEntries[spanBuckets[n+1]].
+   static QVector<CC65IndexedSpan> indexedSpans;
+   static QVector<int>        spanBuckets;
+   static QVector<int>        spanBucketEntries;
+
+   // Spans of each line of each source file, in debug information order.
+   static QStringList         indexedSourceNames;
+   static QHash<QString,QHash<int,QVector<int> > > indexedLineSpans;
 };
 
 #endif // CCC65INTERFACE_H
@@ -59,10 +59,21 @@ void APUInformationDockWidget::hideEvent(QHideEvent* /*e*/)
 void APUInformationDockWidget::updateInformation()
 {
    CBreakpointInfo* pBreakpoints = nesGetBreakpointDatabase();
+   const NesStateSnapshot* pSnapshot;
    int idx;
    char buffer[16];
 
-   nesGetNesSnapshot(&m_nesState);
+   // Only the APU part of the snapshot published by the emulator is needed.
+   pSnapshot = nesAcquireSnapshot();
+   if ( pSnapshot )
+   {
+      m_nesState.apu = pSnapshot->apu;
+      nesReleaseSnapshot(pSnapshot);
+   }
+   else
+   {
+      nesGetApuSnapshot(&m_nesState.apu);
+   }
 
    sprintf ( buffer, "%d", m_nesState.apu.cycle );
    ui->apuCycle->setText ( buffer );
@@ -40,6 +40,19 @@ CPPUDBG::CPPUDBG()
 {
 }
 
+const PpuStateSnapshot* CPPUDBG::ACQUIREPPUSTATE ( const NesStateSnapshot** ppSnapshot )
+{
+   (*ppSnapshot) = nesAcquireSnapshot();
+   if ( (*ppSnapshot) )
+   {
+      return &(*ppSnapshot)->ppu;
+   }
+
+   // Nothing has been published yet.
+   nesGetPpuSnapshot(&m_ppuState);
+   return &m_ppuState;
+}
+
 CPPUDBG::~CPPUDBG()
 {
    m_pCodeDataLoggerInspectorTV = NULL;
@@ -137,11 +150,13 @@ void CPPUDBG::RENDERCHRMEM ( void )
    uint8_t colorIdx;
    int32_t color[4][3];
    int8_t* pTV;
+   const NesStateSnapshot* pSnapshot;
+   const PpuStateSnapshot* pPpuState;
 
    pTV = (int8_t*)m_pCHRMEMInspectorTV;
    if ( !pTV ) return;
 
-   nesGetPpuSnapshot(&m_ppuState);
+   pPpuState = ACQUIREPPUSTATE(&pSnapshot);
 
    color[0][0] = m_chrMemColor[0].red();
    color[0][1] = m_chrMemColor[0].green();
@@ -167,8 +182,8 @@ void CPPUDBG::RENDERCHRMEM ( void )
             ppuAddr += 0x1000;
          }
 
-         patternData1 = m_ppuState.memory[ppuAddr];
-         patternData2 = m_ppuState.memory[ppuAddr+8];
+         patternData1 = pPpuState->memory[ppuAddr];
+         patternData2 = pPpuState->memory[ppuAddr+8];
 
          for ( int32_t xf = 0; xf < 8; xf++ )
          {
@@ -183,6 +198,8 @@ void CPPUDBG::RENDERCHRMEM ( void )
          }
       }
    }
+
+   nesReleaseSnapshot(pSnapshot);
 }
 
 void CPPUDBG::RENDEROAM ( void )
@@ -203,22 +220,24 @@ void CPPUDBG::RENDEROAM ( void )
    uint8_t spriteY;
    QColor color[4];
    int8_t* pTV;
+   const NesStateSnapshot* pSnapshot;
+   const PpuStateSnapshot* pPpuState;
 
    pTV = (int8_t*)m_pOAMInspectorTV;
    if ( !pTV ) return;
 
-   nesGetPpuSnapshot(&m_ppuState);
+   pPpuState = ACQUIREPPUSTATE(&pSnapshot);
 
    color[0] = CBasePalette::GetPalette ( 0x0D );
    color[1] = CBasePalette::GetPalette ( 0x10 );
    color[2] = CBasePalette::GetPalette ( 0x20 );
    color[3] = CBasePalette::GetPalette ( 0x30 );
 
-   spriteSize = ((!!(m_ppuState.reg[PPUCTRL_REG]&PPUCTRL_SPRITE_SIZE))+1)<<3;
+   spriteSize = ((!!(pPpuState->reg[PPUCTRL_REG]&PPUCTRL_SPRITE_SIZE))+1)<<3;
 
    if ( spriteSize == 8 )
    {
-      spritePatBase = (!!(m_ppuState.reg[PPUCTRL_REG]&PPUCTRL_SPRITE_PAT_TBL_ADDR))<<12;
+      spritePatBase = (!!(pPpuState->reg[PPUCTRL_REG]&PPUCTRL_SPRITE_PAT_TBL_ADDR))<<12;
    }
 
    for ( y = 0; y < spriteSize<<1; y++ )
@@ -227,12 +246,12 @@ void CPPUDBG::RENDEROAM ( void )
       {
          sprite = (spriteSize==8)?((y>>3)<<5)+(x>>3):
                   ((y>>4)<<5)+(x>>3);
-         spriteY = m_ppuState.oamMemory[(sprite<<2)+SPRITEY];
+         spriteY = pPpuState->oamMemory[(sprite<<2)+SPRITEY];
 
          if ( ((m_bOAMViewerShowVisible) && ((spriteY+1) < SPRITE_YMAX)) ||
                (!m_bOAMViewerShowVisible) )
          {
-            patternIdx = m_ppuState.oamMemory[(sprite<<2)+SPRITEPAT];
+            patternIdx = pPpuState->oamMemory[(sprite<<2)+SPRITEPAT];
 
             if ( spriteSize == 16 )
             {
@@ -240,7 +259,7 @@ void CPPUDBG::RENDEROAM ( void )
                patternIdx &= 0xFE;
             }
 
-            spriteAttr = m_ppuState.oamMemory[(sprite<<2)+SPRITEATT];
+            spriteAttr = pPpuState->oamMemory[(sprite<<2)+SPRITEATT];
             spriteFlipVert = !!(spriteAttr&SPRITE_FLIP_VERT);
             spriteFlipHoriz = !!(spriteAttr&SPRITE_FLIP_HORIZ);
             attribData = (spriteAttr&SPRITE_PALETTE_IDX_MSK)<<2;
@@ -260,8 +279,8 @@ void CPPUDBG::RENDEROAM ( void )
                yf = (7-yf);
             }
 
-            patternData1 = m_ppuState.memory[spritePatBase+(patternIdx<<4)+(yf)];
-            patternData2 = m_ppuState.memory[spritePatBase+(patternIdx<<4)+(yf)+PATTERN_SIZE];
+            patternData1 = pPpuState->memory[spritePatBase+(patternIdx<<4)+(yf)];
+            patternData2 = pPpuState->memory[spritePatBase+(patternIdx<<4)+(yf)+PATTERN_SIZE];
 
             for ( xf = 0; xf < PATTERN_SIZE; xf++ )
             {
@@ -277,9 +296,9 @@ void CPPUDBG::RENDEROAM ( void )
                }
 
                colorIdx = (attribData|bit1|(bit2<<1));
-               *pTV = CBasePalette::GetPaletteR(m_ppuState.paletteMemory[0x10+colorIdx]);
-               *(pTV+1) = CBasePalette::GetPaletteG(m_ppuState.paletteMemory[0x10+colorIdx]);
-               *(pTV+2) = CBasePalette::GetPaletteB(m_ppuState.paletteMemory[0x10+colorIdx]);
+               *pTV = CBasePalette::GetPaletteR(pPpuState->paletteMemory[0x10+colorIdx]);
+               *(pTV+1) = CBasePalette::GetPaletteG(pPpuState->paletteMemory[0x10+colorIdx]);
+               *(pTV+2) = CBasePalette::GetPaletteB(pPpuState->paletteMemory[0x10+colorIdx]);
 
                pTV += 4;
             }
@@ -297,6 +316,8 @@ void CPPUDBG::RENDEROAM ( void )
          }
       }
    }
+
+   nesReleaseSnapshot(pSnapshot);
 }
 
 void CPPUDBG::RENDERNAMETABLE ( void )
@@ -317,11 +338,14 @@ void CPPUDBG::RENDERNAMETABLE ( void )
    uint8_t bit1, bit2;
    uint8_t colorIdx;
    int8_t* pTV;
+   const NesStateSnapshot* pSnapshot;
+   const PpuStateSnapshot* pPpuState;
+   const PpuScrollRun* pScrollRun;
 
    pTV = (int8_t*)m_pNameTableInspectorTV;
    if ( !pTV ) return;
 
-   nesGetPpuSnapshot(&m_ppuState);
+   pPpuState = ACQUIREPPUSTATE(&pSnapshot);
 
    for ( y = 0; y < 480; y++ )
    {
@@ -331,12 +355,12 @@ void CPPUDBG::RENDERNAMETABLE ( void )
          tileY = (ppuAddr&0x03E0)>>5;
          nameAddr = 0x2000 + (ppuAddr&0x0FFF);
          attribAddr = 0x2000 + (ppuAddr&0x0C00) + 0x03C0 + ((tileY&0xFFFC)<<1) + (tileX>>2);
-         bkgndPatBase = (!!(m_ppuState.reg[PPUCTRL_REG]&PPUCTRL_BKGND_PAT_TBL_ADDR))<<12;
+         bkgndPatBase = (!!(pPpuState->reg[PPUCTRL_REG]&PPUCTRL_BKGND_PAT_TBL_ADDR))<<12;
 
-         patternIdx = bkgndPatBase+(m_ppuState.memory[nameAddr]<<4)+((ppuAddr&0x7000)>>12);
-         attribData = m_ppuState.memory[attribAddr];
-         patternData1 = m_ppuState.memory[patternIdx];
-         patternData2 = m_ppuState.memory[patternIdx+PATTERN_SIZE];
+         patternIdx = bkgndPatBase+(pPpuState->memory[nameAddr]<<4)+((ppuAddr&0x7000)>>12);
+         attribData = pPpuState->memory[attribAddr];
+         patternData1 = pPpuState->memory[patternIdx];
+         patternData2 = pPpuState->memory[patternIdx+PATTERN_SIZE];
 
          if ( (tileY&0x0002) == 0 )
          {
@@ -366,15 +390,16 @@ void CPPUDBG::RENDERNAMETABLE ( void )
             bit1 = (patternData1>>(7-(xf)))&0x1;
             bit2 = (patternData2>>(7-(xf)))&0x1;
             colorIdx = (attribData|bit1|(bit2<<1));
-            *pTV = CBasePalette::GetPaletteR(m_ppuState.paletteMemory[colorIdx]);
-            *(pTV+1) = CBasePalette::GetPaletteG(m_ppuState.paletteMemory[colorIdx]);
-            *(pTV+2) = CBasePalette::GetPaletteB(m_ppuState.paletteMemory[colorIdx]);
+            *pTV = CBasePalette::GetPaletteR(pPpuState->paletteMemory[colorIdx]);
+            *(pTV+1) = CBasePalette::GetPaletteG(pPpuState->paletteMemory[colorIdx]);
+            *(pTV+2) = CBasePalette::GetPaletteB(pPpuState->paletteMemory[colorIdx]);
 
-            if ( m_bPPUViewerShowVisible )
+            if ( m_bPPUViewerShowVisible &&
+                 (pScrollRun = nesGetPpuSnapshotScrollRun(pPpuState,(x+xf)&0xFF,y%240)) )
             {
-               lbx = *(*(m_ppuState.xOffset+((x+xf)&0xFF))+(y%240));
+               lbx = pScrollRun->scrollX;
                ubx = lbx>>8?lbx&0xFF:lbx+255;
-               lby = *(*(m_ppuState.yOffset+((x+xf)&0xFF))+(y%240));
+               lby = pScrollRun->scrollY;
                uby = lby/240?lby%240:lby+239;
 
                if ( !( (((lbx <= ubx) && ((x+xf) >= lbx) && ((x+xf) <= ubx)) ||
@@ -426,4 +451,6 @@ void CPPUDBG::RENDERNAMETABLE ( void )
          ppuAddr += 0x1000;
       }
    }
+
+   nesReleaseSnapshot(pSnapshot);
 }
@@ -144,6 +144,10 @@ public:
    // Flag indicating whether or not to decorate invisible TV region(s).
    static bool           m_bPPUViewerShowVisible;
 
+   // The PPU state the inspectors draw from is the snapshot most recently
+   // published by the emulator, so it is never a mixture of frames.  The
+   // snapshot returned must be given back with nesReleaseSnapshot.
+   static const PpuStateSnapshot* ACQUIREPPUSTATE ( const NesStateSnapshot** ppSnapshot );
    static PpuStateSnapshot m_ppuState;
 };
 
@@ -61,6 +61,9 @@ void NameTableVisualizerDockWidget::showEvent(QShowEvent* /*event*/)
 
    QObject::connect(emulator,SIGNAL(updateDebuggers()),pThread,SLOT(updateDebuggers()));
 
+   // The PPU only keeps track of the scroll at each pixel while it's shown.
+   nesSetScrollCapture(ui->showVisible->isChecked());
+
    pThread->updateDebuggers();
 }
 
@@ -69,6 +72,8 @@ void NameTableVisualizerDockWidget::hideEvent(QHideEvent* /*event*/)
    QObject* emulator = CObjectRegistry::getObject("Emulator");
 
    QObject::disconnect(emulator,SIGNAL(updateDebuggers()),pThread,SLOT(updateDebuggers()));
+
+   nesSetScrollCapture(false);
 }
 
 void NameTableVisualizerDockWidget::changeEvent(QEvent* e)
@@ -93,4 +98,5 @@ void NameTableVisualizerDockWidget::renderData()
 void NameTableVisualizerDockWidget::on_showVisible_toggled(bool checked)
 {
    CPPUDBG::SetPPUViewerShowVisible ( checked );
+   nesSetScrollCapture(checked && isVisible());
 }
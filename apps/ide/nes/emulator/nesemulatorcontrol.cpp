@@ -22,6 +22,7 @@ NESEmulatorControl::NESEmulatorControl(QWidget *parent) :
    QObject::connect(breakpointWatcher, SIGNAL(breakpointHit()), this, SLOT(internalPause()));
    QObject::connect(emulator, SIGNAL(emulatorPaused(bool)), this, SLOT(internalPause()));
    QObject::connect(emulator, SIGNAL(emulatorStarted()), this, SLOT(internalPlay()));
+   QObject::connect(emulator, SIGNAL(emulatorFPS(float)), this, SLOT(emulatorFPS(float)));
 
    // Buttons are disabled until a cartridge is loaded...then they go to the "pause-just-happened" state.
    QObject::connect(emulator, SIGNAL(machineReady()), this, SLOT(internalPause()));
@@ -36,6 +37,8 @@ NESEmulatorControl::NESEmulatorControl(QWidget *parent) :
    QObject::connect(ui->actionReset, SIGNAL(triggered()), this, SLOT(on_resetButton_clicked()));
    QObject::connect(ui->actionSoft_Reset, SIGNAL(triggered()), this, SLOT(on_softButton_clicked()));
    QObject::connect(ui->actionFrame_Advance, SIGNAL(triggered()), this, SLOT(on_frameAdvance_clicked()));
+   QObject::connect(ui->actionRewind, SIGNAL(triggered()), this, SLOT(on_rewindButton_clicked()));
+   QObject::connect(ui->actionMaximum_Speed, SIGNAL(toggled(bool)), ui->turboButton, SLOT(setChecked(bool)));
 
    // Connect control signals to emulator.
    QObject::connect(this,SIGNAL(startEmulation()),emulator,SLOT(startEmulation()));
@@ -45,8 +48,10 @@ NESEmulatorControl::NESEmulatorControl(QWidget *parent) :
    QObject::connect(this,SIGNAL(stepOutCPUEmulation()),emulator,SLOT(stepOutCPUEmulation()));
    QObject::connect(this,SIGNAL(stepPPUEmulation()),emulator,SLOT(stepPPUEmulation()));
    QObject::connect(this,SIGNAL(advanceFrame()),emulator,SLOT(advanceFrame()));
+   QObject::connect(this,SIGNAL(rewindEmulation()),emulator,SLOT(rewindEmulation()));
    QObject::connect(this,SIGNAL(resetEmulator()),emulator,SLOT(resetEmulator()));
    QObject::connect(this,SIGNAL(softResetEmulator()),emulator,SLOT(softResetEmulator()));
+   QObject::connect(this,SIGNAL(setTurbo(bool)),emulator,SLOT(setTurbo(bool)));
 
    ui->debugButton->setChecked(debugging);
 }
@@ -67,6 +72,8 @@ QList<QAction*> NESEmulatorControl::menu()
    items.append(ui->actionStep_Out);
    items.append(ui->actionStep_PPU);
    items.append(ui->actionFrame_Advance);
+   items.append(ui->actionRewind);
+   items.append(ui->actionMaximum_Speed);
    items.append(ui->actionReset);
    items.append(ui->actionSoft_Reset);
    return items;
@@ -81,6 +88,7 @@ void NESEmulatorControl::internalPlay()
    ui->stepOutButton->setEnabled(false);
    ui->stepPPUButton->setEnabled(false);
    ui->frameAdvance->setEnabled(false);
+   ui->rewindButton->setEnabled(true);
    ui->actionRun->setEnabled(false);
    ui->actionPause->setEnabled(true);
    ui->actionStep_CPU->setEnabled(false);
@@ -88,10 +96,18 @@ void NESEmulatorControl::internalPlay()
    ui->actionStep_Out->setEnabled(false);
    ui->actionStep_PPU->setEnabled(false);
    ui->actionFrame_Advance->setEnabled(false);
+   ui->actionRewind->setEnabled(true);
+}
+
+void NESEmulatorControl::emulatorFPS(float fps)
+{
+   ui->fpsLabel->setText(QString::number(fps,'f',0)+" fps");
 }
 
 void NESEmulatorControl::internalPause()
 {
+   ui->fpsLabel->setText("");
+
    if ( nesROMIsLoaded() )
    {
       ui->playButton->setEnabled(true);
@@ -101,6 +117,7 @@ void NESEmulatorControl::internalPause()
       ui->stepOutButton->setEnabled(debugging);
       ui->stepPPUButton->setEnabled(debugging);
       ui->frameAdvance->setEnabled(debugging);
+      ui->rewindButton->setEnabled(nesGetRewindDepth()>0);
       ui->actionRun->setEnabled(true);
       ui->actionPause->setEnabled(false);
       ui->actionStep_CPU->setEnabled(debugging);
@@ -108,6 +125,7 @@ void NESEmulatorControl::internalPause()
       ui->actionStep_Out->setEnabled(debugging);
       ui->actionStep_PPU->setEnabled(debugging);
       ui->actionFrame_Advance->setEnabled(debugging);
+      ui->actionRewind->setEnabled(nesGetRewindDepth()>0);
    }
    else
    {
@@ -118,6 +136,7 @@ void NESEmulatorControl::internalPause()
       ui->stepOutButton->setEnabled(false);
       ui->stepPPUButton->setEnabled(false);
       ui->frameAdvance->setEnabled(false);
+      ui->rewindButton->setEnabled(false);
       ui->actionRun->setEnabled(false);
       ui->actionPause->setEnabled(false);
       ui->actionStep_CPU->setEnabled(false);
@@ -125,6 +144,7 @@ void NESEmulatorControl::internalPause()
       ui->actionStep_Out->setEnabled(false);
       ui->actionStep_PPU->setEnabled(false);
       ui->actionFrame_Advance->setEnabled(false);
+      ui->actionRewind->setEnabled(false);
    }
 }
 
@@ -177,6 +197,18 @@ void NESEmulatorControl::on_frameAdvance_clicked()
    emit advanceFrame();
 }
 
+void NESEmulatorControl::on_rewindButton_clicked()
+{
+   emit rewindEmulation();
+}
+
+void NESEmulatorControl::on_turboButton_toggled(bool checked)
+{
+   ui->actionMaximum_Speed->setChecked(checked);
+
+   emit setTurbo(checked);
+}
+
 void NESEmulatorControl::on_stepOverButton_clicked()
 {
    CCC65Interface::isBuildUpToDate();
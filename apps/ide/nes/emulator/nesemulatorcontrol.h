@@ -29,15 +29,19 @@ signals:
    void stepOutCPUEmulation();
    void stepPPUEmulation();
    void advanceFrame();
+   void rewindEmulation();
    void resetEmulator();
    void softResetEmulator();
+   void setTurbo(bool turbo);
 
 private slots:
    void on_softButton_clicked();
+   void on_turboButton_toggled(bool checked);
    void on_debugButton_toggled(bool checked);
    void on_stepOutButton_clicked();
    void on_stepOverButton_clicked();
    void on_frameAdvance_clicked();
+   void on_rewindButton_clicked();
    void on_resetButton_clicked();
    void on_stepPPUButton_clicked();
    void on_stepCPUButton_clicked();
@@ -45,6 +49,7 @@ private slots:
    void on_playButton_clicked();
    void internalPause();
    void internalPlay();
+   void emulatorFPS(float fps);
 };
 
 #endif // NESEMULATORCONTROL_H
@@ -59,7 +59,12 @@ void NESEmulatorThread::_breakpointHook()
 static void audioHook ( void )
 {
    NESEmulatorThread* emulator = dynamic_cast<NESEmulatorThread*>(CObjectRegistry::getObject("Emulator"));
-   emulator->nesAudioSemaphore->acquire();
+
+   // Don't wait for the sound card when running at maximum speed.
+   if ( !emulator->isTurbo() )
+   {
+      emulator->nesAudioSemaphore->acquire();
+   }
 }
 
 extern "C" void SDL_Emulator(void* userdata, uint8_t* stream, int32_t len)
@@ -101,7 +106,10 @@ NESEmulatorThread::NESEmulatorThread(QObject*)
    m_isStarting = false;
    m_isTerminating = false;
    m_isResetting = false;
+   m_isRewinding = false;
    m_debugFrame = 0;
+   m_isTurbo = false;
+   m_fpsFrames = 0;
    m_pCartridge = NULL;
    
    nesBreakpointSemaphore = new QSemaphore(0);
@@ -111,6 +119,9 @@ NESEmulatorThread::NESEmulatorThread(QObject*)
    nesSetBreakpointHook(breakpointHook);
    nesSetAudioHook(audioHook);
 
+   // The debugger inspectors draw from snapshots published by the emulator.
+   nesSetSnapshotPublishing(true);
+
    nesSDLCallback._user = this;
    nesSDLCallback._func = SDL_Emulator;
    nesSDLCallback._valid = true;
@@ -118,6 +129,9 @@ NESEmulatorThread::NESEmulatorThread(QObject*)
 
    nesClearAudioSamplesAvailable();
 
+   // Keep a rewind history so a problem can be stepped back from.
+   nesSetRewind(REWIND_DEFAULT_INTERVAL,REWIND_DEFAULT_MEMORY);
+
    BreakpointWatcherThread* breakpointWatcher = dynamic_cast<BreakpointWatcherThread*>(CObjectRegistry::getObject("Breakpoint Watcher"));
    QObject::connect(this,SIGNAL(breakpoint()),breakpointWatcher,SLOT(breakpoint()));
 }
@@ -384,6 +398,26 @@ void NESEmulatorThread::advanceFrame ()
    start();
 }
 
+void NESEmulatorThread::rewindEmulation ()
+{
+   // Rewinding can only be done between frames.  If we're stopped at a
+   // breakpoint the rest of the frame is run without breakpoints first,
+   // then the emulator steps back and pauses...
+   nesEnableBreakpoints(false);
+
+   m_isRewinding = true;
+   m_isStarting = false;
+   m_isRunning = false;
+   m_isPaused = true;
+   m_showOnPause = false;
+
+   if ( !(nesBreakpointSemaphore->available()) )
+   {
+      nesBreakpointSemaphore->release();
+   }
+   start();
+}
+
 void NESEmulatorThread::pauseEmulation (bool show)
 {
    m_isStarting = false;
@@ -478,6 +512,7 @@ void NESEmulatorThread::run ()
    int emuY;
    int32_t samplesAvailable;
    int32_t debuggerUpdateRate = EnvironmentSettingsDialog::debuggerUpdateRate();
+   int32_t frameTime;
 
    // Special case for 1Hz debugger update to match system mode.
    if ( debuggerUpdateRate == -1 )
@@ -492,6 +527,16 @@ void NESEmulatorThread::run ()
       }
    }
 
+   // Real-time length of a frame in milliseconds, for maximum speed mode.
+   if ( nesGetSystemMode() == MODE_NTSC )
+   {
+      frameTime = 1000/60;
+   }
+   else
+   {
+      frameTime = 1000/50;
+   }
+
    while ( m_isStarting || m_isRunning || m_isResetting || m_isPaused )
    {
       // Allow thread exit...
@@ -511,6 +556,11 @@ void NESEmulatorThread::run ()
          // Re-enable breakpoints that were previously enabled...
          nesEnableBreakpoints(true);
 
+         // Start measuring frame rate...
+         m_frameTimer.start();
+         m_fpsTimer.start();
+         m_fpsFrames = 0;
+
          // Trigger UI updates...
          emit emulatorStarted();
       }
@@ -548,6 +598,17 @@ void NESEmulatorThread::run ()
          m_isResetting = false;
       }
 
+      // Step back through the rewind history...
+      if ( m_isRewinding )
+      {
+         nesRewind();
+
+         // Re-enable breakpoints that were previously enabled...
+         nesEnableBreakpoints(true);
+
+         m_isRewinding = false;
+      }
+
       // Pause?
       if ( m_isPaused || (m_pauseAfterFrames == 0) )
       {
@@ -619,26 +680,52 @@ void NESEmulatorThread::run ()
                                               emuY+(240*scale));
             }
          }
-         nesRun(m_joy);
 
-         if ( m_pauseAfterFrames != -1 )
+         // At maximum speed only draw the frames the display has time for,
+         // the rest are emulated without rendering or audio.
+         if ( m_isTurbo )
          {
-            m_pauseAfterFrames--;
+            nesSetFrameSkip(m_frameTimer.elapsed() < frameTime);
+         }
+         else
+         {
+            nesSetFrameSkip(false);
          }
 
-         emit emulatedFrame();
+         nesRun(m_joy);
 
-         if ( m_debugFrame )
+         if ( m_pauseAfterFrames != -1 )
          {
-            m_debugFrame--;
+            m_pauseAfterFrames--;
          }
-         if ( (!m_debugFrame) && (debuggerUpdateRate) )
+
+         if ( !nesGetFrameSkip() )
          {
-            m_debugFrame = debuggerUpdateRate;
-            if ( nesIsDebuggable() )
+            m_frameTimer.restart();
+
+            emit emulatedFrame();
+
+            if ( m_debugFrame )
             {
-               emit updateDebuggers();
+               m_debugFrame--;
             }
+            if ( (!m_debugFrame) && (debuggerUpdateRate) )
+            {
+               m_debugFrame = debuggerUpdateRate;
+               if ( nesIsDebuggable() )
+               {
+                  emit updateDebuggers();
+               }
+            }
+         }
+
+         // Report achieved frame rate once a second...
+         m_fpsFrames++;
+         if ( m_fpsTimer.elapsed() >= 1000 )
+         {
+            emit emulatorFPS((m_fpsFrames*1000.0)/m_fpsTimer.elapsed());
+            m_fpsTimer.restart();
+            m_fpsFrames = 0;
          }
       }
    }
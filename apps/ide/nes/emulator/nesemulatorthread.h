@@ -3,6 +3,7 @@
 
 #include <QThread>
 #include <QSemaphore>
+#include <QElapsedTimer>
 
 #include "ixmlserializable.h"
 
@@ -27,6 +28,8 @@ public:
 
    QSemaphore* nesBreakpointSemaphore;
    QSemaphore* nesAudioSemaphore;   
+
+   bool isTurbo() const { return m_isTurbo; }
    
 public slots:
    void breakpointsChanged (); // unused
@@ -41,7 +44,9 @@ public slots:
    void stepOutCPUEmulation ();
    void stepPPUEmulation ();
    void advanceFrame ();
+   void rewindEmulation ();
    void adjustAudio ( int32_t bufferDepth );
+   void setTurbo ( bool turbo ) { m_isTurbo = turbo; }
    void controllerInput ( uint32_t* joy )
    {
       m_joy[CONTROLLER1] = joy[CONTROLLER1];
@@ -52,6 +57,7 @@ public slots:
 signals:
    void breakpoint ();
    void emulatedFrame ();
+   void emulatorFPS ( float fps );
    void updateDebuggers ();
    void machineReady ();
    void emulatorPaused(bool show);
@@ -73,8 +79,13 @@ protected:
    bool          m_isTerminating;
    bool          m_isResetting;
    bool          m_isSoftReset;
+   bool          m_isRewinding;
    bool          m_isStarting;
    int           m_debugFrame;
+   bool          m_isTurbo;
+   QElapsedTimer m_frameTimer;
+   QElapsedTimer m_fpsTimer;
+   int           m_fpsFrames;
    uint32_t      m_joy [ NUM_CONTROLLERS ];
 };
 
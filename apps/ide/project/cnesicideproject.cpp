@@ -584,11 +584,11 @@ bool CNesicideProject::createProjectFromRom(QString fileName,bool silent)
       QDataStream fs(&fileIn);
 
       // Check the NES header
-      char nesHeader[4] = {'N', 'E', 'S', 0x1A};
-      char nesTest[4] = {0, 0, 0, 0};
-      fs.readRawData(nesTest,4);
+      uint8_t header[INES_HEADER_SIZE];
+      NesRomHeader romHeader;
 
-      if (memcmp(nesHeader, nesTest,4))
+      if ((fs.readRawData((char*)header,INES_HEADER_SIZE) != INES_HEADER_SIZE) ||
+          (!nesParseROMHeader(header,&romHeader)))
       {
          // Header check failed, quit
          fileIn.close();
@@ -599,37 +599,13 @@ bool CNesicideProject::createProjectFromRom(QString fileName,bool silent)
          return false;
       }
 
-      // Number of 16 KB PRG-ROM banks
-      qint8 numPrgRomBanks;
-      fs >> numPrgRomBanks;
-
-      // Convert to 8 KB banks
-      numPrgRomBanks <<= 1;
-
-      // Get the number of 8 KB CHR-ROM / VROM banks
-      qint8 numChrRomBanks;
-      fs >> numChrRomBanks;
-
-      // ROM Control Byte 1:
-      // - Bit 0 - Indicates the type of mirroring used by the game
-      //   where 0 indicates horizontal mirroring, 1 indicates
-      //   vertical mirroring.
-      //
-      // - Bit 1 - Indicates the presence of battery-backed RAM at
-      //   memory locations $6000-$7FFF.
-      //
-      // - Bit 2 - Indicates the presence of a 512-byte trainer at
-      //   memory locations $7000-$71FF.
-      //
-      // - Bit 3 - If this bit is set it overrides bit 0 to indicate fourscreen
-      //   mirroring should be used.
-      //
-      // - Bits 4-7 - Four lower bits of the mapper number.
-      qint8 romCB1;
-      fs >> romCB1;
+      if ( romHeader.junk && (!silent) )
+      {
+         QMessageBox::information(0, "Warning", "Invalid iNES header format.\nSave the project to fix.");
+      }
 
       // First extract the mirror mode
-      if ((romCB1&FLAG_MIRROR) == FLAG_MIRROR_VERT)
+      if ((romHeader.flags&FLAG_MIRROR) == FLAG_MIRROR_VERT)
       {
          m_pCartridge->setMirrorMode(VerticalMirroring);
       }
@@ -637,66 +613,26 @@ bool CNesicideProject::createProjectFromRom(QString fileName,bool silent)
       {
          m_pCartridge->setMirrorMode(HorizontalMirroring);
       }
-      if ((romCB1&FLAG_VRAM) == FLAG_FOURSCREEN_VRAM)
+      if ((romHeader.flags&FLAG_VRAM) == FLAG_FOURSCREEN_VRAM)
       {
          m_pCartridge->setFourScreen(true);
       }
 
-      // Now extract the two flags (battery backed ram and trainer)
-      m_pCartridge->setBatteryBackedRam(romCB1 & 0x02);
-      bool hasTrainer = (romCB1 & 0x04);
-
-      // ROM Control Byte 2:
-      //  Bits 0-3 - Reserved for future usage and should all be 0.
-      //  Bits 4-7 - Four upper bits of the mapper number.
-      qint8 romCB2;
-      fs >> romCB2;
-
-      if ( romCB2&0x0F )
-      {
-         romCB2 = 0x00;
-         if (!silent)
-         {
-            QMessageBox::information(0, "Warning", "Invalid iNES header format.\nSave the project to fix.");
-         }
-      }
-
-      // Extract the upper four bits of the mapper number
-      m_pCartridge->setMapperNumber(((romCB1>>4)&0x0F)|(romCB2&0xF0));
-
-      // Number of 8 KB RAM banks. For compatibility with previous
-      // versions of the iNES format, assume 1 page of RAM when
-      // this is 0.
-      qint8 numRamBanks;
-      fs >> numRamBanks;
-
-      if (numRamBanks == 0)
-      {
-         numRamBanks = 1;
-      }
-
-      // Skip the 7 reserved bytes
-      qint8 skip;
+      // Now extract the battery backed RAM flag and the mapper number
+      m_pCartridge->setBatteryBackedRam(romHeader.flags&FLAG_SRAM);
+      m_pCartridge->setMapperNumber(romHeader.mapper);
 
-      for (int i=0; i<7; i++)
-      {
-         fs >> skip;
-      }
+      // Skip the trainer (if it exists)
+      // TODO: Handle trainer. Skipping for now.
+      fs.skipRawData(romHeader.dataOffset-INES_HEADER_SIZE);
 
-      // Extract the trainer (if it exists)
-      if (hasTrainer)
-      {
-         // TODO: Handle trainer. Skipping for now.
-         for (int i=0; i<512; i++)
-         {
-            fs >> skip;
-         }
-      }
+      uint32_t numPrgRomBanks = romHeader.numPrgRomBanks;
+      uint32_t numChrRomBanks = romHeader.numChrRomBanks;
 
-      // Load the PRG-ROM banks (16KB each)
+      // Load the PRG-ROM banks (8KB each)
       oldBanks = prgRomBanks->getPrgRomBanks().count();
       bankIdx = 0;
-      for (int bank=0; bank<numPrgRomBanks; bank++)
+      for (uint32_t bank=0; bank<numPrgRomBanks; bank++)
       {
          // Grab either a previously used bank, or a new one
          CPRGROMBank* curBank;
@@ -722,7 +658,7 @@ bool CNesicideProject::createProjectFromRom(QString fileName,bool silent)
       // Load the CHR-ROM banks (8KB each)
       oldBanks = chrRomBanks->getChrRomBanks().count();
       bankIdx = 0;
-      for (int bank=0; bank<numChrRomBanks; bank++)
+      for (uint32_t bank=0; bank<numChrRomBanks; bank++)
       {
          // Grab either a previously used bank, or a new one
          CCHRROMBank* curBank;
@@ -813,72 +749,34 @@ bool CNesicideProject::createRomFromProject(QString fileName)
        QDataStream fs(&fileOut);
 
        // Check the NES header
-       char nesHeader[4] = {'N', 'E', 'S', 0x1A};
-       fs.writeRawData(nesHeader,4);
-
-       // Number of 16KB PRG-ROM banks
-       qint8 numPrgRomBanks = prgRomBanks->getPrgRomBanks().count();
-
-       // iNES header expects 16KB banks
-       qint8 numPrgRomBanksHdr = numPrgRomBanks>>1;
-
-       fs << numPrgRomBanksHdr;
-
-       // Get the number of 8KB CHR-ROM / VROM banks
-       qint8 numChrRomBanks = chrRomBanks->getChrRomBanks().count();
-       fs << numChrRomBanks;
-
-       // ROM Control Byte 1:
-       // - Bit 0 - Indicates the type of mirroring used by the game
-       //   where 0 indicates horizontal mirroring, 1 indicates
-       //   vertical mirroring.
-       //
-       // - Bit 1 - Indicates the presence of battery-backed RAM at
-       //   memory locations $6000-$7FFF.
-       //
-       // - Bit 2 - Indicates the presence of a 512-byte trainer at
-       //   memory locations $7000-$71FF.
-       //
-       // - Bit 3 - If this bit is set it overrides bit 0 to indicate fourscreen
-       //   mirroring should be used.
-       //
-       // - Bits 4-7 - Four lower bits of the mapper number.
-       qint8 romCB1 = 0x00;
-
-       // First extract the mirror mode
+       uint8_t header[INES_HEADER_SIZE];
+       NesRomHeader romHeader;
+
+       // The iNES header expects 16KB PRG-ROM banks and 8KB CHR-ROM banks.
+       // Bigger cartridges and mappers past 255 get a NES 2.0 header.
+       uint32_t numPrgRomBanks = prgRomBanks->getPrgRomBanks().count();
+       uint32_t numChrRomBanks = chrRomBanks->getChrRomBanks().count();
+
+       romHeader.numPrgRomBanks = numPrgRomBanks;
+       romHeader.numChrRomBanks = numChrRomBanks;
+       romHeader.mapper = m_pCartridge->getMapperNumber();
+       romHeader.flags = 0x00;
        if (m_pCartridge->getMirrorMode() == VerticalMirroring)
        {
-          romCB1 |= FLAG_MIRROR_VERT;
+          romHeader.flags |= FLAG_MIRROR_VERT;
        }
        if (m_pCartridge->isBatteryBackedRam())
        {
-          romCB1 |= 0x02;
+          romHeader.flags |= FLAG_SRAM_ENABLED;
        }
-       romCB1 |= ((m_pCartridge->getMapperNumber()&0xF)<<4);
 
-       fs << romCB1;
-
-       // ROM Control Byte 2:
-       //  Bits 0-3 - Reserved for future usage and should all be 0.
-       //  Bits 4-7 - Four upper bits of the mapper number.
-       qint8 romCB2 = 0x00;
-
-       romCB2 |= (m_pCartridge->getMapperNumber()&0xF0);
-
-       fs << romCB2;
-
-       // Skip the 7 reserved bytes
-       qint8 skip = 0;
-
-       for (int i=0; i<8; i++)
-       {
-          fs << skip;
-       }
+       nesBuildROMHeader(&romHeader,header);
+       fs.writeRawData((char*)header,INES_HEADER_SIZE);
 
        // Ignore trainer.
 
-       // Save the PRG-ROM banks (16KB each)
-       for (int bank=0; bank<numPrgRomBanks; bank++)
+       // Save the PRG-ROM banks (8KB each)
+       for (uint32_t bank=0; bank<numPrgRomBanks; bank++)
        {
           // Grab either a previously used bank, or a new one
           CPRGROMBank* curBank = prgRomBanks->getPrgRomBanks().at(bank);
@@ -887,7 +785,7 @@ bool CNesicideProject::createRomFromProject(QString fileName)
        }
 
        // Save the CHR-ROM banks (8KB each)
-       for (int bank=0; bank<numChrRomBanks; bank++)
+       for (uint32_t bank=0; bank<numChrRomBanks; bank++)
        {
           // Grab either a previously used bank, or a new one
           CCHRROMBank* curBank = chrRomBanks->getChrRomBanks().at(bank);
@@ -88,7 +88,11 @@ NESEmulatorThread::NESEmulatorThread(QObject*)
    sdlAudioSpec.samples = APU_SAMPLES;
 
    SDL_AudioSpec sdlAudioSpecOut;
-   SDL_OpenAudio ( &sdlAudioSpec, &sdlAudioSpecOut );
+   if ( SDL_OpenAudio ( &sdlAudioSpec, &sdlAudioSpecOut ) == 0 )
+   {
+      // Produce samples at whatever rate the device opened at.
+      nesSetAudioSampleRate ( sdlAudioSpecOut.freq );
+   }
 
    SDL_PauseAudio ( 0 );
 
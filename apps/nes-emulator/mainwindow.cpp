@@ -267,11 +267,11 @@ void MainWindow::loadCartridge ( QString fileName )
       QDataStream fs(&fileIn);
 
       // Check the NES header
-      char nesHeader[4] = {'N', 'E', 'S', 0x1A};
-      char nesTest[4] = {0, 0, 0, 0};
-      fs.readRawData(nesTest,4);
+      uint8_t header[INES_HEADER_SIZE];
+      NesRomHeader romHeader;
 
-      if (memcmp(nesHeader, nesTest,4))
+      if ((fs.readRawData((char*)header,INES_HEADER_SIZE) != INES_HEADER_SIZE) ||
+          (!nesParseROMHeader(header,&romHeader)))
       {
          // Header check failed, quit
          fileIn.close();
@@ -279,37 +279,13 @@ void MainWindow::loadCartridge ( QString fileName )
          return;
       }
 
-      // Number of 16 KB PRG-ROM banks
-      qint8 numPrgRomBanks;
-      fs >> numPrgRomBanks;
-
-      // Convert to 8 KB banks
-      numPrgRomBanks <<= 1;
-
-      // Get the number of 8 KB CHR-ROM / VROM banks
-      qint8 numChrRomBanks;
-      fs >> numChrRomBanks;
-
-      // ROM Control Byte 1:
-      // - Bit 0 - Indicates the type of mirroring used by the game
-      //   where 0 indicates horizontal mirroring, 1 indicates
-      //   vertical mirroring.
-      //
-      // - Bit 1 - Indicates the presence of battery-backed RAM at
-      //   memory locations $6000-$7FFF.
-      //
-      // - Bit 2 - Indicates the presence of a 512-byte trainer at
-      //   memory locations $7000-$71FF.
-      //
-      // - Bit 3 - If this bit is set it overrides bit 0 to indicate fourscreen
-      //   mirroring should be used.
-      //
-      // - Bits 4-7 - Four lower bits of the mapper number.
-      qint8 romCB1;
-      fs >> romCB1;
+      if (romHeader.junk)
+      {
+         QMessageBox::information(0, "Warning", "Invalid iNES header format.\nSave the project to fix.");
+      }
 
       // First extract the mirror mode
-      if ((romCB1&FLAG_MIRROR) == FLAG_MIRROR_VERT)
+      if ((romHeader.flags&FLAG_MIRROR) == FLAG_MIRROR_VERT)
       {
          cartridge->setMirrorMode(VerticalMirroring);
       }
@@ -318,72 +294,31 @@ void MainWindow::loadCartridge ( QString fileName )
          cartridge->setMirrorMode(HorizontalMirroring);
       }
 
-      // Now extract the two flags (battery backed ram and trainer)
-      cartridge->setBatteryBackedRam(romCB1 & 0x02);
-      bool hasTrainer = (romCB1 & 0x04);
+      // Now extract the battery backed RAM flag and the mapper number
+      cartridge->setBatteryBackedRam(romHeader.flags&FLAG_SRAM);
+      cartridge->setFourScreen(romHeader.flags&FLAG_FOURSCREEN_VRAM);
+      cartridge->setMapperNumber(romHeader.mapper);
 
-      // ROM Control Byte 2:
-      //  Bits 0-3 - Reserved for future usage and should all be 0.
-      //  Bits 4-7 - Four upper bits of the mapper number.
-      qint8 romCB2;
-      fs >> romCB2;
+      // Skip the trainer (if it exists)
+      // TODO: Handle trainer. Skipping for now.
+      fs.skipRawData(romHeader.dataOffset-INES_HEADER_SIZE);
 
-      if ( romCB2&0x0F )
-      {
-         romCB2 = 0x00;
-         QMessageBox::information(0, "Warning", "Invalid iNES header format.\nSave the project to fix.");
-      }
-
-      // Extract the upper four bits of the mapper number
-      cartridge->setMapperNumber(((romCB1>>4)&0x0F)|(romCB2&0xF0));
-
-      // Number of 8 KB RAM banks. For compatibility with previous
-      // versions of the iNES format, assume 1 page of RAM when
-      // this is 0.
-      qint8 numRamBanks;
-      fs >> numRamBanks;
-
-      if (numRamBanks == 0)
-      {
-         numRamBanks = 1;
-      }
-
-      // Skip the 7 reserved bytes
-      qint8 skip;
-
-      for (int i=0; i<7; i++)
-      {
-         fs >> skip;
-      }
-
-      // Extract the trainer (if it exists)
-      if (hasTrainer)
-      {
-         // TODO: Handle trainer. Skipping for now.
-         for (int i=0; i<512; i++)
-         {
-            fs >> skip;
-         }
-      }
-
-      // Load the PRG-ROM banks (16KB each)
-      for (int bank=0; bank<numPrgRomBanks; bank++)
+      // Load the PRG-ROM banks (8KB each)
+      cartridge->setNumPrgRomBanks(romHeader.numPrgRomBanks);
+      for (uint32_t bank=0; bank<romHeader.numPrgRomBanks; bank++)
       {
          // Load in the binary data
          fs.readRawData(cartridge->getPointerToPrgRomBank(bank),MEM_8KB);
       }
 
-      cartridge->setNumPrgRomBanks(numPrgRomBanks);
-
       // Load the CHR-ROM banks (8KB each)
-      for (int bank=0; bank<numChrRomBanks; bank++)
+      cartridge->setNumChrRomBanks(romHeader.numChrRomBanks);
+      for (uint32_t bank=0; bank<romHeader.numChrRomBanks; bank++)
       {
          // Load in the binary data
          fs.readRawData(cartridge->getPointerToChrRomBank(bank),MEM_8KB);
       }
 
-      cartridge->setNumChrRomBanks(numChrRomBanks);
-
       cartridge->setSaveStateFile(fileInfo.completeBaseName()+".sav");
 
       fileIn.close();
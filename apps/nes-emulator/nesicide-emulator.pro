@@ -60,7 +60,7 @@ TEMPLATE = app
 #########################################
 
 NESICIDE_CXXFLAGS = -I$$TOP/libs/nes -I$$TOP/libs/nes/emulator
-NESICIDE_LIBS = -L$$TOP/libs/nes/$$DESTDIR -lnes-emulator
+NESICIDE_LIBS = -L$$TOP/libs/nes/$$DESTDIR -lnes-emulator-nodebug
 
 QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
 
@@ -87,8 +87,8 @@ mac {
 
    QMAKE_PRE_LINK += cp $$TOP/libs/nes/$$DESTDIR/*.dylib \
       $$DESTDIR/$${TARGET}.app/Contents/Frameworks/ $$escape_expand(\n\t)
-   QMAKE_POST_LINK += install_name_tool -change libnes-emulator.1.dylib \
-       @executable_path/../Frameworks/libnes-emulator.1.dylib \
+   QMAKE_POST_LINK += install_name_tool -change libnes-emulator-nodebug.1.dylib \
+       @executable_path/../Frameworks/libnes-emulator-nodebug.1.dylib \
        $$DESTDIR/$${TARGET}.app/Contents/MacOS/nes-emulator $$escape_expand(\n\t)
 
    QMAKE_PRE_LINK += cp -r $$DEPENDENCYPATH/SDL.framework \
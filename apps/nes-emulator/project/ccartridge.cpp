@@ -2,9 +2,12 @@
 
 CCartridge::CCartridge()
 {
+   m_numPrgBanks = 0;
+   m_numChrBanks = 0;
    m_mirrorMode = HorizontalMirroring;
    m_mapperNumber = 0;
    m_hasBatteryBackedRam = false;
+   m_fourScreen = false;
 }
 
 CCartridge::~CCartridge()
@@ -2,6 +2,7 @@
 #define CCARTRIDGE_H
 
 #include <QString>
+#include <QByteArray>
 
 #include "nes_emulator_core.h"
 
@@ -40,7 +41,7 @@ public:
    }
    char* getPointerToPrgRomBank(int bank)
    {
-      return m_prgBank[bank];
+      return m_prgRom.data()+(bank*MEM_8KB);
    }
    int getNumChrRomBanks()
    {
@@ -48,7 +49,7 @@ public:
    }
    char* getPointerToChrRomBank(int bank)
    {
-      return m_chrBank[bank];
+      return m_chrRom.data()+(bank*MEM_8KB);
    }
    QString getSaveStateFile()
    {
@@ -56,13 +57,17 @@ public:
    }
 
    // Member Setters
+   // The ROM is only as big as the cartridge says, set the number of banks
+   // before filling them in.
    void setNumChrRomBanks(int banks)
    {
       m_numChrBanks = banks;
+      m_chrRom.resize(banks*MEM_8KB);
    }
    void setNumPrgRomBanks(int banks)
    {
       m_numPrgBanks = banks;
+      m_prgRom.resize(banks*MEM_8KB);
    }
    void setMirrorMode(eMirrorMode mirrorMode)
    {
@@ -87,9 +92,9 @@ public:
 
 private:
    int m_numPrgBanks;
-   char m_prgBank [ NUM_ROM_BANKS ][ MEM_8KB ];
+   QByteArray m_prgRom;
    int m_numChrBanks;
-   char m_chrBank [ NUM_ROM_BANKS ][ MEM_8KB ];
+   QByteArray m_chrRom;
    eMirrorMode m_mirrorMode;                      // Mirror mode used in the emulator
    bool m_hasBatteryBackedRam;                        // Memory can be saved via RAM kept valid with a battery
    bool m_fourScreen;
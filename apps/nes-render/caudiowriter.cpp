@@ -0,0 +1,111 @@
+#include "caudiowriter.h"
+
+#include <QtEndian>
+
+#include <stdio.h>
+#include <string.h>
+
+#define WAV_HEADER_SIZE 44
+
+CAudioWriter::CAudioWriter() :
+   m_wav(false),
+   m_sampleRate(0),
+   m_dataBytes(0)
+{
+}
+
+CAudioWriter::~CAudioWriter()
+{
+   close();
+}
+
+bool CAudioWriter::open(QString fileName, bool wav, int sampleRate)
+{
+   bool opened;
+
+   m_wav = wav;
+   m_sampleRate = sampleRate;
+   m_dataBytes = 0;
+
+   if ( fileName == "-" )
+   {
+      opened = m_file.open(stdout,QIODevice::WriteOnly);
+   }
+   else
+   {
+      m_file.setFileName(fileName);
+      opened = m_file.open(QIODevice::WriteOnly|QIODevice::Truncate);
+   }
+
+   if ( opened && m_wav )
+   {
+      opened = writeHeader(0xFFFFFFFF-(WAV_HEADER_SIZE-8));
+   }
+
+   return opened;
+}
+
+bool CAudioWriter::writeHeader(uint32_t dataBytes)
+{
+   uchar header[WAV_HEADER_SIZE];
+
+   memcpy(header,"RIFF",4);
+   qToLittleEndian<quint32>(dataBytes+(WAV_HEADER_SIZE-8),header+4);
+   memcpy(header+8,"WAVEfmt ",8);
+   qToLittleEndian<quint32>(16,header+16);
+   qToLittleEndian<quint16>(1,header+20); // PCM
+   qToLittleEndian<quint16>(1,header+22); // Mono
+   qToLittleEndian<quint32>(m_sampleRate,header+24);
+   qToLittleEndian<quint32>(m_sampleRate*sizeof(int16_t),header+28);
+   qToLittleEndian<quint16>(sizeof(int16_t),header+32);
+   qToLittleEndian<quint16>(16,header+34);
+   memcpy(header+36,"data",4);
+   qToLittleEndian<quint32>(dataBytes,header+40);
+
+   return m_file.write((const char*)header,WAV_HEADER_SIZE) == WAV_HEADER_SIZE;
+}
+
+bool CAudioWriter::write(const int16_t* samples, int count)
+{
+   int16_t little[1024];
+   int chunk;
+   int sample;
+
+   // Both formats are little-endian whatever the host is.
+   while ( count )
+   {
+      chunk = count;
+      if ( chunk > 1024 )
+      {
+         chunk = 1024;
+      }
+      for ( sample = 0; sample < chunk; sample++ )
+      {
+         little[sample] = qToLittleEndian<qint16>(samples[sample]);
+      }
+      if ( m_file.write((const char*)little,chunk*sizeof(int16_t)) != (qint64)(chunk*sizeof(int16_t)) )
+      {
+         return false;
+      }
+      m_dataBytes += chunk*sizeof(int16_t);
+      samples += chunk;
+      count -= chunk;
+   }
+
+   return true;
+}
+
+void CAudioWriter::close()
+{
+   if ( !m_file.isOpen() )
+   {
+      return;
+   }
+
+   if ( m_wav && (!m_file.isSequential()) && m_file.seek(0) )
+   {
+      writeHeader(m_dataBytes);
+   }
+
+   m_file.close();
+}
@@ -0,0 +1,34 @@
+#ifndef CAUDIOWRITER_H
+#define CAUDIOWRITER_H
+
+#include <QFile>
+#include <QString>
+
+#include <stdint.h>
+
+// Streams 16-bit mono PCM to a file, or to standard output if the file
+// name is "-", either raw or as a WAV file.  The WAV header is written up
+// front and its sizes are filled in on close; when writing to a pipe they
+// can't be, so they are left at the maximum as streaming tools expect.
+class CAudioWriter
+{
+public:
+   CAudioWriter();
+   ~CAudioWriter();
+
+   bool open(QString fileName, bool wav, int sampleRate);
+   bool write(const int16_t* samples, int count);
+   void close();
+
+   qint64 samplesWritten() const { return m_dataBytes/sizeof(int16_t); }
+
+private:
+   bool writeHeader(uint32_t dataBytes);
+
+   QFile  m_file;
+   bool   m_wav;
+   int    m_sampleRate;
+   qint64 m_dataBytes;
+};
+
+#endif // CAUDIOWRITER_H
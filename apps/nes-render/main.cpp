@@ -0,0 +1,294 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nes_emulator_core.h"
+#include "cjoypadlogger.h"
+
+#include "caudiowriter.h"
+
+// Loads an iNES image into the emulator the same way the emulator's
+// cartridge loader does.
+static bool loadROM(QString romPath, QString* error)
+{
+   QFile        romFile(romPath);
+   QByteArray   rom;
+   NesRomHeader header;
+   uint32_t     offset;
+   uint32_t     bank;
+
+   if ( !romFile.open(QIODevice::ReadOnly) )
+   {
+      (*error) = "cannot open ROM";
+      return false;
+   }
+   rom = romFile.readAll();
+   romFile.close();
+
+   if ( (rom.size() < INES_HEADER_SIZE) || (!nesParseROMHeader((const uint8_t*)rom.constData(),&header)) )
+   {
+      (*error) = "invalid ROM format";
+      return false;
+   }
+
+   offset = header.dataOffset;
+   if ( (uint64_t)rom.size() < offset+(((uint64_t)header.numPrgRomBanks+header.numChrRomBanks)*MEM_8KB) )
+   {
+      (*error) = "ROM is truncated";
+      return false;
+   }
+
+   nesUnloadROM();
+
+   for ( bank = 0; bank < header.numPrgRomBanks; bank++ )
+   {
+      nesLoadPRGROMBank(bank,(uint8_t*)rom.data()+offset);
+      offset += MEM_8KB;
+   }
+   for ( bank = 0; bank < header.numChrRomBanks; bank++ )
+   {
+      nesLoadCHRROMBank(bank,(uint8_t*)rom.data()+offset);
+      offset += MEM_8KB;
+   }
+
+   nesLoadROM();
+
+   if ( (header.flags&FLAG_MIRROR) == FLAG_MIRROR_VERT )
+   {
+      nesSetVerticalMirroring();
+   }
+   else
+   {
+      nesSetHorizontalMirroring();
+   }
+   if ( header.flags&FLAG_FOURSCREEN_VRAM )
+   {
+      nesSetFourScreen();
+   }
+
+   nesResetInitial(header.mapper);
+
+   return true;
+}
+
+// Feeds joypad input recorded by the IDE, stored base64 encoded the
+// same way as in a test suite, to controller 1.
+static bool loadInput(QString inputPath)
+{
+   QFile             inputFile(inputPath);
+   QByteArray        inputSamplesRaw;
+   JoypadLoggerInfo* inputSample;
+   int32_t           numInputSamples;
+   int32_t           sample;
+
+   if ( !inputFile.open(QIODevice::ReadOnly) )
+   {
+      return false;
+   }
+   inputSamplesRaw = QByteArray::fromBase64(inputFile.readAll().trimmed());
+   inputFile.close();
+
+   nesResetInputRecording();
+   inputSample = (JoypadLoggerInfo*)inputSamplesRaw.data();
+   numInputSamples = inputSamplesRaw.length()/sizeof(JoypadLoggerInfo);
+   for ( sample = 0; sample < numInputSamples; sample++ )
+   {
+      nesSetInputSample(0,inputSample);
+      inputSample++;
+   }
+   nesSetInputRecording(false);
+   nesSetInputPlayback(true);
+
+   return true;
+}
+
+// Runs a ROM for a number of frames as fast as possible and streams its
+// audio, expansion audio included, and optionally its video to files.
+// Frames are only drawn if the video is wanted.
+int main(int argc, char* argv[])
+{
+   QCoreApplication renderApplication(argc, argv);
+   QCommandLineParser parser;
+   CAudioWriter audioWriter;
+   QElapsedTimer timer;
+   QString romPath;
+   QString outputPath;
+   QString videoPath;
+   QString system;
+   QString error;
+   bool wav = false;
+   int videoFormat = NES_FRAMEDUMP_RGBA;
+   int frames;
+   int frame;
+   int sampleRate;
+   int32_t samples;
+   int16_t audio[APU_SAMPLES];
+   uint32_t joy[NUM_CONTROLLERS] = { 0, };
+   int8_t* tv;
+
+   QCoreApplication::setOrganizationName("CSPSoftware");
+   QCoreApplication::setOrganizationDomain("nesicide.com");
+   QCoreApplication::setApplicationName("nes-render");
+
+   parser.setApplicationDescription("Renders the audio and video of a NES ROM headless, faster than real time.");
+   parser.addHelpOption();
+   parser.addPositionalArgument("rom","iNES ROM file.");
+   parser.addPositionalArgument("output","Audio file to write, or - for standard output.","[output]");
+   QCommandLineOption framesOption(QStringList() << "f" << "frames","Number of frames to run.","N","3600");
+   parser.addOption(framesOption);
+   QCommandLineOption rateOption(QStringList() << "r" << "rate","Output sample rate in Hz.","HZ",QString::number(SDL_SAMPLE_RATE));
+   parser.addOption(rateOption);
+   QCommandLineOption formatOption("format","Output format, wav or raw (16-bit signed little-endian mono).  By default wav if the output file name ends in .wav.","FORMAT");
+   parser.addOption(formatOption);
+   QCommandLineOption systemOption(QStringList() << "s" << "system","System to emulate, ntsc, pal or dendy.","SYSTEM","ntsc");
+   parser.addOption(systemOption);
+   QCommandLineOption inputOption(QStringList() << "i" << "input","Joypad input recorded by the IDE, base64 encoded as in a test suite.","FILE");
+   parser.addOption(inputOption);
+   QCommandLineOption videoOption("video","Also write every frame to FILE, or - for standard output, as 256x240 raw frames.","FILE");
+   parser.addOption(videoOption);
+   QCommandLineOption videoFormatOption("video-format","Frame format, rgba (8-bit RGBA) or indexed (16-bit little-endian palette index and emphasis bits).","FORMAT","rgba");
+   parser.addOption(videoFormatOption);
+   parser.process(renderApplication);
+
+   if ( (parser.positionalArguments().count() < 1) ||
+        (parser.positionalArguments().count() > 2) ||
+        ((parser.positionalArguments().count() == 1) && (!parser.isSet(videoOption))) )
+   {
+      parser.showHelp(1);
+   }
+   romPath = parser.positionalArguments().at(0);
+   if ( parser.positionalArguments().count() == 2 )
+   {
+      outputPath = parser.positionalArguments().at(1);
+   }
+   videoPath = parser.value(videoOption);
+
+   if ( parser.value(videoFormatOption) == "indexed" )
+   {
+      videoFormat = NES_FRAMEDUMP_INDEXED;
+   }
+   else if ( parser.value(videoFormatOption) != "rgba" )
+   {
+      fprintf(stderr,"%s: unknown video format\n",qPrintable(parser.value(videoFormatOption)));
+      return 1;
+   }
+
+   frames = parser.value(framesOption).toInt();
+   sampleRate = parser.value(rateOption).toInt();
+   if ( (sampleRate < APU_SAMPLE_RATE_MIN) || (sampleRate > APU_SAMPLE_RATE_MAX) )
+   {
+      fprintf(stderr,"sample rate must be between %d and %d Hz\n",APU_SAMPLE_RATE_MIN,APU_SAMPLE_RATE_MAX);
+      return 1;
+   }
+
+   if ( parser.isSet(formatOption) )
+   {
+      if ( (parser.value(formatOption) != "wav") && (parser.value(formatOption) != "raw") )
+      {
+         fprintf(stderr,"%s: unknown format\n",qPrintable(parser.value(formatOption)));
+         return 1;
+      }
+      wav = (parser.value(formatOption) == "wav");
+   }
+   else if ( !outputPath.isEmpty() )
+   {
+      wav = (QFileInfo(outputPath).suffix().toLower() == "wav");
+   }
+
+   system = parser.value(systemOption);
+   if ( system == "ntsc" )
+   {
+      nesSetSystemMode(MODE_NTSC);
+   }
+   else if ( system == "pal" )
+   {
+      nesSetSystemMode(MODE_PAL);
+   }
+   else if ( system == "dendy" )
+   {
+      nesSetSystemMode(MODE_DENDY);
+   }
+   else
+   {
+      fprintf(stderr,"%s: unknown system\n",qPrintable(system));
+      return 1;
+   }
+
+   tv = new int8_t[256*256*4];
+   memset(tv,0,256*256*4);
+   nesSetTVOut(tv);
+
+   nesSetControllerType(CONTROLLER1,IO_StandardJoypad);
+   nesSetControllerType(CONTROLLER2,IO_StandardJoypad);
+
+   if ( parser.isSet(inputOption) && (!loadInput(parser.value(inputOption))) )
+   {
+      fprintf(stderr,"%s: cannot load input\n",qPrintable(parser.value(inputOption)));
+      return 1;
+   }
+
+   nesSetAudioSampleRate(sampleRate);
+
+   if ( !loadROM(romPath,&error) )
+   {
+      fprintf(stderr,"%s: %s\n",qPrintable(romPath),qPrintable(error));
+      return 1;
+   }
+
+   if ( (!outputPath.isEmpty()) && (!audioWriter.open(outputPath,wav,sampleRate)) )
+   {
+      fprintf(stderr,"%s: cannot open output\n",qPrintable(outputPath));
+      return 1;
+   }
+
+   if ( videoPath.isEmpty() )
+   {
+      // Nobody looks at the pictures, only the sound is kept.
+      nesSetFrameSkip(true);
+      nesSetFrameSkipAudio(true);
+   }
+   else if ( !nesStartFrameDump(qPrintable(videoPath),videoFormat,8,false) )
+   {
+      fprintf(stderr,"%s: cannot open video output\n",qPrintable(videoPath));
+      return 1;
+   }
+
+   timer.start();
+
+   for ( frame = 0; frame < frames; frame++ )
+   {
+      nesRun(joy);
+
+      while ( (samples = nesReadAudioSamples(audio,APU_SAMPLES)) > 0 )
+      {
+         if ( outputPath.isEmpty() )
+         {
+            continue;
+         }
+         if ( !audioWriter.write(audio,samples) )
+         {
+            fprintf(stderr,"%s: write failed\n",qPrintable(outputPath));
+            return 1;
+         }
+      }
+   }
+
+   audioWriter.close();
+   if ( !videoPath.isEmpty() )
+   {
+      nesStopFrameDump();
+   }
+
+   fprintf(stderr,"%d frames, %lld samples at %d Hz, %u frames dumped in %lld ms\n",
+           frames,audioWriter.samplesWritten(),sampleRate,nesGetFramesDumped(),timer.elapsed());
+
+   nesSetTVOut(NULL);
+   delete [] tv;
+
+   return 0;
+}
@@ -0,0 +1,171 @@
+#include "ctestrunner.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <string.h>
+
+#include "nes_emulator_core.h"
+#include "cjoypadlogger.h"
+
+CTestRunner::CTestRunner(const CTestInfo& test, QString romPath, CTestOutcome* pOutcome) :
+   m_test(test),
+   m_romPath(romPath),
+   m_pOutcome(pOutcome)
+{
+   setAutoDelete(true);
+}
+
+bool CTestRunner::loadROM()
+{
+   QFile        romFile(m_romPath);
+   QByteArray   rom;
+   NesRomHeader header;
+   uint32_t     offset;
+   uint32_t     bank;
+
+   if ( !romFile.open(QIODevice::ReadOnly) )
+   {
+      m_pOutcome->error = "cannot open ROM";
+      return false;
+   }
+   rom = romFile.readAll();
+   romFile.close();
+
+   // Same interpretation of the iNES header as the emulator's cartridge loader.
+   if ( (rom.size() < INES_HEADER_SIZE) || (!nesParseROMHeader((const uint8_t*)rom.constData(),&header)) )
+   {
+      m_pOutcome->error = "invalid ROM format";
+      return false;
+   }
+
+   offset = header.dataOffset;
+   if ( (uint64_t)rom.size() < offset+(((uint64_t)header.numPrgRomBanks+header.numChrRomBanks)*MEM_8KB) )
+   {
+      m_pOutcome->error = "ROM is truncated";
+      return false;
+   }
+
+   nesUnloadROM();
+
+   for ( bank = 0; bank < header.numPrgRomBanks; bank++ )
+   {
+      nesLoadPRGROMBank(bank,(uint8_t*)rom.data()+offset);
+      offset += MEM_8KB;
+   }
+   for ( bank = 0; bank < header.numChrRomBanks; bank++ )
+   {
+      nesLoadCHRROMBank(bank,(uint8_t*)rom.data()+offset);
+      offset += MEM_8KB;
+   }
+
+   nesLoadROM();
+
+   if ( (header.flags&FLAG_MIRROR) == FLAG_MIRROR_VERT )
+   {
+      nesSetVerticalMirroring();
+   }
+   else
+   {
+      nesSetHorizontalMirroring();
+   }
+   if ( header.flags&FLAG_FOURSCREEN_VRAM )
+   {
+      nesSetFourScreen();
+   }
+
+   nesResetInitial(header.mapper);
+
+   return true;
+}
+
+void CTestRunner::run()
+{
+   QElapsedTimer      timer;
+   QCryptographicHash crypto(QCryptographicHash::Sha1);
+   QByteArray         inputSamplesRaw;
+   JoypadLoggerInfo*  inputSample;
+   int32_t            numInputSamples;
+   int32_t            sample;
+   int32_t            frame;
+   uint32_t           joy[NUM_CONTROLLERS] = { 0, };
+   int8_t*            tv;
+   NesContext*        pContext;
+
+   timer.start();
+
+   // This pool thread's NES lives until the end of the test.
+   pContext = nesCreateContext();
+
+   tv = new int8_t[256*256*4];
+   memset(tv,0,256*256*4);
+   nesSetTVOut(tv);
+
+   nesSetControllerType(CONTROLLER1,IO_StandardJoypad);
+   nesSetControllerType(CONTROLLER2,IO_StandardJoypad);
+
+   // Feed the recorded input, if any, exactly as the IDE does.
+   nesResetInputRecording();
+   inputSamplesRaw = QByteArray::fromBase64(m_test.recordedInput.toLatin1());
+   inputSample = (JoypadLoggerInfo*)inputSamplesRaw.data();
+   numInputSamples = inputSamplesRaw.length()/sizeof(JoypadLoggerInfo);
+   for ( sample = 0; sample < numInputSamples; sample++ )
+   {
+      nesSetInputSample(0,inputSample);
+      inputSample++;
+   }
+   nesSetInputRecording(false);
+   nesSetInputPlayback(true);
+
+   if ( m_test.system == "ntsc" )
+   {
+      nesSetSystemMode(MODE_NTSC);
+   }
+   else
+   {
+      nesSetSystemMode(MODE_PAL);
+   }
+
+   if ( loadROM() )
+   {
+      for ( frame = 0; frame < m_test.frames; frame++ )
+      {
+         // Only the last frame is compared so don't bother drawing the rest.
+         nesSetFrameSkip(frame < (m_test.frames-1));
+         nesRun(joy);
+
+         // Nobody is listening to the audio.
+         nesClearAudioSamplesAvailable();
+      }
+      nesSetFrameSkip(false);
+
+      crypto.addData((char*)nesGetTVOut(),256*240*4);
+      m_pOutcome->tvSha1 = crypto.result().toBase64();
+
+      if ( m_test.tvSha1.isEmpty() )
+      {
+         m_pOutcome->status = TestNoReference;
+      }
+      else if ( m_pOutcome->tvSha1 == m_test.tvSha1 )
+      {
+         m_pOutcome->status = TestPassed;
+      }
+      else
+      {
+         m_pOutcome->status = TestFailed;
+      }
+   }
+   else
+   {
+      m_pOutcome->status = TestError;
+   }
+
+   nesSetTVOut(NULL);
+   delete [] tv;
+
+   nesDestroyContext(pContext);
+
+   m_pOutcome->elapsedMs = timer.elapsed();
+}
@@ -0,0 +1,42 @@
+#ifndef CTESTRUNNER_H
+#define CTESTRUNNER_H
+
+#include <QRunnable>
+#include <QString>
+
+#include "ctestsuite.h"
+
+enum
+{
+   TestPassed = 0,
+   TestFailed,
+   TestNoReference,
+   TestError
+};
+
+struct CTestOutcome
+{
+   int     status;
+   QString tvSha1;
+   qint64  elapsedMs;
+   QString error;
+};
+
+// Runs one test on whichever pool thread picks it up.  Each run creates
+// its own emulator context so tests never share NES state.
+class CTestRunner : public QRunnable
+{
+public:
+   CTestRunner(const CTestInfo& test, QString romPath, CTestOutcome* pOutcome);
+
+   void run();
+
+private:
+   bool loadROM();
+
+   CTestInfo     m_test;
+   QString       m_romPath;
+   CTestOutcome* m_pOutcome;
+};
+
+#endif // CTESTRUNNER_H
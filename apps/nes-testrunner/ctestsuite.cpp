@@ -0,0 +1,111 @@
+#include "ctestsuite.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtXml>
+
+bool CTestSuite::load(QString fileName)
+{
+   QFile        testSuiteFile(fileName);
+   QDomDocument testSuiteDoc;
+   QDomElement  testSuiteElement;
+   QDomNode     testNode;
+
+   if ( !testSuiteFile.open(QIODevice::ReadOnly|QIODevice::Text) )
+   {
+      return false;
+   }
+   if ( !testSuiteDoc.setContent(&testSuiteFile) )
+   {
+      testSuiteFile.close();
+      return false;
+   }
+   testSuiteFile.close();
+
+   // ROM file names are relative to the test suite file.
+   m_folder = QFileInfo(fileName).absolutePath();
+   m_tests.clear();
+
+   testSuiteElement = testSuiteDoc.documentElement();
+   testNode = testSuiteElement.firstChild();
+   while ( !testNode.isNull() )
+   {
+      QDomElement testElement = testNode.toElement();
+      CTestInfo   test;
+
+      test.fileName = testElement.attribute("filename");
+      test.frames = testElement.attribute("runframes").toInt();
+      test.system = testElement.attribute("system");
+      test.result = testElement.attribute("testresult");
+      test.failComment = testElement.attribute("failcomment");
+      test.notes = testElement.attribute("testnotes");
+
+      QDomNode childNode = testElement.firstChild();
+      while ( !childNode.isNull() )
+      {
+         QDomElement childElement = childNode.toElement();
+         if ( childElement.nodeName() == "tvsha1" )
+         {
+            test.tvSha1 = childElement.firstChild().toCDATASection().data();
+         }
+         else if ( childElement.nodeName() == "recordedinput" )
+         {
+            test.recordedInput = childElement.firstChild().toCDATASection().data();
+         }
+         childNode = childNode.nextSibling();
+      }
+
+      m_tests.append(test);
+
+      testNode = testNode.nextSibling();
+   }
+
+   return true;
+}
+
+bool CTestSuite::save(QString fileName)
+{
+   QFile        testSuiteFile(fileName);
+   QDomDocument testSuiteDoc;
+   QDomElement  testSuiteElement;
+   QDomElement  testElement;
+   QDomElement  childElement;
+   QDomProcessingInstruction instr = testSuiteDoc.createProcessingInstruction("xml", "version='1.0' encoding='UTF-8'");
+   testSuiteDoc.appendChild(instr);
+
+   if ( !testSuiteFile.open(QIODevice::ReadWrite|QIODevice::Text|QIODevice::Truncate) )
+   {
+      return false;
+   }
+
+   testSuiteElement = testSuiteDoc.createElement("testsuite");
+   testSuiteDoc.appendChild(testSuiteElement);
+   foreach ( const CTestInfo& test, m_tests )
+   {
+      testElement = testSuiteDoc.createElement("test");
+      testSuiteElement.appendChild(testElement);
+      testElement.setAttribute("filename",test.fileName);
+      testElement.setAttribute("runframes",QString::number(test.frames));
+      testElement.setAttribute("system",test.system);
+      testElement.setAttribute("testresult",test.result);
+      testElement.setAttribute("failcomment",test.failComment);
+      testElement.setAttribute("testnotes",test.notes);
+      childElement = testSuiteDoc.createElement("tvsha1");
+      testElement.appendChild(childElement);
+      childElement.appendChild(testSuiteDoc.createCDATASection(test.tvSha1));
+      childElement = testSuiteDoc.createElement("recordedinput");
+      testElement.appendChild(childElement);
+      childElement.appendChild(testSuiteDoc.createCDATASection(test.recordedInput));
+   }
+
+   testSuiteFile.write(testSuiteDoc.toByteArray());
+   testSuiteFile.close();
+
+   return true;
+}
+
+QString CTestSuite::romPath(const CTestInfo& test) const
+{
+   return QDir(m_folder).absoluteFilePath(test.fileName);
+}
@@ -0,0 +1,39 @@
+#ifndef CTESTSUITE_H
+#define CTESTSUITE_H
+
+#include <QString>
+#include <QList>
+
+// One entry of a test suite file as written by the IDE's
+// Test Suite Executive dialog.
+struct CTestInfo
+{
+   QString fileName;
+   int     frames;
+   QString system;
+   QString result;
+   QString failComment;
+   QString notes;
+   QString tvSha1;
+   QString recordedInput;
+};
+
+// A test suite is an XML file of <test> elements each naming a ROM,
+// the number of frames to run it for and the SHA1 of the TV output
+// that is expected after that many frames.
+class CTestSuite
+{
+public:
+   bool load(QString fileName);
+   bool save(QString fileName);
+
+   QString romPath(const CTestInfo& test) const;
+
+   QList<CTestInfo>& tests() { return m_tests; }
+
+private:
+   QString          m_folder;
+   QList<CTestInfo> m_tests;
+};
+
+#endif // CTESTSUITE_H
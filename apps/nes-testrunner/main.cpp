@@ -0,0 +1,113 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+
+#include <stdio.h>
+
+#include "ctestsuite.h"
+#include "ctestrunner.h"
+
+// Runs a test suite written by the IDE's Test Suite Executive dialog
+// without a UI.  Every test gets its own emulator context so the tests
+// are spread across all available cores.
+int main(int argc, char* argv[])
+{
+   QCoreApplication testRunnerApplication(argc, argv);
+   QCommandLineParser parser;
+   CTestSuite testSuite;
+   QVector<CTestOutcome> outcomes;
+   QElapsedTimer timer;
+   QThreadPool pool;
+   int jobs;
+   int test;
+   int numPassed = 0;
+   int numFailed = 0;
+   int numNoReference = 0;
+   int numErrors = 0;
+
+   QCoreApplication::setOrganizationName("CSPSoftware");
+   QCoreApplication::setOrganizationDomain("nesicide.com");
+   QCoreApplication::setApplicationName("nes-testrunner");
+
+   parser.setApplicationDescription("Runs a NESICIDE test suite headless.");
+   parser.addHelpOption();
+   parser.addPositionalArgument("testsuite","Test suite XML file.");
+   QCommandLineOption jobsOption(QStringList() << "j" << "jobs","Number of tests to run at once.","N",QString::number(QThread::idealThreadCount()));
+   parser.addOption(jobsOption);
+   QCommandLineOption updateOption(QStringList() << "u" << "update","Store the TV SHA1 of tests that have none yet back into the test suite.");
+   parser.addOption(updateOption);
+   parser.process(testRunnerApplication);
+
+   if ( parser.positionalArguments().count() != 1 )
+   {
+      parser.showHelp(1);
+   }
+
+   if ( !testSuite.load(parser.positionalArguments().at(0)) )
+   {
+      fprintf(stderr,"%s: cannot load test suite\n",qPrintable(parser.positionalArguments().at(0)));
+      return 1;
+   }
+
+   jobs = parser.value(jobsOption).toInt();
+   if ( jobs < 1 )
+   {
+      jobs = 1;
+   }
+   pool.setMaxThreadCount(jobs);
+
+   timer.start();
+
+   outcomes.resize(testSuite.tests().count());
+   for ( test = 0; test < testSuite.tests().count(); test++ )
+   {
+      const CTestInfo& testInfo = testSuite.tests().at(test);
+
+      pool.start(new CTestRunner(testInfo,testSuite.romPath(testInfo),&outcomes[test]));
+   }
+   pool.waitForDone();
+
+   for ( test = 0; test < testSuite.tests().count(); test++ )
+   {
+      CTestInfo& testInfo = testSuite.tests()[test];
+      const CTestOutcome& outcome = outcomes.at(test);
+
+      switch ( outcome.status )
+      {
+      case TestPassed:
+         // Output is unchanged so the recorded verdict still holds.
+         printf("PASS %6lld ms %s\n",outcome.elapsedMs,qPrintable(testInfo.fileName));
+         numPassed++;
+         break;
+      case TestFailed:
+         printf("FAIL %6lld ms %s [%s]\n",outcome.elapsedMs,qPrintable(testInfo.fileName),qPrintable(outcome.tvSha1));
+         numFailed++;
+         break;
+      case TestNoReference:
+         printf("NEW  %6lld ms %s [%s]\n",outcome.elapsedMs,qPrintable(testInfo.fileName),qPrintable(outcome.tvSha1));
+         if ( parser.isSet(updateOption) )
+         {
+            testInfo.tvSha1 = outcome.tvSha1;
+         }
+         numNoReference++;
+         break;
+      default:
+         printf("ERR  %6lld ms %s [%s]\n",outcome.elapsedMs,qPrintable(testInfo.fileName),qPrintable(outcome.error));
+         numErrors++;
+         break;
+      }
+   }
+
+   printf("%d passed, %d failed, %d new, %d errors in %lld ms using %d threads\n",
+          numPassed,numFailed,numNoReference,numErrors,timer.elapsed(),jobs);
+
+   if ( parser.isSet(updateOption) && numNoReference )
+   {
+      testSuite.save(parser.positionalArguments().at(0));
+   }
+
+   return (numFailed||numErrors) ? 1 : 0;
+}
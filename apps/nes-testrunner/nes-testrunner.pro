@@ -0,0 +1,86 @@
+#-------------------------------------------------
+#
+# Headless regression runner for NESICIDE test suites.
+#
+#-------------------------------------------------
+
+# No GUI, just core and XML.
+QT = core xml
+
+CONFIG += console
+CONFIG -= app_bundle
+
+TOP = ../..
+
+macx {
+    QMAKE_MAC_SDK = macosx10.15
+}
+
+CONFIG(release, debug|release) {
+   DESTDIR = release
+} else {
+   DESTDIR = debug
+}
+
+# Remove crap we do not need!
+CONFIG -= rtti exceptions
+
+OBJECTS_DIR = $$DESTDIR
+MOC_DIR = $$DESTDIR
+RCC_DIR = $$DESTDIR
+UI_DIR = $$DESTDIR
+
+DEFINES -= UNICODE
+DEFINES += NES_MULTI_INSTANCE
+
+TARGET = "nes-testrunner"
+
+TEMPLATE = app
+
+# set platform specific cxxflags and libs
+#########################################
+
+NESICIDE_CXXFLAGS = -I$$TOP/libs/nes -I$$TOP/libs/nes/emulator -I$$TOP/libs/nes/common
+NESICIDE_LIBS = -L$$TOP/libs/nes/$$DESTDIR -lnes-emulator-mt-nodebug
+
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+
+win32 {
+   QMAKE_LFLAGS += -static-libgcc
+}
+
+mac {
+   QMAKE_POST_LINK += install_name_tool -change libnes-emulator-mt-nodebug.1.dylib \
+       @executable_path/../../../libs/nes/$$DESTDIR/libnes-emulator-mt-nodebug.1.dylib \
+       $$DESTDIR/$${TARGET} $$escape_expand(\n\t)
+}
+
+unix:!mac {
+   PREFIX = $$(PREFIX)
+   isEmpty (PREFIX) {
+      PREFIX = /usr/local
+   }
+
+   BINDIR = $$(BINDIR)
+   isEmpty (BINDIR) {
+      BINDIR=$$PREFIX/bin
+   }
+
+   target.path = $$BINDIR
+   INSTALLS += target
+}
+
+QMAKE_CXXFLAGS += $$NESICIDE_CXXFLAGS
+LIBS += $$NESICIDE_LIBS
+
+INCLUDEPATH += \
+   $$TOP/common
+
+SOURCES += \
+   main.cpp \
+   ctestsuite.cpp \
+   ctestrunner.cpp
+
+HEADERS += \
+   ctestsuite.h \
+   ctestrunner.h
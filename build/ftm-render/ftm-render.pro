@@ -0,0 +1,10 @@
+TEMPLATE = subdirs
+
+SUBDIRS = rtmidi famitracker-lib ftm-render-app
+
+rtmidi.file = ../../deps/rtmidi/rtmidi.pro
+famitracker-lib.file = ../../libs/famitracker/famitracker-lib.pro
+ftm-render-app.file = ../../apps/ftm-render/ftm-render.pro
+
+famitracker-lib.depends = rtmidi
+ftm-render-app.depends = famitracker-lib
@@ -24,5 +24,11 @@ echo Building FamiPlayer...
 ( cd build/famiplayer; qmake; make )
 echo Building NES Emulator...
 ( cd build/famitracker; qmake; make )
+echo Building NES test runner...
+( cd build/nes-testrunner; qmake; make )
+echo Building NES renderer...
+( cd build/nes-render; qmake; make )
+echo Building FamiTracker renderer...
+( cd build/ftm-render; qmake; make )
 
 exit 0
@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+SUBDIRS = nes-emulator-lib-nodebug nes-render-app
+
+nes-emulator-lib-nodebug.file = ../../libs/nes/nes-emulator-lib-nodebug.pro
+nes-render-app.file = ../../apps/nes-render/nes-render.pro
+
+nes-render-app.depends = nes-emulator-lib-nodebug
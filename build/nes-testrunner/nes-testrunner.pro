@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+SUBDIRS = nes-emulator-lib-mt-nodebug nes-testrunner-app
+
+nes-emulator-lib-mt-nodebug.file = ../../libs/nes/nes-emulator-lib-mt-nodebug.pro
+nes-testrunner-app.file = ../../apps/nes-testrunner/nes-testrunner.pro
+
+nes-testrunner-app.depends = nes-emulator-lib-mt-nodebug
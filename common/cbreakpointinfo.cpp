@@ -1,7 +1,8 @@
 #include "cbreakpointinfo.h"
 
 CBreakpointInfo::CBreakpointInfo()
-   : m_numBreakpoints(0)
+   : m_numBreakpoints(0),
+     m_version(0)
 {
 }
 
@@ -12,11 +13,13 @@ CBreakpointInfo::~CBreakpointInfo()
 void CBreakpointInfo::ToggleEnabled ( int bp )
 {
    m_breakpoint [ bp ].enabled = !m_breakpoint [ bp ].enabled;
+   m_version++;
 }
 
 void CBreakpointInfo::SetEnabled ( int bp, bool enabled )
 {
    m_breakpoint [ bp ].enabled = enabled;
+   m_version++;
 }
 
 int CBreakpointInfo::FindExactMatch ( int type, eBreakpointItemType itemType, int event, int item1, int item1Absolute, int item2, int mask, bool maskExclusive, eBreakpointConditionType conditionType, int condition, eBreakpointDataType dataType, int data )
@@ -65,6 +68,7 @@ void CBreakpointInfo::ModifyBreakpoint ( int bp, BreakpointInfo* pBreakpoint )
                        pBreakpoint->dataType,
                        pBreakpoint->data,
                        pBreakpoint->enabled);
+      m_version++;
    }
 }
 
@@ -93,6 +97,7 @@ int CBreakpointInfo::AddBreakpoint ( BreakpointInfo* pBreakpoint )
                          pBreakpoint->data,
                          pBreakpoint->enabled );
       m_numBreakpoints++;
+      m_version++;
    }
    else
    {
@@ -122,6 +127,7 @@ int CBreakpointInfo::AddBreakpoint ( int type, eBreakpointItemType itemType, int
                          data,
                          enabled );
       m_numBreakpoints++;
+      m_version++;
    }
    else
    {
@@ -157,6 +163,7 @@ void CBreakpointInfo::RemoveBreakpoint ( int index )
    }
 
    m_numBreakpoints--;
+   m_version++;
 }
 
 BreakpointStatus CBreakpointInfo::GetStatus ( int idx )
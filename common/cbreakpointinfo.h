@@ -173,6 +173,12 @@ public:
    {
       return m_numBreakpoints;
    }
+   // The version changes whenever a breakpoint is added, removed, modified,
+   // enabled or disabled.
+   int GetVersion ( void ) const
+   {
+      return m_version;
+   }
    BreakpointInfo* GetBreakpoint ( int idx )
    {
       return &(m_breakpoint[idx]);
@@ -185,6 +191,7 @@ protected:
 protected:
    BreakpointInfo m_breakpoint [ NUM_BREAKPOINTS ];
    int            m_numBreakpoints;
+   int            m_version;
 };
 
 #endif // CBREAKPOINTINFO_H
@@ -18,6 +18,7 @@
 #include "resource.h"
 
 #include <stdarg.h>
+#include <stdio.h>
 
 CWinApp* ptrToTheApp;
 
@@ -354,20 +355,30 @@ int AfxMessageBox(
       button1 = "OK";
    }
 
-   switch ( icon )
+   if ( !qobject_cast<QApplication*>(QCoreApplication::instance()) )
    {
-   case MB_ICONERROR:
-      ret = QMessageBox::critical(0,"FamiTracker",text,button1,button2,button3);
-      break;
-   case MB_ICONEXCLAMATION:
-      ret = QMessageBox::warning(0,"FamiTracker",text,button1,button2,button3);
-      break;
-   case MB_ICONQUESTION:
-      ret = QMessageBox::question(0,"FamiTracker",text,button1,button2,button3);
-      break;
-   default:
-      ret = QMessageBox::information(0,"FamiTracker",text,button1,button2,button3);
-      break;
+      // Command line tools have nobody to ask, so say it and take the
+      // first button.
+      fprintf(stderr,"%s\n",qPrintable(text));
+      ret = 0;
+   }
+   else
+   {
+      switch ( icon )
+      {
+      case MB_ICONERROR:
+         ret = QMessageBox::critical(0,"FamiTracker",text,button1,button2,button3);
+         break;
+      case MB_ICONEXCLAMATION:
+         ret = QMessageBox::warning(0,"FamiTracker",text,button1,button2,button3);
+         break;
+      case MB_ICONQUESTION:
+         ret = QMessageBox::question(0,"FamiTracker",text,button1,button2,button3);
+         break;
+      default:
+         ret = QMessageBox::information(0,"FamiTracker",text,button1,button2,button3);
+         break;
+      }
    }
    switch ( ret )
    {
@@ -3107,6 +3118,119 @@ BOOL CBitmap::LoadBitmap(
    return result;
 }
 
+/*
+ *  Glyph atlas used by CDC text output
+ */
+
+// Every Latin-1 glyph of one font rendered once in one color, on a 16x16
+// grid.  Text is blitted a cell at a time instead of going through
+// QPainter::drawText for each call, which is what the pattern editor
+// spends its time on while scrolling.
+class CGlyphAtlas
+{
+public:
+   CGlyphAtlas(const QFont& font,const QColor& color);
+
+   static CGlyphAtlas* get(const QFont& font,const QColor& color);
+
+   static bool contains(ushort ch) { return (ch >= FIRST_GLYPH) && (ch <= LAST_GLYPH); }
+   int ascent() const { return _ascent; }
+   int advance(ushort ch) const { return _advance[ch]; }
+   void draw(QPainter* painter,int x,int baseline,ushort ch) const
+   {
+      painter->drawPixmap(x-GLYPH_PAD,baseline-_ascent-GLYPH_PAD,_pixmap,
+                          (ch&15)*_cellWidth,(ch>>4)*_cellHeight,_cellWidth,_cellHeight);
+   }
+
+private:
+   enum
+   {
+      FIRST_GLYPH = 0x20,
+      LAST_GLYPH = 0xFF,
+      GLYPH_PAD = 2,       // Room for glyphs that reach past their advance
+      MAX_COLORS = 64      // Atlases kept per font before they're all dropped
+   };
+
+   QPixmap _pixmap;
+   int     _cellWidth;
+   int     _cellHeight;
+   int     _ascent;
+   int     _advance[LAST_GLYPH+1];
+};
+
+// Atlases by color for each font, and the font looked up last since
+// consecutive calls almost always draw with the same one.
+typedef QHash<QRgb,CGlyphAtlas*> CGlyphAtlasColors;
+
+static QHash<QString,CGlyphAtlasColors*> glyphAtlases;
+static QFont* glyphAtlasFont = NULL;
+static CGlyphAtlasColors* glyphAtlasColors = NULL;
+
+CGlyphAtlas::CGlyphAtlas(const QFont& font,const QColor& color)
+{
+   QFontMetrics fontMetrics(font);
+   QPainter painter;
+   int ch;
+
+   _ascent = fontMetrics.ascent();
+   _cellWidth = fontMetrics.maxWidth()+(GLYPH_PAD*2);
+   _cellHeight = fontMetrics.height()+(GLYPH_PAD*2);
+
+   _pixmap = QPixmap(_cellWidth*16,_cellHeight*16);
+   _pixmap.fill(Qt::transparent);
+
+   memset(_advance,0,sizeof(_advance));
+
+   painter.begin(&_pixmap);
+   painter.setFont(font);
+   painter.setPen(QPen(color));
+   for ( ch = FIRST_GLYPH; ch <= LAST_GLYPH; ch++ )
+   {
+      _advance[ch] = fontMetrics.width(QChar(ch));
+      painter.drawText((ch&15)*_cellWidth+GLYPH_PAD,(ch>>4)*_cellHeight+GLYPH_PAD+_ascent,QString(QChar(ch)));
+   }
+   painter.end();
+}
+
+CGlyphAtlas* CGlyphAtlas::get(const QFont& font,const QColor& color)
+{
+   CGlyphAtlas* atlas;
+
+   if ( !glyphAtlasFont || (font != (*glyphAtlasFont)) )
+   {
+      QString key = font.key();
+
+      glyphAtlasColors = glyphAtlases.value(key);
+      if ( !glyphAtlasColors )
+      {
+         glyphAtlasColors = new CGlyphAtlasColors;
+         glyphAtlases.insert(key,glyphAtlasColors);
+      }
+      if ( !glyphAtlasFont )
+      {
+         glyphAtlasFont = new QFont(font);
+      }
+      else
+      {
+         (*glyphAtlasFont) = font;
+      }
+   }
+
+   atlas = glyphAtlasColors->value(color.rgb());
+   if ( !atlas )
+   {
+      // Colors come from user settings, don't let them pile up
+      if ( glyphAtlasColors->count() >= MAX_COLORS )
+      {
+         qDeleteAll(*glyphAtlasColors);
+         glyphAtlasColors->clear();
+      }
+      atlas = new CGlyphAtlas(font,color);
+      glyphAtlasColors->insert(color.rgb(),atlas);
+   }
+   return atlas;
+}
+
 /*
  *  Class CDC
  */
@@ -3712,20 +3836,11 @@ BOOL CDC::TextOut(
 )
 {
 #if UNICODE
-   QString qstr = QString::fromWCharArray(lpszString);
+   QString qstr = QString::fromWCharArray(lpszString,nCount);
 #else
-   QString qstr = QString::fromLatin1(lpszString);
+   QString qstr = QString::fromLatin1(lpszString,nCount);
 #endif
-   QFontMetrics fontMetrics((QFont)*_font);
-   QPen origPen = _qpainter.pen();
-   _qpainter.setPen(QPen(_textColor));
-//   _qpainter.setFont((QFont)*_font);
-   x += -_windowOrg.x;
-   y += -_windowOrg.y;
-   y += fontMetrics.ascent();
-   _qpainter.drawText(x,y,qstr.left(nCount));
-   _qpainter.setPen(origPen);
-   return TRUE;
+   return textOut(x,y,qstr,0);
 }
 
 BOOL CDC::TextOut(
@@ -3734,15 +3849,71 @@ BOOL CDC::TextOut(
       const CString& str
 )
 {
-   QFontMetrics fontMetrics((QFont)*_font);
-   QPen origPen = _qpainter.pen();
-   _qpainter.setPen(QPen(_textColor));
-//   _qpainter.setFont((QFont)*_font);
+   return textOut(x,y,(const QString&)str,0);
+}
+
+BOOL CDC::DrawCharRun(
+   int x,
+   int y,
+   LPCTSTR lpszString,
+   int nCount,
+   int nPitch
+)
+{
+#if UNICODE
+   QString qstr = QString::fromWCharArray(lpszString,nCount);
+#else
+   QString qstr = QString::fromLatin1(lpszString,nCount);
+#endif
+   return textOut(x,y,qstr,nPitch);
+}
+
+BOOL CDC::textOut(
+   int x,
+   int y,
+   const QString& qstr,
+   int pitch
+)
+{
+   CGlyphAtlas* atlas;
+   int ch;
+
    x += -_windowOrg.x;
    y += -_windowOrg.y;
-   y += fontMetrics.ascent();
-   _qpainter.drawText(x,y,(const QString&)str);
-   _qpainter.setPen(origPen);
+
+   // Anything past Latin-1 is shaped by Qt as before
+   for ( ch = 0; ch < qstr.length(); ch++ )
+   {
+      if ( !CGlyphAtlas::contains(qstr.at(ch).unicode()) )
+      {
+         QFontMetrics fontMetrics(_qpainter.font());
+         QPen origPen = _qpainter.pen();
+         _qpainter.setPen(QPen(_textColor));
+         y += fontMetrics.ascent();
+         if ( pitch )
+         {
+            for ( ch = 0; ch < qstr.length(); ch++ )
+            {
+               _qpainter.drawText(x+(ch*pitch),y,QString(qstr.at(ch)));
+            }
+         }
+         else
+         {
+            _qpainter.drawText(x,y,qstr);
+         }
+         _qpainter.setPen(origPen);
+         return TRUE;
+      }
+   }
+
+   atlas = CGlyphAtlas::get(_qpainter.font(),_textColor);
+   y += atlas->ascent();
+   for ( ch = 0; ch < qstr.length(); ch++ )
+   {
+      ushort glyph = qstr.at(ch).unicode();
+      atlas->draw(&_qpainter,x,y,glyph);
+      x += pitch ? pitch : atlas->advance(glyph);
+   }
    return TRUE;
 }
 
@@ -10363,7 +10534,8 @@ CWinThread::CWinThread() :
    _priority(QThread::NormalPriority),
    pTimer(NULL),
    pThread(NULL),
-   _initialized(false)
+   _initialized(false),
+   _idleInterval(10)
 {
    m_hThread = (HANDLE)this;
    m_pfnThreadProc = NULL;
@@ -10496,7 +10668,7 @@ DWORD CWinThread::ResumeThread( )
 
       pTimer = new QTimer;
 
-      pTimer->start(10);
+      pTimer->start(_idleInterval);
       pTimer->moveToThread(pThread);
 
       QObject::connect(pTimer,SIGNAL(timeout()),this,SLOT(runSlot()));
@@ -10561,6 +10733,15 @@ BOOL CWinThread::PostThreadMessage(
    return true;
 }
 
+void CWinThread::SetIdleInterval(int msec)
+{
+   _idleInterval = msec;
+   if ( pTimer && (pTimer->interval() != msec) )
+   {
+      pTimer->setInterval(msec);
+   }
+}
+
 void CWinThread::runSlot()
 {
 #ifdef Q_OS_MAC
@@ -10636,8 +10817,12 @@ END_MESSAGE_MAP()
 CDocument::CDocument()
    : m_pDocTemplate(NULL), m_bModified(FALSE), m_bAutoDelete(TRUE)
 {
-   QObject::connect(this,SIGNAL(documentSaved()),ptrToTheApp->qtMainWindow,SLOT(documentSaved()));
-   QObject::connect(this,SIGNAL(documentClosed()),ptrToTheApp->qtMainWindow,SLOT(documentClosed()));
+   // Command line tools have no main window.
+   if ( ptrToTheApp->qtMainWindow )
+   {
+      QObject::connect(this,SIGNAL(documentSaved()),ptrToTheApp->qtMainWindow,SLOT(documentSaved()));
+      QObject::connect(this,SIGNAL(documentClosed()),ptrToTheApp->qtMainWindow,SLOT(documentClosed()));
+   }
 }
 
 void CDocument::OnCloseDocument()
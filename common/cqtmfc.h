@@ -3740,12 +3740,22 @@ public:
          int y,
          const CString& str
    );
+   // Not MFC.  Draws nCount characters nPitch pixels apart in one call,
+   // for fixed grids of text like the pattern editor.
+   BOOL DrawCharRun(
+      int x,
+      int y,
+      LPCTSTR lpszString,
+      int nCount,
+      int nPitch
+   );
 
 public:
    HDC  m_hDC;
 
 private:
    CDC(CDC& orig);
+   BOOL textOut(int x, int y, const QString& qstr, int pitch);
    bool attached;
    QWidget*    _qwidget;
    QPixmap    _qpixmap;
@@ -5695,9 +5705,13 @@ class CWinThread : public QObject, public CCmdTarget
 protected:
    QThread::Priority _priority;
    bool _initialized;
+   int _idleInterval;
    virtual bool event(QEvent *event);
    QTimer* pTimer;
    QThread* pThread;
+   // How often the thread runs OnIdle, in ms.  0 runs it whenever the
+   // thread has no messages to handle.  Call from the thread itself.
+   void SetIdleInterval(int msec);
 signals:
    void update();
 public slots:
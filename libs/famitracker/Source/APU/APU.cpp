@@ -49,8 +49,6 @@ const uint8 CAPU::LENGTH_TABLE[] = {
 	0xC0, 0x18, 0x48, 0x1A, 0x10, 0x1C, 0x20, 0x1E
 };
 
-static std::vector<CExternal*> ExChips;
-
 CAPU::CAPU(IAudioCallback *pCallback, CSampleMem *pSampleMem) : 
 	m_pParent(pCallback),
 	m_iFrameCycles(0),
@@ -209,7 +207,7 @@ void CAPU::Process()
 		RunAPU1(Time);
 		RunAPU2(Time);
 
-		for (std::vector<CExternal*>::iterator iter = ExChips.begin(); iter != ExChips.end(); ++iter) {
+		for (std::vector<CExternal*>::iterator iter = m_ExChips.begin(); iter != m_ExChips.end(); ++iter) {
 			(*iter)->Process(Time);
 		}
 
@@ -237,7 +235,7 @@ void CAPU::EndFrame()
 	m_pNoise->EndFrame();
 	m_pDPCM->EndFrame();
 
-	for (std::vector<CExternal*>::iterator iter = ExChips.begin(); iter != ExChips.end(); ++iter) {
+	for (std::vector<CExternal*>::iterator iter = m_ExChips.begin(); iter != m_ExChips.end(); ++iter) {
 		(*iter)->EndFrame();
 	}
 
@@ -273,7 +271,7 @@ void CAPU::Reset()
 	m_pNoise->Reset();
 	m_pDPCM->Reset();
 
-	for (std::vector<CExternal*>::iterator iter = ExChips.begin(); iter != ExChips.end(); ++iter) {
+	for (std::vector<CExternal*>::iterator iter = m_ExChips.begin(); iter != m_ExChips.end(); ++iter) {
 		(*iter)->Reset();
 	}
 
@@ -295,20 +293,20 @@ void CAPU::SetExternalSound(uint8 Chip)
 	m_iExternalSoundChip = Chip;
 	m_pMixer->ExternalSound(Chip);
 
-	ExChips.clear();
+	m_ExChips.clear();
 
 	if (Chip & SNDCHIP_VRC6)
-		ExChips.push_back(m_pVRC6);
+		m_ExChips.push_back(m_pVRC6);
 	if (Chip & SNDCHIP_VRC7)
-		ExChips.push_back(m_pVRC7);
+		m_ExChips.push_back(m_pVRC7);
 	if (Chip & SNDCHIP_FDS)
-		ExChips.push_back(m_pFDS);
+		m_ExChips.push_back(m_pFDS);
 	if (Chip & SNDCHIP_MMC5)
-		ExChips.push_back(m_pMMC5);
+		m_ExChips.push_back(m_pMMC5);
 	if (Chip & SNDCHIP_N163)
-		ExChips.push_back(m_pN163);
+		m_ExChips.push_back(m_pN163);
 	if (Chip & SNDCHIP_S5B)
-		ExChips.push_back(m_pS5B);
+		m_ExChips.push_back(m_pS5B);
 
 	Reset();
 }
@@ -374,6 +372,15 @@ bool CAPU::SetupSound(int SampleRate, int NrChannels, int Machine)
 	return true;
 }
 
+void CAPU::SetFrameCycles(uint32 Cycles)
+{
+	// Shorter audio frames hand samples to the player sooner, SetupSound sets one video frame
+	m_iFrameCycleCount = Cycles;
+
+	if (m_iFrameClock > Cycles)
+		m_iFrameClock = Cycles;
+}
+
 void CAPU::AddTime(int32 Cycles)
 {
 	if (Cycles < 0)
@@ -478,7 +485,7 @@ void CAPU::ExternalWrite(uint16 Address, uint8 Value)
 
 	Process();
 
-	for (std::vector<CExternal*>::iterator iter = ExChips.begin(); iter != ExChips.end(); ++iter) {
+	for (std::vector<CExternal*>::iterator iter = m_ExChips.begin(); iter != m_ExChips.end(); ++iter) {
 		(*iter)->Write(Address, Value);
 	}
 
@@ -495,7 +502,7 @@ uint8 CAPU::ExternalRead(uint16 Address)
 
 	Process();
 
-	for (std::vector<CExternal*>::iterator iter = ExChips.begin(); iter != ExChips.end(); ++iter) {
+	for (std::vector<CExternal*>::iterator iter = m_ExChips.begin(); iter != m_ExChips.end(); ++iter) {
 		if (!Mapped)
 			Value = (*iter)->Read(Address, Mapped);
 	}
@@ -23,6 +23,8 @@
 
 //#define LOGGING
 
+#include <vector>
+
 #include "cqtmfc.h"
 
 #include "../Common.h"
@@ -68,6 +70,7 @@ public:
 	
 	void	ChangeMachine(int Machine);
 	bool	SetupSound(int SampleRate, int NrChannels, int Speed);
+	void	SetFrameCycles(uint32 Cycles);
 	void	SetupMixer(int LowCut, int HighCut, int HighDamp, int Volume) const;
 
 	int32	GetVol(uint8 Chan) const;
@@ -125,6 +128,7 @@ private:
 	CS5B		*m_pS5B;
 
 	uint8		m_iExternalSoundChip;				// External sound chip, if used
+	std::vector<CExternal*> m_ExChips;				// Enabled external chips
 
 	uint32		m_iFramePeriod;						// Cycles per frame
 	uint32		m_iFrameCycles;						// Cycles emulated from start of frame
@@ -30,27 +30,29 @@
 CFDS::CFDS(CMixer *pMixer) : CExChannel(pMixer, SNDCHIP_FDS, CHANID_FDS)
 {
 	FDSSoundInstall3();
+	m_pFDSSound = FDSSoundAlloc();
 }
 
 CFDS::~CFDS()
 {
+	FDSSoundFree(m_pFDSSound);
 }
 
 void CFDS::Reset()
 {
-	FDSSoundReset();
-	FDSSoundVolume(0);
+	FDSSoundReset(m_pFDSSound);
+	FDSSoundVolume(m_pFDSSound, 0);
 }
 
 void CFDS::Write(uint16 Address, uint8 Value)
 {
-	FDSSoundWrite(Address, Value);
+	FDSSoundWrite(m_pFDSSound, Address, Value);
 }
 
 uint8 CFDS::Read(uint16 Address, bool &Mapped)
 {
 	Mapped = ((0x4040 <= Address && Address <= 0x407f) || (0x4090 == Address) || (0x4092 == Address));
-	return FDSSoundRead(Address);
+	return FDSSoundRead(m_pFDSSound, Address);
 }
 
 void CFDS::EndFrame()
@@ -64,7 +66,7 @@ void CFDS::Process(uint32 Time)
 		return;
 
 	while (Time--) {
-		Mix(FDSSoundRender() >> 12);
+		Mix(FDSSoundRender(m_pFDSSound) >> 12);
 		++m_iTime;
 	}
 }
@@ -55,8 +55,6 @@
 #include <cmath>
 #include "Mixer.h"
 #include "APU.h"
-#include "emu2413.h"
-#include "emu2149.h"
 
 //#define LINEAR_MIXING
 
@@ -273,14 +271,6 @@ int CMixer::FinishBuffer(int t)
 {
 	BlipBuffer.end_frame(t);
 
-	// Get channel levels for VRC7
-	for (int i = 0; i < 6; ++i)
-		StoreChannelLevel(CHANID_VRC7_CH1 + i, OPLL_getchanvol(i));
-
-	// Get channel levels for Sunsoft
-	for (int i = 0; i < 3; ++i)
-		StoreChannelLevel(CHANID_S5B_CH1 + i, PSG_getchanvol(i));
-
 	for (int i = 0; i < CHANNELS; ++i) {
 		if (m_iChanLevelFallOff[i] > 0)
 			m_iChanLevelFallOff[i]--;
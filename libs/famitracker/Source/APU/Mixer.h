@@ -61,6 +61,7 @@ public:
 	void	SetChipLevel(chip_level_t Chip, float Level);
 	uint32	ResampleDuration(uint32 Time) const;
 	void	SetNamcoVolume(float fVol);
+	void	StoreChannelLevel(int Channel, int Value);
 
 private:
 	inline double CalcPin1(double Val1, double Val2);
@@ -74,7 +75,6 @@ private:
 	void MixMMC5(int Value, int Time);
 	void MixS5B(int Value, int Time);
 
-	void StoreChannelLevel(int Channel, int Value);
 	void ClearChannelLevels();
 
 	float GetAttenuation() const;
@@ -21,32 +21,29 @@
 #include <cstdio>
 #include "APU.h"
 #include "S5B.h"
-#include "emu2149.h"
 
 // Sunsoft 5B (YM2149)
 
-PSG *psg;
-
 float CS5B::AMPLIFY = 2.0f;
 
-CS5B::CS5B(CMixer *pMixer) : m_iRegister(0), m_iTime(0)
+CS5B::CS5B(CMixer *pMixer) : m_iRegister(0), m_iTime(0), m_pPSG(NULL), m_iBufferPtr(0), m_iLastSample(0)
 {
 	m_pMixer = pMixer;
 
 	m_fVolume = AMPLIFY;
-
-	psg = NULL;
 }
 
 CS5B::~CS5B()
 {
-	if (psg)
-		PSG_delete(psg);
+	if (m_pPSG)
+		PSG_delete(m_pPSG);
 }
 
 void CS5B::Reset()
 {
 	m_iTime = 0;
+	m_iBufferPtr = 0;
+	m_iLastSample = 0;
 //	PSG_reset(psg);
 }
 
@@ -55,9 +52,6 @@ void CS5B::Process(uint32 Time)
 	m_iTime += Time;
 }
 
-int16 m_pBuffer[4000];
-uint32 m_iBufferPtr = 0;
-
 void CS5B::EndFrame()
 {
 	GetMixMono();
@@ -65,19 +59,21 @@ void CS5B::EndFrame()
 
 void CS5B::GetMixMono()
 {
-	static int32 LastSample = 0;
-
 	uint32 WantSamples = m_pMixer->GetMixSampleCount(m_iTime);
 
 	// Generate samples
 	while (m_iBufferPtr < WantSamples) {
-		int32 Sample = int32(float(PSG_calc(psg)) * m_fVolume);
-		m_pBuffer[m_iBufferPtr++] = int16((Sample + LastSample) >> 1);
-		LastSample = Sample;
+		int32 Sample = int32(float(PSG_calc(m_pPSG)) * m_fVolume);
+		m_pBuffer[m_iBufferPtr++] = int16((Sample + m_iLastSample) >> 1);
+		m_iLastSample = Sample;
 	}
 
 	m_pMixer->MixSamples((blip_sample_t*)m_pBuffer, WantSamples);
 
+	// Get channel levels
+	for (int i = 0; i < 3; ++i)
+		m_pMixer->StoreChannelLevel(CHANID_S5B_CH1 + i, PSG_getchanvol(m_pPSG, i));
+
 	m_iBufferPtr -= WantSamples;
 	m_iTime = 0;
 }
@@ -89,7 +85,7 @@ void CS5B::Write(uint16 Address, uint8 Value)
 			m_iRegister = Value & 0xF;
 			break;
 		case 0xE000:
-			PSG_writeReg(psg, m_iRegister, Value);
+			PSG_writeReg(m_pPSG, m_iRegister, Value);
 			break;
 	}
 }
@@ -103,14 +99,14 @@ uint8 CS5B::Read(uint16 Address, bool &Mapped)
 
 void CS5B::SetSampleSpeed(uint32 SampleRate, double ClockRate, uint32 FrameRate)
 {
-	if (psg != NULL) {
-		PSG_delete(psg);
+	if (m_pPSG != NULL) {
+		PSG_delete(m_pPSG);
 	}
 
 	//PSG_init((uint32)ClockRate, SampleRate);
-	psg = PSG_new((uint32)ClockRate, SampleRate);
-	PSG_setVolumeMode(psg, 1);
-	PSG_reset(psg);
+	m_pPSG = PSG_new((uint32)ClockRate, SampleRate);
+	PSG_setVolumeMode(m_pPSG, 1);
+	PSG_reset(m_pPSG);
 
 //	psg = PSG_new();
 
@@ -3,6 +3,7 @@
 
 #include "External.h"
 #include "Channel.h"
+#include "emu2149.h"
 
 class CS5B : public CExternal {
 public:
@@ -27,6 +28,11 @@ private:
 
 	float	m_fVolume;
 
+	PSG		*m_pPSG;
+	int16	m_pBuffer[4000];
+	uint32	m_iBufferPtr;
+	int32	m_iLastSample;
+
 };
 
 #endif /* S5B_H */
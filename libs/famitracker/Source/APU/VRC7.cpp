@@ -20,13 +20,14 @@
 
 #include "../stdafx.h"
 #include <memory>
+#include <QMutex>
 #include "APU.h"
 #include "VRC7.h"
 
 const float  CVRC7::AMPLIFY	  = 4.6f;		// Mixing amplification, VRC7 patch 14 is 4,88 times stronger than a 50% square @ v=15
 const uint32 CVRC7::OPL_CLOCK = 3579545;	// Clock frequency
 
-CVRC7::CVRC7(CMixer *pMixer) : CExternal(pMixer), m_pBuffer(NULL), m_pOPLLInt(NULL), m_fVolume(1.0f), m_iMaxSamples(0), m_iSoundReg(0)
+CVRC7::CVRC7(CMixer *pMixer) : CExternal(pMixer), m_pBuffer(NULL), m_pOPLLInt(NULL), m_fVolume(1.0f), m_iMaxSamples(0), m_iSoundReg(0), m_iLastSample(0)
 {
 	Reset();
 }
@@ -44,6 +45,7 @@ CVRC7::~CVRC7()
 void CVRC7::Reset()
 {
 	m_iBufferPtr = 0;
+	m_iLastSample = 0;
 	m_iTime = 0;
 }
 
@@ -54,7 +56,11 @@ void CVRC7::SetSampleSpeed(uint32 SampleRate, double ClockRate, uint32 FrameRate
 		m_pOPLLInt = NULL;
 	}
 
+	// emu2413 keeps its tables in globals, serialize creation between render threads
+	static QMutex TableMutex;
+	TableMutex.lock();
 	m_pOPLLInt = OPLL_new(OPL_CLOCK, SampleRate);
+	TableMutex.unlock();
 
 	OPLL_reset(m_pOPLLInt);
 	OPLL_reset_patch(m_pOPLLInt, 1);
@@ -92,8 +98,6 @@ void CVRC7::EndFrame()
 {
 	uint32 WantSamples = m_pMixer->GetMixSampleCount(m_iTime);
 
-	static int32 LastSample = 0;
-
 	// Generate VRC7 samples
 	while (m_iBufferPtr < WantSamples) {
 		int32 RawSample = OPLL_calc(m_pOPLLInt);
@@ -112,12 +116,16 @@ void CVRC7::EndFrame()
 		if (Sample < -32768)
 			Sample = -32768;
 
-		m_pBuffer[m_iBufferPtr++] = int16((Sample + LastSample) >> 1);
-		LastSample = Sample;
+		m_pBuffer[m_iBufferPtr++] = int16((Sample + m_iLastSample) >> 1);
+		m_iLastSample = Sample;
 	}
 
 	m_pMixer->MixSamples((blip_sample_t*)m_pBuffer, WantSamples);
 
+	// Get channel levels
+	for (int i = 0; i < 6; ++i)
+		m_pMixer->StoreChannelLevel(CHANID_VRC7_CH1 + i, OPLL_getchanvol(m_pOPLLInt, i));
+
 	m_iBufferPtr -= WantSamples;
 	m_iTime = 0;
 }
@@ -48,6 +48,7 @@ private:
 
 	int16	*m_pBuffer;
 	uint32	m_iBufferPtr;
+	int32	m_iLastSample;
 
 	uint8	m_iSoundReg;
 
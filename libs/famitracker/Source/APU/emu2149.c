@@ -39,8 +39,6 @@ static uint32 voltbl[2][32] = {
 
 #define GETA_BITS 24
 
-int32 psg_volumes[3];
-
 static void
 internal_refresh (PSG * psg)
 {
@@ -140,6 +138,7 @@ PSG_reset (PSG * psg)
   for (i = 0; i < 3; i++)
   {
     psg->cout[i] = 0;
+    psg->chanvol[i] = 0;
     psg->count[i] = 0x1000;
     psg->freq[i] = 0;
     psg->edge[i] = 0;
@@ -273,7 +272,7 @@ calc (PSG * psg)
       else
         psg->cout[i] = psg->voltbl[psg->env_ptr];
 
-	  psg_volumes[i] = psg->cout[i];
+	  psg->chanvol[i] = psg->cout[i];
 	  mix += psg->cout[i];
     }
 
@@ -367,7 +366,7 @@ PSG_writeReg (PSG * psg, uint32 reg, uint32 val)
 }
 
 
-int32 PSG_getchanvol(int i)
+int32 PSG_getchanvol(PSG *psg, int i)
 {
-	return psg_volumes[i];
+	return psg->chanvol[i];
 }
\ No newline at end of file
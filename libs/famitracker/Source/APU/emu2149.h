@@ -39,6 +39,7 @@ extern "C"
     uint8 reg[0x20];
     int32 out;
     int32 cout[3];
+    int32 chanvol[3];	/* Channel levels for the meters */
 
     uint32 clk, rate, base_incr, quality;
 
@@ -95,7 +96,7 @@ extern "C"
   EMU2149_API uint32 PSG_setMask (PSG *, uint32 mask);
   EMU2149_API uint32 PSG_toggleMask (PSG *, uint32 mask);
 
-  int32 PSG_getchanvol(int i);
+  int32 PSG_getchanvol(PSG *psg, int i);
 
 #ifdef __cplusplus
 }
@@ -611,6 +611,11 @@ bool CChannelHandler::IsReleasing() const
 	return m_bRelease;
 }
 
+void CChannelHandler::SetSequencePlayPos(const CSequence *pSequence, int Pos)
+{
+	m_pSoundGen->SetSequencePlayPos(pSequence, Pos);
+}
+
 int CChannelHandler::GetVibrato() const
 {
 	// Vibrato offset (4xx)
@@ -840,7 +845,7 @@ void CSequenceHandler::UpdateSequenceRunning(int Index, const CSequence *pSequen
 		}
 	}
 
-	theApp.GetSoundGenerator()->SetSequencePlayPos(pSequence, m_iSeqPointer[Index]);
+	SetSequencePlayPos(pSequence, m_iSeqPointer[Index]);
 }
 
 void CSequenceHandler::UpdateSequenceEnd(int Index, const CSequence *pSequence)
@@ -855,7 +860,7 @@ void CSequenceHandler::UpdateSequenceEnd(int Index, const CSequence *pSequence)
 
 	m_iSeqState[Index] = SEQ_STATE_HALT;
 
-	theApp.GetSoundGenerator()->SetSequencePlayPos(pSequence, -1);
+	SetSequencePlayPos(pSequence, -1);
 }
 
 void CSequenceHandler::RunSequence(int Index)
@@ -47,6 +47,7 @@ protected:
 	virtual void SetDutyPeriod(int Period) = 0;
 	virtual bool IsActive() const = 0;
 	virtual bool IsReleasing() const = 0;
+	virtual void SetSequencePlayPos(const CSequence *pSequence, int Pos) = 0;
 
 	// Sequence functions
 	void SetupSequence(int Index, const CSequence *pSequence);
@@ -167,6 +168,7 @@ protected:
 	void	SetNote(int Note);
 	int		GetNote() const;
 	void	SetDutyPeriod(int Period);
+	void	SetSequencePlayPos(const CSequence *pSequence, int Pos);
 
 private:
 	void	UpdateNoteCut();
@@ -603,7 +603,7 @@ void CDPCMChan::RefreshChannel()
 		// Cut sample
 		WriteRegister(0x4015, 0x0F);
 
-		if (!theApp.GetSettings()->General.bNoDPCMReset || theApp.IsPlaying()) {
+		if (!theApp.GetSettings()->General.bNoDPCMReset || m_pSoundGen->IsPlaying()) {
 			WriteRegister(0x4011, 0);	// regain full volume for TN
 		}
 
@@ -306,7 +306,7 @@ void CChannelHandlerFDS::CheckWaveUpdate()
 {
 	// Check wave changes
 	CFamiTrackerDoc *pDocument = m_pSoundGen->GetDocument();
-	bool bWaveChanged = theApp.GetSoundGenerator()->HasWaveChanged();
+	bool bWaveChanged = m_pSoundGen->HasWaveChanged();
 
 	if (m_iInstrument != MAX_INSTRUMENTS && bWaveChanged) {
 		CInstrumentContainer<CInstrumentFDS> instContainer(pDocument, m_iInstrument);
@@ -50,6 +50,7 @@ BEGIN_MESSAGE_MAP(CConfigMIDI, CPropertyPage)
 	ON_BN_CLICKED(IDC_CHANMAP, OnBnClickedChanmap)
 	ON_BN_CLICKED(IDC_VELOCITY, OnBnClickedVelocity)
 	ON_BN_CLICKED(IDC_ARPEGGIATE, OnBnClickedArpeggiate)
+	ON_BN_CLICKED(IDC_LOW_LATENCY, OnBnClickedLowLatency)
 	ON_CBN_SELCHANGE(IDC_OUTDEVICES, OnCbnSelchangeOutdevices)
 END_MESSAGE_MAP()
 
@@ -94,6 +95,7 @@ BOOL CConfigMIDI::OnInitDialog()
 	CheckDlgButton(IDC_CHANMAP,		theApp.GetSettings()->Midi.bMidiChannelMap	? 1 : 0);
 	CheckDlgButton(IDC_VELOCITY,	theApp.GetSettings()->Midi.bMidiVelocity	? 1 : 0);
 	CheckDlgButton(IDC_ARPEGGIATE,	theApp.GetSettings()->Midi.bMidiArpeggio	? 1 : 0);
+	CheckDlgButton(IDC_LOW_LATENCY,	theApp.GetSettings()->Midi.bMidiLowLatency	? 1 : 0);
 
 	return TRUE;  // return TRUE unless you set the focus to a control
 	// EXCEPTION: OCX Property Pages should return FALSE
@@ -114,6 +116,14 @@ BOOL CConfigMIDI::OnApply()
 	theApp.GetSettings()->Midi.bMidiVelocity	= IsDlgButtonChecked(IDC_VELOCITY)		== 1;
 	theApp.GetSettings()->Midi.bMidiArpeggio	= IsDlgButtonChecked(IDC_ARPEGGIATE)	== 1;
 
+	// Low latency changes the audio buffer, reopen the device if it was toggled
+	bool bLowLatency = IsDlgButtonChecked(IDC_LOW_LATENCY) == 1;
+
+	if (theApp.GetSettings()->Midi.bMidiLowLatency != bLowLatency) {
+		theApp.GetSettings()->Midi.bMidiLowLatency = bLowLatency;
+		theApp.LoadSoundConfig();
+	}
+
 	return CPropertyPage::OnApply();
 }
 
@@ -147,6 +157,11 @@ void CConfigMIDI::OnBnClickedArpeggiate()
 	SetModified();
 }
 
+void CConfigMIDI::OnBnClickedLowLatency()
+{
+	SetModified();
+}
+
 void CConfigMIDI::OnCbnSelchangeOutdevices()
 {
 	SetModified();
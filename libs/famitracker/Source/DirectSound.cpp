@@ -58,12 +58,119 @@ CDSound::~CDSound()
 //	}
 }
 
-static unsigned char* m_pSoundBuffer = NULL;
-static unsigned int   m_iSoundProducer = 0;
-static unsigned int   m_iSoundConsumer = 0;
-static unsigned int   m_iSoundBufferSize = 0;
-static unsigned int   m_iTotalSamples = 0;
+// CSoundRing
 
+CSoundRing::CSoundRing() : m_pBuffer(NULL), m_iSize(0), m_iWritePos(0), m_iReadPos(0)
+{
+}
+
+CSoundRing::~CSoundRing()
+{
+	SAFE_RELEASE_ARRAY(m_pBuffer);
+}
+
+void CSoundRing::Allocate(unsigned int Size)
+{
+	// Only while the callback isn't running
+	SAFE_RELEASE_ARRAY(m_pBuffer);
+	m_pBuffer = new unsigned char[Size];
+	memset(m_pBuffer, 0, Size);
+	m_iSize = Size;
+	m_iWritePos.fetchAndStoreOrdered(0);
+	m_iReadPos.fetchAndStoreOrdered(0);
+}
+
+unsigned int CSoundRing::GetFill() const
+{
+	unsigned int WritePos = m_iWritePos.fetchAndAddAcquire(0);
+	unsigned int ReadPos = m_iReadPos.fetchAndAddAcquire(0);
+
+	return (WritePos + 2 * m_iSize - ReadPos) % (2 * m_iSize);
+}
+
+unsigned int CSoundRing::GetFree() const
+{
+	return m_iSize - GetFill();
+}
+
+unsigned int CSoundRing::Write(const char *pData, unsigned int Size)
+{
+	if (m_pBuffer == NULL)
+		return 0;
+
+	unsigned int WritePos = m_iWritePos.fetchAndAddAcquire(0);
+	unsigned int Free = GetFree();
+
+	if (Size > Free)
+		Size = Free;
+
+	unsigned int Offset = WritePos % m_iSize;
+	unsigned int First = (Size < m_iSize - Offset) ? Size : m_iSize - Offset;
+
+	memcpy(m_pBuffer + Offset, pData, First);
+	memcpy(m_pBuffer, pData + First, Size - First);
+
+	// Samples are in place before the reader can see them
+	m_iWritePos.fetchAndStoreRelease((WritePos + Size) % (2 * m_iSize));
+
+	return Size;
+}
+
+unsigned int CSoundRing::Read(unsigned char *pData, unsigned int Size)
+{
+	if (m_pBuffer == NULL)
+		return 0;
+
+	unsigned int ReadPos = m_iReadPos.fetchAndAddAcquire(0);
+	unsigned int Fill = GetFill();
+
+	if (Size > Fill)
+		Size = Fill;
+
+	unsigned int Offset = ReadPos % m_iSize;
+	unsigned int First = (Size < m_iSize - Offset) ? Size : m_iSize - Offset;
+
+	memcpy(pData, m_pBuffer + Offset, First);
+	memcpy(pData + First, m_pBuffer, Size - First);
+
+	// Space is handed back after the samples are out
+	m_iReadPos.fetchAndStoreRelease((ReadPos + Size) % (2 * m_iSize));
+
+	return Size;
+}
+
+// Audio queued for the callback
+static CSoundRing     SoundRing;
+
+// The callback's copy of a period, short periods are padded with silence
+static unsigned char* m_pCallbackBuffer = NULL;
+static unsigned int   m_iCallbackBufferSize = 0;
+static unsigned char  m_iSilence = 0;
+
+// Set once the player has written, counts callbacks that ran short after that
+static QAtomicInt     m_iStarted(0);
+static QAtomicInt     m_iUnderruns(0);
+
+// Note events and the callback are timed on one clock
+class CLatencyClock : public QElapsedTimer
+{
+public:
+   CLatencyClock() { start(); }
+};
+
+static CLatencyClock  LatencyClock;
+
+// Bytes written by the player and taken by the callback since the channel opened,
+// and the last marked event waiting to be heard
+static unsigned int   m_iWrittenBytes = 0;
+static unsigned int   m_iPlayedBytes = 0;
+static unsigned int   m_iBytesPerSecond = 1;
+static QAtomicInt     m_iMarkPending(0);
+static QAtomicInt     m_iMarkPos(0);
+static QAtomicInt     m_iMarkTime(0);
+static QAtomicInt     m_iEventLatency(-1);
+
+// Wakes the player thread when the callback has made room
 QSemaphore ftmAudioSemaphore(0);
 
 QList<SDL_Callback> sdlHooks;
@@ -72,6 +179,8 @@ extern bool invisibleFamiTracker;
 
 extern "C" void SDL_FamiTracker(void* userdata, uint8_t* stream, int32_t len)
 {
+   int32_t pos;
+
    if ( !stream )
       return;
 #if 0
@@ -85,21 +194,52 @@ extern "C" void SDL_FamiTracker(void* userdata, uint8_t* stream, int32_t len)
    to = t;
    qDebug(str.toLatin1().constData());
 #endif
-   
+
    if ( invisibleFamiTracker )
    {
-       memset(stream,0,len);
-       if ( m_pSoundBuffer &&
-            m_iTotalSamples )
-          memcpy(stream,m_pSoundBuffer,len);
+      memset(stream,0,len);
    }
-   else
+
+   for ( pos = 0; m_pCallbackBuffer && (pos < len); pos += m_iCallbackBufferSize )
    {
-       if ( m_pSoundBuffer )
-          SDL_MixAudio(stream,m_pSoundBuffer,len,SDL_MIX_MAXVOLUME);
+      unsigned int chunk = qMin((unsigned int)(len-pos),m_iCallbackBufferSize);
+      unsigned int got = SoundRing.Read(m_pCallbackBuffer,chunk);
+
+      if ( got < chunk )
+      {
+         memset(m_pCallbackBuffer+got,m_iSilence,chunk-got);
+         if ( m_iStarted.fetchAndAddAcquire(0) )
+         {
+            m_iUnderruns.fetchAndAddRelaxed(1);
+         }
+      }
+
+      // The marked event is in this chunk, time it from its offset into the chunk
+      if ( m_iMarkPending.fetchAndAddAcquire(0) )
+      {
+         int offset = (int)((unsigned int)m_iMarkPos.fetchAndAddRelaxed(0) - m_iPlayedBytes);
+
+         if ( offset < (int)got )
+         {
+            unsigned int delay = (unsigned int)((long long)qMax(offset,0) * 1000000 / m_iBytesPerSecond);
+            unsigned int elapsed = CDSoundChannel::GetTimestamp() - (unsigned int)m_iMarkTime.fetchAndAddRelaxed(0);
+
+            m_iEventLatency.fetchAndStoreRelaxed((int)(elapsed + delay));
+            m_iMarkPending.fetchAndStoreRelease(0);
+         }
+      }
+
+      m_iPlayedBytes += got;
+
+      if ( invisibleFamiTracker )
+      {
+         memcpy(stream+pos,m_pCallbackBuffer,chunk);
+      }
+      else
+      {
+         SDL_MixAudio(stream+pos,m_pCallbackBuffer,chunk,SDL_MIX_MAXVOLUME);
+      }
    }
-   m_iSoundConsumer += len;
-   m_iSoundConsumer %= m_iSoundBufferSize;
 
    foreach ( SDL_Callback cb, sdlHooks )
    {
@@ -108,8 +248,12 @@ extern "C" void SDL_FamiTracker(void* userdata, uint8_t* stream, int32_t len)
          cb._func(cb._user,stream,len);
       }
    }
-   
-   ftmAudioSemaphore.release();
+
+   // One wakeup is enough however many periods the player slept through
+   if ( ftmAudioSemaphore.available() == 0 )
+   {
+      ftmAudioSemaphore.release();
+   }
 }
 
 bool CDSound::SetupDevice(int iDevice)
@@ -206,24 +350,32 @@ CDSoundChannel *CDSound::OpenChannel(int SampleRate, int SampleSize, int Channel
        SDL_OpenAudio ( &sdlAudioSpecIn, &sdlAudioSpecOut );
 
        //   qDebug("Adjusting audio: %d",memcmp(&sdlAudioSpecIn,&sdlAudioSpecOut,sizeof(sdlAudioSpecIn)));
-       SoundBufferSize = sdlAudioSpecOut.samples*sdlAudioSpecOut.channels*((sdlAudioSpecOut.format==AUDIO_U8?8:16)>>3);
-       BlockSize = SoundBufferSize / Blocks;
+       BlockSize = sdlAudioSpecOut.samples*sdlAudioSpecOut.channels*((sdlAudioSpecOut.format==AUDIO_U8?8:16)>>3);
     }
     else
     {
-        SoundBufferSize = 1152;
         BlockSize = 1152;
     }
-   
-   if ( m_pSoundBuffer )
-      delete m_pSoundBuffer;
-   m_pSoundBuffer = new unsigned char[SoundBufferSize];
-   memset(m_pSoundBuffer,0,SoundBufferSize);
-   m_iSoundProducer = 0;
-   m_iTotalSamples = 0;
-   m_iSoundConsumer = 0;
-   m_iSoundBufferSize = SoundBufferSize;
-   
+
+   // The ring holds every block, the callback takes one at a time
+   SoundBufferSize = BlockSize * Blocks;
+
+   SoundRing.Allocate(SoundBufferSize);
+
+   SAFE_RELEASE_ARRAY(m_pCallbackBuffer);
+   m_pCallbackBuffer = new unsigned char[BlockSize];
+   m_iCallbackBufferSize = BlockSize;
+   m_iSilence = invisibleFamiTracker ? 0 : sdlAudioSpecOut.silence;
+
+   m_iStarted.fetchAndStoreOrdered(0);
+   m_iUnderruns.fetchAndStoreOrdered(0);
+
+   m_iWrittenBytes = 0;
+   m_iPlayedBytes = 0;
+   m_iBytesPerSecond = SampleRate * (SampleSize / 8) * Channels;
+   m_iMarkPending.fetchAndStoreOrdered(0);
+   m_iEventLatency.fetchAndStoreOrdered(-1);
+
 	pChannel->m_iBufferLength		= BufferLength;			// in ms
 	pChannel->m_iSoundBufferSize	= SoundBufferSize;		// in bytes
 	pChannel->m_iBlockSize			= BlockSize;			// in bytes
@@ -276,8 +428,8 @@ CDSoundChannel::~CDSoundChannel()
 
 bool CDSoundChannel::Play()
 {
-    m_iTotalSamples = 0;
-    m_bPaused = false;
+   m_iStarted.fetchAndStoreOrdered(0);
+   m_bPaused = false;
    ftmAudioSemaphore.release();
    return true;
 }
@@ -300,19 +452,51 @@ bool CDSoundChannel::ClearBuffer()
 }
 
 bool CDSoundChannel::WriteBuffer(char *pBuffer, unsigned int Samples)
-{   
-   memcpy(m_pSoundBuffer+m_iSoundProducer,pBuffer,Samples);
-   m_iSoundProducer += Samples;
-   m_iTotalSamples = 1;
-   m_iSoundProducer %= m_iSoundBufferSize;
+{
+   // The player waits for room first, this never drops anything
+   m_iWrittenBytes += SoundRing.Write(pBuffer,Samples);
+   m_iStarted.fetchAndStoreRelease(1);
    return true;
 }
 
 buffer_event_t CDSoundChannel::WaitForSyncEvent(DWORD dwTimeout) const
 {
-	// Wait for a DirectSound event
-   bool ok = ftmAudioSemaphore.tryAcquire(1,dwTimeout);
-   return ok?BUFFER_IN_SYNC:BUFFER_OUT_OF_SYNC;
+	// Sleep until the callback has taken enough out of the ring for a block
+	while (SoundRing.GetFree() < m_iBlockSize) {
+		if (!ftmAudioSemaphore.tryAcquire(1, dwTimeout))
+			return BUFFER_TIMEOUT;
+	}
+
+	return BUFFER_IN_SYNC;
+}
+
+int CDSoundChannel::GetBufferFill() const
+{
+	return SoundRing.GetFill();
+}
+
+unsigned int CDSoundChannel::GetUnderruns() const
+{
+	return m_iUnderruns.fetchAndAddAcquire(0);
+}
+
+unsigned int CDSoundChannel::GetTimestamp()
+{
+	return (unsigned int)(LatencyClock.nsecsElapsed() / 1000);
+}
+
+void CDSoundChannel::MarkEvent(unsigned int Timestamp, unsigned int Offset)
+{
+	// Called before the write the event is in, replaces an event that wasn't heard yet
+	m_iMarkPending.fetchAndStoreOrdered(0);
+	m_iMarkTime.fetchAndStoreRelaxed((int)Timestamp);
+	m_iMarkPos.fetchAndStoreRelaxed((int)(m_iWrittenBytes + Offset));
+	m_iMarkPending.fetchAndStoreRelease(1);
+}
+
+int CDSoundChannel::GetEventLatency() const
+{
+	return m_iEventLatency.fetchAndAddAcquire(0);
 }
 
 //int CDSoundChannel::GetPlayBlock() const
@@ -27,6 +27,8 @@
 #undef main
 #include <SDL.h>
 #include <QObject>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 
 #include "cqtmfc.h"
 
@@ -39,6 +41,31 @@ enum buffer_event_t {
 	BUFFER_OUT_OF_SYNC
 };
 
+// Sample ring between the player thread and the audio callback, one writer
+// and one reader. Each side only moves its own position and reads the other
+// one, so neither takes a lock.
+class CSoundRing
+{
+public:
+	CSoundRing();
+	~CSoundRing();
+
+	void Allocate(unsigned int Size);
+
+	unsigned int Write(const char *pData, unsigned int Size);		// Player thread
+	unsigned int Read(unsigned char *pData, unsigned int Size);		// Audio callback
+
+	unsigned int GetSize() const	{ return m_iSize; };
+	unsigned int GetFill() const;
+	unsigned int GetFree() const;
+
+private:
+	unsigned char		*m_pBuffer;
+	unsigned int		m_iSize;					// in bytes
+	mutable QAtomicInt	m_iWritePos;				// 0 to 2 * size, so a full ring differs from an empty one
+	mutable QAtomicInt	m_iReadPos;
+};
+
 // DirectSound channel
 class CDSoundChannel : public QObject
 {
@@ -57,6 +84,16 @@ public:
 
 	buffer_event_t WaitForSyncEvent(DWORD dwTimeout) const;
 
+	// Bytes queued for the callback, and callbacks that ran short since the channel opened
+	int GetBufferFill() const;
+	unsigned int GetUnderruns() const;
+
+	// Note latency. An event is marked at a byte offset into the next write and timed
+	// when the callback hands that byte to the device, in microseconds, -1 until then
+	static unsigned int GetTimestamp();
+	void MarkEvent(unsigned int Timestamp, unsigned int Offset);
+	int GetEventLatency() const;
+
 	int GetBlockSize() const	{ return m_iBlockSize; };
 	int GetBlockSamples() const	{ return m_iBlockSize >> ((m_iSampleSize >> 3) - 1); };
 	int GetBlocks()	const		{ return m_iBlocks; };
@@ -301,6 +301,24 @@ BOOL CFamiTrackerApp::InitInstance()
 	return TRUE;
 }
 
+BOOL CFamiTrackerApp::InitHeadless()
+{
+	// Sets up only what loading and rendering modules needs, for command line
+	// tools. No windows, MIDI or audio device, and the sound generator is never
+	// started as a thread; see CSoundGen::RenderDocument.
+
+	TRACE("App: InitHeadless\n");
+
+	// Default settings, the user's don't apply here
+	m_pSettings = CSettings::GetObject();
+	m_pSettings->DefaultSettings();
+
+	m_pSoundGenerator = new CSoundGen();
+	m_pChannelMap = new CChannelMap();
+
+	return TRUE;
+}
+
 int CFamiTrackerApp::ExitInstance()
 {
 	// Close program
@@ -669,7 +687,8 @@ void CFamiTrackerApp::StopPlayer()
 	if (m_pSoundGenerator)
 		m_pSoundGenerator->StopPlayer();
 
-   m_pMIDI->ResetOutput();
+   if (m_pMIDI)
+      m_pMIDI->ResetOutput();
 }
 
 void CFamiTrackerApp::StopPlayerAndWait()
@@ -679,7 +698,8 @@ void CFamiTrackerApp::StopPlayerAndWait()
 		m_pSoundGenerator->StopPlayer();
 		m_pSoundGenerator->WaitForStop();
 	}
-   m_pMIDI->ResetOutput();
+   if (m_pMIDI)
+      m_pMIDI->ResetOutput();
 }
 
 void CFamiTrackerApp::TogglePlayer()
@@ -170,6 +170,9 @@ public:
 	virtual BOOL InitInstance();
 	virtual int ExitInstance();	
 
+	// Command line tools
+	BOOL InitHeadless();
+
 	// Implementation
 	DECLARE_MESSAGE_MAP()
 public:
@@ -1337,15 +1337,13 @@ void CPatternEditor::DrawCell(CDC *pDC, int PosX, int Column, int Channel, bool
 					if (pTrackerChannel->GetID() == CHANID_NOISE) {
 						// Noise
 						char NoiseFreq = (pNoteData->Note - 1 + pNoteData->Octave * 12) & 0x0F;
-						DrawChar(pDC, PosX, PosY, HEX[NoiseFreq], pColorInfo->Note);
-						DrawChar(pDC, PosX + CHARACTER_WIDTH, PosY, '-', pColorInfo->Note);
-						DrawChar(pDC, PosX + CHARACTER_WIDTH * 2, PosY, '#', pColorInfo->Note);
+						TCHAR Text[] = {HEX[NoiseFreq], '-', '#'};
+						DrawChars(pDC, PosX, PosY, Text, 3, pColorInfo->Note);
 					}
 					else {
 						// The rest
-						DrawChar(pDC, PosX, PosY, NOTES_A[pNoteData->Note - 1], pColorInfo->Note);
-						DrawChar(pDC, PosX + CHARACTER_WIDTH, PosY, NOTES_B[pNoteData->Note - 1], pColorInfo->Note);
-						DrawChar(pDC, PosX + CHARACTER_WIDTH * 2, PosY, NOTES_C[pNoteData->Octave], pColorInfo->Note);
+						TCHAR Text[] = {NOTES_A[pNoteData->Note - 1], NOTES_B[pNoteData->Note - 1], NOTES_C[pNoteData->Octave]};
+						DrawChars(pDC, PosX, PosY, Text, 3, pColorInfo->Note);
 					}
 					return;
 			}
@@ -1830,6 +1828,14 @@ void CPatternEditor::DrawChar(CDC *pDC, int x, int y, TCHAR c, COLORREF Color) c
 	++m_iCharsDrawn;
 }
 
+// Draws a run of characters in one color, one column apart
+void CPatternEditor::DrawChars(CDC *pDC, int x, int y, LPCTSTR pChars, int Count, COLORREF Color) const
+{
+	pDC->SetTextColor(Color);
+	pDC->DrawCharRun(x, y, pChars, Count, CHARACTER_WIDTH);
+	m_iCharsDrawn += Count;
+}
+
 void CPatternEditor::SetDPCMState(const stDPCMState &State)
 {
 	m_DPCMState = State;
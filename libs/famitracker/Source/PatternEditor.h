@@ -203,6 +203,7 @@ private:
 	void DrawRow(CDC *pDC, int Row, int Line, int Frame, bool bPreview) const;
 	void DrawCell(CDC *pDC, int PosX, int Column, int Channel, bool bInvert, stChanNote *pNoteData, RowColorInfo_t *pColorInfo) const;
 	void DrawChar(CDC *pDC, int x, int y, TCHAR c, COLORREF Color) const;
+	void DrawChars(CDC *pDC, int x, int y, LPCTSTR pChars, int Count, COLORREF Color) const;
 
 	// Other drawing
 	void DrawChannelStates(CDC *pDC);
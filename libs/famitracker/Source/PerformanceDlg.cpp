@@ -70,6 +70,7 @@ void CPerformanceDlg::OnTimer(UINT nIDEvent)
 	unsigned int Usage = theApp.GetCPUUsage();
 	unsigned int Rate = theApp.GetSoundGenerator()->GetFrameRate();
 	unsigned int Underruns = theApp.GetSoundGenerator()->GetUnderruns();
+	int Latency = theApp.GetSoundGenerator()->GetNoteLatency();
 	CString Text;
 
 	Text.Format(_T("%i%%"), Usage / 100);
@@ -81,6 +82,10 @@ void CPerformanceDlg::OnTimer(UINT nIDEvent)
 	AfxFormatString1(Text, IDS_PERFORMANCE_UNDERRUN_FORMAT, MakeIntString(Underruns));
 	SetDlgItemText(IDC_UNDERRUN, Text);
 
+	// Nothing to show until a note has been heard
+	AfxFormatString1(Text, IDS_PERFORMANCE_LATENCY_FORMAT, (Latency < 0) ? CString(_T("-")) : MakeIntString(Latency));
+	SetDlgItemText(IDC_LATENCY, Text);
+
 	pBar->SetRange(0, 100);
 	pBar->SetPos(Usage / 100);
 
@@ -125,6 +125,7 @@ void CSettings::SetupSettings()
 	SETTING_BOOL("MIDI", "Channel map", false, &Midi.bMidiChannelMap);
 	SETTING_BOOL("MIDI", "Velocity control", false,	&Midi.bMidiVelocity);
 	SETTING_BOOL("MIDI", "Auto Arpeggio", false, &Midi.bMidiArpeggio);
+	SETTING_BOOL("MIDI", "Low latency", false, &Midi.bMidiLowLatency);
 
 	// Appearance
 	SETTING_INT("Appearance", "Background", DEFAULT_COLOR_SCHEME.BACKGROUND, &Appearance.iColBackground);
@@ -140,6 +140,7 @@ public:
 		bool	bMidiChannelMap;
 		bool	bMidiVelocity;
 		bool	bMidiArpeggio;
+		bool	bMidiLowLatency;
 	} Midi;
 
 	struct {
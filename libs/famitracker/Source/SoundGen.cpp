@@ -30,6 +30,7 @@
 
 #include "stdafx.h"
 #include <cmath>
+#include <algorithm>
 #include "FamiTracker.h"
 #include "FamiTrackerDoc.h"
 #include "FamiTrackerView.h"
@@ -127,6 +128,12 @@ CSoundGen::CSoundGen() :
 	m_bBufferUnderrun(false),
 	m_bAudioClipping(false),
 	m_iClipCounter(0),
+	m_bLowLatency(false),
+	m_iNoteEventTime(0),
+	m_iNoteEventPending(0),
+	m_bNoteEventMark(false),
+	m_iNoteEventMarkTime(0),
+	m_iNoteEventMarkOffset(0),
 	m_pSequencePlayPos(NULL),
 	m_iSequencePlayPos(0),
 	m_iSequenceTimeout(0)
@@ -524,7 +531,15 @@ bool CSoundGen::ResetAudioDevice()
 		return false;
 	}
 
-	int iBlocks = 1;	// default = 2
+	int iBlocks = 2;	// The audio callback takes one block while the player fills the other
+
+	// Live input wants short blocks and a short queue, what is played is heard sooner at the cost of underruns
+	m_bLowLatency = pSettings->Midi.bMidiLowLatency;
+
+	if (m_bLowLatency) {
+		BufferLen = LOW_LATENCY_PERIOD * LOW_LATENCY_BLOCKS;
+		iBlocks = LOW_LATENCY_BLOCKS;
+	}
 
 	// Create more blocks if a bigger buffer than 100ms is used to enhance program response
 //	if (BufferLen > 100)
@@ -559,9 +574,33 @@ bool CSoundGen::ResetAudioDevice()
 
 	m_csVisualizerWndLock.Unlock();
 
+	if (!SetupAPU(SampleRate, pSettings))
+		return false;
+
+	m_bAudioClipping = false;
+	m_bBufferUnderrun = false;
+	m_bBufferTimeout = false;
+	m_iClipCounter = 0;
+	m_bNoteEventMark = false;
+
+//	TRACE("SoundGen: Created sound channel with params: %i Hz, %i bits, %i ms (%i blocks)\n", SampleRate, SampleSize, BufferLen, iBlocks);
+
+	return true;
+}
+
+bool CSoundGen::SetupAPU(int SampleRate, const CSettings *pSettings)
+{
+	// Emulation rate, chip levels and output filtering
+
 	if (!m_pAPU->SetupSound(SampleRate, 1, (m_iMachineType == NTSC) ? MACHINE_NTSC : MACHINE_PAL))
 		return false;
 
+	// Flush the APU once per audio block instead of once per frame
+	if (m_bLowLatency) {
+		int BaseFreq = (m_iMachineType == NTSC) ? CAPU::BASE_FREQ_NTSC : CAPU::BASE_FREQ_PAL;
+		m_pAPU->SetFrameCycles(BaseFreq / 1000 * LOW_LATENCY_PERIOD);
+	}
+
 	m_pAPU->SetChipLevel(CHIP_LEVEL_APU1, float(pSettings->ChipLevels.iLevelAPU1 / 10.0f));
 	m_pAPU->SetChipLevel(CHIP_LEVEL_APU2, float(pSettings->ChipLevels.iLevelAPU2 / 10.0f));
 	m_pAPU->SetChipLevel(CHIP_LEVEL_VRC6, float(pSettings->ChipLevels.iLevelVRC6 / 10.0f));
@@ -582,13 +621,6 @@ bool CSoundGen::ResetAudioDevice()
 	// Update blip-buffer filtering 
 	m_pAPU->SetupMixer(pSettings->Sound.iBassFilter, pSettings->Sound.iTrebleFilter,  pSettings->Sound.iTrebleDamping, pSettings->Sound.iMixVolume);
 
-	m_bAudioClipping = false;
-	m_bBufferUnderrun = false;
-	m_bBufferTimeout = false;
-	m_iClipCounter = 0;
-
-//	TRACE("SoundGen: Created sound channel with params: %i Hz, %i bits, %i ms (%i blocks)\n", SampleRate, SampleSize, BufferLen, iBlocks);
-
 	return true;
 }
 
@@ -641,7 +673,7 @@ void CSoundGen::FlushBuffer(int16 *pBuffer, uint32 Size)
 	// May only be called from sound player thread
 //	ASSERT(GetCurrentThreadId() == m_nThreadID);
 
-	if (!m_pDSoundChannel)
+	if (!m_pDSoundChannel && !m_bRendering)
 		return;
 
 #ifdef EXPORT_TEST
@@ -734,8 +766,10 @@ bool CSoundGen::PlayBuffer()
 		// Output to direct sound
 		DWORD dwEvent;
 
-		// Wait for a buffer event
+		// Wait for room in the buffer
 		while ((dwEvent = m_pDSoundChannel->WaitForSyncEvent(AUDIO_TIMEOUT)) != BUFFER_IN_SYNC) {
+			if (dwEvent == BUFFER_TIMEOUT)
+				m_bBufferTimeout = true;
 //			switch (dwEvent) {
 //				case BUFFER_TIMEOUT:
 //					// Buffer timeout
@@ -751,9 +785,23 @@ bool CSoundGen::PlayBuffer()
 //					break; }
 		}
 
+		// A note was started in this block, time it until the callback reaches it
+		if (m_bNoteEventMark) {
+			m_pDSoundChannel->MarkEvent(m_iNoteEventMarkTime, m_iNoteEventMarkOffset);
+			m_bNoteEventMark = false;
+		}
+
 		// Write audio to buffer
 		m_pDSoundChannel->WriteBuffer(m_pAccumBuffer, m_iBufSizeBytes);
 
+		// The audio callback counts the times it ran out of samples
+		unsigned int Underruns = m_pDSoundChannel->GetUnderruns();
+
+		if (Underruns != (unsigned int)m_iAudioUnderruns) {
+			m_iAudioUnderruns = Underruns;
+			m_bBufferUnderrun = true;
+		}
+
 		// Draw graph
 		m_csVisualizerWndLock.Lock();
 
@@ -775,6 +823,28 @@ unsigned int CSoundGen::GetUnderruns() const
 	return m_iAudioUnderruns;
 }
 
+unsigned int CSoundGen::GetBufferFill() const
+{
+	// Audio waiting for the device, in ms
+	if (!m_pDSoundChannel)
+		return 0;
+
+	int BytesPerSecond = m_pDSoundChannel->GetSampleRate() * (m_pDSoundChannel->GetSampleSize() / 8) * m_pDSoundChannel->GetChannels();
+
+	return (unsigned int)((long long)m_pDSoundChannel->GetBufferFill() * 1000 / BytesPerSecond);
+}
+
+int CSoundGen::GetNoteLatency() const
+{
+	// Time from the last queued note to its first sample going out, in ms, -1 if none was heard
+	if (!m_pDSoundChannel)
+		return -1;
+
+	int Latency = m_pDSoundChannel->GetEventLatency();
+
+	return (Latency < 0) ? -1 : (Latency + 500) / 1000;
+}
+
 unsigned int CSoundGen::GetFrameRate()
 {
 	int FrameRate = m_iFrameCounter;
@@ -841,9 +911,9 @@ void CSoundGen::BeginPlayer(play_mode_t Mode, int Track)
 	// Called from player thread
 //	ASSERT(GetCurrentThreadId() == m_nThreadID);
 	ASSERT(m_pDocument != NULL);
-	ASSERT(m_pTrackerView != NULL);
 
-	if (!m_pDocument || !m_pDSoundChannel || !m_pDocument->IsFileLoaded())
+	// Rendering doesn't need the audio device
+	if (!m_pDocument || (!m_pDSoundChannel && !m_bRendering) || !m_pDocument->IsFileLoaded())
 		return;
 
 	switch (Mode) {
@@ -891,7 +961,8 @@ void CSoundGen::BeginPlayer(play_mode_t Mode, int Track)
 
 	MakeSilent();
 
-	m_pTrackerView->MakeSilent();
+	if (m_pTrackerView != NULL)
+		m_pTrackerView->MakeSilent();
 }
 
 void CSoundGen::HaltPlayer()
@@ -1013,10 +1084,10 @@ void CSoundGen::RunFrame()
 	// Called from player thread
 //	ASSERT(GetCurrentThreadId() == m_nThreadID);
 	ASSERT(m_pDocument != NULL);
-	ASSERT(m_pTrackerView != NULL);
 
 	// View callback
-	m_pTrackerView->PlayerTick();
+	if (m_pTrackerView != NULL)
+		m_pTrackerView->PlayerTick();
 
 	if (IsPlaying()) {
 		
@@ -1065,7 +1136,6 @@ void CSoundGen::RunFrame()
 void CSoundGen::CheckControl()
 {
 	// This function takes care of jumping and skipping
-	ASSERT(m_pTrackerView != NULL);
 
 	if (IsPlaying()) {
 		// If looping, halt when a jump or skip command are encountered
@@ -1102,7 +1172,7 @@ void CSoundGen::CheckControl()
 
 	if (m_bDirty) {
 		m_bDirty = false;
-		if (!m_bRendering)
+		if (!m_bRendering && m_pTrackerView != NULL)
 			m_pTrackerView->PostMessage(WM_USER_PLAYER, m_iPlayFrame, m_iPlayRow);
 	}
 }
@@ -1427,6 +1497,92 @@ bool CSoundGen::RenderToFile(LPTSTR pFile, render_end_t SongEndType, int SongEnd
 		WaitForStop();
 	}
 
+	SetupRender(SongEndType, SongEndParam, Track);
+
+	if (!m_wfWaveFile.OpenFile(pFile, theApp.GetSettings()->Sound.iSampleRate, theApp.GetSettings()->Sound.iSampleSize, 1)) {
+		AfxMessageBox(IDS_FILE_OPEN_ERROR);
+		return false;
+	}
+	else
+		PostThreadMessage(WM_USER_START_RENDER, 0, 0);
+
+	return true;
+}
+
+bool CSoundGen::RenderDocument(CFamiTrackerDoc *pDoc, LPCTSTR pFile, bool bRaw, int SampleRate, int SampleSize, render_end_t SongEndType, int SongEndParam, int Track)
+{
+	// Renders a module to a file from the calling thread, as fast as it will go.
+	// The generator must not have been started as the player thread, there is
+	// no view, audio device or visualizer. Mixer settings are the program's.
+
+	ASSERT(!m_bRunning);
+	ASSERT(SampleSize == 8 || SampleSize == 16);
+
+	if (pDoc == NULL || !pDoc->IsFileLoaded())
+		return false;
+
+	m_pDocument = pDoc;
+	m_pTrackerView = NULL;
+
+	for (int i = 0; i < CHANNELS; ++i) {
+		if (m_pChannels[i])
+			m_pChannels[i]->InitChannel(m_pAPU, m_iVibratoTable, this);
+	}
+
+	// The document has to play through the tracker channels of this generator
+	RegisterChannels(pDoc->GetExpansionChip(), pDoc);
+
+	// Same setup as the player thread and a loaded document goes through, the
+	// emulation clock follows the module's machine from the start
+	m_iMachineType = pDoc->GetMachine();
+
+	if (!SetupAPU(SampleRate, theApp.GetSettings())) {
+		m_pDocument = NULL;
+		return false;
+	}
+
+	SetupChip(pDoc->GetExpansionChip());
+	LoadMachineSettings(pDoc->GetMachine(), pDoc->GetEngineSpeed(), pDoc->GetNamcoChannels());
+	GenerateVibratoTable(pDoc->GetVibratoStyle());
+	DocumentPropertiesChanged(pDoc);
+	ResetAPU();
+
+	// Output buffer, 100ms
+	m_iSampleSize	  = SampleSize;
+	m_iBufSizeSamples = SampleRate / 10;
+	m_iBufSizeBytes	  = m_iBufSizeSamples * (SampleSize / 8);
+
+	SAFE_RELEASE_ARRAY(m_pAccumBuffer);
+	m_pAccumBuffer = new char[m_iBufSizeBytes];
+
+	SAFE_RELEASE_ARRAY(m_iGraphBuffer);
+	m_iGraphBuffer = new short[m_iBufSizeSamples];
+
+	SetupRender(SongEndType, SongEndParam, Track);
+
+	if (!m_wfWaveFile.OpenFile(pFile, SampleRate, SampleSize, 1, bRaw)) {
+		m_pDocument = NULL;
+		return false;
+	}
+
+	OnStartRender(0, 0);
+
+	while (IsRendering()) {
+		ProcessFrame();
+
+		// Nothing else ends the render if the player has stopped by itself
+		// (a halt effect) or couldn't be started
+		if (IsRendering() && !m_bPlaying && !m_iDelayedStart && !m_bRequestRenderStop)
+			StopRendering();
+	}
+
+	m_pDocument = NULL;
+
+	return true;
+}
+
+void CSoundGen::SetupRender(render_end_t SongEndType, int SongEndParam, int Track)
+{
 	m_iRenderEndWhen = SongEndType;
 	m_iRenderEndParam = SongEndParam;
 	m_iRenderTrack = Track;
@@ -1440,15 +1596,6 @@ bool CSoundGen::RenderToFile(LPTSTR pFile, render_end_t SongEndType, int SongEnd
 	else if (m_iRenderEndWhen == SONG_LOOP_LIMIT) {
 		m_iRenderEndParam = m_pDocument->ScanActualLength(Track, m_iRenderEndParam, m_iRenderRowCount);
 	}
-
-	if (!m_wfWaveFile.OpenFile(pFile, theApp.GetSettings()->Sound.iSampleRate, theApp.GetSettings()->Sound.iSampleSize, 1)) {
-		AfxMessageBox(IDS_FILE_OPEN_ERROR);
-		return false;
-	}
-	else
-		PostThreadMessage(WM_USER_START_RENDER, 0, 0);
-
-	return true;
 }
 
 void CSoundGen::StopRendering()
@@ -1464,6 +1611,11 @@ void CSoundGen::StopRendering()
 	m_bRendering = false;
 	m_iPlayFrame = 0;
 	m_iPlayRow = 0;
+
+	// Samples left over from the last full buffer
+	if (m_iBufferPtr > 0)
+		m_wfWaveFile.WriteWave(m_pAccumBuffer, m_iBufferPtr * (m_iSampleSize / 8));
+
 	m_wfWaveFile.CloseFile();
 
 	MakeSilent();
@@ -1618,8 +1770,22 @@ BOOL CSoundGen::OnIdle(LONG lCount)
 	if (CWinThread::OnIdle(lCount))
 		return TRUE;
 
-	if (!m_pDocument || !m_pDSoundChannel || !m_pDocument->IsFileLoaded())
+	if (!m_pDocument || !m_pDSoundChannel || !m_pDocument->IsFileLoaded()) {
+		SetIdleInterval(IDLE_INTERVAL);
 		return TRUE;
+	}
+
+	// Run frames back to back, the thread sleeps in PlayBuffer while the audio buffer is full
+	SetIdleInterval(0);
+
+	ProcessFrame();
+
+	return TRUE;
+}
+
+void CSoundGen::ProcessFrame()
+{
+	// Runs the player and the APU for one frame
 
 	++m_iFrameCounter;
 
@@ -1668,7 +1834,10 @@ BOOL CSoundGen::OnIdle(LONG lCount)
 	if (m_iDelayedStart > 0) {
 		--m_iDelayedStart;
 		if (!m_iDelayedStart) {
-			PostThreadMessage(WM_USER_PLAY, MODE_PLAY_START, m_iRenderTrack);
+			if (m_bRunning)
+				PostThreadMessage(WM_USER_PLAY, MODE_PLAY_START, m_iRenderTrack);
+			else
+				BeginPlayer(MODE_PLAY_START, m_iRenderTrack);
 		}
 	}
 
@@ -1677,8 +1846,6 @@ BOOL CSoundGen::OnIdle(LONG lCount)
 		delete m_pPreviewSample;
 		m_pPreviewSample = NULL;
 	}
-
-	return TRUE;
 }
 
 void CSoundGen::PlayChannelNotes()
@@ -1686,12 +1853,19 @@ void CSoundGen::PlayChannelNotes()
 	// Feed queued notes into channels
 	const int Channels = m_pDocument->GetChannelCount();
 
+	// Queued notes start here, mark where the audio is at for the latency measurement
+	if (m_iNoteEventPending.fetchAndStoreAcquire(0) && !m_bRendering) {
+		m_bNoteEventMark = true;
+		m_iNoteEventMarkTime = m_iNoteEventTime.fetchAndAddRelaxed(0);
+		m_iNoteEventMarkOffset = m_iBufferPtr * (m_iSampleSize / 8);
+	}
+
 	// Read notes
 	for (int i = 0; i < Channels; ++i) {
 		int Channel = m_pDocument->GetChannelType(i);
 		
 		// Run auto-arpeggio, if enabled
-		int Arpeggio = m_pTrackerView->GetAutoArpeggio(i);
+		int Arpeggio = (m_pTrackerView != NULL) ? m_pTrackerView->GetAutoArpeggio(i) : 0;
 		if (Arpeggio > 0) {
 			m_pChannels[Channel]->Arpeggiate(Arpeggio);
 		}
@@ -1711,9 +1885,11 @@ void CSoundGen::PlayChannelNotes()
 	}
 
 	// Instrument sequence visualization
-	int SelectedChan = m_pTrackerView->GetSelectedChannel();
-	if (m_pChannels[SelectedChan])
-		m_pChannels[SelectedChan]->UpdateSequencePlayPos();
+	if (m_pTrackerView != NULL) {
+		int SelectedChan = m_pTrackerView->GetSelectedChannel();
+		if (m_pChannels[SelectedChan])
+			m_pChannels[SelectedChan]->UpdateSequencePlayPos();
+	}
 
 }
 
@@ -1771,8 +1947,22 @@ void CSoundGen::UpdateAPU()
 	}
 
 	// Finish the audio frame
-	m_pAPU->AddTime(m_iUpdateCycles - m_iConsumedCycles);
-	m_pAPU->Process();
+	if (m_bLowLatency && !m_bPlaying && !m_bRendering) {
+		// Run the rest of the frame a block at a time and cut it short when a note is queued,
+		// the next frame starts right away and plays it. Songs keep whole frames for the tempo.
+		// At least one block is run so a note that couldn't be read yet doesn't stall the audio.
+		int BaseFreq = (m_iMachineType == NTSC) ? CAPU::BASE_FREQ_NTSC : CAPU::BASE_FREQ_PAL;
+		int Slice = BaseFreq / 1000 * LOW_LATENCY_PERIOD;
+
+		do {
+			AddCycles(std::max(std::min(Slice, m_iUpdateCycles - m_iConsumedCycles), 0));
+			m_pAPU->Process();
+		} while (m_iConsumedCycles < m_iUpdateCycles && !m_iNoteEventPending.fetchAndAddAcquire(0));
+	}
+	else {
+		m_pAPU->AddTime(m_iUpdateCycles - m_iConsumedCycles);
+		m_pAPU->Process();
+	}
 
 #ifdef LOGGING
 	if (m_bPlaying)
@@ -1856,8 +2046,11 @@ void CSoundGen::OnCloseSound(WPARAM wParam, LPARAM lParam)
 
 void CSoundGen::OnSetChip(WPARAM wParam, LPARAM lParam)
 {
-	int Chip = wParam;
+	SetupChip(wParam);
+}
 
+void CSoundGen::SetupChip(int Chip)
+{
 	m_pAPU->SetExternalSound(Chip);
 
 	// Enable internal channels after reset
@@ -1920,7 +2113,12 @@ void CSoundGen::ReadPatternRow()
 	stChanNote NoteData;
 
 	for (int i = 0; i < Channels; ++i) {
-		if (m_pTrackerView->PlayerGetNote(m_iPlayTrack, m_iPlayFrame, i, m_iPlayRow, NoteData))
+		if (m_pTrackerView == NULL) {
+			// Nothing muted without a view
+			m_pDocument->GetNoteData(m_iPlayTrack, m_iPlayFrame, i, m_iPlayRow, &NoteData);
+			QueueNote(i, NoteData, NOTE_PRIO_1);
+		}
+		else if (m_pTrackerView->PlayerGetNote(m_iPlayTrack, m_iPlayFrame, i, m_iPlayRow, NoteData))
 			QueueNote(i, NoteData, NOTE_PRIO_1);
 	}
 }
@@ -2003,7 +2201,14 @@ void CSoundGen::QueueNote(int Channel, stChanNote &NoteData, note_prio_t Priorit
 
 	// Queue a note for play
 	m_pDocument->GetChannel(Channel)->SetNote(NoteData, Priority);
-   theApp.GetMIDI()->WriteNote(Channel, NoteData.Note, NoteData.Octave, NoteData.Vol);
+
+	// Time it for the latency measurement, this also ends a low latency frame early
+	m_iNoteEventTime.fetchAndStoreRelaxed((int)CDSoundChannel::GetTimestamp());
+	m_iNoteEventPending.fetchAndStoreRelease(1);
+
+	// Don't echo to MIDI what goes to a file
+	if (!m_bRendering)
+		theApp.GetMIDI()->WriteNote(Channel, NoteData.Note, NoteData.Octave, NoteData.Vol);
 }
 
 int	CSoundGen::GetPlayerRow() const
@@ -2162,5 +2367,8 @@ int CSoundGen::GetSequencePlayPos(const CSequence *pSequence)
 
 int CSoundGen::GetDefaultInstrument() const
 {
+	if (theApp.m_pMainWnd == NULL)
+		return 0;
+
 	return ((CMainFrame*)theApp.m_pMainWnd)->GetSelectedInstrument();
 }
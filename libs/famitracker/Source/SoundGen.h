@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <QAtomicInt>
 #include <QThread>
 #include <QTimer>
 
@@ -86,6 +87,7 @@ class CDSoundChannel;
 class CVisualizerWnd;
 class CDSample;
 class CTrackerChannel;
+class CSettings;
 
 #ifdef EXPORT_TEST
 class CExportTest;
@@ -160,6 +162,8 @@ public:
 	// Stats
 	unsigned int GetUnderruns() const;
 	unsigned int GetFrameRate();
+	unsigned int GetBufferFill() const;
+	int			 GetNoteLatency() const;
 
 	// Tracker playing
 	void		 SetJumpPattern(int Pattern);
@@ -169,6 +173,7 @@ public:
 
 	// Rendering
 	bool		 RenderToFile(LPTSTR pFile, render_end_t SongEndType, int SongEndParam, int Track);
+	bool		 RenderDocument(CFamiTrackerDoc *pDoc, LPCTSTR pFile, bool bRaw, int SampleRate, int SampleSize, render_end_t SongEndType, int SongEndParam, int Track);
 	void		 StopRendering();
 	void		 GetRenderStat(int &Frame, int &Time, bool &Done, int &FramesToRender, int &Row, int &RowCount) const;
 	bool		 IsRendering() const;	
@@ -232,6 +237,8 @@ private:
 
 	// Audio
 	bool		ResetAudioDevice();
+	bool		SetupAPU(int SampleRate, const CSettings *pSettings);
+	void		SetupChip(int Chip);
 	void		CloseAudioDevice();
 	void		CloseAudio();
 	template<class T, int SHIFT> void FillBuffer(int16 *pBuffer, uint32 Size);
@@ -250,6 +257,8 @@ private:
 	void		HaltPlayer();
 	void		MakeSilent();
 	void		SetupSpeed();
+	void		SetupRender(render_end_t SongEndType, int SongEndParam, int Track);
+	void		ProcessFrame();
 
 	// Misc
 	void		PlaySample(const CDSample *pSample, int Offset, int Pitch);
@@ -272,6 +281,9 @@ public:
 	static const double OLD_VIBRATO_DEPTH[];
 
 	static const int AUDIO_TIMEOUT = 2000;		// 2s buffer timeout
+	static const int IDLE_INTERVAL = 10;		// Thread poll rate while there's nothing to play, in ms
+	static const int LOW_LATENCY_PERIOD = 5;	// Audio block length for live input, in ms
+	static const int LOW_LATENCY_BLOCKS = 3;
 
 	//
 	// Private variables
@@ -314,6 +326,14 @@ private:
 	bool				m_bBufferUnderrun;
 	bool				m_bAudioClipping;
 	int					m_iClipCounter;
+	bool				m_bLowLatency;						// Short audio blocks for live input
+
+	// Note latency, queued notes are timed from the user thread
+	mutable QAtomicInt	m_iNoteEventTime;
+	mutable QAtomicInt	m_iNoteEventPending;
+	bool				m_bNoteEventMark;					// Mark the next audio block written
+	unsigned int		m_iNoteEventMarkTime;
+	unsigned int		m_iNoteEventMarkOffset;				// in bytes
 	
 // Tracker playing variables
 private:
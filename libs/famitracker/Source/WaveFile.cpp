@@ -21,50 +21,56 @@
 #include "cqtmfc.h"
 #include "WaveFile.h"
 
-bool CWaveFile::OpenFile(LPTSTR Filename, int SampleRate, int SampleSize, int Channels)
-{
-	// Open a wave file for streaming
-	//
+#include <string.h>
 
-	int nError;
+// Size of the RIFF, fmt and data chunk headers
+static const int WAVE_HEADER_SIZE = 44;
 
-	WaveFormat.wf.wFormatTag	  = WAVE_FORMAT_PCM;
-	WaveFormat.wf.nChannels		  = Channels;
-	WaveFormat.wf.nSamplesPerSec  = SampleRate;
-	WaveFormat.wf.nBlockAlign	  = (SampleSize / 8) * Channels;
-	WaveFormat.wf.nAvgBytesPerSec = SampleRate * (SampleSize / 8) * Channels;
-	WaveFormat.wBitsPerSample	  = SampleSize;
-
-	hmmioOut = mmioOpen(Filename, NULL, MMIO_ALLOCBUF | MMIO_READWRITE | MMIO_CREATE);
-
-	ckOutRIFF.fccType = mmioFOURCC('W', 'A', 'V', 'E');
-	ckOutRIFF.cksize  = 0;
+static void PutLong(unsigned char *pBuf, unsigned int Value)
+{
+	pBuf[0] = Value & 0xFF;
+	pBuf[1] = (Value >> 8) & 0xFF;
+	pBuf[2] = (Value >> 16) & 0xFF;
+	pBuf[3] = (Value >> 24) & 0xFF;
+}
 
-	nError = mmioCreateChunk(hmmioOut, &ckOutRIFF, MMIO_CREATERIFF);
+static void PutShort(unsigned char *pBuf, unsigned short Value)
+{
+	pBuf[0] = Value & 0xFF;
+	pBuf[1] = (Value >> 8) & 0xFF;
+}
 
-	if (nError != MMSYSERR_NOERROR)
-		return false;
+CWaveFile::CWaveFile() : 
+	m_bOpen(false),
+	m_bRaw(false),
+	m_iSampleRate(0),
+	m_iSampleSize(0),
+	m_iChannels(0),
+	m_iDataSize(0)
+{
+}
 
-	ckOut.ckid	 = mmioFOURCC('f', 'm', 't', ' ');     
-	ckOut.cksize = sizeof(PCMWAVEFORMAT);
+bool CWaveFile::OpenFile(LPCTSTR Filename, int SampleRate, int SampleSize, int Channels, bool bRaw)
+{
+	// Open a wave file for streaming
+	//
 
-	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
+	if (m_bOpen)
+		CloseFile();
 
-	if (nError != MMSYSERR_NOERROR)
+	if (!m_File.Open(Filename, CFile::modeCreate | CFile::modeWrite))
 		return false;
 
-	mmioWrite(hmmioOut, (HPSTR)&WaveFormat, sizeof(PCMWAVEFORMAT));
-	mmioAscend(hmmioOut, &ckOut, 0);
-
-	ckOut.ckid	 = mmioFOURCC('d', 'a', 't', 'a');
-	ckOut.cksize = 0;
-
-	nError = mmioCreateChunk(hmmioOut, &ckOut, 0);
-
-	if (nError != MMSYSERR_NOERROR)
-		return false;
+	m_bOpen		  = true;
+	m_bRaw		  = bRaw;
+	m_iSampleRate = SampleRate;
+	m_iSampleSize = SampleSize;
+	m_iChannels	  = Channels;
+	m_iDataSize	  = 0;
 
-	mmioGetInfo(hmmioOut, &mmioinfoOut, 0);	
+	// Sizes are not known yet, they are written again when closing
+	if (!m_bRaw)
+		WriteHeader();
 
 	return true;
 }
@@ -74,33 +80,52 @@ void CWaveFile::CloseFile()
 	// Close the file
 	//
 
-	mmioinfoOut.dwFlags |= MMIO_DIRTY;
-	mmioSetInfo(hmmioOut, &mmioinfoOut, 0);
-
-	mmioAscend(hmmioOut, &ckOut, 0);
-	mmioAscend(hmmioOut, &ckOutRIFF, 0);
+	if (!m_bOpen)
+		return;
 
-	mmioSeek(hmmioOut, 0, SEEK_SET); 
-	mmioDescend(hmmioOut, &ckOutRIFF, NULL, 0);
+	if (!m_bRaw) {
+		m_File.Seek(0, CFile::begin);
+		WriteHeader();
+	}
 
-	mmioClose(hmmioOut, 0);
+	m_File.Close();
+	m_bOpen = false;
 }
 
-void CWaveFile::WriteWave(char *Data, int Size)
+void CWaveFile::WriteWave(const char *Data, int Size)
 {
 	// Save data to the file
 	//
 
-	int cT;
-	
-	for (cT = 0; cT < Size; cT++) {
-        if (mmioinfoOut.pchNext == mmioinfoOut.pchEndWrite) { 
-			mmioinfoOut.dwFlags |= MMIO_DIRTY; 
-			mmioAdvance(hmmioOut, &mmioinfoOut, MMIO_WRITE);
-		}
+	if (!m_bOpen)
+		return;
 
-		*((BYTE*)mmioinfoOut.pchNext) = *((BYTE*)Data + cT); 
-		mmioinfoOut.pchNext++;
-	}
+	m_File.Write(Data, Size);
+	m_iDataSize += Size;
 }
 
+void CWaveFile::WriteHeader()
+{
+	unsigned char Header[WAVE_HEADER_SIZE];
+	int BlockAlign = (m_iSampleSize / 8) * m_iChannels;
+
+	memcpy(Header, "RIFF", 4);
+	PutLong(Header + 4, WAVE_HEADER_SIZE - 8 + m_iDataSize);
+	memcpy(Header + 8, "WAVE", 4);
+
+	// PCM format chunk
+	memcpy(Header + 12, "fmt ", 4);
+	PutLong(Header + 16, 16);
+	PutShort(Header + 20, 1);			// WAVE_FORMAT_PCM
+	PutShort(Header + 22, m_iChannels);
+	PutLong(Header + 24, m_iSampleRate);
+	PutLong(Header + 28, m_iSampleRate * BlockAlign);
+	PutShort(Header + 32, BlockAlign);
+	PutShort(Header + 34, m_iSampleSize);
+
+	// Sample data follows
+	memcpy(Header + 36, "data", 4);
+	PutLong(Header + 40, m_iDataSize);
+
+	m_File.Write(Header, WAVE_HEADER_SIZE);
+}
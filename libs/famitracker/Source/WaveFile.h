@@ -21,20 +21,29 @@
 #pragma once
 
 
-#include <mmsystem.h>
+// Streams PCM to a RIFF wave file, or to a raw file with no header at all
+// when bRaw is set.  The header sizes are filled in when the file is closed.
 
 class CWaveFile
 {
 	public:
-		bool	OpenFile(LPTSTR Filename, int SampleRate, int SampleSize, int Channels);
+		CWaveFile();
+
+		bool	OpenFile(LPCTSTR Filename, int SampleRate, int SampleSize, int Channels, bool bRaw = false);
 		void	CloseFile();
-		void	WriteWave(char *Data, int Size);
+		void	WriteWave(const char *Data, int Size);
+
+	private:
+		void	WriteHeader();
 
 	private:
-		PCMWAVEFORMAT	WaveFormat;
-		MMCKINFO		ckOutRIFF, ckOut;
-		MMIOINFO		mmioinfoOut;
-		HMMIO			hmmioOut;
+		CFile			m_File;
+		bool			m_bOpen;
+		bool			m_bRaw;
+		int				m_iSampleRate;
+		int				m_iSampleSize;
+		int				m_iChannels;
+		unsigned int	m_iDataSize;
 
 };
 
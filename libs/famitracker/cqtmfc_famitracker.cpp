@@ -1245,6 +1245,7 @@ void qtMfcInitStringResources()
    qtMfcStringResources.insert(IDS_DPCM_IMPORT_TARGET_FORMAT,"Target sample rate: %1 Hz");
    qtMfcStringResources.insert(IDS_PERFORMANCE_FRAMERATE_FORMAT,"Frame rate: %1 Hz");
    qtMfcStringResources.insert(IDS_PERFORMANCE_UNDERRUN_FORMAT,"Underruns: %1");
+   qtMfcStringResources.insert(IDS_PERFORMANCE_LATENCY_FORMAT,"Note latency: %1 ms");
    // END
 
 
@@ -2904,6 +2905,13 @@ void qtMfcInitDialogResource_IDD_CONFIG_MIDI(CDialog* parent)
 	mfc11->Create(_T("Auto arpeggiate chords"), WS_VISIBLE|WS_BORDER|BS_AUTOCHECKBOX|WS_TABSTOP, r11, parent, IDC_ARPEGGIATE);
 	mfcToQtWidget->insert(IDC_ARPEGGIATE, mfc11);
 
+   // CONTROL "Low latency", IDC_LOW_LATENCY, "Button", WS_VISIBLE|WS_BORDER|BS_AUTOCHECKBOX|WS_TABSTOP, 190, 102, 76, 10
+	CButton* mfc12 = new CButton(parent);
+	CRect r12(CPoint(190, 102), CSize(76, 10));
+	parent->MapDialogRect(&r12);
+	mfc12->Create(_T("Low latency"), WS_VISIBLE|WS_BORDER|BS_AUTOCHECKBOX|WS_TABSTOP, r12, parent, IDC_LOW_LATENCY);
+	mfcToQtWidget->insert(IDC_LOW_LATENCY, mfc12);
+
    // END
 }
 
@@ -4786,13 +4794,20 @@ void qtMfcInitDialogResource_IDD_PERFORMANCE(CDialog* parent)
 	mfc7->Create(_T("Frame rate: 0 Hz"),WS_VISIBLE|WS_BORDER,r7,parent,IDC_FRAMERATE);
 	// IDC_STATIC do not get added to MFC-to-Qt map.
 
-   // LTEXT "Underruns: 0",IDC_UNDERRUN,89,45,66,8
+   // LTEXT "Underruns: 0",IDC_UNDERRUN,89,42,66,8
 	CStatic* mfc8 = new CStatic(parent);
-	CRect r8(CPoint(89,45),CSize(66,8));
+	CRect r8(CPoint(89,42),CSize(66,8));
 	parent->MapDialogRect(&r8);
 	mfc8->Create(_T("Underruns: 0"),WS_VISIBLE|WS_BORDER,r8,parent,IDC_UNDERRUN);
 	// IDC_STATIC do not get added to MFC-to-Qt map.
 
+   // LTEXT "Note latency: - ms",IDC_LATENCY,89,50,76,8
+	CStatic* mfc12 = new CStatic(parent);
+	CRect r12(CPoint(89,50),CSize(76,8));
+	parent->MapDialogRect(&r12);
+	mfc12->Create(_T("Note latency: - ms"),WS_VISIBLE|WS_BORDER,r12,parent,IDC_LATENCY);
+	// IDC_STATIC do not get added to MFC-to-Qt map.
+
    // CONTROL "", IDC_STATIC, "Static", WS_VISIBLE|WS_BORDER|SS_ETCHEDHORZ, 7, 67, 162, 1
 	CStatic* mfc9 = new CStatic(parent);
 	CRect r9(CPoint(7, 67), CSize(162, 1));
@@ -5713,3 +5728,9 @@ void qtMfcInit(QMainWindow* parent)
 	qtInitIconResources();
 }
 
+void qtMfcInitHeadless()
+{
+	// No windows, just the strings for messages...
+	qtMfcInitStringResources();
+}
+
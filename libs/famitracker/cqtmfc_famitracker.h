@@ -11,6 +11,7 @@ extern QHash<int,QString> qtIconNames;
 extern QHash<int,QIcon*> qtIconResources;
 
 void qtMfcInit(QMainWindow* parent);
+void qtMfcInitHeadless();
 
 void qtMfcInitDialogResource(UINT dlgID,CDialog* parent);
 
@@ -203,6 +203,7 @@
 #define IDS_MIDI_MESSAGE_ON_FORMAT      316
 #define IDS_MIDI_MESSAGE_OFF            317
 #define IDI_RIGHT                       317
+#define IDS_PERFORMANCE_LATENCY_FORMAT  318
 #define IDR_SEQUENCE_POPUP              319
 #define IDC_INSTRUMENTS                 1001
 #define IDC_INSTSETTINGS                1002
@@ -462,6 +463,8 @@
 #define IDC_SLIDER_N163                 1284
 #define IDC_SLIDER8                     1285
 #define IDC_SLIDER_S5B                  1285
+#define IDC_LOW_LATENCY                 1286
+#define IDC_LATENCY                     1287
 #define ID_TRACKER_PLAY                 32771
 #define ID_TRACKER_PLAYPATTERN          32775
 #define ID_TRACKER_STOP                 32776
@@ -623,7 +626,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NEXT_RESOURCE_VALUE        320
 #define _APS_NEXT_COMMAND_VALUE         33127
-#define _APS_NEXT_CONTROL_VALUE         1280
+#define _APS_NEXT_CONTROL_VALUE         1288
 #define _APS_NEXT_SYMED_VALUE           179
 #endif
 #endif
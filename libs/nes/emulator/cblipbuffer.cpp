@@ -0,0 +1,118 @@
+//    NESICIDE - an IDE for the 8-bit NES.
+//    Copyright (C) 2009  Christopher S. Pow
+
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "cblipbuffer.h"
+
+#include <math.h>
+
+#if !defined ( M_PI )
+#define M_PI 3.14159265358979323846
+#endif
+
+// Fraction of the output sample rate passed by the impulse.  Just under
+// the Nyquist frequency so the window has room to roll off.
+#define BLIP_CUTOFF 0.45
+
+CBlipBuffer::CBlipBuffer()
+{
+   m_factor = 0;
+   BuildKernel ();
+   Clear ();
+}
+
+void CBlipBuffer::SetRates ( double clockRate, uint32_t sampleRate )
+{
+   m_factor = (uint64_t)((((double)sampleRate)/clockRate)*((double)(((uint64_t)1)<<FRAC_BITS))+0.5);
+   Clear ();
+}
+
+void CBlipBuffer::Clear ( void )
+{
+   memset ( m_buffer, 0, sizeof(m_buffer) );
+   m_offset = 0;
+   m_readPos = 0;
+   m_integrator = 0;
+}
+
+void CBlipBuffer::BuildKernel ( void )
+{
+   double impulse [ KERNEL_WIDTH ];
+   double sum;
+   double x;
+   int32_t phase;
+   int32_t tap;
+   int32_t total;
+   int32_t peak;
+
+   for ( phase = 0; phase < NUM_PHASES; phase++ )
+   {
+      // The impulse is centred half the kernel width in, moved along by
+      // how far between two output samples the change happened.
+      sum = 0.0;
+      for ( tap = 0; tap < KERNEL_WIDTH; tap++ )
+      {
+         x = tap-((KERNEL_WIDTH/2)-1)-(((double)phase)/NUM_PHASES);
+
+         // Windowed sinc low-pass (Blackman window).
+         impulse[tap] = 2.0*BLIP_CUTOFF;
+         if ( x != 0.0 )
+         {
+            impulse[tap] = sin(2.0*M_PI*BLIP_CUTOFF*x)/(M_PI*x);
+         }
+         impulse[tap] *= 0.42+(0.5*cos((2.0*M_PI*x)/KERNEL_WIDTH))+(0.08*cos((4.0*M_PI*x)/KERNEL_WIDTH));
+
+         sum += impulse[tap];
+      }
+
+      // Each impulse must add up to exactly one step so that the integrated
+      // output settles on the exact level of the input.  The rounding error
+      // is taken up by the largest tap.
+      total = 0;
+      peak = 0;
+      for ( tap = 0; tap < KERNEL_WIDTH; tap++ )
+      {
+         m_kernel[phase][tap] = (int32_t)floor(((impulse[tap]/sum)*(1<<KERNEL_BITS))+0.5);
+         total += m_kernel[phase][tap];
+         if ( m_kernel[phase][tap] > m_kernel[phase][peak] )
+         {
+            peak = tap;
+         }
+      }
+      m_kernel[phase][peak] += (1<<KERNEL_BITS)-total;
+   }
+}
+
+void CBlipBuffer::STATE ( CSaveState& state )
+{
+   uint32_t offsetLo = (uint32_t)m_offset;
+   uint32_t offsetHi = (uint32_t)(m_offset>>32);
+   int32_t idx;
+
+   state.Value ( offsetLo );
+   state.Value ( offsetHi );
+   state.Value ( m_readPos );
+   state.Value ( m_integrator );
+   for ( idx = 0; idx < BUFFER_SIZE; idx++ )
+   {
+      state.Value ( m_buffer[idx] );
+   }
+
+   if ( state.IsLoading() )
+   {
+      m_offset = (((uint64_t)offsetHi)<<32)|offsetLo;
+      m_readPos &= (BUFFER_SIZE-1);
+   }
+}
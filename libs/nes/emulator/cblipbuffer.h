@@ -0,0 +1,100 @@
+#if !defined ( BLIPBUFFER_H )
+#define BLIPBUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "csavestate.h"
+
+// The CBlipBuffer class turns a signal that changes at the APU clock into
+// band-limited output samples at the host sample rate.  It works the same
+// way as the Blip_Buffer library the music designer uses.
+//
+// Every change of the signal is added to the buffer as a band-limited step:
+// a windowed sinc impulse, positioned to a fraction of an output sample,
+// spread over the next few output samples.  Reading a sample integrates the
+// impulses back into a signal.  This costs nothing on the clocks where the
+// signal doesn't change, and a change that falls between two output samples
+// comes out between them instead of being box-averaged into one, so nothing
+// above the output Nyquist frequency folds back as aliasing.
+//
+// The output lags the input by half the width of the impulse.
+class CBlipBuffer
+{
+public:
+   CBlipBuffer();
+
+   // Set the rate of the input clock and of the output samples.  This
+   // clears the buffer.
+   void SetRates ( double clockRate, uint32_t sampleRate );
+
+   // Drop everything in the buffer and start again from silence.
+   void Clear ( void );
+
+   // Add a change of the signal at the current clock.
+   inline void AddDelta ( int32_t delta )
+   {
+      const int32_t* pKernel = m_kernel[(m_offset>>(FRAC_BITS-PHASE_BITS))&(NUM_PHASES-1)];
+      uint32_t pos = m_readPos+(uint32_t)(m_offset>>FRAC_BITS);
+      int32_t tap;
+
+      for ( tap = 0; tap < KERNEL_WIDTH; tap++ )
+      {
+         m_buffer[(pos+tap)&(BUFFER_SIZE-1)] += delta*pKernel[tap];
+      }
+   }
+
+   // Move on one input clock.  Returns true when an output sample is
+   // complete and should be read.
+   inline bool Clock ( void )
+   {
+      m_offset += m_factor;
+      return (m_offset>>FRAC_BITS) != 0;
+   }
+
+   // Read the next output sample.
+   inline int32_t ReadSample ( void )
+   {
+      m_integrator += m_buffer[m_readPos];
+      m_buffer[m_readPos] = 0;
+      m_readPos = (m_readPos+1)&(BUFFER_SIZE-1);
+      m_offset -= ((uint64_t)1)<<FRAC_BITS;
+
+      return m_integrator>>KERNEL_BITS;
+   }
+
+   // The samples not read yet are part of the emulator state.
+   void STATE ( CSaveState& state );
+
+protected:
+   enum
+   {
+      // Impulse resolution: 32 positions between two output samples,
+      // each 16 output samples wide.
+      PHASE_BITS = 5,
+      NUM_PHASES = (1<<PHASE_BITS),
+      KERNEL_WIDTH = 16,
+      KERNEL_BITS = 12,
+
+      // Impulses are added at most KERNEL_WIDTH samples past the next one
+      // to be read.
+      BUFFER_SIZE = 32,
+
+      FRAC_BITS = 32
+   };
+
+   void BuildKernel ( void );
+
+   // Output samples per input clock, and the position of the current clock
+   // from the next sample to be read, in 32.32 fixed point.
+   uint64_t m_factor;
+   uint64_t m_offset;
+
+   int32_t  m_buffer [ BUFFER_SIZE ];
+   uint32_t m_readPos;
+   int32_t  m_integrator;
+
+   int32_t  m_kernel [ NUM_PHASES ] [ KERNEL_WIDTH ];
+};
+
+#endif
@@ -22,8 +22,8 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-uint32_t CCodeDataLogger::m_curCycle = 0;
-LoggerInfo* CCodeDataLogger::m_pLastLoad = NULL;
+NES_THREAD_LOCAL uint32_t CCodeDataLogger::m_curCycle = 0;
+NES_THREAD_LOCAL LoggerInfo* CCodeDataLogger::m_pLastLoad = NULL;
 
 CCodeDataLogger::CCodeDataLogger(uint32_t size, uint32_t mask)
 {
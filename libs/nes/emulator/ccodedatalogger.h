@@ -88,9 +88,9 @@ public:
 protected:
    uint32_t        m_size;
    uint32_t        m_mask;
-   static uint32_t m_curCycle;
+   static NES_THREAD_LOCAL uint32_t m_curCycle;
    uint32_t m_maxCount;
-   static LoggerInfo* m_pLastLoad;
+   static NES_THREAD_LOCAL LoggerInfo* m_pLastLoad;
    LoggerInfo* m_pLogger;
 };
 
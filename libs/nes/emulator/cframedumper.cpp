@@ -0,0 +1,252 @@
+//    NESICIDE - an IDE for the 8-bit NES.
+//    Copyright (C) 2009  Christopher S. Pow
+
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "cframedumper.h"
+
+#include <string.h>
+
+#define FRAME_WIDTH  256
+#define FRAME_HEIGHT 240
+
+CFrameDumper::CFrameDumper()
+{
+   m_pFile = NULL;
+   m_closeFile = false;
+   m_format = NES_FRAMEDUMP_RGBA;
+   m_frameSize = 0;
+   m_dropWhenFull = false;
+   m_pFrames = NULL;
+   m_depth = 0;
+   m_head = 0;
+   m_count = 0;
+   m_stopping = false;
+   m_failed = false;
+   m_framesWritten = 0;
+   m_framesDropped = 0;
+}
+
+CFrameDumper::~CFrameDumper()
+{
+   Stop ();
+}
+
+bool CFrameDumper::Start ( const char* fileName, int32_t format, int32_t depth, bool dropWhenFull )
+{
+   int32_t idx;
+
+   Stop ();
+
+   if ( (format != NES_FRAMEDUMP_RGBA) && (format != NES_FRAMEDUMP_INDEXED) )
+   {
+      return false;
+   }
+
+   if ( strcmp(fileName,"-") == 0 )
+   {
+      m_pFile = stdout;
+      m_closeFile = false;
+   }
+   else
+   {
+      m_pFile = fopen ( fileName, "wb" );
+      m_closeFile = true;
+   }
+   if ( !m_pFile )
+   {
+      return false;
+   }
+
+   if ( depth < 1 )
+   {
+      depth = 1;
+   }
+
+   m_format = format;
+   m_frameSize = FRAME_WIDTH*FRAME_HEIGHT*((format == NES_FRAMEDUMP_RGBA) ? 4 : 2);
+   m_dropWhenFull = dropWhenFull;
+   m_depth = depth;
+   m_pFrames = new uint8_t* [ m_depth ];
+   for ( idx = 0; idx < m_depth; idx++ )
+   {
+      m_pFrames[idx] = new uint8_t [ m_frameSize ];
+   }
+
+   m_head = 0;
+   m_count = 0;
+   m_stopping = false;
+   m_failed = false;
+   m_framesWritten = 0;
+   m_framesDropped = 0;
+
+   m_writer = std::thread ( &CFrameDumper::Writer, this );
+
+   return true;
+}
+
+void CFrameDumper::Stop ( void )
+{
+   if ( !m_pFile )
+   {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock ( m_mutex );
+      m_stopping = true;
+   }
+   m_queued.notify_one ();
+   m_writer.join ();
+
+   if ( m_closeFile )
+   {
+      fclose ( m_pFile );
+   }
+   else
+   {
+      fflush ( m_pFile );
+   }
+   m_pFile = NULL;
+
+   Free ();
+}
+
+void CFrameDumper::Free ( void )
+{
+   int32_t idx;
+
+   for ( idx = 0; idx < m_depth; idx++ )
+   {
+      delete [] m_pFrames[idx];
+   }
+   delete [] m_pFrames;
+   m_pFrames = NULL;
+   m_depth = 0;
+}
+
+void CFrameDumper::Submit ( const int8_t* pTV, const uint16_t* pTVIndex )
+{
+   std::unique_lock<std::mutex> lock ( m_mutex );
+   uint8_t* pFrame;
+
+   if ( (!m_pFile) || m_failed )
+   {
+      return;
+   }
+
+   if ( m_count == m_depth )
+   {
+      if ( m_dropWhenFull )
+      {
+         m_framesDropped++;
+         return;
+      }
+      m_written.wait ( lock, [this]{ return (m_count < m_depth) || m_failed; } );
+      if ( m_failed )
+      {
+         return;
+      }
+   }
+
+   // The writer never touches the slots past the ones queued.
+   pFrame = m_pFrames[(m_head+m_count)%m_depth];
+   if ( m_format == NES_FRAMEDUMP_RGBA )
+   {
+      memcpy ( pFrame, pTV, m_frameSize );
+   }
+   else
+   {
+      memcpy ( pFrame, pTVIndex, m_frameSize );
+   }
+   m_count++;
+
+   lock.unlock ();
+   m_queued.notify_one ();
+}
+
+void CFrameDumper::Writer ( void )
+{
+   std::unique_lock<std::mutex> lock ( m_mutex );
+   uint8_t* pFrame;
+   uint16_t* pIndex;
+   uint16_t index;
+   uint32_t idx;
+   bool ok;
+
+   for ( ; ; )
+   {
+      m_queued.wait ( lock, [this]{ return m_count || m_stopping; } );
+      if ( !m_count )
+      {
+         break;
+      }
+
+      pFrame = m_pFrames[m_head];
+      lock.unlock ();
+
+      // Tidy the frame up here rather than on the emulator thread.  The
+      // TV surface's fourth byte isn't drawn, and indexed frames are
+      // stored little-endian.
+      if ( m_format == NES_FRAMEDUMP_RGBA )
+      {
+         for ( idx = 3; idx < m_frameSize; idx += 4 )
+         {
+            pFrame[idx] = 0xFF;
+         }
+      }
+      else
+      {
+         pIndex = (uint16_t*)pFrame;
+         for ( idx = 0; idx < m_frameSize/2; idx++ )
+         {
+            index = pIndex[idx];
+            pFrame[(idx<<1)] = index&0xFF;
+            pFrame[(idx<<1)+1] = index>>8;
+         }
+      }
+
+      ok = (fwrite(pFrame,1,m_frameSize,m_pFile) == m_frameSize);
+
+      lock.lock ();
+      if ( ok )
+      {
+         m_framesWritten++;
+      }
+      else
+      {
+         // Nothing more can be written; let the emulator carry on.
+         m_failed = true;
+         m_framesDropped += m_count;
+         m_count = 1;
+      }
+      m_head = (m_head+1)%m_depth;
+      m_count--;
+      m_written.notify_one ();
+   }
+}
+
+uint32_t CFrameDumper::GetFramesWritten ( void )
+{
+   std::lock_guard<std::mutex> lock ( m_mutex );
+
+   return m_framesWritten;
+}
+
+uint32_t CFrameDumper::GetFramesDropped ( void )
+{
+   std::lock_guard<std::mutex> lock ( m_mutex );
+
+   return m_framesDropped;
+}
@@ -0,0 +1,82 @@
+#if !defined ( FRAMEDUMPER_H )
+#define FRAMEDUMPER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "nes_emulator_core.h"
+
+// The CFrameDumper class streams the frames the emulator draws to a file
+// or pipe without holding up the emulator.
+//
+// At the end of a frame the emulator copies it into a free slot of a small
+// queue and carries on; a writer thread of its own takes frames off the
+// queue and writes them out.  When the writer can't keep up and the queue
+// is full the emulator either waits for a free slot, which is what an
+// offline render wants, or drops the frame, which is what a player running
+// in real time wants.  Dropped frames are counted.
+//
+// Frames are written back to back with no header, as 256x240 pixels in one
+// of the NES_FRAMEDUMP_ formats.
+class CFrameDumper
+{
+public:
+   CFrameDumper();
+   ~CFrameDumper();
+
+   // Start dumping to a file, or to standard output if the file name is
+   // "-".  Any dump already going is stopped first.
+   bool Start ( const char* fileName, int32_t format, int32_t depth, bool dropWhenFull );
+
+   // Write out what is queued and close the file.
+   void Stop ( void );
+
+   inline bool IsRunning ( void ) const
+   {
+      return m_pFile != NULL;
+   }
+   inline int32_t GetFormat ( void ) const
+   {
+      return m_format;
+   }
+
+   // Emulator thread only.  Queue the frame just drawn.  The RGBA format
+   // takes it from the TV surface, the indexed format from the PPU's
+   // palette indexes.
+   void Submit ( const int8_t* pTV, const uint16_t* pTVIndex );
+
+   uint32_t GetFramesWritten ( void );
+   uint32_t GetFramesDropped ( void );
+
+protected:
+   void Writer ( void );
+   void Free ( void );
+
+   FILE*     m_pFile;
+   bool      m_closeFile;
+   int32_t   m_format;
+   uint32_t  m_frameSize;
+   bool      m_dropWhenFull;
+
+   // Queue of frames waiting to be written.  The writer owns the slot
+   // at m_head while it writes it out.
+   uint8_t** m_pFrames;
+   int32_t   m_depth;
+   int32_t   m_head;
+   int32_t   m_count;
+   bool      m_stopping;
+   bool      m_failed;
+   uint32_t  m_framesWritten;
+   uint32_t  m_framesDropped;
+
+   std::mutex              m_mutex;
+   std::condition_variable m_queued;
+   std::condition_variable m_written;
+   std::thread             m_writer;
+};
+
+#endif
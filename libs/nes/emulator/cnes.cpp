@@ -22,43 +22,70 @@
 #include "cnesio.h"
 #include "cnesapu.h"
 
-int32_t  CNES::m_videoMode = MODE_NTSC;
-int32_t  CNES::m_controllerType [] = { IO_StandardJoypad, IO_Zapper };
-int32_t  CNES::m_controllerPositionX [] = { 0, };
-int32_t  CNES::m_controllerPositionY [] = { 0, };
-int32_t  CNES::m_windowX1 = 0;
-int32_t  CNES::m_windowY1 = 0;
-int32_t  CNES::m_windowX2 = 0;
-int32_t  CNES::m_windowY2 = 0;
-
-bool     CNES::m_bReplay = false;
-bool     CNES::m_bRecord = true;
-uint32_t CNES::m_frame = 0;
-
-CTracer*         CNES::m_tracer = NULL;
-
-CBreakpointInfo* CNES::m_breakpoints;
-bool            CNES::m_bBreakpointsEnabled = true;
-bool            CNES::m_bAtBreakpoint = false;
-bool            CNES::m_bStepCPUBreakpoint = false;
-bool            CNES::m_bStepPPUBreakpoint = false;
-int32_t         CNES::m_ppuCycleToStepTo = -1;
-uint32_t        CNES::m_ppuFrameToStepTo = -1;
-
+NES_THREAD_LOCAL int32_t  CNES::m_videoMode = MODE_NTSC;
+NES_THREAD_LOCAL bool     CNES::m_bFrameSkip = false;
+NES_THREAD_LOCAL int32_t  CNES::m_controllerType [] = { IO_StandardJoypad, IO_Zapper };
+NES_THREAD_LOCAL int32_t  CNES::m_controllerPositionX [] = { 0, };
+NES_THREAD_LOCAL int32_t  CNES::m_controllerPositionY [] = { 0, };
+NES_THREAD_LOCAL int32_t  CNES::m_windowX1 = 0;
+NES_THREAD_LOCAL int32_t  CNES::m_windowY1 = 0;
+NES_THREAD_LOCAL int32_t  CNES::m_windowX2 = 0;
+NES_THREAD_LOCAL int32_t  CNES::m_windowY2 = 0;
+
+NES_THREAD_LOCAL bool     CNES::m_bReplay = false;
+NES_THREAD_LOCAL bool     CNES::m_bRecord = true;
+NES_THREAD_LOCAL uint32_t CNES::m_frame = 0;
+
+NES_THREAD_LOCAL CTracer*         CNES::m_tracer = NULL;
+
+NES_THREAD_LOCAL CRewind*         CNES::m_rewind = NULL;
+NES_THREAD_LOCAL CSnapshotBuffer* CNES::m_snapshots = NULL;
+NES_THREAD_LOCAL CFrameDumper*    CNES::m_frameDumper = NULL;
+
+NES_THREAD_LOCAL CBreakpointInfo* CNES::m_breakpoints;
+NES_THREAD_LOCAL bool            CNES::m_bBreakpointsEnabled = true;
+NES_THREAD_LOCAL int32_t         CNES::m_breakpointsVersion = -1;
+NES_THREAD_LOCAL bool            CNES::m_breakpointsHit = false;
+NES_THREAD_LOCAL uint32_t        CNES::m_breakpointTypes [ NUM_BREAKPOINT_TARGETS ] = { 0, };
+NES_THREAD_LOCAL uint32_t        CNES::m_breakpointEvents [ NUM_BREAKPOINT_TARGETS ] = { 0, };
+NES_THREAD_LOCAL int8_t          CNES::m_breakpointList [ NUM_BREAKPOINT_TARGETS ][ NUM_BREAKPOINT_TYPES ][ NUM_BREAKPOINTS+1 ];
+NES_THREAD_LOCAL uint8_t*        CNES::m_breakpointAddresses = NULL;
+NES_THREAD_LOCAL bool            CNES::m_bAtBreakpoint = false;
+NES_THREAD_LOCAL bool            CNES::m_bStepCPUBreakpoint = false;
+NES_THREAD_LOCAL bool            CNES::m_bStepPPUBreakpoint = false;
+NES_THREAD_LOCAL int32_t         CNES::m_ppuCycleToStepTo = -1;
+NES_THREAD_LOCAL uint32_t        CNES::m_ppuFrameToStepTo = -1;
+
+#if !defined ( NES_MULTI_INSTANCE )
 static CNES __init __attribute__((unused));
+#endif
 
 CNES::CNES()
 {
    m_breakpoints = new CNESBreakpointInfo();
+   m_breakpointAddresses = new uint8_t [ MEM_64KB ];
 
    m_tracer = new CTracer();
+
+   m_rewind = new CRewind();
+
+   m_snapshots = new CSnapshotBuffer();
+
+   m_frameDumper = new CFrameDumper();
 }
 
 CNES::~CNES()
 {
    delete m_breakpoints;
+   delete [] m_breakpointAddresses;
 
    delete m_tracer;
+
+   delete m_rewind;
+
+   delete m_snapshots;
+
+   delete m_frameDumper;
 }
 
 uint8_t CNES::_MEM ( uint32_t addr )
@@ -276,6 +303,12 @@ void CNES::RESET ( uint32_t mapper, bool soft )
       C6502::MARKERS()->ZeroAllMarkers();
    }
 
+   // NES 2.0 mapper numbers go past the mappers there are, run those as NROM.
+   if ( mapper >= NUM_MAPPERS )
+   {
+      mapper = 0;
+   }
+
    // Reset mapper and set up quick access pointer to mapper function table.
    MAPPERFUNC = &(_mapperfunc[mapper]);
    MAPPERFUNC->reset ( soft );
@@ -291,6 +324,34 @@ void CNES::RESET ( uint32_t mapper, bool soft )
    m_frame = 0;
 }
 
+void CNES::STATE ( CSaveState& state )
+{
+   if ( state.BeginChunk(SAVESTATE_TAG('N','E','S',' '),1) )
+   {
+      state.Value ( m_frame );
+
+      // Only the controllers' latches are saved; the logged input
+      // belongs to the recording, not to the machine.
+      CIOTurboJoypad::STATE ( state );
+      CIOVaus::STATE ( state );
+
+      state.EndChunk ();
+   }
+
+   C6502::STATE ( state );
+   CPPU::STATE ( state );
+   CAPU::STATE ( state );
+
+   // The mapper saves the cartridge memories along with its own registers.
+   MAPPERFUNC->state ( state );
+
+   if ( state.IsLoading() )
+   {
+      // The restored banks need to be put back in the CPU's memory map.
+      C6502::REMAP ();
+   }
+}
+
 void CNES::STEPCPUBREAKPOINT ( void )
 {
    m_bStepCPUBreakpoint = true;
@@ -311,16 +372,567 @@ void CNES::STEPPPUBREAKPOINT ( bool goFrame )
    }
 }
 
-void CNES::CHECKBREAKPOINT ( eBreakpointTarget target, eBreakpointType type, int32_t data, int32_t event )
+#if !defined ( NES_NO_DEBUG )
+// Breakpoint address map bits.  An address has a bit set if it is within
+// the address range and mask of at least one breakpoint of that kind.
+#define BREAKPOINT_ADDR_EXECUTION 0x01
+#define BREAKPOINT_ADDR_READ      0x02
+#define BREAKPOINT_ADDR_WRITE     0x04
+#define BREAKPOINT_ADDR_PPUFETCH  0x08
+
+static inline bool breakpointAddressMatches ( BreakpointInfo* pBreakpoint, uint32_t addr )
+{
+   return (addr >= pBreakpoint->item1) &&
+          (addr <= pBreakpoint->item2) &&
+          (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+           ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0)));
+}
+
+void CNES::COMPILEBREAKPOINTS ( void )
 {
-   int32_t idx;
    BreakpointInfo* pBreakpoint;
+   int32_t  numListed [ NUM_BREAKPOINT_TARGETS ][ NUM_BREAKPOINT_TYPES ];
+   int32_t  idx;
+   int32_t  target;
+   int32_t  type;
+   uint32_t addr;
+   uint8_t  addrBits;
+
+   m_breakpointsVersion = m_breakpoints->GetVersion();
+
+   memset ( numListed, 0, sizeof(numListed) );
+   memset ( m_breakpointTypes, 0, sizeof(m_breakpointTypes) );
+   memset ( m_breakpointEvents, 0, sizeof(m_breakpointEvents) );
+   memset ( m_breakpointAddresses, 0, MEM_64KB );
+
+   for ( idx = 0; idx < m_breakpoints->GetNumBreakpoints(); idx++ )
+   {
+      pBreakpoint = m_breakpoints->GetBreakpoint(idx);
+
+      target = pBreakpoint->target;
+      type = pBreakpoint->type;
+      if ( (!pBreakpoint->enabled) ||
+           (target < 0) || (target >= NUM_BREAKPOINT_TARGETS) ||
+           (type < 0) || (type >= NUM_BREAKPOINT_TYPES) )
+      {
+         continue;
+      }
+
+      // List the breakpoint under each kind of check that can hit it.
+      // "Access" breakpoints are hit by both reads and writes.
+      m_breakpointList[target][type][numListed[target][type]++] = idx;
+      m_breakpointTypes[target] |= (1<<type);
+      if ( type == eBreakOnCPUMemoryAccess )
+      {
+         m_breakpointList[target][eBreakOnCPUMemoryRead][numListed[target][eBreakOnCPUMemoryRead]++] = idx;
+         m_breakpointList[target][eBreakOnCPUMemoryWrite][numListed[target][eBreakOnCPUMemoryWrite]++] = idx;
+         m_breakpointTypes[target] |= (1<<eBreakOnCPUMemoryRead)|(1<<eBreakOnCPUMemoryWrite);
+      }
+      else if ( type == eBreakOnOAMPortalAccess )
+      {
+         m_breakpointList[target][eBreakOnOAMPortalRead][numListed[target][eBreakOnOAMPortalRead]++] = idx;
+         m_breakpointList[target][eBreakOnOAMPortalWrite][numListed[target][eBreakOnOAMPortalWrite]++] = idx;
+         m_breakpointTypes[target] |= (1<<eBreakOnOAMPortalRead)|(1<<eBreakOnOAMPortalWrite);
+      }
+      else if ( type == eBreakOnPPUPortalAccess )
+      {
+         m_breakpointList[target][eBreakOnPPUPortalRead][numListed[target][eBreakOnPPUPortalRead]++] = idx;
+         m_breakpointList[target][eBreakOnPPUPortalWrite][numListed[target][eBreakOnPPUPortalWrite]++] = idx;
+         m_breakpointTypes[target] |= (1<<eBreakOnPPUPortalRead)|(1<<eBreakOnPPUPortalWrite);
+      }
+
+      // Event breakpoints are only looked at for their own event.
+      if ( ((type == eBreakOnCPUEvent) ||
+            (type == eBreakOnPPUEvent) ||
+            (type == eBreakOnAPUEvent) ||
+            (type == eBreakOnMapperEvent)) &&
+           (pBreakpoint->event >= 0) && (pBreakpoint->event < 32) )
+      {
+         m_breakpointEvents[target] |= (1<<pBreakpoint->event);
+      }
+
+      // Address breakpoints are only looked at for addresses they can hit.
+      switch ( type )
+      {
+         case eBreakOnCPUExecution:
+            addrBits = BREAKPOINT_ADDR_EXECUTION;
+            break;
+         case eBreakOnCPUMemoryAccess:
+            addrBits = BREAKPOINT_ADDR_READ|BREAKPOINT_ADDR_WRITE;
+            break;
+         case eBreakOnCPUMemoryRead:
+            addrBits = BREAKPOINT_ADDR_READ;
+            break;
+         case eBreakOnCPUMemoryWrite:
+            addrBits = BREAKPOINT_ADDR_WRITE;
+            break;
+         case eBreakOnPPUFetch:
+            addrBits = BREAKPOINT_ADDR_PPUFETCH;
+            break;
+         default:
+            addrBits = 0;
+            break;
+      }
+      if ( addrBits )
+      {
+         for ( addr = pBreakpoint->item1; (addr <= pBreakpoint->item2) && (addr < MEM_64KB); addr++ )
+         {
+            if ( breakpointAddressMatches(pBreakpoint,addr) )
+            {
+               m_breakpointAddresses[addr] |= addrBits;
+            }
+         }
+      }
+   }
+
+   for ( target = 0; target < NUM_BREAKPOINT_TARGETS; target++ )
+   {
+      for ( type = 0; type < NUM_BREAKPOINT_TYPES; type++ )
+      {
+         m_breakpointList[target][type][numListed[target][type]] = -1;
+      }
+   }
+}
+
+bool CNES::EVALUATEBREAKPOINT ( BreakpointInfo* pBreakpoint, int32_t data, int32_t event )
+{
    CRegisterData* pRegister;
    CBitfieldData* pBitfield;
    uint32_t addr = 0;
    uint32_t absAddr = 0;
    int32_t value = 0;
-   bool force = false;
+
+   switch ( pBreakpoint->type )
+   {
+      case eBreakOnPPUCycle:
+         // Nothing to do here; make the warning go away...
+         break;
+      case eBreakOnCPUExecution:
+         addr = C6502::__PCSYNC();
+         absAddr = CNES::ABSADDR(C6502::__PCSYNC());
+
+         if ( pBreakpoint->item1 == pBreakpoint->item2 )
+         {
+            if ( ((absAddr == (uint32_t)-1) || (absAddr == pBreakpoint->item1Absolute)) &&
+                 (addr >= pBreakpoint->item1) &&
+                 (addr <= pBreakpoint->item2) &&
+                 (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+                  ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
+            {
+               pBreakpoint->itemActual = addr;
+               pBreakpoint->hit = true;
+            }
+         }
+         else
+         {
+            if ( (addr >= pBreakpoint->item1) &&
+                 (addr <= pBreakpoint->item2) &&
+                 (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+                  ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
+            {
+               pBreakpoint->itemActual = addr;
+               pBreakpoint->hit = true;
+            }
+         }
+         break;
+      case eBreakOnCPUMemoryAccess:
+      case eBreakOnCPUMemoryRead:
+      case eBreakOnCPUMemoryWrite:
+         addr = C6502::_EA();
+
+         if ( (addr >= pBreakpoint->item1) &&
+              (addr <= pBreakpoint->item2) &&
+              (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+               ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
+         {
+            pBreakpoint->itemActual = addr;
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (data == pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (data != pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (data < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (data > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (data&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (data&pBreakpoint->data) &&
+                      ((data&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnCPUState:
+
+         // Is the breakpoint on this register?
+         if ( pBreakpoint->item1 == (uint32_t)data )
+         {
+            pRegister = C6502::REGISTERS()->GetRegister(pBreakpoint->item1);
+            pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
+
+            // Get actual register data...
+            switch ( pBreakpoint->item1 )
+            {
+               case CPU_PC:
+                  value = C6502::__PC();
+                  break;
+               case CPU_A:
+                  value = C6502::_A();
+                  break;
+               case CPU_X:
+                  value = C6502::_X();
+                  break;
+               case CPU_Y:
+                  value = C6502::_Y();
+                  break;
+               case CPU_SP:
+                  value = C6502::_SP();
+                  break;
+               case CPU_F:
+                  value = C6502::_F();
+                  break;
+            }
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
+                      ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnOAMPortalAccess:
+      case eBreakOnOAMPortalRead:
+      case eBreakOnOAMPortalWrite:
+         addr = CPPU::_OAMADDR();
+
+         if ( (addr >= pBreakpoint->item1) &&
+              (addr <= pBreakpoint->item2) &&
+              (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+               ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
+         {
+            pBreakpoint->itemActual = addr;
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (data == pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (data != pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (data < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (data > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (data&pBreakpoint->data) &&
+                      ((data&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (data&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnPPUFetch:
+      case eBreakOnPPUPortalAccess:
+      case eBreakOnPPUPortalRead:
+      case eBreakOnPPUPortalWrite:
+         addr = CPPU::_PPUADDR();
+
+         if ( (addr >= pBreakpoint->item1) &&
+              (addr <= pBreakpoint->item2) &&
+              (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
+               ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
+         {
+            pBreakpoint->itemActual = addr;
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (data == pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (data != pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (data < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (data > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (data&pBreakpoint->data) &&
+                      ((data&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (data&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnPPUState:
+
+         // Is the breakpoint on this register?
+         if ( pBreakpoint->item1 == (uint32_t)data )
+         {
+            pRegister = CPPU::REGISTERS()->GetRegister(pBreakpoint->item1);
+            pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
+
+            // Get actual register data...
+            value = CPPU::_PPU(pRegister->GetAddr());
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
+                      ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnAPUState:
+
+         // Is the breakpoint on this register?
+         if ( pBreakpoint->item1 == (uint32_t)data )
+         {
+            pRegister = CAPU::REGISTERS()->GetRegister(pBreakpoint->item1);
+            pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
+
+            // Get actual register data...
+            value = CAPU::_APU(pRegister->GetAddr());
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
+                      ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnMapperState:
+
+         // Is the breakpoint on this register?
+         if ( pBreakpoint->item1 == (uint32_t)data )
+         {
+            pRegister = CROM::REGISTERS()->GetRegister(pBreakpoint->item1);
+            pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
+
+            // Get actual register data...
+            if ( pRegister->GetAddr() >= MEM_32KB )
+            {
+               value = MAPPERFUNC->debuginfo(pRegister->GetAddr());
+            }
+            else
+            {
+               value = MAPPERFUNC->debuginfo(pRegister->GetAddr());
+            }
+
+            if ( pBreakpoint->condition == eBreakIfAnything )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfEqual) &&
+                      (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
+                      (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
+                      (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
+                      (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
+                      ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
+            {
+               pBreakpoint->hit = true;
+            }
+            else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
+                      (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
+            {
+               pBreakpoint->hit = true;
+            }
+         }
+
+         break;
+      case eBreakOnCPUEvent:
+      case eBreakOnPPUEvent:
+      case eBreakOnAPUEvent:
+      case eBreakOnMapperEvent:
+
+         // If this is the right event to check, check it...
+         if ( pBreakpoint->event == event )
+         {
+            pBreakpoint->hit = pBreakpoint->pEvent->Evaluate(pBreakpoint,data);
+         }
+
+         break;
+   }
+
+   return pBreakpoint->hit;
+}
+
+void CNES::EVALUATEBREAKPOINTS ( eBreakpointTarget target, eBreakpointType type, int32_t data, int32_t event )
+{
+   int8_t*  pList;
+   uint32_t addr;
+   uint8_t  addrBits = 0;
+   int32_t  idx;
+   bool     force = false;
 
    // If stepping, break...
    if ( (m_bStepCPUBreakpoint) &&
@@ -343,519 +955,72 @@ void CNES::CHECKBREAKPOINT ( eBreakpointTarget target, eBreakpointType type, int
    // For all breakpoints...if we're not stepping...
    else
    {
-      for ( idx = 0; idx < m_breakpoints->GetNumBreakpoints(); idx++ )
+      if ( m_breakpointsVersion != m_breakpoints->GetVersion() )
       {
-         // Get breakpoint data...
-         pBreakpoint = m_breakpoints->GetBreakpoint(idx);
-
-         // Not hit yet...
-         pBreakpoint->hit = false;
+         COMPILEBREAKPOINTS ();
+      }
 
-         // Is this breakpoint enabled?
-         if ( pBreakpoint->enabled )
+      // A breakpoint only shows as hit until the next check.
+      if ( m_breakpointsHit )
+      {
+         for ( idx = 0; idx < m_breakpoints->GetNumBreakpoints(); idx++ )
          {
-            // Are there any for the specified target?
-            if ( pBreakpoint->target == target )
+            m_breakpoints->GetBreakpoint(idx)->hit = false;
+         }
+         m_breakpointsHit = false;
+      }
+
+      if ( ((uint32_t)target >= NUM_BREAKPOINT_TARGETS) ||
+           ((uint32_t)type >= NUM_BREAKPOINT_TYPES) ||
+           (!(m_breakpointTypes[target]&(1<<type))) )
+      {
+         return;
+      }
+
+      switch ( type )
+      {
+         case eBreakOnCPUExecution:
+            addr = C6502::__PCSYNC();
+            addrBits = BREAKPOINT_ADDR_EXECUTION;
+            break;
+         case eBreakOnCPUMemoryRead:
+            addr = C6502::_EA();
+            addrBits = BREAKPOINT_ADDR_READ;
+            break;
+         case eBreakOnCPUMemoryWrite:
+            addr = C6502::_EA();
+            addrBits = BREAKPOINT_ADDR_WRITE;
+            break;
+         case eBreakOnPPUFetch:
+            addr = CPPU::_PPUADDR();
+            addrBits = BREAKPOINT_ADDR_PPUFETCH;
+            break;
+         case eBreakOnCPUEvent:
+         case eBreakOnPPUEvent:
+         case eBreakOnAPUEvent:
+         case eBreakOnMapperEvent:
+            if ( (event < 0) || (event >= 32) ||
+                 (!(m_breakpointEvents[target]&(1<<event))) )
             {
-               // Promote "Access" types...
-               if ( (pBreakpoint->type == eBreakOnCPUMemoryAccess) &&
-                     ((type == eBreakOnCPUMemoryRead) || (type == eBreakOnCPUMemoryWrite)) )
-               {
-                  type = eBreakOnCPUMemoryAccess;
-               }
-
-               if ( (pBreakpoint->type == eBreakOnOAMPortalAccess) &&
-                     ((type == eBreakOnOAMPortalRead) || (type == eBreakOnOAMPortalWrite)) )
-               {
-                  type = eBreakOnOAMPortalAccess;
-               }
-
-               if ( (pBreakpoint->type == eBreakOnPPUPortalAccess) &&
-                     ((type == eBreakOnPPUPortalRead) || (type == eBreakOnPPUPortalWrite)) )
-               {
-                  type = eBreakOnPPUPortalAccess;
-               }
-
-               if ( pBreakpoint->type == type )
-               {
-                  switch ( pBreakpoint->type )
-                  {
-                     case eBreakOnPPUCycle:
-                        // Nothing to do here; make the warning go away...
-                        break;
-                     case eBreakOnCPUExecution:
-                        addr = C6502::__PCSYNC();
-                        absAddr = CNES::ABSADDR(C6502::__PCSYNC());
-
-                        if ( pBreakpoint->item1 == pBreakpoint->item2 )
-                        {
-                           if ( ((absAddr == (uint32_t)-1) || (absAddr == pBreakpoint->item1Absolute)) &&
-                                (addr >= pBreakpoint->item1) &&
-                                (addr <= pBreakpoint->item2) &&
-                                (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
-                                 ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
-                           {
-                              pBreakpoint->itemActual = addr;
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-                        else
-                        {
-                           if ( (addr >= pBreakpoint->item1) &&
-                                (addr <= pBreakpoint->item2) &&
-                                (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
-                                 ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
-                           {
-                              pBreakpoint->itemActual = addr;
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-                        break;
-                     case eBreakOnCPUMemoryAccess:
-                     case eBreakOnCPUMemoryRead:
-                     case eBreakOnCPUMemoryWrite:
-                        addr = C6502::_EA();
-
-                        if ( (addr >= pBreakpoint->item1) &&
-                             (addr <= pBreakpoint->item2) &&
-                             (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
-                              ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
-                        {
-                           pBreakpoint->itemActual = addr;
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (data == pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (data != pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (data < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (data > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (data&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (data&pBreakpoint->data) &&
-                                     ((data&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnCPUState:
-
-                        // Is the breakpoint on this register?
-                        if ( pBreakpoint->item1 == (uint32_t)data )
-                        {
-                           pRegister = C6502::REGISTERS()->GetRegister(pBreakpoint->item1);
-                           pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
-
-                           // Get actual register data...
-                           switch ( pBreakpoint->item1 )
-                           {
-                              case CPU_PC:
-                                 value = C6502::__PC();
-                                 break;
-                              case CPU_A:
-                                 value = C6502::_A();
-                                 break;
-                              case CPU_X:
-                                 value = C6502::_X();
-                                 break;
-                              case CPU_Y:
-                                 value = C6502::_Y();
-                                 break;
-                              case CPU_SP:
-                                 value = C6502::_SP();
-                                 break;
-                              case CPU_F:
-                                 value = C6502::_F();
-                                 break;
-                           }
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
-                                     ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnOAMPortalAccess:
-                     case eBreakOnOAMPortalRead:
-                     case eBreakOnOAMPortalWrite:
-                        addr = CPPU::_OAMADDR();
-
-                        if ( (addr >= pBreakpoint->item1) &&
-                             (addr <= pBreakpoint->item2) &&
-                             (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
-                              ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
-                        {
-                           pBreakpoint->itemActual = addr;
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (data == pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (data != pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (data < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (data > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (data&pBreakpoint->data) &&
-                                     ((data&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (data&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnPPUFetch:
-                     case eBreakOnPPUPortalAccess:
-                     case eBreakOnPPUPortalRead:
-                     case eBreakOnPPUPortalWrite:
-                        addr = CPPU::_PPUADDR();
-
-                        if ( (addr >= pBreakpoint->item1) &&
-                             (addr <= pBreakpoint->item2) &&
-                             (((!pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask)) ||
-                              ((pBreakpoint->itemMaskExclusive) && (addr&pBreakpoint->itemMask) && ((addr&(~pBreakpoint->itemMask)) == 0))) )
-                        {
-                           pBreakpoint->itemActual = addr;
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (data == pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (data != pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (data < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (data > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (data&pBreakpoint->data) &&
-                                     ((data&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (data&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnPPUState:
-
-                        // Is the breakpoint on this register?
-                        if ( pBreakpoint->item1 == (uint32_t)data )
-                        {
-                           pRegister = CPPU::REGISTERS()->GetRegister(pBreakpoint->item1);
-                           pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
-
-                           // Get actual register data...
-                           value = CPPU::_PPU(pRegister->GetAddr());
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
-                                     ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnAPUState:
-
-                        // Is the breakpoint on this register?
-                        if ( pBreakpoint->item1 == (uint32_t)data )
-                        {
-                           pRegister = CAPU::REGISTERS()->GetRegister(pBreakpoint->item1);
-                           pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
-
-                           // Get actual register data...
-                           value = CAPU::_APU(pRegister->GetAddr());
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
-                                     ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnMapperState:
-
-                        // Is the breakpoint on this register?
-                        if ( pBreakpoint->item1 == (uint32_t)data )
-                        {
-                           pRegister = CROM::REGISTERS()->GetRegister(pBreakpoint->item1);
-                           pBitfield = pRegister->GetBitfield(pBreakpoint->item2);
-
-                           // Get actual register data...
-                           if ( pRegister->GetAddr() >= MEM_32KB )
-                           {
-                              value = MAPPERFUNC->debuginfo(pRegister->GetAddr());
-                           }
-                           else
-                           {
-                              value = MAPPERFUNC->debuginfo(pRegister->GetAddr());
-                           }
-
-                           if ( pBreakpoint->condition == eBreakIfAnything )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfEqual) &&
-                                     (pBreakpoint->data == pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfNotEqual) &&
-                                     (pBreakpoint->data != pBitfield->GetValueRaw(value)) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfLessThan) &&
-                                     (pBitfield->GetValueRaw(value) < pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfGreaterThan) &&
-                                     (pBitfield->GetValueRaw(value) > pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfExclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) &&
-                                     ((pBitfield->GetValueRaw(value)&(~pBreakpoint->data)) == 0) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                           else if ( (pBreakpoint->condition == eBreakIfInclusiveMask) &&
-                                     (pBitfield->GetValueRaw(value)&pBreakpoint->data) )
-                           {
-                              pBreakpoint->hit = true;
-                              force = true;
-                           }
-                        }
-
-                        break;
-                     case eBreakOnCPUEvent:
-                     case eBreakOnPPUEvent:
-                     case eBreakOnAPUEvent:
-                     case eBreakOnMapperEvent:
-
-                        // If this is the right event to check, check it...
-                        if ( pBreakpoint->event == event )
-                        {
-                           pBreakpoint->hit = pBreakpoint->pEvent->Evaluate(pBreakpoint,data);
-
-                           if ( pBreakpoint->hit )
-                           {
-                              force = true;
-                           }
-                        }
-
-                        break;
-                  }
-               }
+               return;
             }
+            break;
+         default:
+            break;
+      }
+      if ( addrBits &&
+           (addr < MEM_64KB) &&
+           (!(m_breakpointAddresses[addr]&addrBits)) )
+      {
+         return;
+      }
+
+      for ( pList = m_breakpointList[target][type]; (*pList) >= 0; pList++ )
+      {
+         if ( EVALUATEBREAKPOINT(m_breakpoints->GetBreakpoint(*pList),data,event) )
+         {
+            m_breakpointsHit = true;
+            force = true;
          }
       }
    }
@@ -865,6 +1030,7 @@ void CNES::CHECKBREAKPOINT ( eBreakpointTarget target, eBreakpointType type, int
       FORCEBREAKPOINT();
    }
 }
+#endif
 
 void CNES::FORCEBREAKPOINT ( void )
 {
@@ -978,6 +1144,12 @@ void CNES::RUN ( uint32_t* joy )
    // Do scanline processing for scanlines 0 - 239 (the screen!)...
    CPPU::RENDERSCANLINE ( SCANLINES_VISIBLE );
 
+   // The frame is drawn; turn it into RGB for whoever is showing it...
+   if ( !CNES::FRAMESKIP() )
+   {
+      CPPU::EXPANDTV ();
+   }
+
 #if 0
 
 // CPTODO: move this to ide...
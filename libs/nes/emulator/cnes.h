@@ -4,9 +4,17 @@
 #include "ctracer.h"
 #include "cjoypadlogger.h"
 #include "cnesbreakpointinfo.h"
+#include "csavestate.h"
+#include "crewind.h"
+#include "csnapshotbuffer.h"
+#include "cframedumper.h"
 
 #include "nes_emulator_core.h"
 
+// Sizes of the compiled breakpoint tables.
+#define NUM_BREAKPOINT_TARGETS (eBreakInMapper+1)
+#define NUM_BREAKPOINT_TYPES   (eBreakOnPPUCycle+1)
+
 // The CNES class is the implementation of the NES as a complete
 // emulatable machine.  It contains a RUN method which is used
 // to drive the other objects (CPPU, C6502, CAPU, CROM) through
@@ -51,6 +59,18 @@ public:
       return m_videoMode;
    }
 
+   // Accessor methods to get/set whether the frames being emulated
+   // will be shown.  Skipped frames are emulated completely but their
+   // pixels are not drawn and their audio samples are not kept.
+   static inline void FRAMESKIP ( bool skip )
+   {
+      m_bFrameSkip = skip;
+   }
+   static inline bool FRAMESKIP ( void )
+   {
+      return m_bFrameSkip;
+   }
+
    // Accessor methods to get/set the controller type.
    static inline void CONTROLLER ( int32_t port, int32_t type )
    {
@@ -92,6 +112,11 @@ public:
    // intercepted keypress/keyrelease events in the UI.
    static void RUN ( uint32_t* joy );
 
+   // This method saves or restores the complete state of the
+   // emulated NES.  It is only valid between calls to RUN, at
+   // which point every object is at a frame boundary.
+   static void STATE ( CSaveState& state );
+
    // Accessor methods to get/set whether or not the emulation
    // engine is in replay mode.  In replay mode the emulation runs
    // as normal but the joypad inputs are fed in from previously
@@ -134,6 +159,27 @@ public:
       return m_tracer;
    }
 
+   // Accessor method to retrieve the rewind history.  Snapshots are
+   // added to it between frames by the emulator core interface.
+   static inline CRewind* REWIND ( void )
+   {
+      return m_rewind;
+   }
+
+   // Accessor method to retrieve the snapshots published for the
+   // debuggers by the emulator core interface.
+   static inline CSnapshotBuffer* SNAPSHOTS ( void )
+   {
+      return m_snapshots;
+   }
+
+   // Accessor method to retrieve the dump of the frames drawn.  Frames
+   // are handed to it between frames by the emulator core interface.
+   static inline CFrameDumper* FRAMEDUMPER ( void )
+   {
+      return m_frameDumper;
+   }
+
    // This method globally enables or disables breakpoints.  It is used
    // during an emulation hard-reset (which is caused whenever a new
    // ROM image is loaded) to prevent the emulation engine from getting
@@ -152,7 +198,23 @@ public:
    // This method is invoked by objects within the emulation engine (CNES,
    // C6502, CPPU, CAPU, CROM) to allow the emulation engine to halt itself
    // if a breakpoint is encountered.
-   static void CHECKBREAKPOINT ( eBreakpointTarget target, eBreakpointType type = (eBreakpointType)-1, int32_t data = 0, int32_t event = 0 );
+   // The breakpoints are compiled into lookup tables so the many checks for
+   // kinds of breakpoint that aren't set cost next to nothing.
+#if defined ( NES_NO_DEBUG )
+   static inline void CHECKBREAKPOINT ( eBreakpointTarget, eBreakpointType = (eBreakpointType)-1, int32_t = 0, int32_t = 0 ) {}
+#else
+   static inline void CHECKBREAKPOINT ( eBreakpointTarget target, eBreakpointType type = (eBreakpointType)-1, int32_t data = 0, int32_t event = 0 )
+   {
+      if ( m_bStepCPUBreakpoint ||
+           m_bStepPPUBreakpoint ||
+           m_breakpointsHit ||
+           (m_breakpointsVersion != m_breakpoints->GetVersion()) ||
+           (((uint32_t)type < NUM_BREAKPOINT_TYPES) && (m_breakpointTypes[target]&(1<<type))) )
+      {
+         EVALUATEBREAKPOINTS ( target, type, data, event );
+      }
+   }
+#endif
 
    // This method forces the emulation engine into breakpoint territory;
    // the emulation is halted, a breakpoint-watching thread is released,
@@ -196,42 +258,70 @@ public:
 protected:
    // Whether or not joypad input is being fed from the user or from
    // previously recorded emulation runs.
-   static bool         m_bReplay;
+   static NES_THREAD_LOCAL bool         m_bReplay;
 
    // Whether or not joypad input is being recorded during this emulation run.
-   static bool         m_bRecord;
+   static NES_THREAD_LOCAL bool         m_bRecord;
 
    // NTSC, or PAL?
-   static int32_t             m_videoMode;
+   static NES_THREAD_LOCAL int32_t             m_videoMode;
+
+   // Is the current frame being skipped?
+   static NES_THREAD_LOCAL bool                m_bFrameSkip;
 
    // Controller type information
-   static int32_t  m_controllerType [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL int32_t  m_controllerType [ NUM_CONTROLLERS ];
 
    // Controller screen position information (for things like zapper)
-   static int32_t  m_controllerPositionX [ NUM_CONTROLLERS ];
-   static int32_t  m_controllerPositionY [ NUM_CONTROLLERS ];
-   static int32_t  m_windowX1;
-   static int32_t  m_windowY1;
-   static int32_t  m_windowX2;
-   static int32_t  m_windowY2;
+   static NES_THREAD_LOCAL int32_t  m_controllerPositionX [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL int32_t  m_controllerPositionY [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL int32_t  m_windowX1;
+   static NES_THREAD_LOCAL int32_t  m_windowY1;
+   static NES_THREAD_LOCAL int32_t  m_windowX2;
+   static NES_THREAD_LOCAL int32_t  m_windowY2;
 
    // The execution tracer database.
-   static CTracer*         m_tracer;
+   static NES_THREAD_LOCAL CTracer*         m_tracer;
+
+   // The rewind history.
+   static NES_THREAD_LOCAL CRewind*         m_rewind;
+
+   // The snapshots published for the debuggers.
+   static NES_THREAD_LOCAL CSnapshotBuffer* m_snapshots;
+
+   // The dump of the frames drawn.
+   static NES_THREAD_LOCAL CFrameDumper*    m_frameDumper;
 
    // This is the database of active breakpoints.
-   static CBreakpointInfo* m_breakpoints;
-   static bool m_bBreakpointsEnabled;
+   static NES_THREAD_LOCAL CBreakpointInfo* m_breakpoints;
+   static NES_THREAD_LOCAL bool m_bBreakpointsEnabled;
+
+   // The breakpoint database compiled for quick lookup.  For each target
+   // and kind of check there's a bitmask of the kinds that have enabled
+   // breakpoints and a list of them, ended by -1.  Event breakpoints also
+   // have a bitmask of the events they're on, and address breakpoints a
+   // map of the addresses they can hit.  The compiled tables are rebuilt
+   // when the database's version changes.
+   static void COMPILEBREAKPOINTS ( void );
+   static void EVALUATEBREAKPOINTS ( eBreakpointTarget target, eBreakpointType type, int32_t data, int32_t event );
+   static bool EVALUATEBREAKPOINT ( BreakpointInfo* pBreakpoint, int32_t data, int32_t event );
+   static NES_THREAD_LOCAL int32_t  m_breakpointsVersion;
+   static NES_THREAD_LOCAL bool     m_breakpointsHit;
+   static NES_THREAD_LOCAL uint32_t m_breakpointTypes [ NUM_BREAKPOINT_TARGETS ];
+   static NES_THREAD_LOCAL uint32_t m_breakpointEvents [ NUM_BREAKPOINT_TARGETS ];
+   static NES_THREAD_LOCAL int8_t   m_breakpointList [ NUM_BREAKPOINT_TARGETS ][ NUM_BREAKPOINT_TYPES ][ NUM_BREAKPOINTS+1 ];
+   static NES_THREAD_LOCAL uint8_t* m_breakpointAddresses;
 
    // These flags determine the breakpoint state and behavior
    // of the emulation engine.
-   static bool            m_bAtBreakpoint;
-   static bool            m_bStepCPUBreakpoint;
-   static bool            m_bStepPPUBreakpoint;
-   static int32_t         m_ppuCycleToStepTo;
-   static uint32_t        m_ppuFrameToStepTo;
+   static NES_THREAD_LOCAL bool            m_bAtBreakpoint;
+   static NES_THREAD_LOCAL bool            m_bStepCPUBreakpoint;
+   static NES_THREAD_LOCAL bool            m_bStepPPUBreakpoint;
+   static NES_THREAD_LOCAL int32_t         m_ppuCycleToStepTo;
+   static NES_THREAD_LOCAL uint32_t        m_ppuFrameToStepTo;
 
    // Emulation frame counter...a copy of CPPU::m_frame;
-   static uint32_t m_frame;
+   static NES_THREAD_LOCAL uint32_t m_frame;
 };
 
 #endif
@@ -161,54 +161,63 @@ static CBreakpointEventInfo* tblCPUEvents [] =
 CBreakpointEventInfo** C6502::m_tblBreakpointEvents = tblCPUEvents;
 int32_t                C6502::m_numBreakpointEvents = NUM_CPU_EVENTS;
 
-bool            C6502::m_killed = false;              // KIL opcode not executed.
-bool            C6502::m_breakOnKIL = false;          // IDE sets this for us.
-bool            C6502::m_irqAsserted = false;
-int32_t         C6502::m_instrCycle = 0;
-bool            C6502::m_irqPending = false;
-bool            C6502::m_nmiAsserted = false;
-bool            C6502::m_nmiPending = false;
-uint8_t         C6502::m_openBusData = 0x00;
-uint8_t*  C6502::m_6502memory = NULL;
-uint8_t   C6502::m_a = 0x00;
-uint8_t   C6502::m_x = 0x00;
-uint8_t   C6502::m_y = 0x00;
-uint8_t   C6502::m_f = FLAG_MISC;
-uint16_t  C6502::m_pc = VECTOR_RESET;
-uint16_t  C6502::m_pcSync = VECTOR_RESET;
-bool      C6502::m_pcSyncSet = false;
-uint32_t    C6502::m_ea = 0;
-uint32_t            C6502::m_pcGoto = 0xFFFFFFFF;
-uint8_t   C6502::m_sp = 0x00;
-
-uint32_t    C6502::m_cycles = 0;
-int32_t         C6502::m_curCycles = 0;
-
-uint16_t C6502::m_writeDmaAddr = 0x0000;
-int32_t  C6502::m_writeDmaCounter = 0;
-uint16_t C6502::m_readDmaAddr = 0x0000;
-int32_t     C6502::m_dmaRequest = -1;
-int32_t  C6502::m_readDmaCounter = 0;
-
-int32_t         C6502::amode;
-uint8_t*  C6502::data = NULL;
-uint8_t   C6502::opcodeData [ 4 ]; // 3 opcode bytes and 1 byte for operand return data [extra cycle]
-struct _CNES6502_opcode* C6502::pOpcodeStruct = NULL;
-int32_t         C6502::opcodeSize;
-bool            C6502::m_write = false;
-int8_t            C6502::m_phase = 0;
-
-TracerInfo*      C6502::pDisassemblySample = NULL;
-
-CMarker*         C6502::m_marker = NULL;
-
-CCodeDataLogger* C6502::m_logger = NULL;
-
-uint8_t*   C6502::m_RAMopcodeMask = NULL;
-char**     C6502::m_RAMdisassembly = NULL;
-uint16_t*  C6502::m_RAMsloc2addr = NULL;
-uint16_t*  C6502::m_RAMaddr2sloc = NULL;
-uint32_t   C6502::m_RAMsloc = 0;
+NES_THREAD_LOCAL bool            C6502::m_killed = false;              // KIL opcode not executed.
+NES_THREAD_LOCAL bool            C6502::m_breakOnKIL = false;          // IDE sets this for us.
+NES_THREAD_LOCAL bool            C6502::m_irqAsserted = false;
+NES_THREAD_LOCAL int32_t         C6502::m_instrCycle = 0;
+NES_THREAD_LOCAL bool            C6502::m_irqPending = false;
+NES_THREAD_LOCAL bool            C6502::m_nmiAsserted = false;
+NES_THREAD_LOCAL bool            C6502::m_nmiPending = false;
+NES_THREAD_LOCAL uint8_t         C6502::m_openBusData = 0x00;
+NES_THREAD_LOCAL uint8_t*  C6502::m_6502memory = NULL;
+NES_THREAD_LOCAL uint8_t*  C6502::m_pReadPage [ 256 ];
+NES_THREAD_LOCAL uint8_t*  C6502::m_pWritePage [ 256 ];
+NES_THREAD_LOCAL int8_t    C6502::m_pageTarget [ 256 ];
+NES_THREAD_LOCAL bool      C6502::m_mapPRGROM = false;
+NES_THREAD_LOCAL bool      C6502::m_mapSRAMRead = false;
+NES_THREAD_LOCAL bool      C6502::m_mapSRAMWrite = false;
+NES_THREAD_LOCAL uint8_t   C6502::m_a = 0x00;
+NES_THREAD_LOCAL uint8_t   C6502::m_x = 0x00;
+NES_THREAD_LOCAL uint8_t   C6502::m_y = 0x00;
+NES_THREAD_LOCAL uint8_t   C6502::m_f = FLAG_MISC;
+NES_THREAD_LOCAL uint16_t  C6502::m_pc = VECTOR_RESET;
+NES_THREAD_LOCAL uint16_t  C6502::m_pcSync = VECTOR_RESET;
+NES_THREAD_LOCAL bool      C6502::m_pcSyncSet = false;
+NES_THREAD_LOCAL uint32_t    C6502::m_ea = 0;
+NES_THREAD_LOCAL uint32_t            C6502::m_pcGoto = 0xFFFFFFFF;
+NES_THREAD_LOCAL uint8_t   C6502::m_sp = 0x00;
+
+NES_THREAD_LOCAL uint32_t    C6502::m_cycles = 0;
+NES_THREAD_LOCAL int32_t         C6502::m_curCycles = 0;
+
+NES_THREAD_LOCAL uint16_t C6502::m_writeDmaAddr = 0x0000;
+NES_THREAD_LOCAL int32_t  C6502::m_writeDmaCounter = 0;
+NES_THREAD_LOCAL uint16_t C6502::m_readDmaAddr = 0x0000;
+NES_THREAD_LOCAL int32_t     C6502::m_dmaRequest = -1;
+NES_THREAD_LOCAL int32_t  C6502::m_readDmaCounter = 0;
+
+NES_THREAD_LOCAL int32_t         C6502::amode;
+NES_THREAD_LOCAL uint8_t*  C6502::data = NULL;
+NES_THREAD_LOCAL uint8_t   C6502::opcodeData [ 4 ]; // 3 opcode bytes and 1 byte for operand return data [extra cycle]
+NES_THREAD_LOCAL struct _CNES6502_opcode* C6502::pOpcodeStruct = NULL;
+NES_THREAD_LOCAL int32_t         C6502::opcodeSize;
+NES_THREAD_LOCAL bool            C6502::m_write = false;
+NES_THREAD_LOCAL int8_t            C6502::m_phase = 0;
+NES_THREAD_LOCAL uint8_t           C6502::m_dmaBuffer = 0x00;
+NES_THREAD_LOCAL uint8_t           C6502::m_brkPCLO = 0x00;
+NES_THREAD_LOCAL bool              C6502::m_brkDoingIrq = false;
+
+NES_THREAD_LOCAL TracerInfo*      C6502::pDisassemblySample = NULL;
+
+NES_THREAD_LOCAL CMarker*         C6502::m_marker = NULL;
+
+NES_THREAD_LOCAL CCodeDataLogger* C6502::m_logger = NULL;
+
+NES_THREAD_LOCAL uint8_t*   C6502::m_RAMopcodeMask = NULL;
+NES_THREAD_LOCAL char*      C6502::m_RAMdisassembly = NULL;
+NES_THREAD_LOCAL uint16_t*  C6502::m_RAMsloc2addr = NULL;
+NES_THREAD_LOCAL uint16_t*  C6502::m_RAMaddr2sloc = NULL;
+NES_THREAD_LOCAL uint32_t   C6502::m_RAMsloc = 0;
 
 static int32_t opcode_size [ NUM_ADDRESSING_MODES ] =
 {
@@ -247,274 +256,270 @@ static const char* operandFmt [ NUM_ADDRESSING_MODES ] =
 static CNES6502_opcode m_6502opcode [ 256 ] =
 {
    { 0x00, "BRK", C6502::BRK, AM_IMPLIED, 7, true, false, 0x0 }, // BRK
-   { 0x01, "ORA", C6502::ORA, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // ORA - (Indirect,X)
+   { 0x01, "ORA", C6502::ORA<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // ORA - (Indirect,X)
    { 0x02, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x03, "ASO", C6502::ASO, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // ASO - (Indirect,X) (undocumented)
-   { 0x04, "DOP", C6502::DOP, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
-   { 0x05, "ORA", C6502::ORA, AM_ZEROPAGE, 3, true, false, 0x4 }, // ORA - Zero Page
-   { 0x06, "ASL", C6502::ASL, AM_ZEROPAGE, 5, true, false, 0x10 }, // ASL - Zero Page
-   { 0x07, "ASO", C6502::ASO, AM_ZEROPAGE, 5, false, false, 0x10 }, // ASO - Zero Page (undocumented)
+   { 0x03, "ASO", C6502::ASO<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // ASO - (Indirect,X) (undocumented)
+   { 0x04, "DOP", C6502::DOP<AM_ZEROPAGE>, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
+   { 0x05, "ORA", C6502::ORA<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // ORA - Zero Page
+   { 0x06, "ASL", C6502::ASL<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // ASL - Zero Page
+   { 0x07, "ASO", C6502::ASO<AM_ZEROPAGE>, AM_ZEROPAGE, 5, false, false, 0x10 }, // ASO - Zero Page (undocumented)
    { 0x08, "PHP", C6502::PHP, AM_IMPLIED, 3, true, false, 0x4 }, // PHP
-   { 0x09, "ORA", C6502::ORA, AM_IMMEDIATE, 2, true, false, 0x2 }, // ORA - Immediate
-   { 0x0A, "ASL", C6502::ASL, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ASL - Accumulator
+   { 0x09, "ORA", C6502::ORA<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // ORA - Immediate
+   { 0x0A, "ASL", C6502::ASL<AM_ACCUMULATOR>, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ASL - Accumulator
    { 0x0B, "ANC", C6502::ANC, AM_IMMEDIATE, 2, false, false, 0x2 }, // ANC - Immediate (undocumented)
-   { 0x0C, "TOP", C6502::TOP, AM_ABSOLUTE, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0x0D, "ORA", C6502::ORA, AM_ABSOLUTE, 4, true, false, 0x8 }, // ORA - Absolute
-   { 0x0E, "ASL", C6502::ASL, AM_ABSOLUTE, 6, true, false, 0x20 }, // ASL - Absolute
-   { 0x0F, "ASO", C6502::ASO, AM_ABSOLUTE, 6, false, false, 0x20 }, // ASO - Absolute (undocumented)
+   { 0x0C, "TOP", C6502::TOP<AM_ABSOLUTE>, AM_ABSOLUTE, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0x0D, "ORA", C6502::ORA<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // ORA - Absolute
+   { 0x0E, "ASL", C6502::ASL<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // ASL - Absolute
+   { 0x0F, "ASO", C6502::ASO<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // ASO - Absolute (undocumented)
    { 0x10, "BPL", C6502::BPL, AM_RELATIVE, 2, true, false, 0xA }, // BPL
-   { 0x11, "ORA", C6502::ORA, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // ORA - (Indirect),Y
+   { 0x11, "ORA", C6502::ORA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // ORA - (Indirect),Y
    { 0x12, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x13, "ASO", C6502::ASO, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // ASO - (Indirect),Y (undocumented)
-   { 0x14, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0x15, "ORA", C6502::ORA, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // ORA - Zero Page,X
-   { 0x16, "ASL", C6502::ASL, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ASL - Zero Page,X
-   { 0x17, "ASO", C6502::ASO, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // ASO - Zero Page,X (undocumented)
+   { 0x13, "ASO", C6502::ASO<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // ASO - (Indirect),Y (undocumented)
+   { 0x14, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0x15, "ORA", C6502::ORA<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // ORA - Zero Page,X
+   { 0x16, "ASL", C6502::ASL<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ASL - Zero Page,X
+   { 0x17, "ASO", C6502::ASO<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // ASO - Zero Page,X (undocumented)
    { 0x18, "CLC", C6502::CLC, AM_IMPLIED, 2, true, false, 0x2 }, // CLC
-   { 0x19, "ORA", C6502::ORA, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // ORA - Absolute,Y
+   { 0x19, "ORA", C6502::ORA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // ORA - Absolute,Y
    { 0x1A, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0x1B, "ASO", C6502::ASO, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // ASO - Absolute,Y (undocumented)
-   { 0x1C, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0x1D, "ORA", C6502::ORA, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // ORA - Absolute,X
-   { 0x1E, "ASL", C6502::ASL, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // ASL - Absolute,X
-   { 0x1F, "ASO", C6502::ASO, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // ASO - Absolute,X (undocumented)
+   { 0x1B, "ASO", C6502::ASO<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // ASO - Absolute,Y (undocumented)
+   { 0x1C, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0x1D, "ORA", C6502::ORA<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // ORA - Absolute,X
+   { 0x1E, "ASL", C6502::ASL<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // ASL - Absolute,X
+   { 0x1F, "ASO", C6502::ASO<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // ASO - Absolute,X (undocumented)
    { 0x20, "JSR", C6502::JSR, AM_ABSOLUTE, 6, true, false, 0x20 }, // JSR
-   { 0x21, "AND", C6502::AND, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // AND - (Indirect,X)
+   { 0x21, "AND", C6502::AND<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // AND - (Indirect,X)
    { 0x22, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x23, "RLA", C6502::RLA, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // RLA - (Indirect,X) (undocumented)
-   { 0x24, "BIT", C6502::BIT, AM_ZEROPAGE, 3, true, false, 0x4 }, // BIT - Zero Page
-   { 0x25, "AND", C6502::AND, AM_ZEROPAGE, 3, true, false, 0x4 }, // AND - Zero Page
-   { 0x26, "ROL", C6502::ROL, AM_ZEROPAGE, 5, true, false, 0x10 }, // ROL - Zero Page
-   { 0x27, "RLA", C6502::RLA, AM_ZEROPAGE, 5, false, false, 0x10 }, // RLA - Zero Page (undocumented)
+   { 0x23, "RLA", C6502::RLA<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // RLA - (Indirect,X) (undocumented)
+   { 0x24, "BIT", C6502::BIT<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // BIT - Zero Page
+   { 0x25, "AND", C6502::AND<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // AND - Zero Page
+   { 0x26, "ROL", C6502::ROL<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // ROL - Zero Page
+   { 0x27, "RLA", C6502::RLA<AM_ZEROPAGE>, AM_ZEROPAGE, 5, false, false, 0x10 }, // RLA - Zero Page (undocumented)
    { 0x28, "PLP", C6502::PLP, AM_IMPLIED, 4, true, false, 0x8 }, // PLP
-   { 0x29, "AND", C6502::AND, AM_IMMEDIATE, 2, true, false, 0x2 }, // AND - Immediate
-   { 0x2A, "ROL", C6502::ROL, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ROL - Accumulator
+   { 0x29, "AND", C6502::AND<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // AND - Immediate
+   { 0x2A, "ROL", C6502::ROL<AM_ACCUMULATOR>, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ROL - Accumulator
    { 0x2B, "ANC", C6502::ANC, AM_IMMEDIATE, 2, false, false, 0x2 }, // ANC - Immediate (undocumented)
-   { 0x2C, "BIT", C6502::BIT, AM_ABSOLUTE, 4, true, false, 0x8 }, // BIT - Absolute
-   { 0x2D, "AND", C6502::AND, AM_ABSOLUTE, 4, true, false, 0x8 }, // AND - Absolute
-   { 0x2E, "ROL", C6502::ROL, AM_ABSOLUTE, 6, true, false, 0x20 }, // ROL - Absolute
-   { 0x2F, "RLA", C6502::RLA, AM_ABSOLUTE, 6, false, false, 0x20 }, // RLA - Absolute (undocumented)
+   { 0x2C, "BIT", C6502::BIT<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // BIT - Absolute
+   { 0x2D, "AND", C6502::AND<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // AND - Absolute
+   { 0x2E, "ROL", C6502::ROL<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // ROL - Absolute
+   { 0x2F, "RLA", C6502::RLA<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // RLA - Absolute (undocumented)
    { 0x30, "BMI", C6502::BMI, AM_RELATIVE, 2, true, false, 0x2 }, // BMI
-   { 0x31, "AND", C6502::AND, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // AND - (Indirect),Y
+   { 0x31, "AND", C6502::AND<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // AND - (Indirect),Y
    { 0x32, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x33, "RLA", C6502::RLA, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // RLA - (Indirect),Y (undocumented)
-   { 0x34, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0x35, "AND", C6502::AND, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // AND - Zero Page,X
-   { 0x36, "ROL", C6502::ROL, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ROL - Zero Page,X
-   { 0x37, "RLA", C6502::RLA, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // RLA - Zero Page,X (undocumented)
+   { 0x33, "RLA", C6502::RLA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // RLA - (Indirect),Y (undocumented)
+   { 0x34, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0x35, "AND", C6502::AND<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // AND - Zero Page,X
+   { 0x36, "ROL", C6502::ROL<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ROL - Zero Page,X
+   { 0x37, "RLA", C6502::RLA<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // RLA - Zero Page,X (undocumented)
    { 0x38, "SEC", C6502::SEC, AM_IMPLIED, 2, true, false, 0x2 }, // SEC
-   { 0x39, "AND", C6502::AND, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // AND - Absolute,Y
+   { 0x39, "AND", C6502::AND<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // AND - Absolute,Y
    { 0x3A, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0x3B, "RLA", C6502::RLA, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // RLA - Absolute,Y (undocumented)
-   { 0x3C, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0x3D, "AND", C6502::AND, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // AND - Absolute,X
-   { 0x3E, "ROL", C6502::ROL, AM_ABSOLUTE_INDEXED_X, 7, true, false, 0x40 }, // ROL - Absolute,X
-   { 0x3F, "RLA", C6502::RLA, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // RLA - Absolute,X (undocumented)
+   { 0x3B, "RLA", C6502::RLA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // RLA - Absolute,Y (undocumented)
+   { 0x3C, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0x3D, "AND", C6502::AND<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // AND - Absolute,X
+   { 0x3E, "ROL", C6502::ROL<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, false, 0x40 }, // ROL - Absolute,X
+   { 0x3F, "RLA", C6502::RLA<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // RLA - Absolute,X (undocumented)
    { 0x40, "RTI", C6502::RTI, AM_IMPLIED, 6, true, false, 0x20 }, // RTI
-   { 0x41, "EOR", C6502::EOR, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // EOR - (Indirect,X)
+   { 0x41, "EOR", C6502::EOR<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // EOR - (Indirect,X)
    { 0x42, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x43, "LSE", C6502::LSE, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // LSE - (Indirect,X) (undocumented)
-   { 0x44, "DOP", C6502::DOP, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
-   { 0x45, "EOR", C6502::EOR, AM_ZEROPAGE, 3, true, false, 0x4 }, // EOR - Zero Page
-   { 0x46, "LSR", C6502::LSR, AM_ZEROPAGE, 5, true, false, 0x10 }, // LSR - Zero Page
-   { 0x47, "LSE", C6502::LSE, AM_ZEROPAGE, 5, false, false, 0x10 }, // LSE - Zero Page (undocumented)
+   { 0x43, "LSE", C6502::LSE<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // LSE - (Indirect,X) (undocumented)
+   { 0x44, "DOP", C6502::DOP<AM_ZEROPAGE>, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
+   { 0x45, "EOR", C6502::EOR<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // EOR - Zero Page
+   { 0x46, "LSR", C6502::LSR<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // LSR - Zero Page
+   { 0x47, "LSE", C6502::LSE<AM_ZEROPAGE>, AM_ZEROPAGE, 5, false, false, 0x10 }, // LSE - Zero Page (undocumented)
    { 0x48, "PHA", C6502::PHA, AM_IMPLIED, 3, true, false, 0x4 }, // PHA
-   { 0x49, "EOR", C6502::EOR, AM_IMMEDIATE, 2, true, false, 0x2 }, // EOR - Immediate
-   { 0x4A, "LSR", C6502::LSR, AM_ACCUMULATOR, 2, true, false, 0x2 }, // LSR - Accumulator
+   { 0x49, "EOR", C6502::EOR<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // EOR - Immediate
+   { 0x4A, "LSR", C6502::LSR<AM_ACCUMULATOR>, AM_ACCUMULATOR, 2, true, false, 0x2 }, // LSR - Accumulator
    { 0x4B, "ALR", C6502::ALR, AM_IMMEDIATE, 2, false, false, 0x2 }, // ALR - Immediate (undocumented)
-   { 0x4C, "JMP", C6502::JMP, AM_ABSOLUTE, 3, true, false, 0x4 }, // JMP - Absolute
-   { 0x4D, "EOR", C6502::EOR, AM_ABSOLUTE, 4, true, false, 0x8 }, // EOR - Absolute
-   { 0x4E, "LSR", C6502::LSR, AM_ABSOLUTE, 6, true, false, 0x20 }, // LSR - Absolute
-   { 0x4F, "LSE", C6502::LSE, AM_ABSOLUTE, 6, false, false, 0x20 }, // LSE - Absolute (undocumented)
+   { 0x4C, "JMP", C6502::JMP<AM_ABSOLUTE>, AM_ABSOLUTE, 3, true, false, 0x4 }, // JMP - Absolute
+   { 0x4D, "EOR", C6502::EOR<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // EOR - Absolute
+   { 0x4E, "LSR", C6502::LSR<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // LSR - Absolute
+   { 0x4F, "LSE", C6502::LSE<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // LSE - Absolute (undocumented)
    { 0x50, "BVC", C6502::BVC, AM_RELATIVE, 2, true, false, 0xA }, // BVC
-   { 0x51, "EOR", C6502::EOR, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // EOR - (Indirect),Y
+   { 0x51, "EOR", C6502::EOR<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // EOR - (Indirect),Y
    { 0x52, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x53, "LSE", C6502::LSE, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // LSE - (Indirect),Y
-   { 0x54, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0x55, "EOR", C6502::EOR, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // EOR - Zero Page,X
-   { 0x56, "LSR", C6502::LSR, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // LSR - Zero Page,X
-   { 0x57, "LSE", C6502::LSE, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // LSE - Zero Page,X (undocumented)
+   { 0x53, "LSE", C6502::LSE<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // LSE - (Indirect),Y
+   { 0x54, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0x55, "EOR", C6502::EOR<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // EOR - Zero Page,X
+   { 0x56, "LSR", C6502::LSR<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // LSR - Zero Page,X
+   { 0x57, "LSE", C6502::LSE<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // LSE - Zero Page,X (undocumented)
    { 0x58, "CLI", C6502::CLI, AM_IMPLIED, 2, true, false, 0x2 }, // CLI
-   { 0x59, "EOR", C6502::EOR, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // EOR - Absolute,Y
+   { 0x59, "EOR", C6502::EOR<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // EOR - Absolute,Y
    { 0x5A, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0x5B, "LSE", C6502::LSE, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // LSE - Absolute,Y (undocumented)
-   { 0x5C, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0x5D, "EOR", C6502::EOR, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // EOR - Absolute,X
-   { 0x5E, "LSR", C6502::LSR, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // LSR - Absolute,X
-   { 0x5F, "LSE", C6502::LSE, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // LSE - Absolute,X (undocumented)
+   { 0x5B, "LSE", C6502::LSE<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // LSE - Absolute,Y (undocumented)
+   { 0x5C, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0x5D, "EOR", C6502::EOR<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // EOR - Absolute,X
+   { 0x5E, "LSR", C6502::LSR<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // LSR - Absolute,X
+   { 0x5F, "LSE", C6502::LSE<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // LSE - Absolute,X (undocumented)
    { 0x60, "RTS", C6502::RTS, AM_IMPLIED, 6, true, false, 0x20 }, // RTS
-   { 0x61, "ADC", C6502::ADC, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // ADC - (Indirect,X)
+   { 0x61, "ADC", C6502::ADC<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // ADC - (Indirect,X)
    { 0x62, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x63, "RRA", C6502::RRA, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // RRA - (Indirect,X) (undocumented)
-   { 0x64, "DOP", C6502::DOP, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
-   { 0x65, "ADC", C6502::ADC, AM_ZEROPAGE, 3, true, false, 0x4 }, // ADC - Zero Page
-   { 0x66, "ROR", C6502::ROR, AM_ZEROPAGE, 5, true, false, 0x10 }, // ROR - Zero Page
-   { 0x67, "RRA", C6502::RRA, AM_ZEROPAGE, 5, false, false, 0x10 }, // RRA - Zero Page (undocumented)
+   { 0x63, "RRA", C6502::RRA<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // RRA - (Indirect,X) (undocumented)
+   { 0x64, "DOP", C6502::DOP<AM_ZEROPAGE>, AM_ZEROPAGE, 3, false, false, 0x4 }, // DOP (undocumented)
+   { 0x65, "ADC", C6502::ADC<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // ADC - Zero Page
+   { 0x66, "ROR", C6502::ROR<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // ROR - Zero Page
+   { 0x67, "RRA", C6502::RRA<AM_ZEROPAGE>, AM_ZEROPAGE, 5, false, false, 0x10 }, // RRA - Zero Page (undocumented)
    { 0x68, "PLA", C6502::PLA, AM_IMPLIED, 4, true, false, 0x8 }, // PLA
-   { 0x69, "ADC", C6502::ADC, AM_IMMEDIATE, 2, true, false, 0x2 }, // ADC - Immediate
-   { 0x6A, "ROR", C6502::ROR, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ROR - Accumulator
+   { 0x69, "ADC", C6502::ADC<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // ADC - Immediate
+   { 0x6A, "ROR", C6502::ROR<AM_ACCUMULATOR>, AM_ACCUMULATOR, 2, true, false, 0x2 }, // ROR - Accumulator
    { 0x6B, "ARR", C6502::ARR, AM_IMMEDIATE, 2, false, false, 0x2 }, // ARR - Immediate (undocumented)
-   { 0x6C, "JMP", C6502::JMP, AM_INDIRECT, 5, true, false, 0x10 }, // JMP - Indirect
-   { 0x6D, "ADC", C6502::ADC, AM_ABSOLUTE, 4, true, false, 0x8 }, // ADC - Absolute
-   { 0x6E, "ROR", C6502::ROR, AM_ABSOLUTE, 6, true, false, 0x20 }, // ROR - Absolute
-   { 0x6F, "RRA", C6502::RRA, AM_ABSOLUTE, 6, false, false, 0x20 }, // RRA - Absolute (undocumented)
+   { 0x6C, "JMP", C6502::JMP<AM_INDIRECT>, AM_INDIRECT, 5, true, false, 0x10 }, // JMP - Indirect
+   { 0x6D, "ADC", C6502::ADC<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // ADC - Absolute
+   { 0x6E, "ROR", C6502::ROR<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // ROR - Absolute
+   { 0x6F, "RRA", C6502::RRA<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // RRA - Absolute (undocumented)
    { 0x70, "BVS", C6502::BVS, AM_RELATIVE, 2, true, false, 0xA }, // BVS
-   { 0x71, "ADC", C6502::ADC, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // ADC - (Indirect),Y
+   { 0x71, "ADC", C6502::ADC<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // ADC - (Indirect),Y
    { 0x72, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x73, "RRA", C6502::RRA, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // RRA - (Indirect),Y (undocumented)
-   { 0x74, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0x75, "ADC", C6502::ADC, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // ADC - Zero Page,X
-   { 0x76, "ROR", C6502::ROR, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ROR - Zero Page,X
-   { 0x77, "RRA", C6502::RRA, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // RRA - Zero Page,X (undocumented)
+   { 0x73, "RRA", C6502::RRA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // RRA - (Indirect),Y (undocumented)
+   { 0x74, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0x75, "ADC", C6502::ADC<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // ADC - Zero Page,X
+   { 0x76, "ROR", C6502::ROR<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // ROR - Zero Page,X
+   { 0x77, "RRA", C6502::RRA<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // RRA - Zero Page,X (undocumented)
    { 0x78, "SEI", C6502::SEI, AM_IMPLIED, 2, true, false, 0x2 }, // SEI
-   { 0x79, "ADC", C6502::ADC, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // ADC - Absolute,Y
+   { 0x79, "ADC", C6502::ADC<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // ADC - Absolute,Y
    { 0x7A, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0x7B, "RRA", C6502::RRA, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // RRA - Absolute,Y (undocumented)
-   { 0x7C, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0x7D, "ADC", C6502::ADC, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // ADC - Absolute,X
-   { 0x7E, "ROR", C6502::ROR, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // ROR - Absolute,X
-   { 0x7F, "RRA", C6502::RRA, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // RRA - Absolute,X (undocumented)
-   { 0x80, "DOP", C6502::DOP, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
-   { 0x81, "STA", C6502::STA, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // STA - (Indirect,X)
-   { 0x82, "DOP", C6502::DOP, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
-   { 0x83, "AXS", C6502::AXS, AM_PREINDEXED_INDIRECT, 6, false, false, 0x20 }, // AXS - (Indirect,X) (undocumented)
-   { 0x84, "STY", C6502::STY, AM_ZEROPAGE, 3, true, false, 0x4 }, // STY - Zero Page
-   { 0x85, "STA", C6502::STA, AM_ZEROPAGE, 3, true, false, 0x4 }, // STA - Zero Page
-   { 0x86, "STX", C6502::STX, AM_ZEROPAGE, 3, true, false, 0x4 }, // STX - Zero Page
-   { 0x87, "AXS", C6502::AXS, AM_ZEROPAGE, 3, false, false, 0x4 }, // AXS - Zero Page (undocumented)
+   { 0x7B, "RRA", C6502::RRA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // RRA - Absolute,Y (undocumented)
+   { 0x7C, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0x7D, "ADC", C6502::ADC<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // ADC - Absolute,X
+   { 0x7E, "ROR", C6502::ROR<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // ROR - Absolute,X
+   { 0x7F, "RRA", C6502::RRA<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // RRA - Absolute,X (undocumented)
+   { 0x80, "DOP", C6502::DOP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
+   { 0x81, "STA", C6502::STA<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // STA - (Indirect,X)
+   { 0x82, "DOP", C6502::DOP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
+   { 0x83, "AXS", C6502::AXS<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, false, false, 0x20 }, // AXS - (Indirect,X) (undocumented)
+   { 0x84, "STY", C6502::STY<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // STY - Zero Page
+   { 0x85, "STA", C6502::STA<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // STA - Zero Page
+   { 0x86, "STX", C6502::STX<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // STX - Zero Page
+   { 0x87, "AXS", C6502::AXS<AM_ZEROPAGE>, AM_ZEROPAGE, 3, false, false, 0x4 }, // AXS - Zero Page (undocumented)
    { 0x88, "DEY", C6502::DEY, AM_IMPLIED, 2, true, false, 0x2 }, // DEY
-   { 0x89, "DOP", C6502::DOP, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
+   { 0x89, "DOP", C6502::DOP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
    { 0x8A, "TXA", C6502::TXA, AM_IMPLIED, 2, true, false, 0x2 }, // TXA
    { 0x8B, "XAA", C6502::XAA, AM_IMMEDIATE, 2, false, false, 0x2 }, // XAA - Immediate (undocumented)
-   { 0x8C, "STY", C6502::STY, AM_ABSOLUTE, 4, true, false, 0x8 }, // STY - Absolute
-   { 0x8D, "STA", C6502::STA, AM_ABSOLUTE, 4, true, false, 0x8 }, // STA - Absolute
-   { 0x8E, "STX", C6502::STX, AM_ABSOLUTE, 4, true, false, 0x8 }, // STX - Absolute
-   { 0x8F, "AXS", C6502::AXS, AM_ABSOLUTE, 4, false, false, 0x8 }, // AXS - Absolulte (undocumented)
+   { 0x8C, "STY", C6502::STY<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // STY - Absolute
+   { 0x8D, "STA", C6502::STA<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // STA - Absolute
+   { 0x8E, "STX", C6502::STX<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // STX - Absolute
+   { 0x8F, "AXS", C6502::AXS<AM_ABSOLUTE>, AM_ABSOLUTE, 4, false, false, 0x8 }, // AXS - Absolulte (undocumented)
    { 0x90, "BCC", C6502::BCC, AM_RELATIVE, 2, true, false, 0xA }, // BCC
-   { 0x91, "STA", C6502::STA, AM_POSTINDEXED_INDIRECT, 6, true, true, 0x20 }, // STA - (Indirect),Y
+   { 0x91, "STA", C6502::STA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 6, true, true, 0x20 }, // STA - (Indirect),Y
    { 0x92, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0x93, "AXA", C6502::AXA, AM_POSTINDEXED_INDIRECT, 6, false, true, 0x20 }, // AXA - (Indirect),Y
-   { 0x94, "STY", C6502::STY, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // STY - Zero Page,X
-   { 0x95, "STA", C6502::STA, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // STA - Zero Page,X
-   { 0x96, "STX", C6502::STX, AM_ZEROPAGE_INDEXED_Y, 4, true, false, 0x8 }, // STX - Zero Page,Y
-   { 0x97, "AXS", C6502::AXS, AM_ZEROPAGE_INDEXED_Y, 4, false, false, 0x8 }, // AXS - Zero Page,Y
+   { 0x93, "AXA", C6502::AXA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 6, false, true, 0x20 }, // AXA - (Indirect),Y
+   { 0x94, "STY", C6502::STY<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // STY - Zero Page,X
+   { 0x95, "STA", C6502::STA<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // STA - Zero Page,X
+   { 0x96, "STX", C6502::STX<AM_ZEROPAGE_INDEXED_Y>, AM_ZEROPAGE_INDEXED_Y, 4, true, false, 0x8 }, // STX - Zero Page,Y
+   { 0x97, "AXS", C6502::AXS<AM_ZEROPAGE_INDEXED_Y>, AM_ZEROPAGE_INDEXED_Y, 4, false, false, 0x8 }, // AXS - Zero Page,Y
    { 0x98, "TYA", C6502::TYA, AM_IMPLIED, 2, true, false, 0x2 }, // TYA
-   { 0x99, "STA", C6502::STA, AM_ABSOLUTE_INDEXED_Y, 5, true, true, 0x10 }, // STA - Absolute,Y
+   { 0x99, "STA", C6502::STA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 5, true, true, 0x10 }, // STA - Absolute,Y
    { 0x9A, "TXS", C6502::TXS, AM_IMPLIED, 2, true, false, 0x2 }, // TXS
-   { 0x9B, "TAS", C6502::TAS, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // TAS - Absolute,Y (undocumented)
-   { 0x9C, "SAY", C6502::SAY, AM_ABSOLUTE_INDEXED_X, 5, false, true, 0x10 }, // SAY - Absolute,X (undocumented)
-   { 0x9D, "STA", C6502::STA, AM_ABSOLUTE_INDEXED_X, 5, true, true, 0x10 }, // STA - Absolute,X
-   { 0x9E, "XAS", C6502::XAS, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // XAS - Absolute,Y (undocumented)
-   { 0x9F, "AXA", C6502::AXA, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // AXA - Absolute,Y (undocumented)
-   { 0xA0, "LDY", C6502::LDY, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDY - Immediate
-   { 0xA1, "LDA", C6502::LDA, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // LDA - (Indirect,X)
-   { 0xA2, "LDX", C6502::LDX, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDX - Immediate
-   { 0xA3, "LAX", C6502::LAX, AM_PREINDEXED_INDIRECT, 6, false, false, 0x20 }, // LAX - (Indirect,X) (undocumented)
-   { 0xA4, "LDY", C6502::LDY, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDY - Zero Page
-   { 0xA5, "LDA", C6502::LDA, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDA - Zero Page
-   { 0xA6, "LDX", C6502::LDX, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDX - Zero Page
-   { 0xA7, "LAX", C6502::LAX, AM_ZEROPAGE, 3, false, false, 0x4 }, // LAX - Zero Page (undocumented)
+   { 0x9B, "TAS", C6502::TAS<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // TAS - Absolute,Y (undocumented)
+   { 0x9C, "SAY", C6502::SAY<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 5, false, true, 0x10 }, // SAY - Absolute,X (undocumented)
+   { 0x9D, "STA", C6502::STA<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 5, true, true, 0x10 }, // STA - Absolute,X
+   { 0x9E, "XAS", C6502::XAS<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // XAS - Absolute,Y (undocumented)
+   { 0x9F, "AXA", C6502::AXA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 5, false, true, 0x10 }, // AXA - Absolute,Y (undocumented)
+   { 0xA0, "LDY", C6502::LDY<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDY - Immediate
+   { 0xA1, "LDA", C6502::LDA<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // LDA - (Indirect,X)
+   { 0xA2, "LDX", C6502::LDX<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDX - Immediate
+   { 0xA3, "LAX", C6502::LAX<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, false, false, 0x20 }, // LAX - (Indirect,X) (undocumented)
+   { 0xA4, "LDY", C6502::LDY<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDY - Zero Page
+   { 0xA5, "LDA", C6502::LDA<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDA - Zero Page
+   { 0xA6, "LDX", C6502::LDX<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // LDX - Zero Page
+   { 0xA7, "LAX", C6502::LAX<AM_ZEROPAGE>, AM_ZEROPAGE, 3, false, false, 0x4 }, // LAX - Zero Page (undocumented)
    { 0xA8, "TAY", C6502::TAY, AM_IMPLIED, 2, true, false, 0x2 }, // TAY
-   { 0xA9, "LDA", C6502::LDA, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDA - Immediate
+   { 0xA9, "LDA", C6502::LDA<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // LDA - Immediate
    { 0xAA, "TAX", C6502::TAX, AM_IMPLIED, 2, true, false, 0x2 }, // TAX
    { 0xAB, "OAL", C6502::OAL, AM_IMMEDIATE, 2, false, false, 0x2 }, // OAL - Immediate
-   { 0xAC, "LDY", C6502::LDY, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDY - Absolute
-   { 0xAD, "LDA", C6502::LDA, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDA - Absolute
-   { 0xAE, "LDX", C6502::LDX, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDX - Absolute
-   { 0xAF, "LAX", C6502::LAX, AM_ABSOLUTE, 4, false, false, 0x8 }, // LAX - Absolute (undocumented)
+   { 0xAC, "LDY", C6502::LDY<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDY - Absolute
+   { 0xAD, "LDA", C6502::LDA<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDA - Absolute
+   { 0xAE, "LDX", C6502::LDX<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // LDX - Absolute
+   { 0xAF, "LAX", C6502::LAX<AM_ABSOLUTE>, AM_ABSOLUTE, 4, false, false, 0x8 }, // LAX - Absolute (undocumented)
    { 0xB0, "BCS", C6502::BCS, AM_RELATIVE, 2, true, false, 0xA }, // BCS
-   { 0xB1, "LDA", C6502::LDA, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // LDA - (Indirect),Y
+   { 0xB1, "LDA", C6502::LDA<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // LDA - (Indirect),Y
    { 0xB2, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0xB3, "LAX", C6502::LAX, AM_POSTINDEXED_INDIRECT, 5, false, false, 0x10 }, // LAX - (Indirect),Y (undocumented)
-   { 0xB4, "LDY", C6502::LDY, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // LDY - Zero Page,X
-   { 0xB5, "LDA", C6502::LDA, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // LDA - Zero Page,X
-   { 0xB6, "LDX", C6502::LDX, AM_ZEROPAGE_INDEXED_Y, 4, true, false, 0x8 }, // LDX - Zero Page,Y
-   { 0xB7, "LAX", C6502::LAX, AM_ZEROPAGE_INDEXED_Y, 4, false, false, 0x8 }, // LAX - Zero Page,X (undocumented)
+   { 0xB3, "LAX", C6502::LAX<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, false, false, 0x10 }, // LAX - (Indirect),Y (undocumented)
+   { 0xB4, "LDY", C6502::LDY<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // LDY - Zero Page,X
+   { 0xB5, "LDA", C6502::LDA<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // LDA - Zero Page,X
+   { 0xB6, "LDX", C6502::LDX<AM_ZEROPAGE_INDEXED_Y>, AM_ZEROPAGE_INDEXED_Y, 4, true, false, 0x8 }, // LDX - Zero Page,Y
+   { 0xB7, "LAX", C6502::LAX<AM_ZEROPAGE_INDEXED_Y>, AM_ZEROPAGE_INDEXED_Y, 4, false, false, 0x8 }, // LAX - Zero Page,X (undocumented)
    { 0xB8, "CLV", C6502::CLV, AM_IMPLIED, 2, true, false, 0x2 }, // CLV
-   { 0xB9, "LDA", C6502::LDA, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // LDA - Absolute,Y
+   { 0xB9, "LDA", C6502::LDA<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // LDA - Absolute,Y
    { 0xBA, "TSX", C6502::TSX, AM_IMPLIED, 2, true, false, 0x2 }, // TSX
-   { 0xBB, "LAS", C6502::LAS, AM_ABSOLUTE_INDEXED_Y, 4, false, false, 0x8 }, // LAS - Absolute,Y (undocumented)
-   { 0xBC, "LDY", C6502::LDY, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // LDY - Absolute,X
-   { 0xBD, "LDA", C6502::LDA, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // LDA - Absolute,X
-   { 0xBE, "LDX", C6502::LDX, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // LDX - Absolute,Y
-   { 0xBF, "LAX", C6502::LAX, AM_ABSOLUTE_INDEXED_Y, 4, false, false, 0x8 }, // LAX - Absolute,Y (undocumented)
-   { 0xC0, "CPY", C6502::CPY, AM_IMMEDIATE, 2, true, false, 0x2 }, // CPY - Immediate
-   { 0xC1, "CMP", C6502::CMP, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // CMP - (Indirect,X)
-   { 0xC2, "DOP", C6502::DOP, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
-   { 0xC3, "DCM", C6502::DCM, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // DCM - (Indirect,X) (undocumented)
-   { 0xC4, "CPY", C6502::CPY, AM_ZEROPAGE, 3, true, false, 0x4 }, // CPY - Zero Page
-   { 0xC5, "CMP", C6502::CMP, AM_ZEROPAGE, 3, true, false, 0x4 }, // CMP - Zero Page
-   { 0xC6, "DEC", C6502::DEC, AM_ZEROPAGE, 5, true, false, 0x10 }, // DEC - Zero Page
-   { 0xC7, "DCM", C6502::DCM, AM_ZEROPAGE, 5, true, false, 0x10 }, // DCM - Zero Page (undocumented)
+   { 0xBB, "LAS", C6502::LAS<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, false, false, 0x8 }, // LAS - Absolute,Y (undocumented)
+   { 0xBC, "LDY", C6502::LDY<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // LDY - Absolute,X
+   { 0xBD, "LDA", C6502::LDA<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // LDA - Absolute,X
+   { 0xBE, "LDX", C6502::LDX<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // LDX - Absolute,Y
+   { 0xBF, "LAX", C6502::LAX<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, false, false, 0x8 }, // LAX - Absolute,Y (undocumented)
+   { 0xC0, "CPY", C6502::CPY<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // CPY - Immediate
+   { 0xC1, "CMP", C6502::CMP<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // CMP - (Indirect,X)
+   { 0xC2, "DOP", C6502::DOP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
+   { 0xC3, "DCM", C6502::DCM<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // DCM - (Indirect,X) (undocumented)
+   { 0xC4, "CPY", C6502::CPY<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // CPY - Zero Page
+   { 0xC5, "CMP", C6502::CMP<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // CMP - Zero Page
+   { 0xC6, "DEC", C6502::DEC<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // DEC - Zero Page
+   { 0xC7, "DCM", C6502::DCM<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // DCM - Zero Page (undocumented)
    { 0xC8, "INY", C6502::INY, AM_IMPLIED, 2, true, false, 0x2 }, // INY
-   { 0xC9, "CMP", C6502::CMP, AM_IMMEDIATE, 2, true, false, 0x2 }, // CMP - Immediate
+   { 0xC9, "CMP", C6502::CMP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // CMP - Immediate
    { 0xCA, "DEX", C6502::DEX, AM_IMPLIED, 2, true, false, 0x2 }, // DEX
    { 0xCB, "SAX", C6502::SAX, AM_IMMEDIATE, 2, false, false, 0x2 }, // SAX - Immediate (undocumented)
-   { 0xCC, "CPY", C6502::CPY, AM_ABSOLUTE, 4, true, false, 0x8 }, // CPY - Absolute
-   { 0xCD, "CMP", C6502::CMP, AM_ABSOLUTE, 4, true, false, 0x8 }, // CMP - Absolute
-   { 0xCE, "DEC", C6502::DEC, AM_ABSOLUTE, 6, true, false, 0x20 }, // DEC - Absolute
-   { 0xCF, "DCM", C6502::DCM, AM_ABSOLUTE, 6, false, false, 0x20 }, // DCM - Absolute (undocumented)
+   { 0xCC, "CPY", C6502::CPY<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // CPY - Absolute
+   { 0xCD, "CMP", C6502::CMP<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // CMP - Absolute
+   { 0xCE, "DEC", C6502::DEC<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // DEC - Absolute
+   { 0xCF, "DCM", C6502::DCM<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // DCM - Absolute (undocumented)
    { 0xD0, "BNE", C6502::BNE, AM_RELATIVE, 2, true, false, 0xA }, // BNE
-   { 0xD1, "CMP", C6502::CMP, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // CMP   (Indirect),Y
+   { 0xD1, "CMP", C6502::CMP<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // CMP   (Indirect),Y
    { 0xD2, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0xD3, "DCM", C6502::DCM, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // DCM - (Indirect),Y (undocumented)
-   { 0xD4, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0xD5, "CMP", C6502::CMP, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // CMP - Zero Page,X
-   { 0xD6, "DEC", C6502::DEC, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // DEC - Zero Page,X
-   { 0xD7, "DCM", C6502::DCM, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // DCM - Zero Page,X (undocumented)
+   { 0xD3, "DCM", C6502::DCM<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // DCM - (Indirect),Y (undocumented)
+   { 0xD4, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0xD5, "CMP", C6502::CMP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // CMP - Zero Page,X
+   { 0xD6, "DEC", C6502::DEC<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // DEC - Zero Page,X
+   { 0xD7, "DCM", C6502::DCM<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // DCM - Zero Page,X (undocumented)
    { 0xD8, "CLD", C6502::CLD, AM_IMPLIED, 2, true, false, 0x2 }, // CLD
-   { 0xD9, "CMP", C6502::CMP, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // CMP - Absolute,Y
+   { 0xD9, "CMP", C6502::CMP<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // CMP - Absolute,Y
    { 0xDA, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0xDB, "DCM", C6502::DCM, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // DCM - Absolute,Y (undocumented)
-   { 0xDC, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0xDD, "CMP", C6502::CMP, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // CMP - Absolute,X
-   { 0xDE, "DEC", C6502::DEC, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // DEC - Absolute,X
-   { 0xDF, "DCM", C6502::DCM, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // DCM - Absolute,X (undocumented)
-   { 0xE0, "CPX", C6502::CPX, AM_IMMEDIATE, 2, true, false, 0x2 }, // CPX - Immediate
-   { 0xE1, "SBC", C6502::SBC, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // SBC - (Indirect,X)
-   { 0xE2, "DOP", C6502::DOP, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
-   { 0xE3, "INS", C6502::INS, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // INS - (Indirect,X) (undocumented)
-   { 0xE4, "CPX", C6502::CPX, AM_ZEROPAGE, 3, true, false, 0x4 }, // CPX - Zero Page
-   { 0xE5, "SBC", C6502::SBC, AM_ZEROPAGE, 3, true, false, 0x4 }, // SBC - Zero Page
-   { 0xE6, "INC", C6502::INC, AM_ZEROPAGE, 5, true, false, 0x10 }, // INC - Zero Page
-   { 0xE7, "INS", C6502::INS, AM_ZEROPAGE, 5, false, false, 0x10 }, // INS - Zero Page (undocumented)
+   { 0xDB, "DCM", C6502::DCM<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // DCM - Absolute,Y (undocumented)
+   { 0xDC, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0xDD, "CMP", C6502::CMP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // CMP - Absolute,X
+   { 0xDE, "DEC", C6502::DEC<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // DEC - Absolute,X
+   { 0xDF, "DCM", C6502::DCM<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }, // DCM - Absolute,X (undocumented)
+   { 0xE0, "CPX", C6502::CPX<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // CPX - Immediate
+   { 0xE1, "SBC", C6502::SBC<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 6, true, false, 0x20 }, // SBC - (Indirect,X)
+   { 0xE2, "DOP", C6502::DOP<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // DOP (undocumented)
+   { 0xE3, "INS", C6502::INS<AM_PREINDEXED_INDIRECT>, AM_PREINDEXED_INDIRECT, 8, false, false, 0x80 }, // INS - (Indirect,X) (undocumented)
+   { 0xE4, "CPX", C6502::CPX<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // CPX - Zero Page
+   { 0xE5, "SBC", C6502::SBC<AM_ZEROPAGE>, AM_ZEROPAGE, 3, true, false, 0x4 }, // SBC - Zero Page
+   { 0xE6, "INC", C6502::INC<AM_ZEROPAGE>, AM_ZEROPAGE, 5, true, false, 0x10 }, // INC - Zero Page
+   { 0xE7, "INS", C6502::INS<AM_ZEROPAGE>, AM_ZEROPAGE, 5, false, false, 0x10 }, // INS - Zero Page (undocumented)
    { 0xE8, "INX", C6502::INX, AM_IMPLIED, 2, true, false, 0x2 }, // INX
-   { 0xE9, "SBC", C6502::SBC, AM_IMMEDIATE, 2, true, false, 0x2 }, // SBC - Immediate
+   { 0xE9, "SBC", C6502::SBC<AM_IMMEDIATE>, AM_IMMEDIATE, 2, true, false, 0x2 }, // SBC - Immediate
    { 0xEA, "NOP", C6502::NOP, AM_IMPLIED, 2, true, false, 0x2 }, // NOP
-   { 0xEB, "SBC", C6502::SBC, AM_IMMEDIATE, 2, false, false, 0x2 }, // SBC - Immediate (undocumented)
-   { 0xEC, "CPX", C6502::CPX, AM_ABSOLUTE, 4, true, false, 0x8 }, // CPX - Absolute
-   { 0xED, "SBC", C6502::SBC, AM_ABSOLUTE, 4, true, false, 0x8 }, // SBC - Absolute
-   { 0xEE, "INC", C6502::INC, AM_ABSOLUTE, 6, true, false, 0x20 }, // INC - Absolute
-   { 0xEF, "INS", C6502::INS, AM_ABSOLUTE, 6, false, false, 0x20 }, // INS - Absolute (undocumented)
+   { 0xEB, "SBC", C6502::SBC<AM_IMMEDIATE>, AM_IMMEDIATE, 2, false, false, 0x2 }, // SBC - Immediate (undocumented)
+   { 0xEC, "CPX", C6502::CPX<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // CPX - Absolute
+   { 0xED, "SBC", C6502::SBC<AM_ABSOLUTE>, AM_ABSOLUTE, 4, true, false, 0x8 }, // SBC - Absolute
+   { 0xEE, "INC", C6502::INC<AM_ABSOLUTE>, AM_ABSOLUTE, 6, true, false, 0x20 }, // INC - Absolute
+   { 0xEF, "INS", C6502::INS<AM_ABSOLUTE>, AM_ABSOLUTE, 6, false, false, 0x20 }, // INS - Absolute (undocumented)
    { 0xF0, "BEQ", C6502::BEQ, AM_RELATIVE, 2, true, false, 0xA }, // BEQ
-   { 0xF1, "SBC", C6502::SBC, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // SBC - (Indirect),Y
+   { 0xF1, "SBC", C6502::SBC<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 5, true, false, 0x10 }, // SBC - (Indirect),Y
    { 0xF2, "KIL", C6502::KIL, AM_IMPLIED, 0, false, false, 0x0 }, // KIL - Implied (processor lock up!)
-   { 0xF3, "INS", C6502::INS, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // INS - (Indirect),Y (undocumented)
-   { 0xF4, "DOP", C6502::DOP, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
-   { 0xF5, "SBC", C6502::SBC, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // SBC - Zero Page,X
-   { 0xF6, "INC", C6502::INC, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // INC - Zero Page,X
-   { 0xF7, "INS", C6502::INS, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // INS - Zero Page,X (undocumented)
+   { 0xF3, "INS", C6502::INS<AM_POSTINDEXED_INDIRECT>, AM_POSTINDEXED_INDIRECT, 8, false, true, 0x80 }, // INS - (Indirect),Y (undocumented)
+   { 0xF4, "DOP", C6502::DOP<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, false, false, 0x8 }, // DOP (undocumented)
+   { 0xF5, "SBC", C6502::SBC<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 4, true, false, 0x8 }, // SBC - Zero Page,X
+   { 0xF6, "INC", C6502::INC<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, true, false, 0x20 }, // INC - Zero Page,X
+   { 0xF7, "INS", C6502::INS<AM_ZEROPAGE_INDEXED_X>, AM_ZEROPAGE_INDEXED_X, 6, false, false, 0x20 }, // INS - Zero Page,X (undocumented)
    { 0xF8, "SED", C6502::SED, AM_IMPLIED, 2, true, false, 0x2 }, // SED
-   { 0xF9, "SBC", C6502::SBC, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // SBC - Absolute,Y
+   { 0xF9, "SBC", C6502::SBC<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 4, true, false, 0x8 }, // SBC - Absolute,Y
    { 0xFA, "NOP", C6502::NOP, AM_IMPLIED, 2, false, false, 0x2 }, // NOP (undocumented)
-   { 0xFB, "INS", C6502::INS, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // INS - Absolute,Y (undocumented)
-   { 0xFC, "TOP", C6502::TOP, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
-   { 0xFD, "SBC", C6502::SBC, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // SBC - Absolute,X
-   { 0xFE, "INC", C6502::INC, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // INC - Absolute,X
-   { 0xFF, "INS", C6502::INS, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }  // INS - Absolute,X (undocumented)
+   { 0xFB, "INS", C6502::INS<AM_ABSOLUTE_INDEXED_Y>, AM_ABSOLUTE_INDEXED_Y, 7, false, true, 0x40 }, // INS - Absolute,Y (undocumented)
+   { 0xFC, "TOP", C6502::TOP<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, false, false, 0x8 }, // TOP (undocumented)
+   { 0xFD, "SBC", C6502::SBC<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 4, true, false, 0x8 }, // SBC - Absolute,X
+   { 0xFE, "INC", C6502::INC<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, true, true, 0x40 }, // INC - Absolute,X
+   { 0xFF, "INS", C6502::INS<AM_ABSOLUTE_INDEXED_X>, AM_ABSOLUTE_INDEXED_X, 7, false, true, 0x40 }  // INS - Absolute,X (undocumented)
 };
 
+#if !defined ( NES_MULTI_INSTANCE )
 static C6502 __init __attribute__((unused));
+#endif
 
 C6502::C6502()
 {
-   int32_t addr;
-
-   m_RAMdisassembly = new char*[MEM_2KB];
-   for ( addr = 0; addr < MEM_2KB; addr++ )
-   {
-      m_RAMdisassembly[addr] = new char [ 16 ];
-   }
+   m_RAMdisassembly = new char[MEM_2KB*DISASSEMBLY_LINE_SIZE];
    m_RAMopcodeMask = new uint8_t[MEM_2KB];
    m_RAMsloc2addr = new uint16_t[MEM_2KB];
    m_RAMaddr2sloc = new uint16_t[MEM_2KB];
@@ -528,12 +533,6 @@ C6502::C6502()
 
 C6502::~C6502()
 {
-   int32_t addr;
-
-   for ( addr = 0; addr < MEM_2KB; addr++ )
-   {
-      delete m_RAMdisassembly[addr];
-   }
    delete [] m_RAMdisassembly;
    delete [] m_RAMopcodeMask;
    delete [] m_RAMsloc2addr;
@@ -580,28 +579,19 @@ void C6502::EMULATE ( int32_t cycles )
 
                   CNES::CHECKBREAKPOINT ( eBreakInCPU, eBreakOnCPUExecution, (*opcodeData) );
 
+#if !defined ( NES_NO_DEBUG )
                   // Save the pointer to where to put the disassembly of
                   // the current opcode now.  This might be the last fetch
                   // for an instruction and the disassembly should be placed there.
                   pDisassemblySample = CNES::TRACER()->GetLastCPUSample ();
+#endif
 
                   // Check flags breakpoint.  Do it here instead of everywhere flags are
                   // changed so as to limit the number of calls to check the breakpoint.
                   CNES::CHECKBREAKPOINT(eBreakInCPU,eBreakOnCPUState,CPU_F);
 
                   // Check for KIL opcodes...
-                  if ( (((*opcodeData) == 0x02) ||
-                        ((*opcodeData) == 0x12) ||
-                        ((*opcodeData) == 0x22) ||
-                        ((*opcodeData) == 0x32) ||
-                        ((*opcodeData) == 0x42) ||
-                        ((*opcodeData) == 0x52) ||
-                        ((*opcodeData) == 0x62) ||
-                        ((*opcodeData) == 0x72) ||
-                        ((*opcodeData) == 0x92) ||
-                        ((*opcodeData) == 0xB2) ||
-                        ((*opcodeData) == 0xD2) ||
-                        ((*opcodeData) == 0xF2)) )
+                  if ( m_6502opcode[(*opcodeData)].pFn == C6502::KIL )
                   {
                      // KIL opcodes halt PC dead!  Force break if desired...
                      if ( m_breakOnKIL )
@@ -836,7 +826,6 @@ void C6502::ADVANCE ( bool stealing )
 bool C6502::DMA( void )
 {
    bool doCycle = true;
-   static uint8_t databuf;
 
    // If the DMC DMA request is active it means the CPU was writing when
    // the DMC DMA controller went active.  We need to assert RDY on the next
@@ -919,7 +908,7 @@ bool C6502::DMA( void )
       // If we're ready to do the sprite DMA read, do it.
       if ( m_writeDmaCounter )
       {
-         databuf = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
+         m_dmaBuffer = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
 
          if ( nesIsDebuggable() )
          {
@@ -987,7 +976,7 @@ bool C6502::DMA( void )
       {
          DMA ( (m_writeDmaAddr)|(((512-m_writeDmaCounter)>>1)&0xFF),
                OAMDATA,
-               databuf );
+               m_dmaBuffer );
          m_writeDmaCounter--;
          doCycle = false;
          goto done;
@@ -1038,7 +1027,7 @@ bool C6502::DMA( void )
       // If this is a read-beat, do the read.
       if ( !(m_writeDmaCounter&0x01) )
       {
-         databuf = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
+         m_dmaBuffer = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
          doCycle = false;
       }
       // If this is a write-beat, do the write.
@@ -1046,7 +1035,7 @@ bool C6502::DMA( void )
       {
          DMA ( (m_writeDmaAddr)|(((512-m_writeDmaCounter)>>1)&0xFF),
                OAMDATA,
-               databuf );
+               m_dmaBuffer );
          doCycle = false;
       }
       m_writeDmaCounter--;
@@ -1091,7 +1080,7 @@ bool C6502::DMA( void )
       {
          if ( !(m_writeDmaCounter&1) )
          {
-            databuf = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
+            m_dmaBuffer = DMA(m_writeDmaAddr|(((512-m_writeDmaCounter)>>1)&0xFF));
             m_writeDmaCounter--;
             doCycle = false;
          }
@@ -1100,7 +1089,7 @@ bool C6502::DMA( void )
          {
             DMA ( (m_writeDmaAddr)|(((512-m_writeDmaCounter)>>1)&0xFF),
                   OAMDATA,
-                  databuf );
+                  m_dmaBuffer );
             m_writeDmaCounter--;
             doCycle = false;
          }
@@ -1226,12 +1215,13 @@ void C6502::XAA ( void )
 // ------------|-----------|---|---|---
 // Absolute,Y  |AXA arg,Y  |$9F| 3 | 5
 // (Indirect),Y|AXA arg    |$93| 2 | 6
+template <int32_t AMODE>
 void C6502::AXA ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = (rX()&rA())&7;
    MEM ( addr, val );
 
@@ -1251,13 +1241,14 @@ void C6502::AXA ( void )
 // Addressing  |Mnemonics  |Opc|Sz | n
 // ------------|-----------|---|---|---
 // Absolute,Y  |XAS arg,Y  |$9B| 3 | 5
+template <int32_t AMODE>
 void C6502::TAS ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
    wSP ( rX()&rA() );
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = (rSP()&((*(data+1))+1));
    MEM ( addr, val );
 
@@ -1276,12 +1267,13 @@ void C6502::TAS ( void )
 // Addressing  |Mnemonics  |Opc|Sz | n
 // ------------|-----------|---|---|---
 // Absolute,X  |SYA arg,X  |$9C| 3 | 5
+template <int32_t AMODE>
 void C6502::SAY ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = (rY()&((addr>>8)+1));
    addr &= 0x00FF;
    addr |= (val<<8);
@@ -1302,12 +1294,13 @@ void C6502::SAY ( void )
 // Addressing  |Mnemonics  |Opc|Sz | n
 // ------------|-----------|---|---|---
 // Absolute,Y  |SXA arg,Y  |$9E| 3 | 5
+template <int32_t AMODE>
 void C6502::XAS ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = (rX()&((addr>>8)+1));
    addr &= 0x00FF;
    addr |= (val<<8);
@@ -1343,11 +1336,12 @@ void C6502::OAL ( void )
 // Addressing  |Mnemonics  |Opc|Sz | n
 // ------------|-----------|---|---|---
 // Absolute,Y  |LAR arg,Y  |$BB| 3 | 4 *
+template <int32_t AMODE>
 void C6502::LAS ( void )
 {
    uint16_t addr;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    wA ( rSP()&MEM(addr) );
    wX ( rA() );
    wSP ( rA() );
@@ -1395,12 +1389,13 @@ void C6502::SAX ( void )
 // Absolute,Y  |SLO arg,Y  |$1B| 3 | 7
 // (Indirect,X)|SLO (arg,X)|$03| 2 | 8
 // (Indirect),Y|SLO (arg),Y|$13| 2 | 8
+template <int32_t AMODE>
 void C6502::ASO ( void )
 {
    uint16_t addr;
    uint16_t val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    val <<= 1;
@@ -1429,11 +1424,12 @@ void C6502::ASO ( void )
 // Zero Page,Y |AAX arg,Y  |$97| 2 | 4
 // (Indirect,X)|AAX (arg,X)|$83| 2 | 6
 // Absolute    |AAX arg    |$8F| 3 | 4
+template <int32_t AMODE>
 void C6502::AXS ( void )
 {
    uint16_t addr;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
 
    MEM ( addr, rA()&rX() );
 
@@ -1460,17 +1456,18 @@ void C6502::AXS ( void )
 //  |  (Indirect),Y  |   ORA (Oper),Y        |    11   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 on page crossing
+template <int32_t AMODE>
 void C6502::ORA ( void )
 {
    uint16_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wA ( rA()|(*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wA ( rA()|MEM(addr) );
    }
 
@@ -1495,18 +1492,19 @@ void C6502::ORA ( void )
 //  |  Absolute      |   ASL Oper            |    0E   |    3    |    6     |
 //  |  Absolute, X   |   ASL Oper,X          |    1E   |    3    |    7     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::ASL ( void )
 {
    uint16_t addr = 0x0000;
    uint16_t val;
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       val = rA ();
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
 
       // dummy write
@@ -1515,7 +1513,7 @@ void C6502::ASL ( void )
 
    val <<= 1;
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       wA ( (uint8_t)val );
    }
@@ -1657,17 +1655,18 @@ void C6502::JSR ( void )
 //  |  (Indirect,Y)  |   AND (Oper),Y        |    31   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::AND ( void )
 {
    uint16_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wA ( rA()&(*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wA ( rA()&MEM(addr) );
    }
 
@@ -1691,12 +1690,13 @@ void C6502::AND ( void )
 //  |  Zero Page     |   BIT Oper            |    24   |    2    |    3     |
 //  |  Absolute      |   BIT Oper            |    2C   |    3    |    4     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::BIT ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
 
    val = MEM ( addr );
 
@@ -1725,18 +1725,19 @@ void C6502::BIT ( void )
 //  |  Absolute      |   ROL Oper            |    2E   |    3    |    6     |
 //  |  Absolute,X    |   ROL Oper,X          |    3E   |    3    |    7     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::ROL ( void )
 {
    uint16_t addr = 0x0000;
    uint16_t val;
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       val = rA ();
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
 
       // dummy write
@@ -1750,7 +1751,7 @@ void C6502::ROL ( void )
    wN ( val&0x80 );
    wZ ( !val );
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       wA ( (uint8_t)val );
    }
@@ -1895,17 +1896,18 @@ void C6502::RTI ( void )
 //  |  (Indirect),Y  |   EOR (Oper),Y        |    51   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::EOR ( void )
 {
    uint16_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wA ( rA()^(*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wA ( rA()^MEM(addr) );
    }
 
@@ -1929,12 +1931,13 @@ void C6502::EOR ( void )
 // Absolute,Y  |SRE arg,Y  |$5B| 3 | 7
 // (Indirect,X)|SRE (arg,X)|$43| 2 | 8
 // (Indirect),Y|SRE (arg),Y|$53| 2 | 8
+template <int32_t AMODE>
 void C6502::LSE ( void )
 {
    uint16_t addr;
    uint16_t val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    wC ( val&0x01 );
@@ -1967,18 +1970,19 @@ void C6502::LSE ( void )
 //  |  Absolute      |   LSR Oper            |    4E   |    3    |    6     |
 //  |  Absolute,X    |   LSR Oper,X          |    5E   |    3    |    7     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::LSR ( void )
 {
    uint16_t addr = 0x0000;
    uint16_t val;
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       val = rA ();
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
 
       // dummy write
@@ -1991,7 +1995,7 @@ void C6502::LSR ( void )
    cN ();
    wZ ( !val );
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       wA ( (uint8_t)val );
    }
@@ -2031,11 +2035,12 @@ void C6502::PHA ( void )
 //  |  Absolute      |   JMP Oper            |    4C   |    3    |    3     |
 //  |  Indirect      |   JMP (Oper)          |    6C   |    3    |    5     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::JMP ( void )
 {
    uint32_t addr = MAKE16(GETUNSIGNED8(data,0),GETUNSIGNED8(data,1));
 
-   if ( amode == AM_ABSOLUTE )
+   if ( AMODE == AM_ABSOLUTE )
    {
       wPC ( addr );
    }
@@ -2171,19 +2176,20 @@ void C6502::RTS ( void )
 //  |  (Indirect),Y  |   ADC (Oper),Y        |    71   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::ADC ( void )
 {
    uint32_t addr;
    int16_t result;
    uint8_t val;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       val = (*data);
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
    }
 
@@ -2218,18 +2224,19 @@ void C6502::ADC ( void )
 //
 //    Note: ROR instruction is available on MCS650X microprocessors after
 //          June, 1976.
+template <int32_t AMODE>
 void C6502::ROR ( void )
 {
    uint32_t addr = 0x0000;
    uint16_t val;
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       val = rA ();
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
 
       // dummy write
@@ -2243,7 +2250,7 @@ void C6502::ROR ( void )
    wN ( val&0x80 );
    wZ ( !val );
 
-   if ( amode == AM_ACCUMULATOR )
+   if ( AMODE == AM_ACCUMULATOR )
    {
       wA ( (uint8_t)val );
    }
@@ -2269,12 +2276,13 @@ void C6502::ROR ( void )
 // Absolute,Y  |RLA arg,Y  |$3B| 3 | 7
 // (Indirect,X)|RLA (arg,X)|$23| 2 | 8
 // (Indirect),Y|RLA (arg),Y|$33| 2 | 8
+template <int32_t AMODE>
 void C6502::RLA ( void )
 {
    uint32_t addr;
    uint16_t val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    val <<= 1;
@@ -2309,13 +2317,14 @@ void C6502::RLA ( void )
 // Absolute,Y  |RRA arg,Y  |$7B| 3 | 7
 // (Indirect,X)|RRA (arg,X)|$63| 2 | 8
 // (Indirect),Y|RRA (arg),Y|$73| 2 | 8
+template <int32_t AMODE>
 void C6502::RRA ( void )
 {
    uint32_t addr;
    uint16_t val;
    int16_t result;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    val |= ( rC()*0x100 );
@@ -2435,11 +2444,12 @@ void C6502::SEI ( void )
 //  |  (Indirect,X)  |   STA (Oper,X)        |    81   |    2    |    6     |
 //  |  (Indirect),Y  |   STA (Oper),Y        |    91   |    2    |    6     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::STA ( void )
 {
    uint16_t addr;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    MEM ( addr, rA() );
 
    return;
@@ -2457,11 +2467,12 @@ void C6502::STA ( void )
 //  |  Zero Page,X   |   STY Oper,X          |    94   |    2    |    4     |
 //  |  Absolute      |   STY Oper            |    8C   |    3    |    4     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::STY ( void )
 {
    uint16_t addr;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    MEM ( addr, rY() );
 
    return;
@@ -2479,11 +2490,12 @@ void C6502::STY ( void )
 //  |  Zero Page,Y   |   STX Oper,Y          |    96   |    2    |    4     |
 //  |  Absolute      |   STX Oper            |    8E   |    3    |    4     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::STX ( void )
 {
    uint16_t addr;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    MEM ( addr, rX() );
 
    return;
@@ -2616,17 +2628,18 @@ void C6502::TXS ( void )
 //  |  Absolute,X    |   LDY Oper,X          |    BC   |    3    |    4*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 when page boundary is crossed.
+template <int32_t AMODE>
 void C6502::LDY ( void )
 {
    uint32_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wY ( (*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wY ( MEM(addr) );
    }
 
@@ -2650,20 +2663,21 @@ void C6502::LDY ( void )
 // (Indirect,X)|LAX (arg,X)|$A3| 2 | 6
 // (Indirect),Y|LAX (arg),Y|$B3| 2 | 5 *
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::LAX ( void )
 {
    uint8_t val;
 
    uint32_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wA ( (*data) );
       wX ( (*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr ); // Single memory access cycle...
       wA ( val );
       wX ( val );
@@ -2693,17 +2707,18 @@ void C6502::LAX ( void )
 //  |  (Indirect),Y  |   LDA (Oper),Y        |    B1   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::LDA ( void )
 {
    uint32_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wA ( (*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wA ( MEM(addr) );
    }
 
@@ -2728,17 +2743,18 @@ void C6502::LDA ( void )
 //  |  Absolute,Y    |   LDX Oper,Y          |    BE   |    3    |    4*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 when page boundary is crossed.
+template <int32_t AMODE>
 void C6502::LDX ( void )
 {
    uint32_t addr;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       wX ( (*data) );
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       wX ( MEM(addr) );
    }
 
@@ -2875,18 +2891,19 @@ void C6502::TSX ( void )
 //  |  Zero Page     |   CPY Oper            |    C4   |    2    |    3     |
 //  |  Absolute      |   CPY Oper            |    CC   |    3    |    4     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::CPY ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       val = (*data)&0xFF;
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
    }
 
@@ -2917,18 +2934,19 @@ void C6502::CPY ( void )
 //  |  (Indirect),Y  |   CMP (Oper),Y        |    D1   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 if page boundary is crossed.
+template <int32_t AMODE>
 void C6502::CMP ( void )
 {
    uint32_t addr;
    uint8_t val;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       val = (*data)&0xFF;
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
    }
 
@@ -2955,12 +2973,13 @@ void C6502::CMP ( void )
 // Absolute,Y  |DCP arg,Y  |$DB| 3 | 7
 // (Indirect,X)|DCP (arg,X)|$C3| 2 | 8
 // (Indirect),Y|DCP (arg),Y|$D3| 2 | 8
+template <int32_t AMODE>
 void C6502::DCM ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
    val -= 1;
    MEM ( addr, val );
@@ -2990,12 +3009,13 @@ void C6502::DCM ( void )
 //  |  Absolute      |   DEC Oper            |    CE   |    3    |    6     |
 //  |  Absolute,X    |   DEC Oper,X          |    DE   |    3    |    7     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::DEC ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    // dummy write
@@ -3117,18 +3137,19 @@ void C6502::CLD ( void )
 //  |  Zero Page     |   CPX Oper            |    E4   |    2    |    3     |
 //  |  Absolute      |   CPX Oper            |    EC   |    3    |    4     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::CPX ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       val = (*data)&0xFF;
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
    }
 
@@ -3159,19 +3180,20 @@ void C6502::CPX ( void )
 //  |  (Indirect),Y  |   SBC (Oper),Y        |    F1   |    2    |    5*    |
 //  +----------------+-----------------------+---------+---------+----------+
 //  * Add 1 when page boundary is crossed.
+template <int32_t AMODE>
 void C6502::SBC ( void )
 {
    uint32_t addr;
    int16_t result;
    uint8_t val;
 
-   if ( amode == AM_IMMEDIATE )
+   if ( AMODE == AM_IMMEDIATE )
    {
       val = (*data);
    }
    else
    {
-      addr = MAKEADDR ( amode, data );
+      addr = MAKEADDR<AMODE> ( data );
       val = MEM ( addr );
    }
 
@@ -3198,12 +3220,13 @@ void C6502::SBC ( void )
 //  |  Absolute      |   INC Oper            |    EE   |    3    |    6     |
 //  |  Absolute,X    |   INC Oper,X          |    FE   |    3    |    7     |
 //  +----------------+-----------------------+---------+---------+----------+
+template <int32_t AMODE>
 void C6502::INC ( void )
 {
    uint16_t addr;
    uint8_t  val;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
 
    // dummy write
@@ -3231,13 +3254,14 @@ void C6502::INC ( void )
 // Absolute,Y  |ISC arg,Y  |$FB| 3 | 7
 // (Indirect,X)|ISC (arg,X)|$E3| 2 | 8
 // (Indirect),Y|ISC (arg),Y|$F3| 2 | 8
+template <int32_t AMODE>
 void C6502::INS ( void )
 {
    uint16_t addr;
    uint8_t  val;
    int16_t result;
 
-   addr = MAKEADDR ( amode, data );
+   addr = MAKEADDR<AMODE> ( data );
    val = MEM ( addr );
    val++;
    MEM ( addr, val );
@@ -3289,11 +3313,12 @@ void C6502::NOP ( void )
    return;
 }
 
+template <int32_t AMODE>
 void C6502::DOP ( void )
 {
-   /*uint16_t addr = */MAKEADDR ( amode, data );
+   /*uint16_t addr = */MAKEADDR<AMODE> ( data );
 
-   if ( amode != AM_IMMEDIATE )
+   if ( AMODE != AM_IMMEDIATE )
    {
       // A missing memory cycle here?
       // Synchronize CPU and APU...
@@ -3303,9 +3328,10 @@ void C6502::DOP ( void )
    return;
 }
 
+template <int32_t AMODE>
 void C6502::TOP ( void )
 {
-   /*uint16_t addr = */MAKEADDR ( amode, data );
+   /*uint16_t addr = */MAKEADDR<AMODE> ( data );
 
    // A missing memory cycle here?
    // Synchronize CPU and APU...
@@ -3385,8 +3411,6 @@ void C6502::SED ( void )
 void C6502::BRK ( void )
 {
    uint8_t         pchi;
-   static uint8_t  pclo = 0x00;
-   static bool     doingIrq = false;
 
    if ( !m_killed )
    {
@@ -3403,26 +3427,26 @@ void C6502::BRK ( void )
          PUSH ( rF() );
          if ( m_nmiPending )
          {
-            doingIrq = false;
+            m_brkDoingIrq = false;
          }
          else
          {
-            doingIrq = true;
+            m_brkDoingIrq = true;
          }
       }
       else
       {
-         if ( m_nmiPending && !doingIrq )
+         if ( m_nmiPending && !m_brkDoingIrq )
          {
             if ( m_instrCycle == 5 )
             {
-               pclo = MEM(VECTOR_NMI);
+               m_brkPCLO = MEM(VECTOR_NMI);
             }
             else if ( m_instrCycle == 6 )
             {
                pchi = MEM(VECTOR_NMI+1);
 
-               wPC ( MAKE16(pclo,pchi) );
+               wPC ( MAKE16(m_brkPCLO,pchi) );
 
                if ( rPC() == m_pcGoto )
                {
@@ -3438,20 +3462,20 @@ void C6502::BRK ( void )
 
                sI();
                m_nmiPending = false;
-               doingIrq = false;
+               m_brkDoingIrq = false;
             }
          }
          else
          {
             if ( m_instrCycle == 5 )
             {
-               pclo = MEM(VECTOR_IRQ);
+               m_brkPCLO = MEM(VECTOR_IRQ);
             }
             else if ( m_instrCycle == 6 )
             {
                pchi = MEM(VECTOR_IRQ+1);
 
-               wPC ( MAKE16(pclo,pchi) );
+               wPC ( MAKE16(m_brkPCLO,pchi) );
 
                if ( rPC() == m_pcGoto )
                {
@@ -3467,7 +3491,7 @@ void C6502::BRK ( void )
 
                sI();
                m_irqPending = false;
-               doingIrq = false;
+               m_brkDoingIrq = false;
             }
          }
       }
@@ -3529,6 +3553,9 @@ void C6502::RESET ( bool soft )
 {
    m_killed = false;
 
+   // The mapper has been reset already, so its banks are in place.
+   REMAP ();
+
    CAPU::RESET ();
 
    if ( nesIsDebuggable() )
@@ -3601,9 +3628,152 @@ void C6502::RESET ( bool soft )
    }
 }
 
+void C6502::STATE ( CSaveState& state )
+{
+   if ( state.BeginChunk(SAVESTATE_TAG('C','P','U',' '),1) )
+   {
+      state.Bytes ( m_6502memory, MEM_2KB );
+
+      state.Value ( m_a );
+      state.Value ( m_x );
+      state.Value ( m_y );
+      state.Value ( m_f );
+      state.Value ( m_pc );
+      state.Value ( m_pcSync );
+      state.Value ( m_pcSyncSet );
+      state.Value ( m_sp );
+      state.Value ( m_ea );
+
+      state.Value ( m_killed );
+      state.Value ( m_irqAsserted );
+      state.Value ( m_irqPending );
+      state.Value ( m_nmiAsserted );
+      state.Value ( m_nmiPending );
+
+      state.Value ( m_cycles );
+      state.Value ( m_instrCycle );
+      state.Value ( m_curCycles );
+
+      state.Value ( m_dmaRequest );
+      state.Value ( m_writeDmaAddr );
+      state.Value ( m_writeDmaCounter );
+      state.Value ( m_readDmaAddr );
+      state.Value ( m_readDmaCounter );
+      state.Value ( m_dmaBuffer );
+
+      state.Bytes ( opcodeData, 4 );
+      state.Value ( opcodeSize );
+      state.Value ( amode );
+      state.Value ( m_write );
+      state.Value ( m_openBusData );
+      state.Value ( m_phase );
+      state.Value ( m_brkPCLO );
+      state.Value ( m_brkDoingIrq );
+
+      state.EndChunk ();
+   }
+
+   if ( state.IsLoading() )
+   {
+      // Rebuild the decode pointers from the restored opcode bytes.
+      pOpcodeStruct = m_6502opcode+opcodeData[0];
+      data = opcodeData+1;
+      pDisassemblySample = NULL;
+   }
+}
+
+void C6502::REMAP ( void )
+{
+   MAPPERRFUNC defaultHighRead = CROM::HMAPPER;
+   MAPPERRFUNC defaultLowRead = CROM::LMAPPER;
+   MAPPERWFUNC defaultLowWrite = CROM::LMAPPER;
+   int32_t page;
+
+   for ( page = 0; page < 256; page++ )
+   {
+      m_pReadPage[page] = NULL;
+      m_pWritePage[page] = NULL;
+      m_pageTarget[page] = eTarget_Unknown;
+   }
+
+   // RAM is mirrored four times below $2000.
+   for ( page = 0x00; page < 0x20; page++ )
+   {
+      m_pReadPage[page] = m_6502memory+((page&0x07)<<8);
+      m_pWritePage[page] = m_pReadPage[page];
+      m_pageTarget[page] = eTarget_RAM;
+   }
+   for ( page = 0x60; page < 0x80; page++ )
+   {
+      m_pageTarget[page] = eTarget_SRAM;
+   }
+   for ( page = 0x80; page < 0x100; page++ )
+   {
+      m_pageTarget[page] = eTarget_Mapper;
+   }
+
+   // Mappers that do anything other than read and write through the bank
+   // pointers keep their handlers.  NROM with more than 32KB of PRG-ROM
+   // shows some of it at $6000-$7FFF instead of SRAM.
+   m_mapPRGROM = (MAPPERFUNC->highread == defaultHighRead);
+   m_mapSRAMRead = (MAPPERFUNC->lowread == defaultLowRead) &&
+                   (!((CROM::MAPPER() == 0) && (CROM::NUMPRGROMBANKS() > 4)));
+   m_mapSRAMWrite = (MAPPERFUNC->lowwrite == defaultLowWrite);
+
+   REMAPBANKS ();
+}
+
+void C6502::REMAPBANKS ( void )
+{
+   uint8_t* pBank;
+   int32_t  slot;
+   int32_t  page;
+
+   if ( m_mapPRGROM )
+   {
+      for ( slot = 0; slot < 4; slot++ )
+      {
+         pBank = CROM::PRGROMBANK ( 0x8000+(slot*MEM_8KB) );
+         page = 0x80+(slot<<5);
+         if ( m_pReadPage[page] != pBank )
+         {
+            for ( ; page < 0x80+((slot+1)<<5); page++ )
+            {
+               m_pReadPage[page] = pBank;
+               pBank += MEM_256B;
+            }
+         }
+      }
+   }
+
+   pBank = CROM::SRAMBANK ( 0x6000 );
+   if ( m_mapSRAMRead && (m_pReadPage[0x60] != pBank) )
+   {
+      for ( page = 0x60; page < 0x80; page++ )
+      {
+         m_pReadPage[page] = pBank+((page-0x60)<<8);
+      }
+   }
+   if ( m_mapSRAMWrite && (m_pWritePage[0x60] != pBank) )
+   {
+      for ( page = 0x60; page < 0x80; page++ )
+      {
+         m_pWritePage[page] = pBank+((page-0x60)<<8);
+      }
+   }
+}
+
 uint8_t C6502::LOAD ( uint32_t addr, int8_t* pTarget )
 {
-   uint8_t data = C6502::OPENBUS();
+   uint8_t  data = C6502::OPENBUS();
+   uint8_t* pPage = m_pReadPage[addr>>8];
+
+   // Plain memory is read straight through the memory map.
+   if ( pPage )
+   {
+      (*pTarget) = m_pageTarget[addr>>8];
+      return pPage[addr&0xFF];
+   }
 
    if ( addr >= 0x8000 )
    {
@@ -3668,6 +3838,20 @@ uint8_t C6502::LOAD ( uint32_t addr, int8_t* pTarget )
 
 void C6502::STORE ( uint32_t addr, uint8_t data, int8_t* pTarget )
 {
+   uint8_t* pPage = m_pWritePage[addr>>8];
+
+   // Plain memory is written straight through the memory map.
+   if ( pPage )
+   {
+      (*pTarget) = m_pageTarget[addr>>8];
+      pPage[addr&0xFF] = data;
+      if ( addr >= SRAM_START )
+      {
+         CROM::SRAMDIRTY ( true );
+      }
+      return;
+   }
+
    if ( addr < 0x2000 )
    {
       (*pTarget) = eTarget_RAM;
@@ -3714,21 +3898,25 @@ void C6502::STORE ( uint32_t addr, uint8_t data, int8_t* pTarget )
    {
       (*pTarget) = eTarget_Mapper;
       MAPPERFUNC->lowwrite ( addr, data );
+      REMAPBANKS ();
    }
    else if ( addr < 0x6000 )
    {
       (*pTarget) = eTarget_EXRAM;
       MAPPERFUNC->lowwrite ( addr, data );
+      REMAPBANKS ();
    }
    else if ( addr < 0x8000 )
    {
       (*pTarget) = eTarget_SRAM;
       MAPPERFUNC->lowwrite ( addr, data );
+      REMAPBANKS ();
    }
    else
    {
       (*pTarget) = eTarget_Mapper;
       MAPPERFUNC->highwrite ( addr, data );
+      REMAPBANKS ();
    }
 }
 
@@ -4192,31 +4380,32 @@ void C6502::_MEM ( uint32_t addr, uint8_t data )
    STORE ( addr, data, &target );
 }
 
-uint32_t C6502::MAKEADDR ( int32_t amode, uint8_t* data )
+template <int32_t AMODE>
+uint32_t C6502::MAKEADDR ( uint8_t* data )
 {
    uint16_t addr = 0x00, addrpre;
 
-   if ( amode == AM_ZEROPAGE )
+   if ( AMODE == AM_ZEROPAGE )
    {
       addr = (*data);
    }
-   else if ( amode == AM_ZEROPAGE_INDEXED_X )
+   else if ( AMODE == AM_ZEROPAGE_INDEXED_X )
    {
       // dummy read
       MEM(*data);
       addr = ((*data)+rX())&0xFF;
    }
-   else if ( amode == AM_ZEROPAGE_INDEXED_Y )
+   else if ( AMODE == AM_ZEROPAGE_INDEXED_Y )
    {
       // dummy read
       MEM(*data);
       addr = ((*data)+rY())&0xFF;
    }
-   else if ( amode == AM_ABSOLUTE )
+   else if ( AMODE == AM_ABSOLUTE )
    {
       addr = MAKE16((*data),(*(data+1)));
    }
-   else if ( amode == AM_ABSOLUTE_INDEXED_X )
+   else if ( AMODE == AM_ABSOLUTE_INDEXED_X )
    {
       addrpre = MAKE16((*data),(*(data+1)));
       addr = addrpre+rX();
@@ -4228,7 +4417,7 @@ uint32_t C6502::MAKEADDR ( int32_t amode, uint8_t* data )
          MEM((addrpre&0xFF00)+((addrpre+rX())&0xFF));
       }
    }
-   else if ( amode == AM_ABSOLUTE_INDEXED_Y )
+   else if ( AMODE == AM_ABSOLUTE_INDEXED_Y )
    {
       addrpre = MAKE16((*data),(*(data+1)));
       addr = addrpre+rY();
@@ -4239,13 +4428,13 @@ uint32_t C6502::MAKEADDR ( int32_t amode, uint8_t* data )
          MEM((addrpre&0xFF00)+((addrpre+rY())&0xFF));
       }
    }
-   else if ( amode == AM_PREINDEXED_INDIRECT )
+   else if ( AMODE == AM_PREINDEXED_INDIRECT )
    {
       // dummy read
       MEM(*data);
       addr = MAKE16(MEM(((*data)+rX())&0xFF),MEM(((*data)+rX()+1)&0xFF));
    }
-   else if ( amode == AM_POSTINDEXED_INDIRECT )
+   else if ( AMODE == AM_POSTINDEXED_INDIRECT )
    {
       addrpre = MAKE16(MEM((*data)),MEM(((*data)+1)&0xFF));
       addr = addrpre+rY();
@@ -4277,87 +4466,158 @@ void C6502::DISASSEMBLE ()
    }
 }
 
-void C6502::DISASSEMBLE ( char** disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength )
+int32_t C6502::DISASSEMBLELINE ( char* disassembly, uint8_t* binary, int32_t addr, int32_t binaryLength, uint8_t mask )
 {
    CNES6502_opcode* pOp;
    int32_t opSize;
    uint8_t op;
    char* ptr;
-   uint8_t mask;
 
-   (*sourceLength) = 0;
+   op = *(binary+addr);
+   pOp = m_6502opcode+op;
+   opSize = *(opcode_size+pOp->amode);
 
-   for ( int32_t i = 0; i < binaryLength; )
+   ptr = disassembly;
+
+   // If we've discovered this address has been executed by the 6502 we'll
+   // attempt to provide disassembly for it...
+   if ( (mask) && ((addr+opSize) < binaryLength) )
    {
-      op = *(binary+i);
-      pOp = m_6502opcode+op;
-      opSize = *(opcode_size+pOp->amode);
+      sprintf_opcode ( ptr, pOp->name );
 
-      mask = *(opcodeMask+i);
+      switch ( pOp->amode )
+      {
+            // Single byte operands
+         case AM_IMMEDIATE:
+         case AM_ZEROPAGE_INDEXED_X:
+         case AM_ZEROPAGE_INDEXED_Y:
+         case AM_ZEROPAGE:
+         case AM_PREINDEXED_INDIRECT:
+         case AM_POSTINDEXED_INDIRECT:
+         case AM_RELATIVE:
+            ptr += sprintf ( ptr, operandFmt[pOp->amode], binary[addr+1] );
+            break;
+
+            // Two byte operands
+         case AM_ABSOLUTE:
+         case AM_ABSOLUTE_INDEXED_X:
+         case AM_ABSOLUTE_INDEXED_Y:
+         case AM_INDIRECT:
+            ptr += sprintf ( ptr, operandFmt[pOp->amode], binary[addr+2], binary[addr+1] );
+            break;
+      }
 
-      ptr = (*disassembly);
+      if ( opSize > 2 )
+      {
+         strcpy(disassembly+(DISASSEMBLY_LINE_SIZE*2), disassembly);
+      }
+
+      if ( opSize > 1 )
+      {
+         strcpy(disassembly+DISASSEMBLY_LINE_SIZE, disassembly);
+      }
+
+      return opSize;
+   }
+
+   sprintf_db(ptr);
+   sprintf_02x(ptr,binary[addr]);
+
+   return 1;
+}
+
+void C6502::DISASSEMBLE ( char* disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength )
+{
+   int32_t lineSize;
+
+   (*sourceLength) = 0;
+
+   for ( int32_t i = 0; i < binaryLength; )
+   {
+      lineSize = DISASSEMBLELINE ( disassembly, binary, i, binaryLength, *(opcodeMask+i) );
 
       // save sloc
       (*sloc2addr) = i;
       sloc2addr++;
-      (*addr2sloc) = (*sourceLength);
-      addr2sloc++;
-
-      // If we've discovered this address has been executed by the 6502 we'll
-      // attempt to provide disassembly for it...
-      if ( (mask) && ((i+opSize) < binaryLength) )
+      for ( i += lineSize; lineSize; lineSize-- )
       {
-         sprintf_opcode ( ptr, pOp->name );
+         (*addr2sloc) = (*sourceLength);
+         addr2sloc++;
+         disassembly += DISASSEMBLY_LINE_SIZE;
+      }
 
-         switch ( pOp->amode )
-         {
-               // Single byte operands
-            case AM_IMMEDIATE:
-            case AM_ZEROPAGE_INDEXED_X:
-            case AM_ZEROPAGE_INDEXED_Y:
-            case AM_ZEROPAGE:
-            case AM_PREINDEXED_INDIRECT:
-            case AM_POSTINDEXED_INDIRECT:
-            case AM_RELATIVE:
-               ptr += sprintf ( ptr, operandFmt[pOp->amode], binary[i+1] );
-               break;
-
-               // Two byte operands
-            case AM_ABSOLUTE:
-            case AM_ABSOLUTE_INDEXED_X:
-            case AM_ABSOLUTE_INDEXED_Y:
-            case AM_INDIRECT:
-               ptr += sprintf ( ptr, operandFmt[pOp->amode], binary[i+2], binary[i+1] );
-               break;
-         }
+      (*sourceLength)++;
+   }
+}
 
-         if ( opSize > 2 )
-         {
-            strcpy((*(disassembly+2)), (*disassembly));
-            (*addr2sloc) = (*sourceLength);
-            addr2sloc++;
-         }
+void C6502::DISASSEMBLE ( char* disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength, int32_t changedStart, int32_t changedEnd )
+{
+   int32_t  addr;
+   int32_t  start;
+   int32_t  idx;
+   int32_t  lineSize;
+   uint32_t sloc;
+   uint32_t oldSloc;
+   uint16_t oldPrevSloc = 0;
 
-         if ( opSize > 1 )
-         {
-            strcpy((*(disassembly+1)), (*disassembly));
-            (*addr2sloc) = (*sourceLength);
-            addr2sloc++;
-         }
+   if ( changedStart >= changedEnd )
+   {
+      return;
+   }
+
+   // The lines before the one the first change is in come out the same, so
+   // start over at that line.
+   start = *(sloc2addr+(*(addr2sloc+changedStart)));
+   sloc = *(addr2sloc+start);
 
-         i += opSize;
-         disassembly += opSize;
+   // Redo lines until past the changes and on an address where a line
+   // started before.  From there on the lines are the same as they were,
+   // they just might have different line numbers.  The old line numbers
+   // of the addresses already redone are gone so the one before the current
+   // address is kept aside to tell whether a line started there.
+   for ( addr = start; addr < binaryLength; )
+   {
+      if ( (addr >= changedEnd) && ((*(addr2sloc+addr)) != oldPrevSloc) )
+      {
+         break;
       }
-      else
+
+      lineSize = DISASSEMBLELINE ( disassembly+(addr*DISASSEMBLY_LINE_SIZE), binary, addr, binaryLength, *(opcodeMask+addr) );
+      oldPrevSloc = *(addr2sloc+addr+lineSize-1);
+      for ( ; lineSize; lineSize-- )
       {
-         sprintf_db(ptr);
-         sprintf_02x(ptr,binary[i]);
+         *(addr2sloc+addr) = sloc;
+         addr++;
+      }
+      sloc++;
+   }
 
-         i++;
-         disassembly++;
+   if ( addr < binaryLength )
+   {
+      // Shift the line numbers of the lines that didn't change.
+      oldSloc = *(addr2sloc+addr);
+      if ( sloc != oldSloc )
+      {
+         memmove ( sloc2addr+sloc, sloc2addr+oldSloc, ((*sourceLength)-oldSloc)*sizeof(uint16_t) );
+         (*sourceLength) = (*sourceLength)+sloc-oldSloc;
+         for ( idx = addr; idx < binaryLength; idx++ )
+         {
+            *(addr2sloc+idx) += sloc-oldSloc;
+         }
       }
+   }
+   else
+   {
+      (*sourceLength) = sloc;
+   }
 
-      (*sourceLength)++;
+   // Line numbers of the lines that were redone.
+   for ( idx = start; idx < addr; idx++ )
+   {
+      if ( (idx == start) || ((*(addr2sloc+idx)) != (*(addr2sloc+idx-1))) )
+      {
+         *(sloc2addr+(*(addr2sloc+idx))) = idx;
+      }
    }
 }
 
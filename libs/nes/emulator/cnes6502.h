@@ -37,6 +37,10 @@
 #define GETHI8(wd) (((wd)>>8)&0xFF)
 #define GETLO8(wd) ((wd)&0xFF)
 
+// Space for one line of runtime disassembly, the longest being
+// something like "*NOP $1234,X".
+#define DISASSEMBLY_LINE_SIZE 16
+
 // CPU stack manipuation macros.
 #define GETSTACKADDR() (MAKE16(rSP(),0x01))
 #define GETSTACKDATA() (MEM(GETSTACKADDR()))
@@ -162,6 +166,9 @@ public:
    // CPU reset vector routine.
    static void RESET ( bool soft );
 
+   // Save or restore the CPU core state.
+   static void STATE ( CSaveState& state );
+
    // Routines to manipulate the IRQ/NMI inputs to the CPU core.
    static void ASSERTIRQ ( int8_t source );
    static void RELEASEIRQ ( int8_t source );
@@ -183,15 +190,19 @@ public:
 
    // CPU instruction execution routines.  Each routine
    // contains the logic to execute all addressing mode
-   // variants of the particular instruction.
+   // variants of the particular instruction.  Routines for
+   // instructions that access memory are templates on the
+   // addressing mode so the opcode table can point each opcode
+   // at a copy of the routine specialized for its addressing
+   // mode, with the addressing mode decode done by the compiler.
    // The documented opcodes:
-   static void ADC ( void );
-   static void AND ( void );
-   static void ASL ( void );
+   template <int32_t AMODE> static void ADC ( void );
+   template <int32_t AMODE> static void AND ( void );
+   template <int32_t AMODE> static void ASL ( void );
    static void BCC ( void );
    static void BCS ( void );
    static void BEQ ( void );
-   static void BIT ( void );
+   template <int32_t AMODE> static void BIT ( void );
    static void BMI ( void );
    static void BNE ( void );
    static void BPL ( void );
@@ -201,39 +212,39 @@ public:
    static void CLD ( void );
    static void CLI ( void );
    static void CLV ( void );
-   static void CMP ( void );
-   static void CPX ( void );
-   static void CPY ( void );
-   static void DEC ( void );
+   template <int32_t AMODE> static void CMP ( void );
+   template <int32_t AMODE> static void CPX ( void );
+   template <int32_t AMODE> static void CPY ( void );
+   template <int32_t AMODE> static void DEC ( void );
    static void DEX ( void );
    static void DEY ( void );
-   static void EOR ( void );
-   static void INC ( void );
+   template <int32_t AMODE> static void EOR ( void );
+   template <int32_t AMODE> static void INC ( void );
    static void INX ( void );
    static void INY ( void );
-   static void JMP ( void );
+   template <int32_t AMODE> static void JMP ( void );
    static void JSR ( void );
-   static void LDA ( void );
-   static void LDY ( void );
-   static void LDX ( void );
-   static void LSR ( void );
+   template <int32_t AMODE> static void LDA ( void );
+   template <int32_t AMODE> static void LDY ( void );
+   template <int32_t AMODE> static void LDX ( void );
+   template <int32_t AMODE> static void LSR ( void );
    static void NOP ( void );
-   static void ORA ( void );
+   template <int32_t AMODE> static void ORA ( void );
    static void PHA ( void );
    static void PHP ( void );
    static void PLA ( void );
    static void PLP ( void );
-   static void ROL ( void );
-   static void ROR ( void );
+   template <int32_t AMODE> static void ROL ( void );
+   template <int32_t AMODE> static void ROR ( void );
    static void RTI ( void );
    static void RTS ( void );
-   static void SBC ( void );
+   template <int32_t AMODE> static void SBC ( void );
    static void SEC ( void );
    static void SED ( void );
    static void SEI ( void );
-   static void STA ( void );
-   static void STX ( void );
-   static void STY ( void );
+   template <int32_t AMODE> static void STA ( void );
+   template <int32_t AMODE> static void STX ( void );
+   template <int32_t AMODE> static void STY ( void );
    static void TAX ( void );
    static void TAY ( void );
    static void TSX ( void );
@@ -242,26 +253,26 @@ public:
    static void TYA ( void );
 
    // The undocumented opcodes:
-   static void ASO ( void );
-   static void AXS ( void );
+   template <int32_t AMODE> static void ASO ( void );
+   template <int32_t AMODE> static void AXS ( void );
    static void ANC ( void );
    static void ALR ( void );
    static void ARR ( void );
-   static void DCM ( void );
-   static void INS ( void );
-   static void LAX ( void );
-   static void LSE ( void );
-   static void DOP ( void );
-   static void TOP ( void );
-   static void RLA ( void );
-   static void RRA ( void );
+   template <int32_t AMODE> static void DCM ( void );
+   template <int32_t AMODE> static void INS ( void );
+   template <int32_t AMODE> static void LAX ( void );
+   template <int32_t AMODE> static void LSE ( void );
+   template <int32_t AMODE> static void DOP ( void );
+   template <int32_t AMODE> static void TOP ( void );
+   template <int32_t AMODE> static void RLA ( void );
+   template <int32_t AMODE> static void RRA ( void );
    static void XAA ( void );
-   static void AXA ( void );
-   static void TAS ( void );
-   static void SAY ( void );
-   static void XAS ( void );
+   template <int32_t AMODE> static void AXA ( void );
+   template <int32_t AMODE> static void TAS ( void );
+   template <int32_t AMODE> static void SAY ( void );
+   template <int32_t AMODE> static void XAS ( void );
    static void OAL ( void );
-   static void LAS ( void );
+   template <int32_t AMODE> static void LAS ( void );
    static void SAX ( void );
 
    // The illegal opcodes:
@@ -322,6 +333,10 @@ public:
       memset(m_6502memory,0,MEM_2KB);
    }
 
+   // Rebuild the memory map the CPU core reads and writes through.  This
+   // must be done whenever the mapper is reset or its state is restored.
+   static void REMAP ( void );
+
    // Method to return the current open bus data.
    static uint8_t OPENBUS () { return m_openBusData; }
 
@@ -482,7 +497,14 @@ public:
 
    // Disassembly routines for display.
    static void DISASSEMBLE ();
-   static void DISASSEMBLE ( char** disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength );
+   // Disassembly text is kept one line of DISASSEMBLY_LINE_SIZE characters
+   // per byte of the binary, in one contiguous block.
+   static void DISASSEMBLE ( char* disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength );
+   // Bring a disassembly up to date after the opcode mask changed for the
+   // addresses from changedStart up to changedEnd.  Only the lines from the
+   // first change up to where the lines fall on the same addresses as before
+   // are redone; the line numbers of the rest are shifted.
+   static void DISASSEMBLE ( char* disassembly, uint8_t* binary, int32_t binaryLength, uint8_t* opcodeMask, uint16_t* sloc2addr, uint16_t* addr2sloc, uint32_t* sourceLength, int32_t changedStart, int32_t changedEnd );
    static char* Disassemble ( uint8_t* pOpcode, char* buffer );
 
    static inline CCodeDataLogger* LOGGER ( void )
@@ -555,7 +577,7 @@ public:
    }
    static inline char* DISASSEMBLY ( uint32_t addr )
    {
-      return *(m_RAMdisassembly+addr);
+      return m_RAMdisassembly+(addr*DISASSEMBLY_LINE_SIZE);
    }
    static uint32_t SLOC2ADDR ( uint16_t sloc )
    {
@@ -576,9 +598,14 @@ public:
    }
 
 protected:
+   // Disassemble the line at addr, returns how many bytes it covers.  The
+   // text is repeated for each of them.
+   static int32_t DISASSEMBLELINE ( char* disassembly, uint8_t* binary, int32_t addr, int32_t binaryLength, uint8_t mask );
+
    // Routine to calculate the effective address of a particular
    // instruction addressing mode based on the internal state of the CPU.
-   static inline uint32_t MAKEADDR ( int32_t amode, uint8_t* data );
+   // Performs the dummy reads the addressing mode requires.
+   template <int32_t AMODE> static inline uint32_t MAKEADDR ( uint8_t* data );
 
    // Routine to drive APU and CPU synchronization by cycles.
    static void ADVANCE ( bool stealing = false );
@@ -593,49 +620,66 @@ protected:
    static uint8_t LOAD ( uint32_t addr, int8_t* pTarget );
    static void STORE ( uint32_t addr, uint8_t data, int8_t* pTarget );
 
+   // Point the memory map at the PRG-ROM and SRAM banks the mapper has
+   // switched in.  Mappers only switch banks when their registers are
+   // written, so this is done after every write to a mapper.
+   static void REMAPBANKS ( void );
+
    // Is the CPU currently locked due to execution of an
    // illegal instruction?  Illegal instructions are all KIL opcodes.
-   static bool            m_killed;
+   static NES_THREAD_LOCAL bool            m_killed;
 
    // Has an IRQ been asserted to the CPU core?
-   static bool            m_irqAsserted;
+   static NES_THREAD_LOCAL bool            m_irqAsserted;
 
    // Was IRQ asserted when checked?
-   static bool            m_irqPending;
+   static NES_THREAD_LOCAL bool            m_irqPending;
 
    // Has NMI been asserted to the CPU core?
-   static bool            m_nmiAsserted;
+   static NES_THREAD_LOCAL bool            m_nmiAsserted;
 
    // Was NMI asserted when checked?
-   static bool            m_nmiPending;
+   static NES_THREAD_LOCAL bool            m_nmiPending;
 
    // The CPU core maintains the 2KB of RAM visible to the CPU.
-   static uint8_t*  m_6502memory;
+   static NES_THREAD_LOCAL uint8_t*  m_6502memory;
+
+   // The memory map.  Each 256-byte page of the CPU's address space that
+   // is plain memory (RAM, and PRG-ROM and SRAM if the mapper uses the
+   // default handlers for them) has a pointer straight to the memory and
+   // the tracer target it belongs to.  Pages that are NULL are registers
+   // or memory the mapper looks after itself, and go through the handlers.
+   static NES_THREAD_LOCAL uint8_t*  m_pReadPage [ 256 ];
+   static NES_THREAD_LOCAL uint8_t*  m_pWritePage [ 256 ];
+   static NES_THREAD_LOCAL int8_t    m_pageTarget [ 256 ];
+   static NES_THREAD_LOCAL bool      m_mapPRGROM;
+   static NES_THREAD_LOCAL bool      m_mapSRAMRead;
+   static NES_THREAD_LOCAL bool      m_mapSRAMWrite;
 
    // The CPU core registers.
-   static uint8_t   m_a;
-   static uint8_t   m_x;
-   static uint8_t   m_y;
-   static uint8_t   m_f;
-   static uint16_t  m_pc;
-   static uint16_t  m_pcSync;
-   static bool      m_pcSyncSet;
-   static uint8_t   m_sp;
+   static NES_THREAD_LOCAL uint8_t   m_a;
+   static NES_THREAD_LOCAL uint8_t   m_x;
+   static NES_THREAD_LOCAL uint8_t   m_y;
+   static NES_THREAD_LOCAL uint8_t   m_f;
+   static NES_THREAD_LOCAL uint16_t  m_pc;
+   static NES_THREAD_LOCAL uint16_t  m_pcSync;
+   static NES_THREAD_LOCAL bool      m_pcSyncSet;
+   static NES_THREAD_LOCAL uint8_t   m_sp;
 
    // The effective address calculated by the CPU core.
-   static uint32_t    m_ea;
+   static NES_THREAD_LOCAL uint32_t    m_ea;
 
    // The address to break at on a "run to here" go.
-   static uint32_t            m_pcGoto;
+   static NES_THREAD_LOCAL uint32_t            m_pcGoto;
 
    // Running counter of CPU cycles executed.  Will roll over in
    // approximately 40 minutes of emulation.
-   static uint32_t    m_cycles;
-   static int32_t     m_instrCycle;
+   static NES_THREAD_LOCAL uint32_t    m_cycles;
+   static NES_THREAD_LOCAL int32_t     m_instrCycle;
 
    // The current number of CPU cycles ready to be executed by
    // the CPU core.
-   static int32_t             m_curCycles; // must be allowed to go negative!
+   static NES_THREAD_LOCAL int32_t             m_curCycles; // must be allowed to go negative!
 
    // The following data is used internally by the CPU core
    // during instruction execution.  As opcodes are fetched and
@@ -644,61 +688,67 @@ protected:
    // on the stack frame during instruction execution via
    // function-pointer invocation.
    // The current opcode's addressing mode.
-   static int32_t             amode;
+   static NES_THREAD_LOCAL int32_t             amode;
 
    // DMC DMA request active flag.
-   static int32_t m_dmaRequest;
+   static NES_THREAD_LOCAL int32_t m_dmaRequest;
 
    // DMA address for DMA write transfers.  The CPU sets this on a DMA
    // request from a write to $4014, then begins its DMA transfer at the
    // appropriate time.  When not DMAing the counter will be 0.
-   static uint16_t m_writeDmaAddr;
-   static int32_t m_writeDmaCounter;
+   static NES_THREAD_LOCAL uint16_t m_writeDmaAddr;
+   static NES_THREAD_LOCAL int32_t m_writeDmaCounter;
 
    // DMA address for DMA read transfers.  The APU sets this on a DMA
    // request for a DMC channel sample, then begins its DMA transfer at the
    // appropriate time.  When not DMAing the counter will be 0.
-   static uint16_t m_readDmaAddr;
-   static int32_t m_readDmaCounter;
+   static NES_THREAD_LOCAL uint16_t m_readDmaAddr;
+   static NES_THREAD_LOCAL int32_t m_readDmaCounter;
 
    // The current opcode's full 1-, 2-, or 3-byte instruction data.
-   static uint8_t*  data;
-   static uint8_t   opcodeData [ 4 ]; // 3 opcode bytes and 1 byte for operand return data [extra cycle]
+   static NES_THREAD_LOCAL uint8_t*  data;
+   static NES_THREAD_LOCAL uint8_t   opcodeData [ 4 ]; // 3 opcode bytes and 1 byte for operand return data [extra cycle]
 
    // The current opcode's table entry (see struct _CNES6502_opcode below).
-   static struct _CNES6502_opcode* pOpcodeStruct;
+   static NES_THREAD_LOCAL struct _CNES6502_opcode* pOpcodeStruct;
 
    // The size of the current opcode in bytes (1, 2, or 3).
-   static int32_t             opcodeSize;
+   static NES_THREAD_LOCAL int32_t             opcodeSize;
 
    // Whether or not the CPU is in a write memory cycle.
-   static bool            m_write;
+   static NES_THREAD_LOCAL bool            m_write;
 
    // Open bus data to be returned if reading an unconnected memory region.
-   static uint8_t m_openBusData;
+   static NES_THREAD_LOCAL uint8_t m_openBusData;
 
    // Which phase of instruction fetching is the CPU core in?
    // m_phase will be 0 during the opcode fetch.  m_phase will go
    // up to 1 if the fetched opcode is 1-byte (extra fetch cycle) or 2-bytes.
    // m_phase will go up to 3 if the fetched opcode is 3-byte.
    // Then m_phase goes to -1 for the instruction execution.
-   static int8_t            m_phase;
+   static NES_THREAD_LOCAL int8_t            m_phase;
+
+   // Data carried across cycles of a sprite DMA transfer and of
+   // the BRK/IRQ/NMI sequence.
+   static NES_THREAD_LOCAL uint8_t m_dmaBuffer;
+   static NES_THREAD_LOCAL uint8_t m_brkPCLO;
+   static NES_THREAD_LOCAL bool    m_brkDoingIrq;
 
    // This points to the last execution tracer tag that
    // is where the disassembly of the instruction should
    // be placed.
-   static TracerInfo* pDisassemblySample;
+   static NES_THREAD_LOCAL TracerInfo* pDisassemblySample;
 
    // Database used by the Execution Visualizer debugger inspector.
    // The data structure is maintained by the CPU core as it executes
    // instructions that are marked.
-   static CMarker*         m_marker;
+   static NES_THREAD_LOCAL CMarker*         m_marker;
 
    // Database used by the Code/Data Logger debugger inspector.  The data structure
    // is maintained by the CPU core as it performs fetches, reads,
    // writes, and DMA transfers to/from its managed RAM.  The
    // Code/Data Logger displays the collected information graphically.
-   static CCodeDataLogger* m_logger;
+   static NES_THREAD_LOCAL CCodeDataLogger* m_logger;
 
    // The database for CPU core registers.  Declaration
    // is in source file.
@@ -708,7 +758,7 @@ protected:
    static CMemoryDatabase* m_dbMemory;
 
    // Configuration from EmulatorPrefs.
-   static bool m_breakOnKIL;
+   static NES_THREAD_LOCAL bool m_breakOnKIL;
 
    // The database for CPU core breakpoint events.  Declaration
    // is in source file.
@@ -716,11 +766,11 @@ protected:
    static int32_t                    m_numBreakpointEvents;
 
    // The data structures that support runtime disassembly of executed code.
-   static uint8_t*   m_RAMopcodeMask;
-   static char**           m_RAMdisassembly;
-   static uint16_t*  m_RAMsloc2addr;
-   static uint16_t*  m_RAMaddr2sloc;
-   static uint32_t    m_RAMsloc;
+   static NES_THREAD_LOCAL uint8_t*   m_RAMopcodeMask;
+   static NES_THREAD_LOCAL char*            m_RAMdisassembly;
+   static NES_THREAD_LOCAL uint16_t*  m_RAMsloc2addr;
+   static NES_THREAD_LOCAL uint16_t*  m_RAMaddr2sloc;
+   static NES_THREAD_LOCAL uint32_t    m_RAMsloc;
 };
 
 // Structure representing each instruction and
@@ -233,31 +233,35 @@ CRegisterDatabase* CAPU::m_dbRegisters = dbRegisters;
 CBreakpointEventInfo** CAPU::m_tblBreakpointEvents = tblAPUEvents;
 int32_t                CAPU::m_numBreakpointEvents = NUM_APU_EVENTS;
 
-uint8_t CAPU::m_APUreg [] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-uint8_t CAPU::m_APUregDirty [] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
-bool          CAPU::m_irqEnabled = false;
-bool          CAPU::m_irqAsserted = false;
-CAPUSquare    CAPU::m_square[2];
-CAPUTriangle  CAPU::m_triangle;
-CAPUNoise     CAPU::m_noise;
-CAPUDMC       CAPU::m_dmc;
-
-uint16_t*      CAPU::m_waveBuf = NULL;
-int32_t        CAPU::m_waveBufProduce = 0;
-int32_t        CAPU::m_waveBufConsume = 0;
-
-uint32_t CAPU::m_cycles = 0;
-
-float        CAPU::m_sampleSpacer = 0.0;
-
-int32_t CAPU::m_sampleBufferSize = APU_BUFFER_SIZE;
-
-int32_t CAPU::m_sequencerMode = 0;
-int32_t CAPU::m_newSequencerMode = 0;
+NES_THREAD_LOCAL uint8_t CAPU::m_APUreg [] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+NES_THREAD_LOCAL uint8_t CAPU::m_APUregDirty [] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+NES_THREAD_LOCAL bool          CAPU::m_irqEnabled = false;
+NES_THREAD_LOCAL bool          CAPU::m_irqAsserted = false;
+NES_THREAD_LOCAL CAPUSquare    CAPU::m_square[2];
+NES_THREAD_LOCAL CAPUTriangle  CAPU::m_triangle;
+NES_THREAD_LOCAL CAPUNoise     CAPU::m_noise;
+NES_THREAD_LOCAL CAPUDMC       CAPU::m_dmc;
+
+NES_THREAD_LOCAL uint16_t*      CAPU::m_waveBuf = NULL;
+NES_THREAD_LOCAL int32_t        CAPU::m_waveBufProduce = 0;
+NES_THREAD_LOCAL int32_t        CAPU::m_waveBufConsume = 0;
+NES_THREAD_LOCAL bool           CAPU::m_keepSkippedSamples = false;
+
+NES_THREAD_LOCAL uint32_t CAPU::m_cycles = 0;
+
+NES_THREAD_LOCAL uint32_t     CAPU::m_sampleRate = SDL_SAMPLE_RATE;
+NES_THREAD_LOCAL int32_t      CAPU::m_mixLast = 0;
+NES_THREAD_LOCAL CBlipBuffer  CAPU::m_blip;
+NES_THREAD_LOCAL int16_t      CAPU::m_outLast = 0;
+
+NES_THREAD_LOCAL int32_t CAPU::m_sampleBufferSize = APU_BUFFER_SIZE;
+
+NES_THREAD_LOCAL int32_t CAPU::m_sequencerMode = 0;
+NES_THREAD_LOCAL int32_t CAPU::m_newSequencerMode = 0;
 // Cycles to wait before changing sequencer modes...0 or 1 are valid values
 // on a mode-change.
-int32_t CAPU::m_changeModes = -1;
-int32_t CAPU::m_sequenceStep = 0;
+NES_THREAD_LOCAL int32_t CAPU::m_changeModes = -1;
+NES_THREAD_LOCAL int32_t CAPU::m_sequenceStep = 0;
 
 // Events that can occur during the APU sequence stepping
 enum
@@ -320,9 +324,74 @@ static uint8_t m_lengthLUT [ 32 ] =
    0x1E
 };
 
-int32_t apuDataAvailable = 0;
+// The APU mixes its channels through resistor networks whose output isn't
+// linear in the DAC values:
+//
+//                            95.88
+//      square_out = -----------------------
+//                          8128
+//                   ----------------- + 100
+//                   square1 + square2
+//
+//
+//                            159.79
+//      tnd_out = ------------------------------
+//                            1
+//                ------------------------ + 100
+//                triangle   noise    dmc
+//                -------- + ----- + -----
+//                  8227     12241   22638
+//
+// The mixed output is needed every APU cycle, so both halves are worked out
+// once for every combination of DAC values, already scaled to the output
+// sample range.  The tables are the same for every emulator instance.
+static int16_t m_squareMixLUT [ 31 ];
+static int16_t m_tndMixLUT [ 16 ] [ 16 ] [ 128 ];
+
+static bool BUILDMIXLUTS ( void )
+{
+   int32_t square;
+   int32_t triangle;
+   int32_t noise;
+   int32_t dmc;
+   float   famp;
+
+   for ( square = 0; square < 31; square++ )
+   {
+      famp = 0.0;
+      if ( square )
+      {
+         famp = (95.88/((8128.0/square)+100.0));
+      }
+      m_squareMixLUT[square] = (int16_t)(float)(65535.0*famp*0.50);
+   }
+
+   for ( triangle = 0; triangle < 16; triangle++ )
+   {
+      for ( noise = 0; noise < 16; noise++ )
+      {
+         for ( dmc = 0; dmc < 128; dmc++ )
+         {
+            famp = 0.0;
+            if ( triangle+noise+dmc )
+            {
+               famp = (159.79/((1.0/(((triangle/8227.0)+(noise/12241.0)+(dmc/22638.0))))+100.0));
+            }
+            m_tndMixLUT[triangle][noise][dmc] = (int16_t)(float)(65535.0*famp*0.50);
+         }
+      }
+   }
+
+   return true;
+}
+
+static bool m_mixLUTsBuilt __attribute__((unused)) = BUILDMIXLUTS();
 
+NES_THREAD_LOCAL int32_t apuDataAvailable = 0;
+
+#if !defined ( NES_MULTI_INSTANCE )
 static CAPU __init __attribute__((unused));
+#endif
 
 CAPU::CAPU()
 {
@@ -342,6 +411,11 @@ CAPU::CAPU()
    memset( m_waveBuf, 0, APU_BUFFER_SIZE * sizeof m_waveBuf[ 0 ] );
 }
 
+CAPU::~CAPU()
+{
+   delete [] m_waveBuf;
+}
+
 uint8_t* CAPU::PLAY ( uint16_t samples )
 {
    uint16_t* waveBuf;
@@ -358,65 +432,66 @@ uint8_t* CAPU::PLAY ( uint16_t samples )
    return (uint8_t*)waveBuf;
 }
 
-uint16_t CAPU::AMPLITUDE ( void )
+int32_t CAPU::READ ( int16_t* samples, int32_t count )
 {
-   float famp;
-   int16_t amp;
-   int16_t delta;
-   int16_t out[100] = { 0, };
-   static int16_t outLast = 0;
-   uint8_t sample;
-   uint8_t* sq1dacSamples = m_square[0].GETDACSAMPLES();
-   uint8_t* sq2dacSamples = m_square[1].GETDACSAMPLES();
-   uint8_t* triangleDacSamples = m_triangle.GETDACSAMPLES();
-   uint8_t* noiseDacSamples = m_noise.GETDACSAMPLES();
-   uint8_t* dmcDacSamples = m_dmc.GETDACSAMPLES();
-   static int32_t outDownsampled = 0;
-
-   for ( sample = 0; sample < m_square[0].GETDACSAMPLECOUNT(); sample++ )
-   {
-//      output = square_out + tnd_out
-//
-//
-//                            95.88
-//      square_out = -----------------------
-//                          8128
-//                   ----------------- + 100
-//                   square1 + square2
-//
-//
-//                            159.79
-//      tnd_out = ------------------------------
-//                            1
-//                ------------------------ + 100
-//                triangle   noise    dmc
-//                -------- + ----- + -----
-//                  8227     12241   22638
-      famp = 0.0;
-      if ( (*(sq1dacSamples+sample))+(*(sq2dacSamples+sample)) )
-      {
-         famp = (95.88/((8128.0/((*(sq1dacSamples+sample))+(*(sq2dacSamples+sample))))+100.0));
-      }
-      if ( (*(triangleDacSamples+sample))+(*(noiseDacSamples+sample))+(*(dmcDacSamples+sample)) )
+   int32_t chunk;
+   int32_t copied = 0;
+
+   if ( count > apuDataAvailable )
+   {
+      count = apuDataAvailable;
+   }
+
+   // The samples may wrap around the end of the ring.
+   while ( copied < count )
+   {
+      chunk = count-copied;
+      if ( chunk > m_sampleBufferSize-m_waveBufConsume )
       {
-         famp += (159.79/((1.0/((((*(triangleDacSamples+sample))/8227.0)+((*(noiseDacSamples+sample))/12241.0)+((*(dmcDacSamples+sample))/22638.0))))+100.0));
+         chunk = m_sampleBufferSize-m_waveBufConsume;
       }
-      amp = (int16_t)(float)(65535.0*famp*0.50);
 
-      (*(out+sample)) = amp;
+      memcpy ( samples+copied, m_waveBuf+m_waveBufConsume, chunk*sizeof(int16_t) );
 
-      outDownsampled += (*(out+sample));
+      m_waveBufConsume += chunk;
+      m_waveBufConsume %= m_sampleBufferSize;
+      copied += chunk;
    }
 
-   outDownsampled = (int32_t)((float)outDownsampled/((float)m_square[0].GETDACSAMPLECOUNT()));
+   apuDataAvailable -= copied;
+
+   return copied;
+}
+
+void CAPU::MIX ( void )
+{
+   int32_t mix;
+
+   mix = (*(m_squareMixLUT+m_square[0].GETDAC()+m_square[1].GETDAC()))+
+         m_tndMixLUT[m_triangle.GETDAC()][m_noise.GETDAC()][m_dmc.GETDAC()];
+
+   // Only changes of the output go to the resampler.
+   if ( mix != m_mixLast )
+   {
+      m_blip.AddDelta ( mix-m_mixLast );
+      m_mixLast = mix;
+   }
+}
+
+uint16_t CAPU::AMPLITUDE ( void )
+{
+   int32_t out;
+   int32_t delta;
+
+   out = m_blip.ReadSample();
 
    // Add mapper audio if any.
-   outDownsampled += MAPPERFUNC->amplitude();
+   out += MAPPERFUNC->amplitude();
 
-   delta = outDownsampled - outLast;
-   outDownsampled = outLast+((delta*65371)/65536); // 65371/65536 is 0.9975 adjusted to 16-bit fixed point.
+   delta = out - m_outLast;
+   out = m_outLast+((delta*65371)/65536); // 65371/65536 is 0.9975 adjusted to 16-bit fixed point.
 
-   outLast = outDownsampled;
+   m_outLast = out;
 
    // Reset DAC averaging...
    m_square[0].CLEARDACAVG();
@@ -425,7 +500,35 @@ uint16_t CAPU::AMPLITUDE ( void )
    m_noise.CLEARDACAVG();
    m_dmc.CLEARDACAVG();
 
-   return outDownsampled;
+   return out;
+}
+
+void CAPU::SAMPLERATE ( uint32_t rate )
+{
+   if ( rate < APU_SAMPLE_RATE_MIN )
+   {
+      rate = APU_SAMPLE_RATE_MIN;
+   }
+   else if ( rate > APU_SAMPLE_RATE_MAX )
+   {
+      rate = APU_SAMPLE_RATE_MAX;
+   }
+
+   m_sampleRate = rate;
+
+   if ( CNES::VIDEOMODE() == MODE_NTSC )
+   {
+      m_blip.SetRates ( APU_CLOCK_RATE_NTSC, m_sampleRate );
+   }
+   else if ( CNES::VIDEOMODE() == MODE_DENDY )
+   {
+      m_blip.SetRates ( APU_CLOCK_RATE_DENDY, m_sampleRate );
+   }
+   else
+   {
+      m_blip.SetRates ( APU_CLOCK_RATE_PAL, m_sampleRate );
+   }
+   m_mixLast = 0;
 }
 
 void CAPU::SEQTICK ( int32_t sequence )
@@ -560,23 +663,64 @@ void CAPU::RESET ( void )
 
    memset( m_waveBuf, 0, APU_BUFFER_SIZE * sizeof m_waveBuf[ 0 ] );
 
-   if ( CNES::VIDEOMODE() == MODE_NTSC )
-   {
-      m_sampleSpacer = APU_SAMPLE_SPACE_NTSC;
-   }
-   else if ( CNES::VIDEOMODE() == MODE_DENDY )
-   {
-      m_sampleSpacer = APU_SAMPLE_SPACE_DENDY;
-   }
-   else
-   {
-      m_sampleSpacer = APU_SAMPLE_SPACE_PAL;
-   }
+   // The APU clock rate depends on the video mode.
+   SAMPLERATE ( m_sampleRate );
 
    m_cycles = 0;
    apuDataAvailable = 0;
 }
 
+void CAPU::STATE ( CSaveState& state )
+{
+   if ( state.BeginChunk(SAVESTATE_TAG('A','P','U',' '),2) )
+   {
+      state.Bytes ( m_APUreg, 32 );
+      state.Value ( m_irqEnabled );
+      state.Value ( m_irqAsserted );
+      state.Value ( m_sequencerMode );
+      state.Value ( m_newSequencerMode );
+      state.Value ( m_changeModes );
+      state.Value ( m_sequenceStep );
+      state.Value ( m_cycles );
+
+      m_square[0].STATE ( state );
+      m_square[1].STATE ( state );
+      m_triangle.STATE ( state );
+      m_noise.STATE ( state );
+      m_dmc.STATE ( state );
+
+      // The samples already produced belong to the host, but the
+      // timing and filter of the next ones are part of the state.
+      if ( state.GetChunkVersion() < 2 )
+      {
+         // Older states sampled the DACs directly; start the
+         // resampler again from the current DACs.
+         float takeSample = 0.0f;
+         int32_t outDownsampled = 0;
+
+         state.Value ( takeSample );
+         state.Value ( m_outLast );
+         state.Value ( outDownsampled );
+
+         SAMPLERATE ( m_sampleRate );
+      }
+      else
+      {
+         state.Value ( m_mixLast );
+         m_blip.STATE ( state );
+         state.Value ( m_outLast );
+      }
+
+      state.EndChunk ();
+   }
+
+   if ( state.IsLoading() )
+   {
+      // Registers are shown as changed so the inspectors refresh.
+      memset ( m_APUregDirty, 1, 32 );
+   }
+}
+
 CAPUOscillator::CAPUOscillator (uint8_t periodAdjust) :
       m_periodAdjust(periodAdjust)
 {
@@ -615,6 +759,43 @@ CAPUOscillator::CAPUOscillator (uint8_t periodAdjust) :
    }
 }
 
+void CAPUOscillator::STATE ( CSaveState& state )
+{
+   state.Value ( m_linearCounter );
+   state.Value ( m_linearCounterReload );
+   state.Value ( m_lengthCounter );
+   state.Value ( m_clockLengthCounter );
+   state.Value ( m_period );
+   state.Value ( m_periodCounter );
+   state.Value ( m_envelope );
+   state.Value ( m_envelopeCounter );
+   state.Value ( m_envelopeDivider );
+   state.Value ( m_envelopeLoop );
+   state.Value ( m_sweepShift );
+   state.Value ( m_sweepDivider );
+   state.Value ( m_sweep );
+   state.Value ( m_sweepVolume );
+   state.Value ( m_volume );
+   state.Value ( m_volumeSet );
+   state.Value ( m_enabled );
+   state.Value ( m_halted );
+   state.Value ( m_newHalted );
+   state.Value ( m_linearCounterHalted );
+   state.Value ( m_envelopeEnabled );
+   state.Value ( m_sweepEnabled );
+   state.Value ( m_sweepNegate );
+   state.Value ( m_dac );
+   state.Value ( m_dacSamples );
+   if ( m_dacSamples > 100 )
+   {
+      m_dacSamples = 100;
+   }
+   state.Bytes ( m_dacAverage, m_dacSamples );
+   state.Value ( m_reg1Wrote );
+   state.Value ( m_reg3Wrote );
+   state.Bytes ( m_reg, 4 );
+}
+
 void CAPUOscillator::APU ( uint32_t addr, uint8_t data )
 {
    *(m_reg+(addr&0x03)) = data;
@@ -794,6 +975,13 @@ static int32_t m_squareSeq [ 4 ] [ 8 ] =
    { 1, 0, 0, 1, 1, 1, 1, 1 }
 };
 
+void CAPUSquare::STATE ( CSaveState& state )
+{
+   CAPUOscillator::STATE ( state );
+   state.Value ( m_seqTick );
+   state.Value ( m_duty );
+}
+
 void CAPUSquare::APU ( uint32_t addr, uint8_t data )
 {
    CAPUOscillator::APU ( addr, data );
@@ -945,6 +1133,12 @@ static int32_t m_triangleSeq [ 32 ] =
    0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF
 };
 
+void CAPUTriangle::STATE ( CSaveState& state )
+{
+   CAPUOscillator::STATE ( state );
+   state.Value ( m_seqTick );
+}
+
 void CAPUTriangle::APU ( uint32_t addr, uint8_t data )
 {
    CAPUOscillator::APU ( addr, data );
@@ -1086,6 +1280,13 @@ static uint16_t m_noisePeriod [ 3 ][ 16 ] =
    }
 };
 
+void CAPUNoise::STATE ( CSaveState& state )
+{
+   CAPUOscillator::STATE ( state );
+   state.Value ( m_mode );
+   state.Value ( m_shiftRegister );
+}
+
 void CAPUNoise::APU ( uint32_t addr, uint8_t data )
 {
    CAPUOscillator::APU ( addr, data );
@@ -1258,6 +1459,22 @@ void CAPUDMC::RESET ( void )
    m_period = (*(*(m_dmcPeriod+CNES::VIDEOMODE())));
 }
 
+void CAPUDMC::STATE ( CSaveState& state )
+{
+   CAPUOscillator::STATE ( state );
+   state.Value ( m_dmaReaderAddrPtr );
+   state.Value ( m_dmcIrqEnabled );
+   state.Value ( m_dmcIrqAsserted );
+   state.Value ( m_sampleBuffer );
+   state.Value ( m_sampleBufferFull );
+   state.Value ( m_loop );
+   state.Value ( m_sampleAddr );
+   state.Value ( m_sampleLength );
+   state.Value ( m_outputShift );
+   state.Value ( m_outputShiftCounter );
+   state.Value ( m_silence );
+}
+
 void CAPUDMC::APU ( uint32_t addr, uint8_t data )
 {
    CAPUOscillator::APU ( addr, data );
@@ -1439,7 +1656,6 @@ void CAPUDMC::TIMERTICK ( void )
 
 void CAPU::EMULATE ( void )
 {
-   static float takeSample = 0.0f;
    uint16_t* pWaveBuf;
 
    // Handle APU clock jitter.  Mode changes occur
@@ -1714,12 +1930,10 @@ void CAPU::EMULATE ( void )
    m_dmc.TIMERTICK ();
 
    // Generate audio samples.
-   takeSample += 1.0;
+   MIX ();
 
-   if ( takeSample >= m_sampleSpacer )
+   if ( m_blip.Clock() )
    {
-      takeSample -= m_sampleSpacer;
-
       pWaveBuf = m_waveBuf+m_waveBufProduce;
       (*pWaveBuf) = AMPLITUDE ();
 
@@ -1743,15 +1957,19 @@ if ( wavOut )
 }
 #endif
 
-      m_waveBufProduce++;
+      // Samples of skipped frames are dropped...
+      if ( (!CNES::FRAMESKIP()) || m_keepSkippedSamples )
+      {
+         m_waveBufProduce++;
 
-      m_waveBufProduce %= m_sampleBufferSize;
+         m_waveBufProduce %= m_sampleBufferSize;
 
-      apuDataAvailable++;
+         apuDataAvailable++;
 
-      if ( apuDataAvailable >= APU_BUFFER_PRERENDER )
-      {
-         nesBreakAudio();
+         if ( apuDataAvailable >= APU_BUFFER_PRERENDER )
+         {
+            nesBreakAudio();
+         }
       }
    }
 
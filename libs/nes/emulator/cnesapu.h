@@ -7,6 +7,7 @@
 #include "cbreakpointinfo.h"
 
 #include "cnes.h"
+#include "cblipbuffer.h"
 
 #define NUM_APU_BUFS 16
 #define APU_BUFFER_SIZE (NUM_APU_BUFS*APU_SAMPLES)
@@ -163,6 +164,9 @@ public:
       m_clockLengthCounter = true;
    }
 
+   // This routine saves or restores the channels' internal state.
+   void STATE ( CSaveState& state );
+
    // These are called directly for use in debugger inspectors.
    // Returns the channels' current length counter value.
    uint16_t LENGTHCOUNTER(void) const
@@ -334,6 +338,9 @@ public:
       m_seqTick = 0;
    }
 
+   // This routine saves or restores the channels' internal state.
+   void STATE ( CSaveState& state );
+
 protected:
    // The square waveform channel has an internal 8-step sequencer for
    // generating the appropriate duty-cycle.
@@ -378,6 +385,9 @@ public:
       m_seqTick = 0;
    }
 
+   // This routine saves or restores the channels' internal state.
+   void STATE ( CSaveState& state );
+
 protected:
    // The triangle waveform channel has an internal 32-step sequencer
    // for generating the appropriate triangular waveform.
@@ -425,6 +435,9 @@ public:
       m_shiftRegister = 1;
    }
 
+   // This routine saves or restores the channels' internal state.
+   void STATE ( CSaveState& state );
+
 protected:
    // The noise channel has two different modes:
    // 93-cycle pattern
@@ -535,6 +548,9 @@ public:
    // what it should be at NES reset.
    void RESET ( void );
 
+   // This routine saves or restores the channels' internal state.
+   void STATE ( CSaveState& state );
+
 protected:
    // Current address within NES system memory where
    // sample data is being fetched from.
@@ -589,12 +605,26 @@ class CAPU
 {
 public:
    CAPU();
+   ~CAPU();
 
    static void RESET ( void );
+   static void STATE ( CSaveState& state );
    static uint32_t APU ( uint32_t addr );
    static void APU ( uint32_t addr, uint8_t data );
    static void EMULATE ( void );
    static uint8_t* PLAY ( uint16_t samples );
+   static int32_t READ ( int16_t* samples, int32_t count );
+
+   // Samples of skipped frames are normally dropped so a real-time player
+   // catches up; an offline renderer skips the pixels but keeps the audio.
+   static void KEEPSKIPPEDSAMPLES ( bool keep )
+   {
+      m_keepSkippedSamples = keep;
+   }
+   static bool KEEPSKIPPEDSAMPLES ( void )
+   {
+      return m_keepSkippedSamples;
+   }
 
    static void DMASOURCE ( uint8_t* source )
    {
@@ -640,8 +670,17 @@ public:
 
    static void RELEASEIRQ ( void );
    static inline void SEQTICK ( int32_t sequence );
+   static inline void MIX ( void );
    static inline uint16_t AMPLITUDE ( void );
 
+   // Rate of the output samples.  Changing it drops the samples that
+   // haven't been produced yet.
+   static void SAMPLERATE ( uint32_t rate );
+   static uint32_t SAMPLERATE ( void )
+   {
+      return m_sampleRate;
+   }
+
    static inline void RESETCYCLECOUNTER ( uint32_t cycle )
    {
       m_cycles = cycle;
@@ -714,30 +753,37 @@ public:
    }
 
 protected:
-   static uint8_t m_APUreg [ 32 ];
-   static uint8_t m_APUregDirty [ 32 ];
-   static bool m_irqEnabled;
-   static bool m_irqAsserted;
-
-   static int32_t m_sequencerMode;
-   static int32_t m_newSequencerMode;
-   static int32_t m_changeModes;
-   static int32_t m_sequenceStep;
-
-   static CAPUSquare m_square[2];
-   static CAPUTriangle m_triangle;
-   static CAPUNoise m_noise;
-   static CAPUDMC m_dmc;
-
-   static uint16_t* m_waveBuf;
-   static int32_t m_waveBufProduce;
-   static int32_t m_waveBufConsume;
-
-   static uint32_t   m_cycles;
-
-   static float m_sampleSpacer;
+   static NES_THREAD_LOCAL uint8_t m_APUreg [ 32 ];
+   static NES_THREAD_LOCAL uint8_t m_APUregDirty [ 32 ];
+   static NES_THREAD_LOCAL bool m_irqEnabled;
+   static NES_THREAD_LOCAL bool m_irqAsserted;
+
+   static NES_THREAD_LOCAL int32_t m_sequencerMode;
+   static NES_THREAD_LOCAL int32_t m_newSequencerMode;
+   static NES_THREAD_LOCAL int32_t m_changeModes;
+   static NES_THREAD_LOCAL int32_t m_sequenceStep;
+
+   static NES_THREAD_LOCAL CAPUSquare m_square[2];
+   static NES_THREAD_LOCAL CAPUTriangle m_triangle;
+   static NES_THREAD_LOCAL CAPUNoise m_noise;
+   static NES_THREAD_LOCAL CAPUDMC m_dmc;
+
+   static NES_THREAD_LOCAL uint16_t* m_waveBuf;
+   static NES_THREAD_LOCAL int32_t m_waveBufProduce;
+   static NES_THREAD_LOCAL int32_t m_waveBufConsume;
+   static NES_THREAD_LOCAL bool    m_keepSkippedSamples;
+
+   static NES_THREAD_LOCAL uint32_t   m_cycles;
+
+   static NES_THREAD_LOCAL uint32_t m_sampleRate;
+
+   // Mixed output of the channels at the last APU cycle, band-limited
+   // resampler of the mixed output, and output filter state.
+   static NES_THREAD_LOCAL int32_t     m_mixLast;
+   static NES_THREAD_LOCAL CBlipBuffer m_blip;
+   static NES_THREAD_LOCAL int16_t     m_outLast;
    
-   static int32_t m_sampleBufferSize;
+   static NES_THREAD_LOCAL int32_t m_sampleBufferSize;
 
    static CRegisterDatabase* m_dbRegisters;
 
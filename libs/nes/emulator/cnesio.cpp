@@ -20,21 +20,21 @@
 #include "cnes6502.h"
 
 // Default IO implementation stuff
-uint32_t   CIO::m_ioJoy [] = { 0x00, 0x00 };
+NES_THREAD_LOCAL uint32_t   CIO::m_ioJoy [] = { 0x00, 0x00 };
 
 // Standard joypad stuff
-uint8_t   CIOStandardJoypad::m_ioJoyLatch [] = { 0x00, 0x00 };
-uint8_t   CIOStandardJoypad::m_last4016 = 0x00;
-CJoypadLogger  CIOStandardJoypad::m_logger [ NUM_CONTROLLERS ];
+NES_THREAD_LOCAL uint8_t   CIOStandardJoypad::m_ioJoyLatch [] = { 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t   CIOStandardJoypad::m_last4016 = 0x00;
+NES_THREAD_LOCAL CJoypadLogger  CIOStandardJoypad::m_logger [ NUM_CONTROLLERS ];
 
 // Turbo joypad stuff
-uint8_t   CIOTurboJoypad::m_alternator [][2] = { { 0, 0 }, { 0, 0 } };
-uint32_t  CIOTurboJoypad::m_lastFrame = 0;
+NES_THREAD_LOCAL uint8_t   CIOTurboJoypad::m_alternator [][2] = { { 0, 0 }, { 0, 0 } };
+NES_THREAD_LOCAL uint32_t  CIOTurboJoypad::m_lastFrame = 0;
 
 // Vaus Arkanoid pad stuff
-uint8_t   CIOVaus::m_ioPotLatch [] = { 0x00, 0x00 };
-uint8_t   CIOVaus::m_last4016 = 0x00;
-uint8_t   CIOVaus::m_trimPot [] = { 0x54, 0x54 };
+NES_THREAD_LOCAL uint8_t   CIOVaus::m_ioPotLatch [] = { 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t   CIOVaus::m_last4016 = 0x00;
+NES_THREAD_LOCAL uint8_t   CIOVaus::m_trimPot [] = { 0x54, 0x54 };
 
 uint32_t CIO::IO ( uint32_t addr )
 {
@@ -84,6 +84,16 @@ void CIO::_IO ( uint32_t addr, uint8_t data )
    return;
 }
 
+void CIO::STATE ( CSaveState& state )
+{
+   int32_t idx;
+
+   for ( idx = 0; idx < NUM_CONTROLLERS; idx++ )
+   {
+      state.Value ( m_ioJoy[idx] );
+   }
+}
+
 uint32_t CIOStandardJoypad::IO ( uint32_t addr )
 {
    uint32_t data = 0xFF;
@@ -158,6 +168,14 @@ void CIOStandardJoypad::_IO ( uint32_t addr, uint8_t data )
    }
 }
 
+void CIOStandardJoypad::STATE ( CSaveState& state )
+{
+   CIO::STATE ( state );
+
+   state.Bytes ( m_ioJoyLatch, NUM_CONTROLLERS );
+   state.Value ( m_last4016 );
+}
+
 void CIOTurboJoypad::IO ( uint32_t addr, uint8_t data )
 {
    switch ( addr )
@@ -253,6 +271,14 @@ void CIOTurboJoypad::_IO ( uint32_t addr, uint8_t data )
    }
 }
 
+void CIOTurboJoypad::STATE ( CSaveState& state )
+{
+   CIOStandardJoypad::STATE ( state );
+
+   state.Value ( m_lastFrame );
+   state.Bytes ( (uint8_t*)m_alternator, NUM_CONTROLLERS*2 );
+}
+
 uint32_t CIOZapper::IO ( uint32_t addr )
 {
    uint32_t data = 0xFF;
@@ -481,3 +507,10 @@ void CIOVaus::SPECIAL(int32_t port,int32_t special)
 {
    m_trimPot[port] = special;
 }
+
+void CIOVaus::STATE ( CSaveState& state )
+{
+   state.Bytes ( m_ioPotLatch, NUM_CONTROLLERS );
+   state.Value ( m_last4016 );
+   state.Bytes ( m_trimPot, NUM_CONTROLLERS );
+}
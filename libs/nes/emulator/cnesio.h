@@ -2,6 +2,7 @@
 #define IO_H
 
 #include "cjoypadlogger.h"
+#include "csavestate.h"
 #include "nes_emulator_core.h"
 
 class CIO
@@ -17,9 +18,10 @@ public:
    {
       *(m_ioJoy+joy) = data;
    }
+   static void STATE ( CSaveState& state );
 
 protected:
-   static uint32_t  m_ioJoy [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL uint32_t  m_ioJoy [ NUM_CONTROLLERS ];
 };
 
 class CIOStandardJoypad : public CIO
@@ -32,11 +34,12 @@ public:
    static void _IO ( uint32_t addr, uint8_t data );
    static uint32_t _IO ( uint32_t addr );
    static inline CJoypadLogger* LOGGER ( int idx ) { return m_logger+idx; }
+   static void STATE ( CSaveState& state );
 
 protected:
-   static uint8_t   m_ioJoyLatch [ NUM_CONTROLLERS ];
-   static uint8_t   m_last4016;
-   static CJoypadLogger  m_logger [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL uint8_t   m_ioJoyLatch [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL uint8_t   m_last4016;
+   static NES_THREAD_LOCAL CJoypadLogger  m_logger [ NUM_CONTROLLERS ];
 };
 
 class CIOTurboJoypad : public CIOStandardJoypad
@@ -47,10 +50,11 @@ public:
    static void IO ( uint32_t addr, uint8_t data );
    static void _IO ( uint32_t addr, uint8_t data );
    static uint32_t _IO ( uint32_t addr );
+   static void STATE ( CSaveState& state );
 
 protected:
-   static uint32_t m_lastFrame;
-   static uint8_t m_alternator [ NUM_CONTROLLERS ][ 2 ];
+   static NES_THREAD_LOCAL uint32_t m_lastFrame;
+   static NES_THREAD_LOCAL uint8_t m_alternator [ NUM_CONTROLLERS ][ 2 ];
 };
 
 class CIOVaus : public CIO
@@ -63,11 +67,12 @@ public:
    static void _IO ( uint32_t addr, uint8_t data );
    static uint32_t _IO ( uint32_t addr );
    static void SPECIAL ( int32_t port, int32_t special );
+   static void STATE ( CSaveState& state );
 
 protected:
-   static uint8_t   m_ioPotLatch [ NUM_CONTROLLERS ];
-   static uint8_t   m_last4016;
-   static uint8_t   m_trimPot [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL uint8_t   m_ioPotLatch [ NUM_CONTROLLERS ];
+   static NES_THREAD_LOCAL uint8_t   m_last4016;
+   static NES_THREAD_LOCAL uint8_t   m_trimPot [ NUM_CONTROLLERS ];
 };
 
 class CIOZapper : public CIO
@@ -3,6 +3,8 @@
 
 #include "nes_emulator_core.h"
 
+class CSaveState;
+
 typedef void (*RESETFUNC)(bool soft);
 typedef uint32_t (*MAPPERRFUNC)(uint32_t addr);
 typedef void (*MAPPERWFUNC)(uint32_t addr, uint8_t data);
@@ -10,6 +12,7 @@ typedef void (*SYNCPPUFUNC)(uint32_t ppuCycle, uint32_t ppuAddr);
 typedef void (*SYNCCPUFUNC)(void);
 typedef uint16_t (*SOUNDFUNC)(void);
 typedef void (*SOUNDENAFUNC)(uint32_t mask);
+typedef void (*STATEFUNC)(CSaveState& state);
 
 typedef struct _MapperFuncs
 {
@@ -23,14 +26,18 @@ typedef struct _MapperFuncs
    MAPPERRFUNC  debuginfo;
    SOUNDFUNC    amplitude;
    SOUNDENAFUNC soundenable;
+   STATEFUNC    state;
    bool     remapPrg;
    bool     remapChr;
    bool     remapVram;
    uint32_t vramSize;
 } MapperFuncs;
 
-extern MapperFuncs _mapperfunc[];
+// One entry for every iNES mapper number.
+#define NUM_MAPPERS 256
+
+extern MapperFuncs _mapperfunc[NUM_MAPPERS];
 
-extern MapperFuncs* MAPPERFUNC;
+extern NES_THREAD_LOCAL MapperFuncs* MAPPERFUNC;
 
 #endif
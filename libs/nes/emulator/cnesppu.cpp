@@ -666,59 +666,70 @@ static CBreakpointEventInfo* tblPPUEvents [] =
 CBreakpointEventInfo** CPPU::m_tblBreakpointEvents = tblPPUEvents;
 int32_t                CPPU::m_numBreakpointEvents = NUM_PPU_EVENTS;
 
-uint8_t* CPPU::m_PPUmemory = NULL;
-uint8_t  CPPU::m_PALETTEmemory [] = { 0, };
-uint8_t* CPPU::m_pPPUmemory [] = { NULL, };
-uint8_t  CPPU::m_oamAddr = 0x00;
-int32_t  CPPU::m_ppuRegByte = 0;
-uint16_t CPPU::m_ppuAddr = 0x0000;
-uint8_t  CPPU::m_ppuAddrIncrement = 1;
-uint16_t CPPU::m_ppuAddrLatch = 0x0000;
-uint8_t  CPPU::m_ppuReadLatch = 0x00;
-uint8_t  CPPU::m_ppuIOLatch = 0x00;
-uint8_t  CPPU::m_ppuIOLatchDecayFrames [] = { 0, };
-uint8_t  CPPU::m_PPUreg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-uint8_t  CPPU::m_PPUoam [] = { 0x00, };
-uint8_t  CPPU::m_ppuScrollX = 0x00;
-int32_t        CPPU::m_oneScreen = -1;
-bool           CPPU::m_extraVRAM = false;
-
-uint32_t   CPPU::m_cycles = 0;
-
-uint32_t CPPU::startVblank;
-uint32_t CPPU::quietScanlines;
-uint32_t CPPU::vblankScanlines;
-uint32_t CPPU::vblankEndCycle;
-uint32_t CPPU::prerenderScanline;
-uint32_t CPPU::cycleRatio;
-uint32_t CPPU::memoryDecayFrames;
-
-bool           CPPU::m_vblankChoked = false;
-bool           CPPU::m_nmiChoked = false;
-bool           CPPU::m_nmiReenabled = false;
-
-int8_t*          CPPU::m_pTV = NULL;
-
-uint32_t       CPPU::m_frame = 0;
-int32_t         CPPU::m_curCycles = 0;
-
-SpriteTemporaryMemory CPPU::m_spriteTemporaryMemory;
-SpriteBuffer          CPPU::m_spriteBuffer;
-
-BackgroundBuffer CPPU::m_bkgndBuffer;
-
-CCodeDataLogger* CPPU::m_logger = NULL;
-
-uint8_t  CPPU::m_last2005x = 0;
-uint8_t  CPPU::m_last2005y = 0;
-uint16_t** CPPU::m_2005x = NULL;
-uint16_t** CPPU::m_2005y = NULL;
-uint8_t  CPPU::m_lastSprite0HitX = 0;
-uint8_t  CPPU::m_lastSprite0HitY = 0;
-uint8_t  CPPU::m_x = 0xFF;
-uint8_t  CPPU::m_y = 0xFF;
-
+NES_THREAD_LOCAL uint8_t* CPPU::m_PPUmemory = NULL;
+NES_THREAD_LOCAL uint8_t  CPPU::m_PALETTEmemory [] = { 0, };
+NES_THREAD_LOCAL uint8_t* CPPU::m_pPPUmemory [] = { NULL, };
+NES_THREAD_LOCAL uint8_t  CPPU::m_oamAddr = 0x00;
+NES_THREAD_LOCAL int32_t  CPPU::m_ppuRegByte = 0;
+NES_THREAD_LOCAL uint16_t CPPU::m_ppuAddr = 0x0000;
+NES_THREAD_LOCAL uint8_t  CPPU::m_ppuAddrIncrement = 1;
+NES_THREAD_LOCAL uint16_t CPPU::m_ppuAddrLatch = 0x0000;
+NES_THREAD_LOCAL uint8_t  CPPU::m_ppuReadLatch = 0x00;
+NES_THREAD_LOCAL uint8_t  CPPU::m_ppuIOLatch = 0x00;
+NES_THREAD_LOCAL uint8_t  CPPU::m_ppuIOLatchDecayFrames [] = { 0, };
+NES_THREAD_LOCAL uint8_t  CPPU::m_PPUreg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CPPU::m_PPUoam [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CPPU::m_ppuScrollX = 0x00;
+NES_THREAD_LOCAL int32_t        CPPU::m_oneScreen = -1;
+NES_THREAD_LOCAL bool           CPPU::m_extraVRAM = false;
+
+NES_THREAD_LOCAL uint32_t   CPPU::m_cycles = 0;
+
+NES_THREAD_LOCAL bool       CPPU::m_scanlineBatching = true;
+NES_THREAD_LOCAL uint32_t   CPPU::m_spanCycles = 0;
+NES_THREAD_LOCAL uint32_t   CPPU::m_spanScanline = 0;
+NES_THREAD_LOCAL uint32_t   CPPU::m_spanDot = 0;
+
+NES_THREAD_LOCAL uint32_t CPPU::startVblank;
+NES_THREAD_LOCAL uint32_t CPPU::vblankStartScanline;
+NES_THREAD_LOCAL uint32_t CPPU::quietScanlines;
+NES_THREAD_LOCAL uint32_t CPPU::vblankScanlines;
+NES_THREAD_LOCAL uint32_t CPPU::vblankEndCycle;
+NES_THREAD_LOCAL uint32_t CPPU::prerenderScanline;
+NES_THREAD_LOCAL uint32_t CPPU::cycleRatio;
+NES_THREAD_LOCAL uint32_t CPPU::memoryDecayFrames;
+
+NES_THREAD_LOCAL bool           CPPU::m_vblankChoked = false;
+NES_THREAD_LOCAL bool           CPPU::m_nmiChoked = false;
+NES_THREAD_LOCAL bool           CPPU::m_nmiReenabled = false;
+
+NES_THREAD_LOCAL int8_t*          CPPU::m_pTV = NULL;
+NES_THREAD_LOCAL uint16_t*        CPPU::m_pTVIndex = NULL;
+NES_THREAD_LOCAL uint32_t         CPPU::m_tvRGBA [ 512 ];
+
+NES_THREAD_LOCAL uint32_t       CPPU::m_frame = 0;
+NES_THREAD_LOCAL int32_t         CPPU::m_curCycles = 0;
+
+NES_THREAD_LOCAL SpriteTemporaryMemory CPPU::m_spriteTemporaryMemory;
+NES_THREAD_LOCAL SpriteBuffer          CPPU::m_spriteBuffer;
+
+NES_THREAD_LOCAL BackgroundBuffer CPPU::m_bkgndBuffer;
+
+NES_THREAD_LOCAL CCodeDataLogger* CPPU::m_logger = NULL;
+
+NES_THREAD_LOCAL uint8_t  CPPU::m_last2005x = 0;
+NES_THREAD_LOCAL uint8_t  CPPU::m_last2005y = 0;
+NES_THREAD_LOCAL bool           CPPU::m_scrollCapture = false;
+NES_THREAD_LOCAL uint16_t       CPPU::m_scrollRunStart [ 241 ];
+NES_THREAD_LOCAL PpuScrollRun   CPPU::m_scrollRun [ PPU_SCROLL_RUNS_MAX ];
+NES_THREAD_LOCAL uint8_t  CPPU::m_lastSprite0HitX = 0;
+NES_THREAD_LOCAL uint8_t  CPPU::m_lastSprite0HitY = 0;
+NES_THREAD_LOCAL uint8_t  CPPU::m_x = 0xFF;
+NES_THREAD_LOCAL uint8_t  CPPU::m_y = 0xFF;
+
+#if !defined ( NES_MULTI_INSTANCE )
 static CPPU __init __attribute__((unused));
+#endif
 
 CPPU::CPPU()
 {
@@ -726,16 +737,8 @@ CPPU::CPPU()
 
    m_logger = new CCodeDataLogger ( MEM_16KB, MASK_16KB );
 
-   m_2005x = new uint16_t*[256];
-   for ( idx = 0; idx < 256; idx++ )
-   {
-      m_2005x[idx] = new uint16_t[240];
-   }
-   m_2005y = new uint16_t*[256];
-   for ( idx = 0; idx < 256; idx++ )
-   {
-      m_2005y[idx] = new uint16_t[240];
-   }
+   m_pTVIndex = new uint16_t[256*240];
+   memset(m_pTVIndex,0,256*240*sizeof(uint16_t));
 
    m_PPUmemory = new uint8_t[MEM_4KB];
 
@@ -748,24 +751,66 @@ CPPU::CPPU()
 
 CPPU::~CPPU()
 {
-   int idx;
-
    delete m_logger;
-   for ( idx = 0; idx < 256; idx++ )
+   delete [] m_pTVIndex;
+
+   delete [] m_PPUmemory;
+}
+
+void CPPU::EMULATE(uint32_t cycles)
+{
+   if ( m_scanlineBatching )
    {
-      delete [] m_2005x[idx];
+      EMULATESPANS ( cycles );
    }
-   delete [] m_2005x;
-   for ( idx = 0; idx < 256; idx++ )
+   else
    {
-      delete [] m_2005y[idx];
+      EMULATECYCLES ( cycles );
    }
-   delete [] m_2005y;
+}
 
-   delete [] m_PPUmemory;
+void CPPU::INCREMENTX ( void )
+{
+   if ( (m_ppuAddr&0x001F) != 0x001F )
+   {
+      m_ppuAddr++;
+   }
+   else
+   {
+      m_ppuAddr ^= 0x041F;
+   }
 }
 
-void CPPU::EMULATE(uint32_t cycles)
+void CPPU::INCREMENTY ( void )
+{
+   if ( (m_ppuAddr&0x7000) == 0x7000 )
+   {
+      m_ppuAddr &= 0x8FFF;
+
+      if ( (m_ppuAddr&0x03E0) == 0x03A0 )
+      {
+         m_ppuAddr ^= 0x0800;
+         m_ppuAddr &= 0xFC1F;
+      }
+      else
+      {
+         if ( (m_ppuAddr&0x03E0) == 0x03E0 )
+         {
+            m_ppuAddr &= 0xFC1F;
+         }
+         else
+         {
+            m_ppuAddr += 0x0020;
+         }
+      }
+   }
+   else
+   {
+      m_ppuAddr += 0x1000;
+   }
+}
+
+void CPPU::EMULATECYCLES(uint32_t cycles)
 {
    uint32_t idxx = 0xffffffff;
    uint32_t idxy = 0xffffffff;
@@ -801,31 +846,7 @@ void CPPU::EMULATE(uint32_t cycles)
          {
             if ( (m_cycles%PPU_CYCLES_PER_SCANLINE) == 251 )
             {
-               if ( (m_ppuAddr&0x7000) == 0x7000 )
-               {
-                  m_ppuAddr &= 0x8FFF;
-
-                  if ( (m_ppuAddr&0x03E0) == 0x03A0 )
-                  {
-                     m_ppuAddr ^= 0x0800;
-                     m_ppuAddr &= 0xFC1F;
-                  }
-                  else
-                  {
-                     if ( (m_ppuAddr&0x03E0) == 0x03E0 )
-                     {
-                        m_ppuAddr &= 0xFC1F;
-                     }
-                     else
-                     {
-                        m_ppuAddr += 0x0020;
-                     }
-                  }
-               }
-               else
-               {
-                  m_ppuAddr += 0x1000;
-               }
+               INCREMENTY ();
             }
 
             if ( (((m_cycles%PPU_CYCLES_PER_SCANLINE)%8) == 3) &&
@@ -833,14 +854,7 @@ void CPPU::EMULATE(uint32_t cycles)
                    ((m_cycles%PPU_CYCLES_PER_SCANLINE) == 323) ||
                    ((m_cycles%PPU_CYCLES_PER_SCANLINE) == 331)) )
             {
-               if ( (m_ppuAddr&0x001F) != 0x001F )
-               {
-                  m_ppuAddr++;
-               }
-               else
-               {
-                  m_ppuAddr ^= 0x041F;
-               }
+               INCREMENTX ();
             }
          }
       }
@@ -894,6 +908,142 @@ void CPPU::EMULATE(uint32_t cycles)
    }
 }
 
+void CPPU::EMULATESPANS(uint32_t cycles)
+{
+   uint32_t idxx;
+   uint32_t idxy;
+   uint32_t span;
+   bool     visible;
+   bool     prerender;
+   bool     vblank;
+
+   // The scanline and dot are counted along with the cycle counter, but the
+   // cycle counter is also reset at the start of each frame and restored on
+   // a state load.  Pick the raster position up from it again if it moved.
+   if ( m_cycles != m_spanCycles )
+   {
+      m_spanScanline = m_cycles/PPU_CYCLES_PER_SCANLINE;
+      m_spanDot = m_cycles-(m_spanScanline*PPU_CYCLES_PER_SCANLINE);
+   }
+
+   while ( cycles > 0 )
+   {
+      // Run up to the end of the current scanline.  Everything the PPU does
+      // differently from one scanline to the next is decided here once for
+      // the whole span.  VBLANK starts on a scanline boundary so it can't
+      // start part way through a span either.
+      span = PPU_CYCLES_PER_SCANLINE-m_spanDot;
+      if ( span > cycles )
+      {
+         span = cycles;
+      }
+      cycles -= span;
+
+      visible = (m_spanScanline < SCANLINES_VISIBLE);
+      prerender = (m_spanScanline == prerenderScanline);
+      vblank = (m_cycles >= startVblank);
+
+      // Get VBLANK raster position.
+      idxy = vblank?(m_spanScanline-vblankStartScanline):0xffffffff;
+
+      for ( ; span > 0; span-- )
+      {
+         idxx = m_spanDot;
+
+         // We're emulating one PPU cycle...
+         m_curCycles += CPU_CYCLE_ADJUST;
+
+         // Update PPU address from latch at appropriate times...
+         // Re-latch PPU address...
+         if ( rPPU(PPUMASK)&(PPUMASK_RENDER_BKGND|PPUMASK_RENDER_SPRITES) )
+         {
+            if ( visible )
+            {
+               if ( m_spanDot == 257 )
+               {
+                  m_ppuAddr &= 0xFBE0;
+                  m_ppuAddr |= m_ppuAddrLatch&0x41F;
+               }
+               else
+               {
+                  if ( m_spanDot == 251 )
+                  {
+                     INCREMENTY ();
+                  }
+
+                  if ( ((m_spanDot&7) == 3) &&
+                        ((m_spanDot < 256) ||
+                         (m_spanDot == 323) ||
+                         (m_spanDot == 331)) )
+                  {
+                     INCREMENTX ();
+                  }
+               }
+            }
+            else if ( prerender && (m_spanDot == 304) )
+            {
+               m_ppuAddr = m_ppuAddrLatch;
+            }
+         }
+
+         // Run 0 or 1 CPU cycles...
+         if ( m_curCycles >= (int32_t)cycleRatio )
+         {
+            C6502::EMULATE ( 1 );
+
+            // Adjust current cycle count...
+            m_curCycles -= cycleRatio;
+         }
+
+         // Turn off NMI choking if it shouldn't be...
+         if ( m_cycles > startVblank+1 )
+         {
+            NMICHOKED ( false );
+         }
+
+         // Turn off NMI re-enablement if it shouldn't be...
+         if ( m_cycles > vblankEndCycle )
+         {
+            NMIREENABLED ( false );
+         }
+
+         if ( nesIsDebuggable() )
+         {
+            // Check for breakpoints...
+            CNES::CHECKBREAKPOINT ( eBreakInPPU, eBreakOnPPUCycle );
+         }
+
+         if ( (rPPU(PPUCTRL)&PPUCTRL_GENERATE_NMI) &&
+               (((!NMICHOKED()) && (idxy == 0) && (idxx == 1)) ||
+                ((NMIREENABLED()) && (idxy <= vblankScanlines-1) && (idxx < PPU_CYCLES_PER_SCANLINE-1))) )
+         {
+            C6502::ASSERTNMI ();
+
+            // Check for PPU NMI breakpoint...
+            CNES::CHECKBREAKPOINT ( eBreakInPPU, eBreakOnPPUEvent, 0, PPU_EVENT_NMI );
+         }
+
+         // Clear OAM at appropriate point...
+         if ( ((rPPU(PPUMASK)&(PPUMASK_RENDER_BKGND|PPUMASK_RENDER_SPRITES)) == (PPUMASK_RENDER_BKGND|PPUMASK_RENDER_SPRITES)) &&
+              (idxy == 19) && (idxx == 316) )
+         {
+            m_oamAddr = 0x00;
+         }
+
+         m_cycles++;
+         m_spanDot++;
+      }
+
+      if ( m_spanDot == PPU_CYCLES_PER_SCANLINE )
+      {
+         m_spanDot = 0;
+         m_spanScanline++;
+      }
+   }
+
+   m_spanCycles = m_cycles;
+}
+
 uint32_t CPPU::LOAD ( uint32_t addr, int8_t source, int8_t type, bool trace )
 {
    uint8_t data = 0xFF;
@@ -1096,6 +1246,7 @@ void CPPU::RESET ( bool soft )
    int idx;
 
    startVblank = (CNES::VIDEOMODE()==MODE_NTSC)?PPU_CYCLE_START_VBLANK_NTSC:(CNES::VIDEOMODE()==MODE_PAL)?PPU_CYCLE_START_VBLANK_PAL:PPU_CYCLE_START_VBLANK_DENDY;
+   vblankStartScanline = startVblank/PPU_CYCLES_PER_SCANLINE;
    quietScanlines = (CNES::VIDEOMODE()==MODE_NTSC)?SCANLINES_QUIET_NTSC:(CNES::VIDEOMODE()==MODE_PAL)?SCANLINES_QUIET_PAL:SCANLINES_QUIET_DENDY;
    vblankScanlines = (CNES::VIDEOMODE()==MODE_NTSC)?SCANLINES_VBLANK_NTSC:(CNES::VIDEOMODE()==MODE_PAL)?SCANLINES_VBLANK_PAL:SCANLINES_VBLANK_DENDY;
    vblankEndCycle = (CNES::VIDEOMODE()==MODE_NTSC)?PPU_CYCLE_END_VBLANK_NTSC:(CNES::VIDEOMODE()==MODE_PAL)?PPU_CYCLE_END_VBLANK_PAL:PPU_CYCLE_END_VBLANK_DENDY;
@@ -1154,6 +1305,83 @@ void CPPU::RESET ( bool soft )
    }
 }
 
+void CPPU::STATE ( CSaveState& state )
+{
+   int32_t  idx;
+   uint16_t bank = 0;
+
+   if ( state.BeginChunk(SAVESTATE_TAG('P','P','U',' '),1) )
+   {
+      state.Bytes ( m_PPUmemory, MEM_4KB );
+      state.Bytes ( m_PALETTEmemory, MEM_32B );
+      state.Bytes ( m_PPUoam, NUM_OAM_REGS );
+      state.Bytes ( m_PPUreg, NUM_PPU_REGS );
+
+      // Nametables are either in the PPU's own memory or, for mappers
+      // that can map CHR memory there, in a CHR bank.  Save which.
+      for ( idx = 0; idx < 8; idx++ )
+      {
+         if ( !state.IsLoading() )
+         {
+            if ( (m_pPPUmemory[idx] >= m_PPUmemory) &&
+                 (m_pPPUmemory[idx] < m_PPUmemory+MEM_4KB) )
+            {
+               bank = m_pPPUmemory[idx]-m_PPUmemory;
+            }
+            else
+            {
+               bank = 0x8000|CROM::CHRBANKINDEX(m_pPPUmemory[idx]);
+            }
+         }
+         state.Value ( bank );
+         if ( state.IsLoading() )
+         {
+            if ( bank&0x8000 )
+            {
+               m_pPPUmemory[idx] = CROM::CHRBANKPOINTER(bank&0x7FFF);
+            }
+            else
+            {
+               m_pPPUmemory[idx] = m_PPUmemory+(bank&MASK_4KB);
+            }
+         }
+      }
+      state.Value ( m_oneScreen );
+      state.Value ( m_extraVRAM );
+
+      state.Value ( m_oamAddr );
+      state.Value ( m_ppuRegByte );
+      state.Value ( m_ppuAddr );
+      state.Value ( m_ppuAddrLatch );
+      state.Value ( m_ppuAddrIncrement );
+      state.Value ( m_ppuReadLatch );
+      state.Value ( m_ppuIOLatch );
+      state.Bytes ( m_ppuIOLatchDecayFrames, 8 );
+      state.Value ( m_ppuScrollX );
+      state.Value ( m_last2005x );
+      state.Value ( m_last2005y );
+
+      state.Value ( m_cycles );
+      state.Value ( m_frame );
+      state.Value ( m_curCycles );
+      state.Value ( m_vblankChoked );
+      state.Value ( m_nmiChoked );
+      state.Value ( m_nmiReenabled );
+
+      state.Value ( m_lastSprite0HitX );
+      state.Value ( m_lastSprite0HitY );
+      state.Value ( m_x );
+      state.Value ( m_y );
+
+      // These hold only byte-sized fields so are saved as they are.
+      state.Bytes ( (uint8_t*)&m_spriteTemporaryMemory, sizeof(m_spriteTemporaryMemory) );
+      state.Bytes ( (uint8_t*)&m_spriteBuffer, sizeof(m_spriteBuffer) );
+      state.Bytes ( (uint8_t*)&m_bkgndBuffer, sizeof(m_bkgndBuffer) );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CPPU::PPU ( uint32_t addr )
 {
    uint8_t data = 0xFF;
@@ -1553,12 +1781,12 @@ void CPPU::RENDERSCANLINE ( int32_t scanlines )
    int32_t idx2;
    int32_t spriteColorIdx;
    int32_t bkgndColorIdx;
+   int32_t colorIdx;
    int32_t startBkgnd;
    int32_t startSprite;
    int start = -1;
    int scanline;
    int32_t rasttv;
-   int8_t* pTV;
    int32_t p;
 
    if ( scanlines == SCANLINES_VISIBLE )
@@ -1571,8 +1799,7 @@ void CPPU::RENDERSCANLINE ( int32_t scanlines )
 
    for ( scanline = start; scanline <= scanlines; scanline++ )
    {
-      rasttv = ((scanline<<8)<<2);
-      pTV = (int8_t*)(m_pTV+rasttv);
+      rasttv = (scanline<<8);
       p = 0;
 
       m_x = 0;
@@ -1607,9 +1834,11 @@ void CPPU::RENDERSCANLINE ( int32_t scanlines )
             {
                m_x = idxx;
 
-               // Update variables for PPU viewer
-               *(*(m_2005x+m_x)+m_y) = m_last2005x+((rPPU(PPUCTRL)&0x1)<<8);
-               *(*(m_2005y+m_x)+m_y) = m_last2005y+(((rPPU(PPUCTRL)&0x2)>>1)*240);
+               // Update scroll runs for the nametable visualizer...
+               if ( m_scrollCapture )
+               {
+                  CAPTURESCROLL ();
+               }
 
                // Check for PPU pixel-at breakpoint...
                CNES::CHECKBREAKPOINT(eBreakInPPU,eBreakOnPPUEvent,0,PPU_EVENT_PIXEL_XY);
@@ -1704,23 +1933,17 @@ void CPPU::RENDERSCANLINE ( int32_t scanlines )
                   }
 
                   // Draw sprite...
-                  *pTV = CBasePalette::GetPaletteR(rPALETTE(0x10+spriteColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+1) = CBasePalette::GetPaletteG(rPALETTE(0x10+spriteColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+2) = CBasePalette::GetPaletteB(rPALETTE(0x10+spriteColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
+                  colorIdx = 0x10+spriteColorIdx;
                }
                else if ( p>=startBkgnd )
                {
                   // Draw background...
-                  *pTV = CBasePalette::GetPaletteR(rPALETTE(bkgndColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+1) = CBasePalette::GetPaletteG(rPALETTE(bkgndColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+2) = CBasePalette::GetPaletteB(rPALETTE(bkgndColorIdx), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
+                  colorIdx = bkgndColorIdx;
                }
                else
                {
                   // Draw 'nothing'...
-                  *pTV = CBasePalette::GetPaletteR(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+1) = CBasePalette::GetPaletteG(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+2) = CBasePalette::GetPaletteB(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
+                  colorIdx = 0;
                }
 
                // Sprite 0 hit checks...
@@ -1753,20 +1976,24 @@ void CPPU::RENDERSCANLINE ( int32_t scanlines )
             {
                if ( (m_ppuAddr&0x3F00) == 0x3F00 )
                {
-                  *pTV = CBasePalette::GetPaletteR(rPALETTE(m_ppuAddr&0x1F), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+1) = CBasePalette::GetPaletteG(rPALETTE(m_ppuAddr&0x1F), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+2) = CBasePalette::GetPaletteB(rPALETTE(m_ppuAddr&0x1F), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
+                  colorIdx = m_ppuAddr&0x1F;
                }
                else
                {
-                  *pTV = CBasePalette::GetPaletteR(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+1) = CBasePalette::GetPaletteG(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
-                  *(pTV+2) = CBasePalette::GetPaletteB(rPALETTE(0), !!(rPPU(PPUMASK)&PPUMASK_GREYSCALE), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_REDS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_GREENS), !!(rPPU(PPUMASK)&PPUMASK_INTENSIFY_BLUES));
+                  colorIdx = 0;
                }
             }
 
+            // Frames that won't be shown don't need their pixels.  Only
+            // the palette index is kept here, it is turned into RGB for
+            // the whole frame at once by EXPANDTV...
+            if ( !CNES::FRAMESKIP() )
+            {
+               *(m_pTVIndex+rasttv+p) = (rPALETTE(colorIdx)&((rPPU(PPUMASK)&PPUMASK_GREYSCALE)?0x30:0x3F))|
+                                        ((rPPU(PPUMASK)&(PPUMASK_INTENSIFY_REDS|PPUMASK_INTENSIFY_GREENS|PPUMASK_INTENSIFY_BLUES))<<1);
+            }
+
             // Move to next pixel...
-            pTV += 4;
             p++;
          }
 
@@ -1862,21 +2089,89 @@ void CPPU::PIXELRGB ( int32_t x, int32_t y, uint8_t* r, uint8_t* g, uint8_t* b )
 {
    if ( (x>=0) && (x<=255) && (y>=0) && (y<=239) )
    {
-      int32_t rasttv = (y<<8)<<2;
-      int8_t* pTV = (int8_t*)(m_pTV+rasttv);
+      // The TV surface isn't up to date part way through a frame
+      // but the palette indexes are.
+      uint16_t index = *(m_pTVIndex+(y<<8)+x);
 
-      pTV += (x<<2);
+      (*r) = CBasePalette::GetPaletteR(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+      (*g) = CBasePalette::GetPaletteG(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+      (*b) = CBasePalette::GetPaletteB(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+   }
+}
 
-      (*r) = (*pTV);
-      (*g) = (*pTV+1);
-      (*b) = (*pTV+2);
+void CPPU::SCROLLCAPTURE ( bool enable )
+{
+   m_scrollCapture = enable;
+
+   // Forget runs from the last time scroll was captured.
+   memset(m_scrollRunStart,0,sizeof(m_scrollRunStart));
+}
+
+const PpuScrollRun* CPPU::SCROLLRUN ( const uint16_t* pStart, const PpuScrollRun* pRuns, int32_t x, int32_t y )
+{
+   int32_t run;
+
+   if ( (x<0) || (x>255) || (y<0) || (y>239) )
+   {
+      return NULL;
+   }
+
+   // A scanline that hasn't been drawn since capture was turned on has
+   // no runs.
+   run = *(pStart+y+1)-1;
+   if ( (run < *(pStart+y)) || (run >= PPU_SCROLL_RUNS_MAX) )
+   {
+      return NULL;
+   }
+   while ( (run > *(pStart+y)) && ((pRuns+run)->x > x) )
+   {
+      run--;
+   }
+
+   return pRuns+run;
+}
+
+void CPPU::EXPANDTV ( void )
+{
+   uint32_t* pTV = (uint32_t*)m_pTV;
+   uint8_t   rgba [ 4 ];
+   uint32_t  alpha;
+   int32_t   index;
+
+   if ( !pTV )
+   {
+      return;
+   }
+
+   // The fourth byte of each pixel belongs to whoever owns the surface.
+   rgba[0] = 0x00;
+   rgba[1] = 0x00;
+   rgba[2] = 0x00;
+   rgba[3] = 0xFF;
+   memcpy(&alpha,rgba,4);
+
+   // The palette can be changed at any time so the 512 colors a
+   // palette index and emphasis bits can stand for are looked up
+   // afresh each time.
+   rgba[3] = 0x00;
+   for ( index = 0; index < 512; index++ )
+   {
+      rgba[0] = CBasePalette::GetPaletteR(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+      rgba[1] = CBasePalette::GetPaletteG(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+      rgba[2] = CBasePalette::GetPaletteB(index&0x3F,0,(index>>6)&1,(index>>7)&1,(index>>8)&1);
+      memcpy(m_tvRGBA+index,rgba,4);
+   }
+
+   for ( index = 0; index < 256*240; index++ )
+   {
+      *(pTV+index) = (*(pTV+index)&alpha)|*(m_tvRGBA+*(m_pTVIndex+index));
    }
 }
 
 void CPPU::GATHERBKGND ( int8_t phase )
 {
-   static uint16_t patternIdx;
-   static BackgroundBufferData bkgndTemp;
+   static NES_THREAD_LOCAL uint16_t patternIdx;
+   static NES_THREAD_LOCAL BackgroundBufferData bkgndTemp;
 
    uint32_t ppuAddr = rPPUADDR();
    int32_t tileX = ppuAddr&0x001F;
@@ -2034,9 +2329,9 @@ void CPPU::GATHERBKGND ( int8_t phase )
 
 void CPPU::BUILDSPRITELIST ( int32_t scanline, int32_t cycle )
 {
-   static SpriteTemporaryMemoryData  devNull;
-   static SpriteTemporaryMemoryData* pSprite = &devNull;
-   static int32_t                    spritesFound = 0;
+   static NES_THREAD_LOCAL SpriteTemporaryMemoryData  devNull;
+   static NES_THREAD_LOCAL SpriteTemporaryMemoryData* pSprite = &devNull;
+   static NES_THREAD_LOCAL int32_t                    spritesFound = 0;
 
    int32_t          idx1;
    int32_t          spriteY;
@@ -195,10 +195,28 @@ public:
    // Emulation routine.  Emulates one PPU cycle.
    static inline void EMULATE ( uint32_t cycles );
 
+   // Selects how the PPU keeps track of where it is in the frame.  With
+   // scanline batching on, PPU cycles are run in spans up to the end of
+   // the current scanline and the scanline and dot are counted along with
+   // the cycle counter.  With it off, they are worked out from the cycle
+   // counter on every PPU cycle.  Both produce identical emulation; the
+   // cycle-by-cycle way is kept as the reference.
+   static inline void SCANLINEBATCHING ( bool enable )
+   {
+      m_scanlineBatching = enable;
+   }
+   static inline bool SCANLINEBATCHING ( void )
+   {
+      return m_scanlineBatching;
+   }
+
    // Routine invoked on reset of the emulation engine.
    // Cleans up the PPU state as if a NES reset had just occurred.
    static void RESET ( bool soft );
 
+   // Routine to save or restore the PPU state at a frame boundary.
+   static void STATE ( CSaveState& state );
+
    // State and internal data accessor interfaces.
    // Read a PPU register, affecting the PPU's internal state.
    // This function is used during emulation.
@@ -307,6 +325,43 @@ public:
    static void QUIETSCANLINES ( void );
    static void VBLANKSCANLINES ( void );
 
+   // Record the scroll in effect at the pixel being rendered, starting
+   // a new run at the start of each scanline and wherever the scroll
+   // changes.  If the runs are running out a change is only recorded
+   // while there's still room for the first run of every scanline left.
+   static inline void CAPTURESCROLL ( void )
+   {
+      uint16_t scrollX = m_last2005x+((rPPU(PPUCTRL)&0x1)<<8);
+      uint16_t scrollY = m_last2005y+(((rPPU(PPUCTRL)&0x2)>>1)*240);
+      PpuScrollRun* pRun;
+      uint16_t run;
+
+      if ( m_x == 0 )
+      {
+         if ( m_y == 0 )
+         {
+            m_scrollRunStart[0] = 0;
+         }
+         run = m_scrollRunStart[m_y];
+      }
+      else
+      {
+         run = m_scrollRunStart[m_y+1];
+         pRun = m_scrollRun+run-1;
+         if ( ((pRun->scrollX == scrollX) && (pRun->scrollY == scrollY)) ||
+              (run >= (PPU_SCROLL_RUNS_MAX-(239-m_y))) )
+         {
+            return;
+         }
+      }
+
+      pRun = m_scrollRun+run;
+      pRun->x = m_x;
+      pRun->scrollX = scrollX;
+      pRun->scrollY = scrollY;
+      m_scrollRunStart[m_y+1] = run+1;
+   }
+
    // Interface to handle the special case where the setting of the
    // VBLANK flag in the PPU registers is choked by the reading of the
    // PPU register containing the VBLANK flag at a precise point within
@@ -442,18 +497,35 @@ public:
       (*sc4) = ((uint8_t*)m_pPPUmemory[3]-(uint8_t*)m_PPUmemory)+MEM_8KB;
    }
 
-   // Accessor functions for the database of scroll values indexed by pixel
-   // location.  At each PPU cycle that is rendering a visible pixel the scroll
-   // register values are stored so that a representation of the visible portions
-   // of the nametable may be overlaid upon the actual nametable in the nametable visual
-   // inspector.
+   // Accessor functions for the scroll values in effect at each pixel.  While
+   // scroll capture is on, the pixels of each visible scanline that share the
+   // same scroll register values are stored as a run so that a representation
+   // of the visible portions of the nametable may be overlaid upon the actual
+   // nametable in the nametable visual inspector.  The runs of scanline y are
+   // those from m_scrollRunStart[y] up to m_scrollRunStart[y+1].
+   static void SCROLLCAPTURE ( bool enable );
+   static inline bool SCROLLCAPTURE ( void )
+   {
+      return m_scrollCapture;
+   }
+   static inline const uint16_t* SCROLLRUNSTART ( void )
+   {
+      return m_scrollRunStart;
+   }
+   static inline const PpuScrollRun* SCROLLRUNS ( void )
+   {
+      return m_scrollRun;
+   }
+   static const PpuScrollRun* SCROLLRUN ( const uint16_t* pStart, const PpuScrollRun* pRuns, int32_t x, int32_t y );
    static inline uint16_t _SCROLLX ( int32_t x, int32_t y )
    {
-      return *(*(m_2005x+x)+y);
+      const PpuScrollRun* pRun = SCROLLRUN(m_scrollRunStart,m_scrollRun,x,y);
+      return pRun?pRun->scrollX:0;
    }
    static inline uint16_t _SCROLLY ( int32_t x, int32_t y )
    {
-      return *(*(m_2005y+x)+y);
+      const PpuScrollRun* pRun = SCROLLRUN(m_scrollRunStart,m_scrollRun,x,y);
+      return pRun?pRun->scrollY:0;
    }
    static inline void _SCROLL ( uint8_t* x, uint8_t* y )
    {
@@ -501,6 +573,15 @@ public:
       return m_pTV;
    }
 
+   // The PPU draws palette indexes and emphasis bits (see
+   // NES_FRAMEDUMP_INDEXED) rather than RGB.  EXPANDTV turns what
+   // has been drawn into RGBA on the rendering surface.
+   static inline const uint16_t* TVINDEX ( void )
+   {
+      return m_pTVIndex;
+   }
+   static void EXPANDTV ( void );
+
    // Accessor method used by some ROM mappers that can remap the
    // nametable memory in a more complicated fashion than straight mirroring.
    static inline void REMAPVRAM ( int32_t bank, uint8_t* point )
@@ -568,6 +649,13 @@ protected:
    static inline void GARBAGE ( uint32_t addr, int8_t target );
    static inline void EXTRA ();
 
+   // The two ways of running PPU cycles selected by SCANLINEBATCHING, and
+   // the PPU address register increments done during rendering.
+   static inline void EMULATECYCLES ( uint32_t cycles );
+   static inline void EMULATESPANS ( uint32_t cycles );
+   static inline void INCREMENTX ( void );
+   static inline void INCREMENTY ( void );
+
    // Routines that mimic the PPU bus behavior down to the PPU cycle.
    // These are used internally by the PPU core during emulation.
    static inline void GATHERBKGND ( int8_t phase );
@@ -589,37 +677,38 @@ protected:
 
 protected:
    // The PPU core maintains 32B of palette RAM.
-   static uint8_t  m_PALETTEmemory [ MEM_32B ];
+   static NES_THREAD_LOCAL uint8_t  m_PALETTEmemory [ MEM_32B ];
 
    // The PPU core maintains 2KB of video RAM.
    // Some mappers extend this by providing more memory on
    // the cartridge.
-   static uint8_t*  m_PPUmemory;
+   static NES_THREAD_LOCAL uint8_t*  m_PPUmemory;
 
    // The PPU's video memory can be rearranged by some mappers.
    // These pointers support that rearrangement.
-   static uint8_t* m_pPPUmemory [ 8 ];
+   static NES_THREAD_LOCAL uint8_t* m_pPPUmemory [ 8 ];
 
    // The PPU has an internal flip-flop which delivers
    // bytes written to $2005 or $2006 to different locations
    // within the PPU.  The flip-flop flips on each write to
    // PPU address $2005, or $2007.  It is reset on reads from
    // PPU address $2002.
-   static int32_t            m_ppuRegByte;
+   static NES_THREAD_LOCAL int32_t            m_ppuRegByte;
 
    // Pre-calculated values based on video mode.
-   static uint32_t startVblank;
-   static uint32_t quietScanlines;
-   static uint32_t vblankScanlines;
-   static uint32_t vblankEndCycle;
-   static uint32_t prerenderScanline;
-   static uint32_t cycleRatio;
-   static uint32_t memoryDecayFrames;
+   static NES_THREAD_LOCAL uint32_t startVblank;
+   static NES_THREAD_LOCAL uint32_t vblankStartScanline;
+   static NES_THREAD_LOCAL uint32_t quietScanlines;
+   static NES_THREAD_LOCAL uint32_t vblankScanlines;
+   static NES_THREAD_LOCAL uint32_t vblankEndCycle;
+   static NES_THREAD_LOCAL uint32_t prerenderScanline;
+   static NES_THREAD_LOCAL uint32_t cycleRatio;
+   static NES_THREAD_LOCAL uint32_t memoryDecayFrames;
 
    // The PPU has an internal OAM address register that is
    // accessed via PPU address $2003.  It is incremented on
    // writes to $2004.
-   static uint8_t  m_oamAddr;
+   static NES_THREAD_LOCAL uint8_t  m_oamAddr;
 
    // The PPU has an internal address register that is used to
    // generate the bus addresses accessed by the PPU during rendering.
@@ -627,19 +716,19 @@ protected:
    // is updated from the PPU address latch (see below) on every
    // other write to PPU address $2006 (ie. when the flip-flop is flipped
    // in the right direction).
-   static uint16_t m_ppuAddr;
+   static NES_THREAD_LOCAL uint16_t m_ppuAddr;
 
    // The PPU has an internal address latch that is programmed
    // via writes to PPU address $2000, $2005, $2006, and $2007.
    // The latch is copied to the address register (see above)
    // on every other write to PPU address $2006.
-   static uint16_t m_ppuAddrLatch;
+   static NES_THREAD_LOCAL uint16_t m_ppuAddrLatch;
 
    // The PPU keeps track internally of whether it should be
    // auto-incrementing its internal address register by 1
    // (for horizontal updating) or by 32 (for vertical updating).
    // This is set on writes to PPU address $2000.
-   static uint8_t  m_ppuAddrIncrement;
+   static NES_THREAD_LOCAL uint8_t  m_ppuAddrIncrement;
 
    // The PPU has an internal latch that keeps the last value
    // read by the PPU on an external memory fetch.  This provides
@@ -651,16 +740,16 @@ protected:
    // accesses to PPU addresses in the range $3F00-$3FFF (the PPU's
    // internal palette memory).  That data is returned immediately
    // to the CPU on a read access of PPU address $2007 in that range.
-   static uint8_t  m_ppuReadLatch;
+   static NES_THREAD_LOCAL uint8_t  m_ppuReadLatch;
 
    // The PPU has an internal hold-up on the bus between it and
    // the CPU that causes the last value written to be readable
    // for about 600 milliseconds.
-   static uint8_t m_ppuIOLatch;
+   static NES_THREAD_LOCAL uint8_t m_ppuIOLatch;
 
    // Each bit of the IO latch decays at the same rate but some
    // might have been set to 1 more recently than others.
-   static uint8_t m_ppuIOLatchDecayFrames [ 8 ];
+   static NES_THREAD_LOCAL uint8_t m_ppuIOLatchDecayFrames [ 8 ];
 
    // The PPU has eight registers visible to the CPU in the CPU's
    // memory map at address $2000 through $2007.  These are further
@@ -673,15 +762,15 @@ protected:
    // Typically, however, a user likes to see what has been written.
    // I'll keep the "open bus" in mind though to provide accurate feedback
    // as if the user were staring at an actual PPU.
-   static uint8_t  m_PPUreg [ NUM_PPU_REGS ];
+   static NES_THREAD_LOCAL uint8_t  m_PPUreg [ NUM_PPU_REGS ];
 
    // The PPU has space for 64 objects (sprites) in its internal
    // Object Attribute Map (OAM) memory.
-   static uint8_t  m_PPUoam [ NUM_OAM_REGS ];
+   static NES_THREAD_LOCAL uint8_t  m_PPUoam [ NUM_OAM_REGS ];
 
    // The PPU maintains fine-X (0..7) scroll value which is used as the
    // pick-off location in the barrel-shifter that does the rendering.
-   static uint8_t  m_ppuScrollX;
+   static NES_THREAD_LOCAL uint8_t  m_ppuScrollX;
 
    // The PPU maintains the state of mirroring of its internal video RAM.
    // Some mappers only use one video screen's worth of RAM, others provide
@@ -689,77 +778,92 @@ protected:
    // the two video screen's worth of RAM dedicated to the PPU in some
    // mirrored fashion across the memory region which supports up to four
    // video screen's worth.
-   static int32_t            m_oneScreen;
-   static bool           m_extraVRAM;
+   static NES_THREAD_LOCAL int32_t            m_oneScreen;
+   static NES_THREAD_LOCAL bool           m_extraVRAM;
 
    // Bounded counter of PPU cycles executed.  It resets to zero at the
    // start of each PPU frame.
-   static uint32_t   m_cycles;
+   static NES_THREAD_LOCAL uint32_t   m_cycles;
+
+   // Raster position kept alongside the cycle counter when scanline
+   // batching is on.  It is only valid while the cycle counter still
+   // matches the value it had when the position was last updated.
+   static NES_THREAD_LOCAL bool       m_scanlineBatching;
+   static NES_THREAD_LOCAL uint32_t   m_spanCycles;
+   static NES_THREAD_LOCAL uint32_t   m_spanScanline;
+   static NES_THREAD_LOCAL uint32_t   m_spanDot;
 
    // Running counter of PPU frames drawn.  It will roll over after
    // approximately 40 minutes of emulation.  However, this roll-over
    // is not a significant event.
-   static uint32_t   m_frame;
+   static NES_THREAD_LOCAL uint32_t   m_frame;
 
    // The current number of PPU cycles ready to be executed by
    // the PPU core.
-   static int32_t            m_curCycles;
+   static NES_THREAD_LOCAL int32_t            m_curCycles;
 
    // If the CPU reads PPU address $2002 at a precise point within the
    // PPU frame it can choke the setting of the VBLANK flag in that register.
-   static bool           m_vblankChoked;
+   static NES_THREAD_LOCAL bool           m_vblankChoked;
 
    // If the CPU reads PPU address $2002 at precise points within the
    // PPU frame it can choke the assertion of NMI by the PPU.
-   static bool           m_nmiChoked;
+   static NES_THREAD_LOCAL bool           m_nmiChoked;
 
    // Re-enabling NMI flag in the PPU control register allows for re-assertion
    // of NMI during VBLANK period.
-   static bool           m_nmiReenabled;
+   static NES_THREAD_LOCAL bool           m_nmiReenabled;
 
    // This is the temporary memory used by the PPU to store gathered
    // OAM data during pixel rendering.
-   static SpriteTemporaryMemory m_spriteTemporaryMemory;
+   static NES_THREAD_LOCAL SpriteTemporaryMemory m_spriteTemporaryMemory;
 
    // This is the secondary OAM that is used to keep track of in-view
    // sprites on each scanline.
-   static SpriteBuffer     m_spriteBuffer;
+   static NES_THREAD_LOCAL SpriteBuffer     m_spriteBuffer;
 
    // This is the background buffer of fetched tile data to be
    // rendered on the next scanline.
-   static BackgroundBuffer m_bkgndBuffer;
+   static NES_THREAD_LOCAL BackgroundBuffer m_bkgndBuffer;
 
    // This is the rendering surface on which the PPU draws the
    // emulated frame representing the true visual state of the
    // NES as would be seen by a player.  The memory is allocated
    // by the dialog class and passed to the PPU.
-   static int8_t*          m_pTV;
+   static NES_THREAD_LOCAL int8_t*          m_pTV;
+
+   // What the PPU actually draws: the palette index and emphasis bits
+   // of each pixel, and the RGB they were last turned into.
+   static NES_THREAD_LOCAL uint16_t*        m_pTVIndex;
+   static NES_THREAD_LOCAL uint32_t         m_tvRGBA [ 512 ];
 
    // These items are the database that keeps track of the status of the
    // x and y scroll values for each rendered pixel.  This information is
    // used by the nametable visualizer to highlight areas of the nametable
    // memory internal to the PPU that are being rendered to the screen.
-   static uint8_t  m_last2005x;
-   static uint8_t  m_last2005y;
-   static uint16_t** m_2005x;
-   static uint16_t** m_2005y;
+   // It is only kept while the visualizer asks for it.
+   static NES_THREAD_LOCAL uint8_t  m_last2005x;
+   static NES_THREAD_LOCAL uint8_t  m_last2005y;
+   static NES_THREAD_LOCAL bool     m_scrollCapture;
+   static NES_THREAD_LOCAL uint16_t m_scrollRunStart [ 241 ];
+   static NES_THREAD_LOCAL PpuScrollRun m_scrollRun [ PPU_SCROLL_RUNS_MAX ];
 
    // These items are the position of the last sprite-0 hit event on the
    // last rendered PPU frame.  They are invalidated at the start of each
    // new frame.
-   static uint8_t  m_lastSprite0HitX;
-   static uint8_t  m_lastSprite0HitY;
+   static NES_THREAD_LOCAL uint8_t  m_lastSprite0HitX;
+   static NES_THREAD_LOCAL uint8_t  m_lastSprite0HitY;
 
    // These items are the position of the pixel being rendered by the
    // PPU on any given PPU cycle.  This information is used by the debugger.
-   static uint8_t  m_x;
-   static uint8_t  m_y;
+   static NES_THREAD_LOCAL uint8_t  m_x;
+   static NES_THREAD_LOCAL uint8_t  m_y;
 
    // Database used by the Code/Data Logger debugger inspector.  The data structure
    // is maintained by the PPU core as it performs fetches, reads,
    // and writes to/from its managed RAM.  The
    // Code/Data Logger displays the collected information graphically.
-   static CCodeDataLogger* m_logger;
+   static NES_THREAD_LOCAL CCodeDataLogger* m_logger;
 
    // The database for PPU core registers.  Declaration
    // is in source file.
@@ -106,109 +106,58 @@ CMemoryDatabase* CROM::m_dbCHRMemory = dbCHRMemory;
 CBreakpointEventInfo** CROM::m_tblBreakpointEvents = tblMapperEvents;
 int32_t                CROM::m_numBreakpointEvents = NUM_MAPPER_EVENTS;
 
-uint8_t** CROM::m_PRGROMmemory = NULL;
-uint8_t** CROM::m_CHRmemory = NULL;
-uint8_t*  CROM::m_VRAMmemory = NULL;
-uint8_t*  CROM::m_pPRGROMmemory [] = { NULL, NULL, NULL, NULL };
-uint8_t*  CROM::m_pCHRmemory [] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
-uint8_t*  CROM::m_pVRAMmemory [] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
-uint8_t** CROM::m_SRAMmemory = NULL;
-uint8_t*  CROM::m_pSRAMmemory [] = { NULL, NULL, NULL, NULL, NULL };
-uint8_t*  CROM::m_EXRAMmemory = NULL;
-
-uint32_t           CROM::m_mapper = 0;
-uint32_t           CROM::m_numPrgBanks = 0;
-uint32_t           CROM::m_numChrBanks = 0;
-
-CCodeDataLogger* CROM::m_pLogger [] = { NULL, };
-CCodeDataLogger* CROM::m_pEXRAMLogger = NULL;
-CCodeDataLogger* CROM::m_pSRAMLogger [] = { NULL, };
-
-uint8_t**  CROM::m_PRGROMopcodeMask = NULL;
-bool*      CROM::m_PRGROMopcodeMaskDirty  = NULL;
-char***    CROM::m_PRGROMdisassembly = NULL;
-uint16_t** CROM::m_PRGROMsloc2addr = NULL;
-uint16_t** CROM::m_PRGROMaddr2sloc = NULL;
-uint32_t*  CROM::m_PRGROMsloc = NULL;
-uint8_t**  CROM::m_SRAMopcodeMask = NULL;
-bool*      CROM::m_SRAMopcodeMaskDirty = NULL;
-char***    CROM::m_SRAMdisassembly = NULL;
-uint16_t** CROM::m_SRAMsloc2addr = NULL;
-uint16_t** CROM::m_SRAMaddr2sloc = NULL;
-uint32_t*  CROM::m_SRAMsloc = NULL;
-bool       CROM::m_SRAMdirty = false;
-uint8_t*   CROM::m_EXRAMopcodeMask = NULL;
-bool       CROM::m_EXRAMopcodeMaskDirty = false;
-char**     CROM::m_EXRAMdisassembly = NULL;
-uint16_t*  CROM::m_EXRAMsloc2addr = NULL;
-uint16_t*  CROM::m_EXRAMaddr2sloc = NULL;
-uint32_t   CROM::m_EXRAMsloc = 0;
-
+NES_THREAD_LOCAL uint8_t** CROM::m_PRGROMmemory = NULL;
+NES_THREAD_LOCAL uint32_t  CROM::m_numPrgSlots = 0;
+NES_THREAD_LOCAL uint8_t** CROM::m_CHRmemory = NULL;
+NES_THREAD_LOCAL uint32_t  CROM::m_numChrSlots = 0;
+NES_THREAD_LOCAL uint8_t** CROM::m_PRGROMbanks = NULL;
+NES_THREAD_LOCAL uint32_t  CROM::m_numPrgBankBuffers = 0;
+NES_THREAD_LOCAL uint8_t** CROM::m_CHRbanks = NULL;
+NES_THREAD_LOCAL uint32_t  CROM::m_numChrBankBuffers = 0;
+NES_THREAD_LOCAL uint8_t*  CROM::m_CHRRAMbanks [] = { NULL, };
+NES_THREAD_LOCAL uint8_t*  CROM::m_VRAMmemory = NULL;
+NES_THREAD_LOCAL uint8_t*  CROM::m_pPRGROMmemory [] = { NULL, NULL, NULL, NULL };
+NES_THREAD_LOCAL uint8_t*  CROM::m_pCHRmemory [] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+NES_THREAD_LOCAL uint8_t*  CROM::m_pVRAMmemory [] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+NES_THREAD_LOCAL uint8_t** CROM::m_SRAMmemory = NULL;
+NES_THREAD_LOCAL uint8_t*  CROM::m_pSRAMmemory [] = { NULL, NULL, NULL, NULL, NULL };
+NES_THREAD_LOCAL uint8_t*  CROM::m_EXRAMmemory = NULL;
+
+NES_THREAD_LOCAL uint32_t           CROM::m_mapper = 0;
+NES_THREAD_LOCAL uint32_t           CROM::m_numPrgBanks = 0;
+NES_THREAD_LOCAL uint32_t           CROM::m_numChrBanks = 0;
+
+NES_THREAD_LOCAL CCodeDataLogger* CROM::m_pEXRAMLogger = NULL;
+
+NES_THREAD_LOCAL BankDebugInfo** CROM::m_pPRGROMdebugInfo = NULL;
+NES_THREAD_LOCAL BankDebugInfo* CROM::m_pSRAMdebugInfo [] = { NULL, };
+NES_THREAD_LOCAL bool       CROM::m_SRAMdirty = false;
+NES_THREAD_LOCAL uint8_t*   CROM::m_EXRAMopcodeMask = NULL;
+NES_THREAD_LOCAL bool       CROM::m_EXRAMopcodeMaskDirty = false;
+NES_THREAD_LOCAL char*      CROM::m_EXRAMdisassembly = NULL;
+NES_THREAD_LOCAL uint16_t*  CROM::m_EXRAMsloc2addr = NULL;
+NES_THREAD_LOCAL uint16_t*  CROM::m_EXRAMaddr2sloc = NULL;
+NES_THREAD_LOCAL uint32_t   CROM::m_EXRAMsloc = 0;
+
+// Memory is always kept for a 32KB PRG-ROM window and 32KB of CHR-RAM.
+#define MIN_PRG_BANK_BUFFERS 4
+#define MIN_CHR_BANK_BUFFERS 32
+
+#if !defined ( NES_MULTI_INSTANCE )
 static CROM __init __attribute__((unused));
+#endif
 
 CROM::CROM()
 {
    int32_t bank;
    int32_t addr;
 
-   m_PRGROMmemory = new uint8_t*[NUM_ROM_BANKS];
-   m_PRGROMdisassembly = new char**[NUM_ROM_BANKS];
-   m_PRGROMopcodeMaskDirty = new bool[NUM_ROM_BANKS];
-   m_PRGROMopcodeMask = new uint8_t*[NUM_ROM_BANKS];
-   m_PRGROMsloc2addr = new uint16_t*[NUM_ROM_BANKS];
-   m_PRGROMaddr2sloc = new uint16_t*[NUM_ROM_BANKS];
-   m_PRGROMsloc = new uint32_t[NUM_ROM_BANKS];
-   for ( bank = 0; bank < NUM_ROM_BANKS; bank++ )
-   {
-      m_PRGROMmemory[bank] = new uint8_t[MEM_8KB+1]; // Leave room for bank ID.
-      m_PRGROMdisassembly[bank] = new char*[MEM_8KB];
-      m_PRGROMopcodeMaskDirty[bank] = true;
-      m_PRGROMopcodeMask[bank] = new uint8_t[MEM_8KB];
-      m_PRGROMsloc2addr[bank] = new uint16_t[MEM_8KB];
-      m_PRGROMaddr2sloc[bank] = new uint16_t[MEM_8KB];
-      m_PRGROMsloc[bank] = 0;
-      m_pLogger [ bank ] = new CCodeDataLogger ( MEM_8KB, MASK_8KB );
-
-      for ( addr = 0; addr < MEM_8KB; addr++ )
-      {
-         m_PRGROMdisassembly[bank][addr] = new char [ 16 ];
-         m_PRGROMopcodeMask[bank][addr] = 0;
-         m_PRGROMsloc2addr[bank][addr] = 0;
-         m_PRGROMaddr2sloc[bank][addr] = 0;
-      }
-
-      // Store bank ID in bank data at the end.  This is used only
-      // by code that needs to calculate absolute address stuff.
-      // Since the banks are stored non-contiguously this is a cheap
-      // way to get the bank ID without having to implement a structure.
-      m_PRGROMmemory[bank][MEM_8KB] = bank;
-   }
+   GROWPRGBANKS ( MIN_PRG_BANK_BUFFERS );
 
    m_SRAMmemory = new uint8_t*[NUM_SRAM_BANKS];
-   m_SRAMdisassembly = new char**[NUM_SRAM_BANKS];
-   m_SRAMopcodeMaskDirty = new bool[NUM_SRAM_BANKS];
-   m_SRAMopcodeMask = new uint8_t*[NUM_SRAM_BANKS];
-   m_SRAMsloc2addr = new uint16_t*[NUM_SRAM_BANKS];
-   m_SRAMaddr2sloc = new uint16_t*[NUM_SRAM_BANKS];
-   m_SRAMsloc = new uint32_t[NUM_SRAM_BANKS];
    for ( bank = 0; bank < NUM_SRAM_BANKS; bank++ )
    {
       m_SRAMmemory[bank] = new uint8_t[MEM_8KB+1]; // Leave room for bank ID.
-      m_SRAMdisassembly[bank] = new char*[MEM_8KB];
-      m_SRAMopcodeMaskDirty[bank] = true;
-      m_SRAMopcodeMask[bank] = new uint8_t[MEM_8KB];
-      m_SRAMsloc2addr[bank] = new uint16_t[MEM_8KB];
-      m_SRAMaddr2sloc[bank] = new uint16_t[MEM_8KB];
-      m_SRAMsloc[bank] = 0;
-      m_pSRAMLogger [ bank ] = new CCodeDataLogger ( MEM_8KB, MASK_8KB );
-
-      for ( addr = 0; addr < MEM_8KB; addr++ )
-      {
-         m_SRAMdisassembly[bank][addr] = new char [ 16 ];
-         m_SRAMopcodeMask[bank][addr] = 0;
-         m_SRAMsloc2addr[bank][addr] = 0;
-         m_SRAMaddr2sloc[bank][addr] = 0;
-      }
 
       // Store bank ID in bank data at the end.  This is used only
       // by code that needs to calculate absolute address stuff.
@@ -218,14 +167,13 @@ CROM::CROM()
    }
 
    m_EXRAMmemory = new uint8_t[MEM_1KB];
-   m_EXRAMdisassembly = new char*[MEM_1KB];
+   m_EXRAMdisassembly = new char[MEM_1KB*DISASSEMBLY_LINE_SIZE];
    m_EXRAMopcodeMask = new uint8_t[MEM_1KB];
    m_EXRAMsloc2addr = new uint16_t[MEM_1KB];
    m_EXRAMaddr2sloc = new uint16_t[MEM_1KB];
    m_pEXRAMLogger = new CCodeDataLogger ( MEM_1KB, MASK_1KB );
    for ( addr = 0; addr < MEM_1KB; addr++ )
    {
-      m_EXRAMdisassembly[addr] = new char [ 16 ];
       m_EXRAMopcodeMask[addr] = 0;
       m_EXRAMsloc2addr[addr] = 0;
       m_EXRAMaddr2sloc[addr] = 0;
@@ -233,17 +181,12 @@ CROM::CROM()
 
    m_VRAMmemory = new uint8_t[MEM_16KB]; // GTROM mapper 111 has 16KB remappable here
 
-   m_CHRmemory = new uint8_t*[NUM_CHR_BANKS];
-   for ( bank = 0; bank < NUM_CHR_BANKS; bank++ )
+   for ( bank = 0; bank < NUM_CHR_RAM_BANKS; bank++ )
    {
-      m_CHRmemory[bank] = new uint8_t[MEM_1KB+1]; // Leave room for bank ID.
-
-      // Store bank ID in bank data at the end.  This is used only
-      // by code that needs to calculate absolute address stuff.
-      // Since the banks are stored non-contiguously this is a cheap
-      // way to get the bank ID without having to implement a structure.
-      m_CHRmemory[bank][MEM_1KB] = bank;
+      m_CHRRAMbanks[bank] = new uint8_t[MEM_1KB+2]; // Leave room for bank ID.
+      memset ( m_CHRRAMbanks[bank], 0, MEM_1KB );
    }
+   GROWCHRBANKS ( MIN_CHR_BANK_BUFFERS );
 
    // Assume identity-mapped SRAM...
    // There are five possible concurrently-visible 8KB
@@ -259,77 +202,316 @@ CROM::CROM()
 
 CROM::~CROM()
 {
-   int32_t bank;
-   int32_t addr;
+   uint32_t bank;
 
-   for ( bank = 0; bank < NUM_ROM_BANKS; bank++ )
+   for ( bank = 0; bank < m_numPrgBankBuffers; bank++ )
    {
-      delete m_pLogger [ bank ];
-
-      for ( addr = 0; addr < MEM_8KB; addr++ )
-      {
-         delete m_PRGROMdisassembly[bank][addr];
-      }
-      delete [] m_PRGROMmemory[bank];
-      delete [] m_PRGROMopcodeMask[bank];
-      delete [] m_PRGROMsloc2addr[bank];
-      delete [] m_PRGROMaddr2sloc[bank];
+      DESTROYDEBUGINFO ( m_pPRGROMdebugInfo[bank] );
+      delete [] m_PRGROMbanks[bank];
    }
-   delete [] m_PRGROMopcodeMaskDirty;
+   delete [] m_pPRGROMdebugInfo;
+   delete [] m_PRGROMbanks;
    delete [] m_PRGROMmemory;
-   delete [] m_PRGROMopcodeMask;
-   delete [] m_PRGROMsloc2addr;
-   delete [] m_PRGROMaddr2sloc;
-   delete [] m_PRGROMsloc;
+   m_pPRGROMdebugInfo = NULL;
+   m_PRGROMbanks = NULL;
+   m_PRGROMmemory = NULL;
+   m_numPrgBankBuffers = 0;
+   m_numPrgSlots = 0;
 
-   for ( bank = 0; bank < NUM_CHR_BANKS; bank++ )
+   for ( bank = 0; bank < m_numChrBankBuffers; bank++ )
    {
-      delete [] m_CHRmemory[bank];
+      delete [] m_CHRbanks[bank];
    }
+   for ( bank = 0; bank < NUM_CHR_RAM_BANKS; bank++ )
+   {
+      delete [] m_CHRRAMbanks[bank];
+   }
+   delete [] m_CHRbanks;
    delete [] m_CHRmemory;
+   m_CHRbanks = NULL;
+   m_CHRmemory = NULL;
+   m_numChrBankBuffers = 0;
+   m_numChrSlots = 0;
 
    for ( bank = 0; bank < NUM_SRAM_BANKS; bank++ )
    {
-      for ( addr = 0; addr < MEM_8KB; addr++ )
-      {
-         delete m_SRAMdisassembly[bank][addr];
-      }
+      DESTROYDEBUGINFO ( m_pSRAMdebugInfo[bank] );
+      m_pSRAMdebugInfo[bank] = NULL;
       delete [] m_SRAMmemory[bank];
-      delete [] m_SRAMopcodeMask[bank];
-      delete [] m_SRAMsloc2addr[bank];
-      delete [] m_SRAMaddr2sloc[bank];
    }
-   delete [] m_SRAMopcodeMaskDirty;
    delete [] m_SRAMmemory;
-   delete [] m_SRAMopcodeMask;
-   delete [] m_SRAMsloc2addr;
-   delete [] m_SRAMaddr2sloc;
-   delete [] m_SRAMsloc;
 
    delete [] m_VRAMmemory;
 
-   for ( addr = 0; addr < MEM_1KB; addr++ )
-   {
-      delete m_EXRAMdisassembly[addr];
-   }
+   delete [] m_EXRAMdisassembly;
+   delete m_pEXRAMLogger;
    delete [] m_EXRAMmemory;
    delete [] m_EXRAMopcodeMask;
    delete [] m_EXRAMsloc2addr;
    delete [] m_EXRAMaddr2sloc;
 }
 
+BankDebugInfo* CROM::CREATEDEBUGINFO ( uint8_t* binary )
+{
+   BankDebugInfo* pDebugInfo = new BankDebugInfo;
+
+   pDebugInfo->pLogger = new CCodeDataLogger ( MEM_8KB, MASK_8KB );
+   pDebugInfo->pOpcodeMask = new uint8_t[MEM_8KB];
+   pDebugInfo->pDisassembly = new char[MEM_8KB*DISASSEMBLY_LINE_SIZE];
+   pDebugInfo->pSloc2addr = new uint16_t[MEM_8KB];
+   pDebugInfo->pAddr2sloc = new uint16_t[MEM_8KB];
+   memset ( pDebugInfo->pOpcodeMask, 0, MEM_8KB );
+
+   // Nothing has been executed in the bank yet, but the debuggers
+   // still need something to show for it.
+   C6502::DISASSEMBLE ( pDebugInfo->pDisassembly,
+                        binary,
+                        MEM_8KB,
+                        pDebugInfo->pOpcodeMask,
+                        pDebugInfo->pSloc2addr,
+                        pDebugInfo->pAddr2sloc,
+                        &(pDebugInfo->sloc) );
+   pDebugInfo->changedStart = MEM_8KB;
+   pDebugInfo->changedEnd = 0;
+
+   return pDebugInfo;
+}
+
+void CROM::DESTROYDEBUGINFO ( BankDebugInfo* pDebugInfo )
+{
+   if ( pDebugInfo )
+   {
+      delete pDebugInfo->pLogger;
+      delete [] pDebugInfo->pOpcodeMask;
+      delete [] pDebugInfo->pDisassembly;
+      delete [] pDebugInfo->pSloc2addr;
+      delete [] pDebugInfo->pAddr2sloc;
+      delete pDebugInfo;
+   }
+}
+
+void CROM::GROWPRGBANKS ( uint32_t numBanks )
+{
+   uint8_t**       banks;
+   BankDebugInfo** debugInfo;
+   uint32_t        bank;
+
+   if ( numBanks > m_numPrgBankBuffers )
+   {
+      banks = new uint8_t*[numBanks];
+      debugInfo = new BankDebugInfo*[numBanks];
+      for ( bank = 0; bank < numBanks; bank++ )
+      {
+         if ( bank < m_numPrgBankBuffers )
+         {
+            banks[bank] = m_PRGROMbanks[bank];
+            debugInfo[bank] = m_pPRGROMdebugInfo[bank];
+         }
+         else
+         {
+            banks[bank] = new uint8_t[MEM_8KB+2]; // Leave room for bank ID.
+            memset ( banks[bank], 0, MEM_8KB );
+
+            // Store bank ID in bank data at the end.  This is used only
+            // by code that needs to calculate absolute address stuff.
+            // Since the banks are stored non-contiguously this is a cheap
+            // way to get the bank ID without having to implement a structure.
+            *((uint16_t*)(banks[bank]+MEM_8KB)) = bank;
+            debugInfo[bank] = NULL;
+         }
+      }
+      delete [] m_PRGROMbanks;
+      delete [] m_pPRGROMdebugInfo;
+      m_PRGROMbanks = banks;
+      m_pPRGROMdebugInfo = debugInfo;
+      m_numPrgBankBuffers = numBanks;
+
+      MAPPRGBANKS ();
+   }
+}
+
+void CROM::GROWCHRBANKS ( uint32_t numBanks )
+{
+   uint8_t** banks;
+   uint32_t  bank;
+
+   if ( numBanks > m_numChrBankBuffers )
+   {
+      banks = new uint8_t*[numBanks];
+      for ( bank = 0; bank < numBanks; bank++ )
+      {
+         if ( bank < m_numChrBankBuffers )
+         {
+            banks[bank] = m_CHRbanks[bank];
+         }
+         else
+         {
+            banks[bank] = new uint8_t[MEM_1KB+2]; // Leave room for bank ID.
+            memset ( banks[bank], 0, MEM_1KB );
+            *((uint16_t*)(banks[bank]+MEM_1KB)) = bank;
+         }
+      }
+      delete [] m_CHRbanks;
+      m_CHRbanks = banks;
+      m_numChrBankBuffers = numBanks;
+
+      MAPCHRBANKS ();
+   }
+}
+
+void CROM::MAPPRGBANKS ( void )
+{
+   uint32_t numSlots = NUM_ROM_BANKS;
+   uint32_t slot;
+
+   // Bank numbers past the end of the ROM wrap around to the start of it,
+   // as they would on a board that doesn't connect the upper address lines.
+   while ( numSlots < m_numPrgBankBuffers )
+   {
+      numSlots <<= 1;
+   }
+   if ( numSlots != m_numPrgSlots )
+   {
+      delete [] m_PRGROMmemory;
+      m_PRGROMmemory = new uint8_t*[numSlots];
+      m_numPrgSlots = numSlots;
+   }
+   for ( slot = 0; slot < numSlots; slot++ )
+   {
+      m_PRGROMmemory[slot] = m_PRGROMbanks[slot%m_numPrgBankBuffers];
+   }
+}
+
+void CROM::MAPCHRBANKS ( void )
+{
+   uint32_t numSlots = NUM_CHR_BANKS;
+   uint32_t slot;
+   uint32_t bank;
+
+   while ( numSlots < m_numChrBankBuffers )
+   {
+      numSlots <<= 1;
+   }
+   if ( numSlots != m_numChrSlots )
+   {
+      delete [] m_CHRmemory;
+      m_CHRmemory = new uint8_t*[numSlots+NUM_CHR_RAM_BANKS];
+      m_numChrSlots = numSlots;
+   }
+   for ( slot = 0; slot < numSlots; slot++ )
+   {
+      m_CHRmemory[slot] = m_CHRbanks[slot%m_numChrBankBuffers];
+   }
+
+   // The extra CHR-RAM banks go on the end so their IDs depend on the
+   // size of the table.
+   for ( bank = 0; bank < NUM_CHR_RAM_BANKS; bank++ )
+   {
+      m_CHRmemory[numSlots+bank] = m_CHRRAMbanks[bank];
+      *((uint16_t*)(m_CHRRAMbanks[bank]+MEM_1KB)) = numSlots+bank;
+   }
+}
+
+void CROM::ClearPRGBanks ()
+{
+   uint32_t bank;
+
+   // The debugger information belongs to the cartridge being removed, and
+   // so does any memory for banks past the minimum.
+   for ( bank = 0; bank < m_numPrgBankBuffers; bank++ )
+   {
+      DESTROYDEBUGINFO ( m_pPRGROMdebugInfo[bank] );
+      m_pPRGROMdebugInfo[bank] = NULL;
+      if ( bank >= MIN_PRG_BANK_BUFFERS )
+      {
+         delete [] m_PRGROMbanks[bank];
+      }
+   }
+   m_numPrgBankBuffers = MIN_PRG_BANK_BUFFERS;
+   MAPPRGBANKS ();
+   for ( bank = 0; bank < NUM_SRAM_BANKS; bank++ )
+   {
+      DESTROYDEBUGINFO ( m_pSRAMdebugInfo[bank] );
+      m_pSRAMdebugInfo[bank] = NULL;
+   }
+
+   m_numPrgBanks = 0;
+}
+
+void CROM::ClearCHRBanks ()
+{
+   uint32_t bank;
+
+   for ( bank = MIN_CHR_BANK_BUFFERS; bank < m_numChrBankBuffers; bank++ )
+   {
+      delete [] m_CHRbanks[bank];
+   }
+   m_numChrBankBuffers = MIN_CHR_BANK_BUFFERS;
+   MAPCHRBANKS ();
+
+   m_numChrBanks = 0;
+}
+
+void CROM::CLEARLOGGERS ( void )
+{
+   uint32_t bank;
+
+   for ( bank = 0; bank < m_numPrgBankBuffers; bank++ )
+   {
+      if ( m_pPRGROMdebugInfo[bank] )
+      {
+         m_pPRGROMdebugInfo[bank]->pLogger->ClearData ();
+      }
+   }
+}
+
+void CROM::PRGROMOPCODEMASKCLR ( void )
+{
+   uint32_t bank;
+
+   for ( bank = 0; bank < m_numPrgBankBuffers; bank++ )
+   {
+      if ( m_pPRGROMdebugInfo[bank] )
+      {
+         memset ( m_pPRGROMdebugInfo[bank]->pOpcodeMask, 0, MEM_8KB );
+         OPCODEMASKCHANGED ( m_pPRGROMdebugInfo[bank] );
+      }
+   }
+}
+
+void CROM::SRAMOPCODEMASKCLR ( void )
+{
+   int32_t bank;
+
+   for ( bank = 0; bank < NUM_SRAM_BANKS; bank++ )
+   {
+      if ( m_pSRAMdebugInfo[bank] )
+      {
+         memset ( m_pSRAMdebugInfo[bank]->pOpcodeMask, 0, MEM_8KB );
+         OPCODEMASKCHANGED ( m_pSRAMdebugInfo[bank] );
+      }
+   }
+}
+
 void CROM::SetPRGBank ( int32_t bank, uint8_t* data )
 {
-   memcpy ( m_PRGROMmemory[m_numPrgBanks], data, MEM_8KB );
+   GROWPRGBANKS ( m_numPrgBanks+1 );
+   memcpy ( m_PRGROMbanks[m_numPrgBanks], data, MEM_8KB );
+   if ( m_pPRGROMdebugInfo[m_numPrgBanks] )
+   {
+      OPCODEMASKCHANGED ( m_pPRGROMdebugInfo[m_numPrgBanks] );
+   }
    m_numPrgBanks++;
 }
 
 void CROM::SetCHRBank ( int32_t bank, uint8_t* data )
 {
    uint8_t ibank;
+
+   GROWCHRBANKS ( (bank+1)<<3 );
    for ( ibank = 0; ibank < 8; ibank++ )
    {
-      memcpy ( m_CHRmemory[(bank<<3)+ibank], data+(ibank*MEM_1KB), MEM_1KB );
+      memcpy ( m_CHRbanks[(bank<<3)+ibank], data+(ibank*MEM_1KB), MEM_1KB );
    }
    m_numChrBanks = bank + 1;
 }
@@ -374,10 +556,7 @@ void CROM::RESET ( uint32_t mapper, bool soft )
    if ( nesIsDebuggable() )
    {
       // Clear Code/Data Logger info...
-      for ( bank = 0; bank < NUM_ROM_BANKS; bank++ )
-      {
-         m_pLogger [ bank ]->ClearData ();
-      }
+      CLEARLOGGERS ();
    }
 
    // Support for NROM-368 for Shiru and crew.
@@ -442,6 +621,78 @@ void CROM::RESET ( uint32_t mapper, bool soft )
    }
 }
 
+void CROM::STATE ( CSaveState& state )
+{
+   int32_t  idx;
+   uint16_t bank = 0;
+
+   if ( state.BeginChunk(SAVESTATE_TAG('R','O','M',' '),1) )
+   {
+      // The bank pointers are saved as bank indexes so a snapshot
+      // does not depend on where the banks are in host memory.
+      for ( idx = 0; idx < 4; idx++ )
+      {
+         if ( !state.IsLoading() )
+         {
+            bank = *((uint16_t*)(m_pPRGROMmemory[idx]+MEM_8KB));
+         }
+         state.Value ( bank );
+         m_pPRGROMmemory[idx] = m_PRGROMmemory[bank%m_numPrgSlots];
+      }
+      for ( idx = 0; idx < 8; idx++ )
+      {
+         if ( !state.IsLoading() )
+         {
+            bank = CHRBANKINDEX(m_pCHRmemory[idx]);
+         }
+         state.Value ( bank );
+         m_pCHRmemory[idx] = CHRBANKPOINTER(bank);
+      }
+      for ( idx = 0; idx < 5; idx++ )
+      {
+         if ( !state.IsLoading() )
+         {
+            bank = *(m_pSRAMmemory[idx]+MEM_8KB);
+         }
+         state.Value ( bank );
+         m_pSRAMmemory[idx] = m_SRAMmemory[bank%NUM_SRAM_BANKS];
+      }
+      for ( idx = 0; idx < 8; idx++ )
+      {
+         if ( !state.IsLoading() )
+         {
+            bank = (m_pVRAMmemory[idx]-m_VRAMmemory)>>UPSHIFT_1KB;
+         }
+         state.Value ( bank );
+         m_pVRAMmemory[idx] = m_VRAMmemory+((bank&0xF)*MEM_1KB);
+      }
+
+      for ( idx = 0; idx < NUM_SRAM_BANKS; idx++ )
+      {
+         state.Bytes ( m_SRAMmemory[idx], MEM_8KB );
+      }
+      state.Bytes ( m_EXRAMmemory, MEM_1KB );
+
+      // Cartridge VRAM is only in use for four-screen mirroring.
+      if ( CPPU::FOURSCREEN() )
+      {
+         state.Bytes ( m_VRAMmemory, MEM_16KB );
+      }
+
+      // Without CHR-ROM the CHR memory is RAM.  Mappers use at most
+      // 32KB of it.
+      if ( !m_numChrBanks )
+      {
+         for ( idx = 0; idx < 32; idx++ )
+         {
+            state.Bytes ( m_CHRmemory[idx], MEM_1KB );
+         }
+      }
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROM::LMAPPER ( uint32_t addr )
 {
    uint8_t data = C6502::OPENBUS();
@@ -470,43 +721,26 @@ void CROM::LMAPPER ( uint32_t addr, uint8_t data )
    }
 }
 
-void CROM::DISASSEMBLE ()
+void CROM::DISASSEMBLE ( BankDebugInfo* pDebugInfo, uint8_t* binary )
 {
-   uint32_t bank;
-
-   // Disassemble PRG-ROM banks...
-   for ( bank = 0; bank < m_numPrgBanks; bank++ )
-   {
-      if ( *(m_PRGROMopcodeMaskDirty+bank) )
-      {
-         C6502::DISASSEMBLE ( m_PRGROMdisassembly[bank],
-                              m_PRGROMmemory[bank],
-                              MEM_8KB,
-                              m_PRGROMopcodeMask[bank],
-                              m_PRGROMsloc2addr[bank],
-                              m_PRGROMaddr2sloc[bank],
-                              &(m_PRGROMsloc[bank]) );
-
-         *(m_PRGROMopcodeMaskDirty+bank) = false;
-      }
-   }
+   C6502::DISASSEMBLE ( pDebugInfo->pDisassembly,
+                        binary,
+                        MEM_8KB,
+                        pDebugInfo->pOpcodeMask,
+                        pDebugInfo->pSloc2addr,
+                        pDebugInfo->pAddr2sloc,
+                        &(pDebugInfo->sloc),
+                        pDebugInfo->changedStart,
+                        pDebugInfo->changedEnd );
+
+   pDebugInfo->changedStart = MEM_8KB;
+   pDebugInfo->changedEnd = 0;
+}
 
-   // Disassemble SRAM...
-   for ( bank = 0; bank < NUM_SRAM_BANKS; bank++ )
-   {
-      if ( *(m_SRAMopcodeMaskDirty+bank) )
-      {
-         C6502::DISASSEMBLE ( m_SRAMdisassembly[bank],
-                              m_SRAMmemory[bank],
-                              MEM_8KB,
-                              m_SRAMopcodeMask[bank],
-                              m_SRAMsloc2addr[bank],
-                              m_SRAMaddr2sloc[bank],
-                              &(m_SRAMsloc[bank]) );
-
-         *(m_SRAMopcodeMaskDirty+bank) = false;
-      }
-   }
+void CROM::DISASSEMBLE ()
+{
+   // PRG-ROM and SRAM banks are brought up to date when their disassembly
+   // is asked for.
 
    // Disassemble EXRAM...
    if ( m_EXRAMopcodeMaskDirty )
@@ -551,14 +785,14 @@ uint32_t CROM::PRGROMSLOC2ADDR ( uint16_t sloc )
       sloc -= slocC000;
    }
 
-   return addr+(*(*(m_PRGROMsloc2addr+PRGBANK_PHYS(addr))+sloc));
+   return addr+(*(PRGROMDISASSEMBLYINFO(PRGBANK_PHYS(addr))->pSloc2addr+sloc));
 }
 
 uint32_t CROM::SRAMSLOC2ADDR ( uint16_t sloc )
 {
    int32_t addr = 0x6000;
 
-   return addr+(*(*(m_SRAMsloc2addr+SRAMBANK_PHYS(addr))+sloc));
+   return addr+(*(SRAMDISASSEMBLYINFO(SRAMBANK_PHYS(addr))->pSloc2addr+sloc));
 }
 
 uint32_t CROM::EXRAMSLOC2ADDR ( uint16_t sloc )
@@ -590,14 +824,14 @@ uint16_t CROM::PRGROMADDR2SLOC ( uint32_t addr )
       sloc = slocC000;
    }
 
-   return sloc+(*(*(m_PRGROMaddr2sloc+PRGBANK_PHYS(addr))+PRGBANK_OFF(addr)));
+   return sloc+(*(PRGROMDISASSEMBLYINFO(PRGBANK_PHYS(addr))->pAddr2sloc+PRGBANK_OFF(addr)));
 }
 
 uint16_t CROM::SRAMADDR2SLOC ( uint32_t addr )
 {
    int32_t sloc = 0;
 
-   return sloc+(*(*(m_SRAMaddr2sloc+SRAMBANK_PHYS(addr))+SRAMBANK_OFF(addr)));
+   return sloc+(*(SRAMDISASSEMBLYINFO(SRAMBANK_PHYS(addr))->pAddr2sloc+SRAMBANK_OFF(addr)));
 }
 
 uint16_t CROM::EXRAMADDR2SLOC ( uint32_t addr )
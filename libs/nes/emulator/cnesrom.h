@@ -16,7 +16,7 @@
 // Retrieve the bank-offset address portion of a 6502-address for use within PRG ROM banks
 #define PRGBANK_OFF(addr) ( addr&MASK_8KB )
 // Resolve a 6502-address to one of the 8KB PRG ROM banks within a ROM file [the absolute physical address]
-#define PRGBANK_PHYS(addr) ( *((*(m_pPRGROMmemory+PRGBANK_VIRT(addr)))+MEM_8KB) )
+#define PRGBANK_PHYS(addr) ( *((uint16_t*)((*(m_pPRGROMmemory+PRGBANK_VIRT(addr)))+MEM_8KB)) )
 
 // Resolve an absolute address to a PRG-ROM bank
 #define PRGBANK_ABSBANK(absAddr) ( absAddr>>SHIFT_32KB_8KB )
@@ -26,7 +26,7 @@
 // Retrieve the bank-offset address portion of an address for use within CHR memory banks
 #define CHRBANK_OFF(addr) ( addr&MASK_1KB )
 // Resolve an address to one of the 8KB CHR memory banks [the absolute physical address]
-#define CHRBANK_PHYS(addr) ( *((*(m_pCHRmemory+CHRBANK_VIRT(addr)))+MEM_1KB) )
+#define CHRBANK_PHYS(addr) ( *((uint16_t*)((*(m_pCHRmemory+CHRBANK_VIRT(addr)))+MEM_1KB)) )
 
 #define SRAMBANK_VIRT(addr) ( ((addr-SRAM_START)&MASK_64KB)>>SHIFT_64KB_8KB )
 #define SRAMBANK_OFF(addr) ( addr&MASK_8KB )
@@ -38,6 +38,24 @@
 
 #define SRAMBANK_ABSBANK(absAddr) ( absAddr>>SHIFT_64KB_8KB )
 
+// The debugger information kept for an 8KB bank of PRG-ROM or SRAM:
+// the Code/Data Logger, which bytes have been executed as opcodes, and
+// the runtime disassembly of the bank.  It is many times the size of the
+// bank itself so it is only allocated for a bank once something needs it.
+// The disassembly is brought up to date when it is asked for, and only
+// around the addresses whose opcode mask changed since the last time.
+typedef struct
+{
+   CCodeDataLogger* pLogger;
+   uint8_t*         pOpcodeMask;
+   uint16_t         changedStart;
+   uint16_t         changedEnd;
+   char*            pDisassembly;
+   uint16_t*        pSloc2addr;
+   uint16_t*        pAddr2sloc;
+   uint32_t         sloc;
+} BankDebugInfo;
+
 class CROM
 {
 public:
@@ -45,14 +63,8 @@ public:
    ~CROM();
 
    // Priming interfaces (data setup/initialization)
-   static void ClearPRGBanks ()
-   {
-      m_numPrgBanks = 0;
-   }
-   static void ClearCHRBanks ()
-   {
-      m_numChrBanks = 0;
-   }
+   static void ClearPRGBanks ();
+   static void ClearCHRBanks ();
    static void SetCHRBank ( int32_t bank, uint8_t* data );
    static void SetPRGBank ( int32_t bank, uint8_t* data );
    static void DoneLoadingBanks ( void );
@@ -83,9 +95,13 @@ public:
       return *(*(m_pPRGROMmemory+PRGBANK_VIRT(addr))+(PRGBANK_OFF(addr)));
    }
    static inline void PRGROM ( uint32_t, uint8_t ) {}
+   static inline uint8_t* PRGROMBANK ( uint32_t addr )
+   {
+      return *(m_pPRGROMmemory+PRGBANK_VIRT(addr));
+   }
    static inline uint32_t PRGROMPHYS ( uint32_t addr )
    {
-      return *(*(m_PRGROMmemory+PRGBANK_ABSBANK(addr))+PRGBANK_OFF(addr));
+      return *(*(m_PRGROMmemory+(PRGBANK_ABSBANK(addr)%m_numPrgSlots))+PRGBANK_OFF(addr));
    }
    static inline void CHRMEM ( uint32_t addr, uint8_t data )
    {
@@ -95,6 +111,21 @@ public:
    {
       return *(*(m_pCHRmemory+CHRBANK_VIRT(addr))+CHRBANK_OFF(addr));
    }
+   // Convert between a 1KB CHR memory bank and its index for save states.
+   static inline uint16_t CHRBANKINDEX ( uint8_t* bank )
+   {
+      return *((uint16_t*)(bank+MEM_1KB));
+   }
+   static inline uint8_t* CHRBANKPOINTER ( uint16_t index )
+   {
+      return *(m_CHRmemory+(index%(m_numChrSlots+NUM_CHR_RAM_BANKS)));
+   }
+   // The extra CHR-RAM banks of CHR-ROM mappers like N106.  They sit in the
+   // CHR bank table just past the bank numbers the ROM can use.
+   static inline uint8_t* CHRRAMBANK ( uint32_t bank )
+   {
+      return *(m_CHRmemory+m_numChrSlots+(bank%NUM_CHR_RAM_BANKS));
+   }
    static inline uint32_t SRAMABSADDR ( uint32_t addr )
    {
       return (SRAMBANK_PHYS(addr)*MEM_8KB)+SRAMBANK_OFF(addr);
@@ -120,6 +151,10 @@ public:
          m_SRAMdirty = true;
       }
    }
+   static inline uint8_t* SRAMBANK ( uint32_t addr )
+   {
+      return *(m_pSRAMmemory+SRAMBANK_VIRT(addr));
+   }
    static inline void REMAPSRAM ( uint32_t addr, uint8_t bank )
    {
       *(m_pSRAMmemory+SRAMBANK_VIRT(addr)) = *(m_SRAMmemory+bank);
@@ -152,6 +187,7 @@ public:
    // Mapper interfaces [called by emulator through mapperfunc array]
    static void RESET ( bool soft );
    static void RESET ( uint32_t mapper, bool soft );
+   static void STATE ( CSaveState& state );
    static uint32_t MAPPER ( void )
    {
       return m_mapper;
@@ -175,23 +211,61 @@ public:
    }
    static void SOUNDENABLE ( uint32_t mask ) {}
 
+   // Debugger information for a PRG-ROM or SRAM bank, allocated the
+   // first time it is asked for.
+   static inline BankDebugInfo* PRGROMDEBUGINFO ( uint32_t bank )
+   {
+      if ( !(*(m_pPRGROMdebugInfo+bank)) )
+      {
+         *(m_pPRGROMdebugInfo+bank) = CREATEDEBUGINFO ( *(m_PRGROMbanks+bank) );
+      }
+      return *(m_pPRGROMdebugInfo+bank);
+   }
+   static inline BankDebugInfo* SRAMDEBUGINFO ( uint32_t bank )
+   {
+      if ( !(*(m_pSRAMdebugInfo+bank)) )
+      {
+         *(m_pSRAMdebugInfo+bank) = CREATEDEBUGINFO ( *(m_SRAMmemory+bank) );
+      }
+      return *(m_pSRAMdebugInfo+bank);
+   }
+   static inline BankDebugInfo* PRGROMDISASSEMBLYINFO ( uint32_t bank )
+   {
+      BankDebugInfo* pDebugInfo = PRGROMDEBUGINFO(bank);
+      if ( pDebugInfo->changedStart < pDebugInfo->changedEnd )
+      {
+         DISASSEMBLE ( pDebugInfo, *(m_PRGROMbanks+bank) );
+      }
+      return pDebugInfo;
+   }
+   static inline BankDebugInfo* SRAMDISASSEMBLYINFO ( uint32_t bank )
+   {
+      BankDebugInfo* pDebugInfo = SRAMDEBUGINFO(bank);
+      if ( pDebugInfo->changedStart < pDebugInfo->changedEnd )
+      {
+         DISASSEMBLE ( pDebugInfo, *(m_SRAMmemory+bank) );
+      }
+      return pDebugInfo;
+   }
+
    // Code/Data logger support functions
    static inline CCodeDataLogger* LOGGERVIRT ( uint32_t addr )
    {
-      return *(m_pLogger+PRGBANK_PHYS(addr));
+      return PRGROMDEBUGINFO(PRGBANK_PHYS(addr))->pLogger;
    }
    static inline CCodeDataLogger* SRAMLOGGERVIRT ( uint32_t addr )
    {
-      return *(m_pSRAMLogger+SRAMBANK_PHYS(addr));
+      return SRAMDEBUGINFO(SRAMBANK_PHYS(addr))->pLogger;
    }
    static inline CCodeDataLogger* LOGGERPHYS ( uint32_t addr )
    {
-      return *(m_pLogger+PRGBANK_ABSBANK(addr));
+      return PRGROMDEBUGINFO(PRGBANK_ABSBANK(addr)%m_numPrgBankBuffers)->pLogger;
    }
    static inline CCodeDataLogger* SRAMLOGGERPHYS ( uint32_t addr )
    {
-      return *(m_pSRAMLogger+SRAMBANK_ABSBANK(addr));
+      return SRAMDEBUGINFO(SRAMBANK_ABSBANK(addr))->pLogger;
    }
+   static void CLEARLOGGERS ( void );
    static inline CCodeDataLogger* EXRAMLOGGER ()
    {
       return m_pEXRAMLogger;
@@ -200,75 +274,59 @@ public:
    // Support functions for inline disassembly in PRG-ROM, SRAM, and EXRAM
    static inline void PRGROMOPCODEMASK ( uint32_t addr, uint8_t mask )
    {
-      if ( (*(*(m_PRGROMopcodeMask+PRGBANK_PHYS(addr))+PRGBANK_OFF(addr))) != mask )
+      BankDebugInfo* pDebugInfo = PRGROMDEBUGINFO(PRGBANK_PHYS(addr));
+      if ( (*(pDebugInfo->pOpcodeMask+PRGBANK_OFF(addr))) != mask )
       {
-         *(m_PRGROMopcodeMaskDirty+PRGBANK_PHYS(addr)) = true;
+         OPCODEMASKCHANGED ( pDebugInfo, PRGBANK_OFF(addr) );
       }
-      *(*(m_PRGROMopcodeMask+PRGBANK_PHYS(addr))+PRGBANK_OFF(addr)) = mask;
+      *(pDebugInfo->pOpcodeMask+PRGBANK_OFF(addr)) = mask;
    }
    static inline void PRGROMOPCODEMASKATABSADDR ( uint32_t absAddr, uint8_t mask )
    {
-      *(*(m_PRGROMopcodeMask+PRGBANK_ABSBANK(absAddr))+PRGBANK_OFF(absAddr)) = mask;
-   }
-   static inline void PRGROMOPCODEMASKCLR ( void )
-   {
-      int32_t idx1;
-      int32_t idx2;
-      for ( idx1 = 0; idx1 < NUM_ROM_BANKS; idx1++ )
+      BankDebugInfo* pDebugInfo = PRGROMDEBUGINFO(PRGBANK_ABSBANK(absAddr)%m_numPrgBankBuffers);
+      if ( (*(pDebugInfo->pOpcodeMask+PRGBANK_OFF(absAddr))) != mask )
       {
-         for ( idx2 = 0; idx2 < MEM_8KB; idx2++ )
-         {
-            m_PRGROMopcodeMask[idx1][idx2] = 0;
-         }
-         m_PRGROMopcodeMaskDirty[idx1] = true;
+         OPCODEMASKCHANGED ( pDebugInfo, PRGBANK_OFF(absAddr) );
       }
+      *(pDebugInfo->pOpcodeMask+PRGBANK_OFF(absAddr)) = mask;
    }
+   static void PRGROMOPCODEMASKCLR ( void );
    static inline char* PRGROMDISASSEMBLY ( uint32_t addr )
    {
-      return *(*(m_PRGROMdisassembly+PRGBANK_PHYS(addr))+PRGBANK_OFF(addr));
+      return PRGROMDISASSEMBLYINFO(PRGBANK_PHYS(addr))->pDisassembly+(PRGBANK_OFF(addr)*DISASSEMBLY_LINE_SIZE);
    }
    static inline char* PRGROMDISASSEMBLYATABSADDR ( uint32_t absAddr, char* buffer )
    {
-      return C6502::Disassemble((*(m_PRGROMmemory+PRGBANK_ABSBANK(absAddr))+PRGBANK_OFF(absAddr)),buffer);
+      return C6502::Disassemble((*(m_PRGROMmemory+(PRGBANK_ABSBANK(absAddr)%m_numPrgSlots))+PRGBANK_OFF(absAddr)),buffer);
    }
    static uint32_t PRGROMSLOC2ADDR ( uint16_t sloc );
    static uint16_t PRGROMADDR2SLOC ( uint32_t addr );
    static inline uint32_t PRGROMSLOC ( uint32_t addr )
    {
-      return *(m_PRGROMsloc+PRGBANK_PHYS(addr));
+      return PRGROMDISASSEMBLYINFO(PRGBANK_PHYS(addr))->sloc;
    }
    static inline void SRAMOPCODEMASK ( uint32_t addr, uint8_t mask )
    {
-      if ( (*(*(m_SRAMopcodeMask+SRAMBANK_PHYS(addr))+SRAMBANK_OFF(addr))) != mask )
-      {
-         *(m_SRAMopcodeMaskDirty+SRAMBANK_PHYS(addr)) = true;
-      }
-      *(*(m_SRAMopcodeMask+SRAMBANK_PHYS(addr))+SRAMBANK_OFF(addr)) = mask;
-   }
-   static inline void SRAMOPCODEMASKCLR ( void )
-   {
-      int32_t idx1;
-      int32_t idx2;
-      for ( idx1 = 0; idx1 < NUM_SRAM_BANKS; idx1++ )
+      BankDebugInfo* pDebugInfo = SRAMDEBUGINFO(SRAMBANK_PHYS(addr));
+      if ( (*(pDebugInfo->pOpcodeMask+SRAMBANK_OFF(addr))) != mask )
       {
-         for ( idx2 = 0; idx2 < MEM_8KB; idx2++ )
-         {
-            m_SRAMopcodeMask[idx1][idx2] = 0;
-         }
-         m_SRAMopcodeMaskDirty[idx1] = true;
+         OPCODEMASKCHANGED ( pDebugInfo, SRAMBANK_OFF(addr) );
       }
+      *(pDebugInfo->pOpcodeMask+SRAMBANK_OFF(addr)) = mask;
    }
+   static void SRAMOPCODEMASKCLR ( void );
    static inline char* SRAMDISASSEMBLY ( uint32_t addr )
    {
-      return *(*(m_SRAMdisassembly+SRAMBANK_PHYS(addr))+SRAMBANK_OFF(addr));
+      return SRAMDISASSEMBLYINFO(SRAMBANK_PHYS(addr))->pDisassembly+(SRAMBANK_OFF(addr)*DISASSEMBLY_LINE_SIZE);
    }
    static uint32_t SRAMSLOC2ADDR ( uint16_t sloc );
    static uint16_t SRAMADDR2SLOC ( uint32_t addr );
    static inline uint32_t SRAMSLOC ( uint32_t addr)
    {
-      return *(m_SRAMsloc+SRAMBANK_PHYS(addr));
+      return SRAMDISASSEMBLYINFO(SRAMBANK_PHYS(addr))->sloc;
    }
    static bool SRAMDIRTY() { return m_SRAMdirty; }
+   static void SRAMDIRTY(bool dirty) { m_SRAMdirty = dirty; }
    static inline void EXRAMOPCODEMASK ( uint32_t addr, uint8_t mask )
    {
       if ( (*(m_EXRAMopcodeMask+(addr-0x5C00))) != mask )
@@ -288,7 +346,7 @@ public:
    }
    static inline char* EXRAMDISASSEMBLY ( uint32_t addr )
    {
-      return *(m_EXRAMdisassembly+(addr-0x5C00));
+      return m_EXRAMdisassembly+((addr-0x5C00)*DISASSEMBLY_LINE_SIZE);
    }
    static uint32_t EXRAMSLOC2ADDR ( uint16_t sloc );
    static uint16_t EXRAMADDR2SLOC ( uint32_t addr );
@@ -340,24 +398,60 @@ public:
    }
 
 protected:
-   static uint8_t**  m_PRGROMmemory;
-   static uint8_t**  m_CHRmemory;
-   static uint8_t**  m_SRAMmemory;
-   static uint8_t*   m_EXRAMmemory;
-   static uint8_t*   m_VRAMmemory;
+   static void GROWPRGBANKS ( uint32_t numBanks );
+   static void GROWCHRBANKS ( uint32_t numBanks );
+   static void MAPPRGBANKS ( void );
+   static void MAPCHRBANKS ( void );
+   static BankDebugInfo* CREATEDEBUGINFO ( uint8_t* binary );
+   static inline void OPCODEMASKCHANGED ( BankDebugInfo* pDebugInfo, uint32_t offset )
+   {
+      if ( offset < pDebugInfo->changedStart )
+      {
+         pDebugInfo->changedStart = offset;
+      }
+      if ( offset >= pDebugInfo->changedEnd )
+      {
+         pDebugInfo->changedEnd = offset+1;
+      }
+   }
+   static inline void OPCODEMASKCHANGED ( BankDebugInfo* pDebugInfo )
+   {
+      pDebugInfo->changedStart = 0;
+      pDebugInfo->changedEnd = MEM_8KB;
+   }
+   static void DESTROYDEBUGINFO ( BankDebugInfo* pDebugInfo );
+   static void DISASSEMBLE ( BankDebugInfo* pDebugInfo, uint8_t* binary );
+
+   // The PRG-ROM and CHR bank tables, indexed by the bank numbers the
+   // mappers select.  Each table entry points at one of the banks there is
+   // memory for, the ones past the end of the ROM mirror it.  The CHR table
+   // has the extra CHR-RAM banks on the end.
+   static NES_THREAD_LOCAL uint8_t**  m_PRGROMmemory;
+   static NES_THREAD_LOCAL uint32_t   m_numPrgSlots;
+   static NES_THREAD_LOCAL uint8_t**  m_CHRmemory;
+   static NES_THREAD_LOCAL uint32_t   m_numChrSlots;
+
+   // The banks there is memory for.  There are always enough for a 32KB
+   // PRG-ROM window and 32KB of CHR-RAM, the rest come and go with the ROM.
+   static NES_THREAD_LOCAL uint8_t**  m_PRGROMbanks;
+   static NES_THREAD_LOCAL uint32_t   m_numPrgBankBuffers;
+   static NES_THREAD_LOCAL uint8_t**  m_CHRbanks;
+   static NES_THREAD_LOCAL uint32_t   m_numChrBankBuffers;
+   static NES_THREAD_LOCAL uint8_t*   m_CHRRAMbanks [ NUM_CHR_RAM_BANKS ];
+   static NES_THREAD_LOCAL uint8_t**  m_SRAMmemory;
+   static NES_THREAD_LOCAL uint8_t*   m_EXRAMmemory;
+   static NES_THREAD_LOCAL uint8_t*   m_VRAMmemory;
 
    // Mapper stuff...
-   static uint32_t           m_mapper;
-   static uint32_t           m_numPrgBanks;
-   static uint32_t           m_numChrBanks;
-   static uint8_t* m_pPRGROMmemory [ 4 ];
-   static uint8_t* m_pCHRmemory [ 8 ];
-   static uint8_t* m_pSRAMmemory [ 5 ];
-   static uint8_t* m_pVRAMmemory [ 8 ];
-
-   static CCodeDataLogger* m_pLogger [ NUM_ROM_BANKS ];
-   static CCodeDataLogger* m_pEXRAMLogger;
-   static CCodeDataLogger* m_pSRAMLogger [ NUM_SRAM_BANKS ];
+   static NES_THREAD_LOCAL uint32_t           m_mapper;
+   static NES_THREAD_LOCAL uint32_t           m_numPrgBanks;
+   static NES_THREAD_LOCAL uint32_t           m_numChrBanks;
+   static NES_THREAD_LOCAL uint8_t* m_pPRGROMmemory [ 4 ];
+   static NES_THREAD_LOCAL uint8_t* m_pCHRmemory [ 8 ];
+   static NES_THREAD_LOCAL uint8_t* m_pSRAMmemory [ 5 ];
+   static NES_THREAD_LOCAL uint8_t* m_pVRAMmemory [ 8 ];
+
+   static NES_THREAD_LOCAL CCodeDataLogger* m_pEXRAMLogger;
 
    static CRegisterDatabase* m_dbRegisters;
 
@@ -370,27 +464,18 @@ protected:
    static CBreakpointEventInfo** m_tblBreakpointEvents;
    static int32_t                    m_numBreakpointEvents;
 
-   static uint8_t**  m_PRGROMopcodeMask;
-   static bool*      m_PRGROMopcodeMaskDirty;
-   static char***    m_PRGROMdisassembly;
-   static uint16_t** m_PRGROMsloc2addr;
-   static uint16_t** m_PRGROMaddr2sloc;
-   static uint32_t*  m_PRGROMsloc;
-
-   static uint8_t**  m_SRAMopcodeMask;
-   static bool*      m_SRAMopcodeMaskDirty;
-   static char***    m_SRAMdisassembly;
-   static uint16_t** m_SRAMsloc2addr;
-   static uint16_t** m_SRAMaddr2sloc;
-   static uint32_t*  m_SRAMsloc;
-   static bool       m_SRAMdirty;
-
-   static uint8_t*  m_EXRAMopcodeMask;
-   static bool     m_EXRAMopcodeMaskDirty;
-   static char**          m_EXRAMdisassembly;
-   static uint16_t* m_EXRAMsloc2addr;
-   static uint16_t* m_EXRAMaddr2sloc;
-   static uint32_t   m_EXRAMsloc;
+   // Debugger information for each PRG-ROM bank there is memory for, and
+   // each SRAM bank.  NULL until it is first needed.
+   static NES_THREAD_LOCAL BankDebugInfo** m_pPRGROMdebugInfo;
+   static NES_THREAD_LOCAL BankDebugInfo* m_pSRAMdebugInfo [ NUM_SRAM_BANKS ];
+   static NES_THREAD_LOCAL bool       m_SRAMdirty;
+
+   static NES_THREAD_LOCAL uint8_t*  m_EXRAMopcodeMask;
+   static NES_THREAD_LOCAL bool     m_EXRAMopcodeMaskDirty;
+   static NES_THREAD_LOCAL char*           m_EXRAMdisassembly;
+   static NES_THREAD_LOCAL uint16_t* m_EXRAMsloc2addr;
+   static NES_THREAD_LOCAL uint16_t* m_EXRAMaddr2sloc;
+   static NES_THREAD_LOCAL uint32_t   m_EXRAMsloc;
 };
 
 #endif
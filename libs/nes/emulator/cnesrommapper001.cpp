@@ -64,13 +64,13 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,4,4,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper001::m_reg [] = { 0x0C, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper001::m_regdef [] = { 0x0C, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper001::m_sr = 0x00;
-uint8_t  CROMMapper001::m_sel = 0x00;
-uint8_t  CROMMapper001::m_srCount = 0;
-uint32_t CROMMapper001::m_cpuCycleOfLastWrite = 0xFFFFFFFF;
-uint32_t CROMMapper001::m_cpuCycle = 0xFFFFFFFF;
+NES_THREAD_LOCAL uint8_t  CROMMapper001::m_reg [] = { 0x0C, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper001::m_regdef [] = { 0x0C, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper001::m_sr = 0x00;
+NES_THREAD_LOCAL uint8_t  CROMMapper001::m_sel = 0x00;
+NES_THREAD_LOCAL uint8_t  CROMMapper001::m_srCount = 0;
+NES_THREAD_LOCAL uint32_t CROMMapper001::m_cpuCycleOfLastWrite = 0xFFFFFFFF;
+NES_THREAD_LOCAL uint32_t CROMMapper001::m_cpuCycle = 0xFFFFFFFF;
 
 CROMMapper001::CROMMapper001()
 {
@@ -109,6 +109,24 @@ void CROMMapper001::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper001::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 4 );
+      state.Bytes ( m_regdef, 4 );
+      state.Value ( m_sr );
+      state.Value ( m_sel );
+      state.Value ( m_srCount );
+      state.Value ( m_cpuCycleOfLastWrite );
+      state.Value ( m_cpuCycle );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper001::SYNCCPU()
 {
    // This may not be the actual CPU cycle but it doesn't matter.
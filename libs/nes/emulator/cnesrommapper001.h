@@ -10,6 +10,7 @@ public:
    ~CROMMapper001();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCCPU ( void );
    static uint32_t DEBUGINFO ( uint32_t addr );
@@ -27,13 +28,13 @@ public:
 
 protected:
    // MMC1
-   static uint8_t  m_reg [ 4 ];
-   static uint8_t  m_regdef [ 4 ];
-   static uint8_t  m_sr;
-   static uint8_t  m_sel;
-   static uint8_t  m_srCount;
-   static uint32_t m_cpuCycleOfLastWrite;
-   static uint32_t m_cpuCycle;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 4 ];
+   static NES_THREAD_LOCAL uint8_t  m_regdef [ 4 ];
+   static NES_THREAD_LOCAL uint8_t  m_sr;
+   static NES_THREAD_LOCAL uint8_t  m_sel;
+   static NES_THREAD_LOCAL uint8_t  m_srCount;
+   static NES_THREAD_LOCAL uint32_t m_cpuCycleOfLastWrite;
+   static NES_THREAD_LOCAL uint32_t m_cpuCycle;
 };
 
 #endif
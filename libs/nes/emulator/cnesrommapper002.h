@@ -10,11 +10,12 @@ public:
    ~CROMMapper002();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
-   static uint8_t  m_reg;
+   static NES_THREAD_LOCAL uint8_t  m_reg;
 };
 
 #endif
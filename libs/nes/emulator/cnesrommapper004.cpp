@@ -88,17 +88,17 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,8,8,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper004::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-bool           CROMMapper004::m_irqAsserted = false;
-uint8_t  CROMMapper004::m_irqCounter = 0x00;
-uint8_t  CROMMapper004::m_irqLatch = 0x00;
-bool           CROMMapper004::m_irqEnable = false;
-bool           CROMMapper004::m_irqReload = false;
-uint8_t  CROMMapper004::m_prg [ 2 ] = { 0, 0 };
-uint8_t  CROMMapper004::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-uint32_t   CROMMapper004::m_lastPPUAddrA12 = 0;
-uint32_t   CROMMapper004::m_lastPPUCycle = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper004::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL bool           CROMMapper004::m_irqAsserted = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper004::m_irqCounter = 0x00;
+NES_THREAD_LOCAL uint8_t  CROMMapper004::m_irqLatch = 0x00;
+NES_THREAD_LOCAL bool           CROMMapper004::m_irqEnable = false;
+NES_THREAD_LOCAL bool           CROMMapper004::m_irqReload = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper004::m_prg [ 2 ] = { 0, 0 };
+NES_THREAD_LOCAL uint8_t  CROMMapper004::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+NES_THREAD_LOCAL uint32_t   CROMMapper004::m_lastPPUAddrA12 = 0;
+NES_THREAD_LOCAL uint32_t   CROMMapper004::m_lastPPUCycle = 0;
 
 CROMMapper004::CROMMapper004()
 {
@@ -142,6 +142,27 @@ void CROMMapper004::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper004::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 8 );
+      state.Value ( m_irqAsserted );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqLatch );
+      state.Value ( m_irqEnable );
+      state.Value ( m_irqReload );
+      state.Bytes ( m_prg, 2 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_lastPPUAddrA12 );
+      state.Value ( m_lastPPUCycle );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper004::SYNCPPU ( uint32_t ppuCycle, uint32_t ppuAddr )
 {
    bool zero = false;
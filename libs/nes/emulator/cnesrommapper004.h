@@ -10,6 +10,7 @@ public:
    ~CROMMapper004();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCPPU ( uint32_t ppuCycle, uint32_t ppuAddr );
    static void SETCPU ( void );
@@ -49,17 +50,17 @@ public:
 
 protected:
    // MMC3
-   static uint8_t  m_reg [ 8 ];
-   static bool           m_irqAsserted;
-   static uint8_t  m_irqCounter;
-   static uint8_t  m_irqLatch;
-   static bool           m_irqEnable;
-   static bool           m_irqReload;
-   static uint8_t  m_prg [ 2 ];
-   static uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 8 ];
+   static NES_THREAD_LOCAL bool           m_irqAsserted;
+   static NES_THREAD_LOCAL uint8_t  m_irqCounter;
+   static NES_THREAD_LOCAL uint8_t  m_irqLatch;
+   static NES_THREAD_LOCAL bool           m_irqEnable;
+   static NES_THREAD_LOCAL bool           m_irqReload;
+   static NES_THREAD_LOCAL uint8_t  m_prg [ 2 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
 
-   static uint32_t   m_lastPPUAddrA12;
-   static uint32_t   m_lastPPUCycle;
+   static NES_THREAD_LOCAL uint32_t   m_lastPPUAddrA12;
+   static NES_THREAD_LOCAL uint32_t   m_lastPPUCycle;
 };
 
 #endif
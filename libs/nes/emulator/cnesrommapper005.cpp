@@ -306,26 +306,26 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,44,44,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper005::m_prgMode = 0;
-uint8_t  CROMMapper005::m_chrMode = 0;
-uint8_t  CROMMapper005::m_chrHigh = 0;
-uint8_t  CROMMapper005::m_irqScanline = 0;
-uint8_t  CROMMapper005::m_irqEnabled = 0;
-uint8_t  CROMMapper005::m_irqStatus = 0;
-bool           CROMMapper005::m_prgRAM [] = { false, false, false };
-bool           CROMMapper005::m_wp = false;
-uint8_t  CROMMapper005::m_wp1 = 0;
-uint8_t  CROMMapper005::m_wp2 = 0;
-uint8_t  CROMMapper005::m_mult1 = 0;
-uint8_t  CROMMapper005::m_mult2 = 0;
-uint16_t CROMMapper005::m_prod = 0;
-uint8_t  CROMMapper005::m_fillTile = 0;
-uint8_t  CROMMapper005::m_fillAttr = 0;
-uint32_t CROMMapper005::m_ppuCycle = 0;
-uint8_t  CROMMapper005::m_chr[] = { 0, };
-uint8_t  CROMMapper005::m_reg[] = { 0, };
-CAPUSquare CROMMapper005::m_square[2];
-CAPUDMC    CROMMapper005::m_dmc;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_prgMode = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_chrMode = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_chrHigh = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_irqScanline = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_irqEnabled = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_irqStatus = 0;
+NES_THREAD_LOCAL bool           CROMMapper005::m_prgRAM [] = { false, false, false };
+NES_THREAD_LOCAL bool           CROMMapper005::m_wp = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_wp1 = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_wp2 = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_mult1 = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_mult2 = 0;
+NES_THREAD_LOCAL uint16_t CROMMapper005::m_prod = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_fillTile = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_fillAttr = 0;
+NES_THREAD_LOCAL uint32_t CROMMapper005::m_ppuCycle = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_chr[] = { 0, };
+NES_THREAD_LOCAL uint8_t  CROMMapper005::m_reg[] = { 0, };
+NES_THREAD_LOCAL CAPUSquare CROMMapper005::m_square[2];
+NES_THREAD_LOCAL CAPUDMC    CROMMapper005::m_dmc;
 
 CROMMapper005::CROMMapper005()
 {
@@ -372,6 +372,43 @@ void CROMMapper005::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper005::STATE ( CSaveState& state )
+{
+   int32_t idx;
+
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Value ( m_prgMode );
+      state.Value ( m_chrMode );
+      state.Value ( m_chrHigh );
+      state.Value ( m_irqScanline );
+      state.Value ( m_irqEnabled );
+      state.Value ( m_irqStatus );
+      for ( idx = 0; idx < 3; idx++ )
+      {
+         state.Value ( m_prgRAM[idx] );
+      }
+      state.Value ( m_wp );
+      state.Value ( m_ppuCycle );
+      state.Bytes ( m_chr, 12 );
+      state.Value ( m_wp1 );
+      state.Value ( m_wp2 );
+      state.Value ( m_mult1 );
+      state.Value ( m_mult2 );
+      state.Value ( m_prod );
+      state.Value ( m_fillTile );
+      state.Value ( m_fillAttr );
+      state.Bytes ( m_reg, 44 );
+      m_square[0].STATE ( state );
+      m_square[1].STATE ( state );
+      m_dmc.STATE ( state );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper005::SYNCCPU ( void )
 {
    m_square[0].TIMERTICK();
@@ -1065,12 +1102,12 @@ uint16_t CROMMapper005::AMPLITUDE ( void )
    int16_t amp;
    int16_t delta;
    int16_t out[100] = { 0, };
-   static int16_t outLast = 0;
+   static NES_THREAD_LOCAL int16_t outLast = 0;
    uint8_t sample;
    uint8_t* sq1dacSamples = m_square[0].GETDACSAMPLES();
    uint8_t* sq2dacSamples = m_square[1].GETDACSAMPLES();
    uint8_t* dmcDacSamples = m_dmc.GETDACSAMPLES();
-   static int32_t outDownsampled = 0;
+   static NES_THREAD_LOCAL int32_t outDownsampled = 0;
 
    for ( sample = 0; sample < m_square[0].GETDACSAMPLECOUNT(); sample++ )
    {
@@ -11,6 +11,7 @@ public:
    ~CROMMapper005();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static uint32_t HMAPPER ( uint32_t addr );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t LMAPPER ( uint32_t addr );
@@ -25,27 +26,27 @@ public:
 
 protected:
    // MMC5
-   static uint8_t m_prgMode;
-   static uint8_t m_chrMode;
-   static uint8_t m_chrHigh;
-   static uint8_t m_irqScanline;
-   static uint8_t m_irqEnabled;
-   static uint8_t m_irqStatus;
-   static bool          m_prgRAM [ 3 ];
-   static bool          m_wp;
-   static uint32_t m_ppuCycle;
-   static uint8_t m_chr[12];
-   static uint8_t m_wp1;
-   static uint8_t m_wp2;
-   static uint8_t  m_mult1;
-   static uint8_t  m_mult2;
-   static uint16_t m_prod;
-   static uint8_t  m_fillTile;
-   static uint8_t  m_fillAttr;
-   static uint8_t  m_reg[44];
+   static NES_THREAD_LOCAL uint8_t m_prgMode;
+   static NES_THREAD_LOCAL uint8_t m_chrMode;
+   static NES_THREAD_LOCAL uint8_t m_chrHigh;
+   static NES_THREAD_LOCAL uint8_t m_irqScanline;
+   static NES_THREAD_LOCAL uint8_t m_irqEnabled;
+   static NES_THREAD_LOCAL uint8_t m_irqStatus;
+   static NES_THREAD_LOCAL bool          m_prgRAM [ 3 ];
+   static NES_THREAD_LOCAL bool          m_wp;
+   static NES_THREAD_LOCAL uint32_t m_ppuCycle;
+   static NES_THREAD_LOCAL uint8_t m_chr[12];
+   static NES_THREAD_LOCAL uint8_t m_wp1;
+   static NES_THREAD_LOCAL uint8_t m_wp2;
+   static NES_THREAD_LOCAL uint8_t  m_mult1;
+   static NES_THREAD_LOCAL uint8_t  m_mult2;
+   static NES_THREAD_LOCAL uint16_t m_prod;
+   static NES_THREAD_LOCAL uint8_t  m_fillTile;
+   static NES_THREAD_LOCAL uint8_t  m_fillAttr;
+   static NES_THREAD_LOCAL uint8_t  m_reg[44];
 
-   static CAPUSquare m_square[2];
-   static CAPUDMC    m_dmc;
+   static NES_THREAD_LOCAL CAPUSquare m_square[2];
+   static NES_THREAD_LOCAL CAPUDMC    m_dmc;
 };
 
 #endif
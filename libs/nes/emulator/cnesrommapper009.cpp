@@ -72,13 +72,13 @@ static const char* columnHeadings [] =
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,6,6,tblRegisters,rowHeadings,columnHeadings);
 
 // MMC2 stuff
-uint8_t  CROMMapper009::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper009::m_latch0 = 0xFE;
-uint8_t  CROMMapper009::m_latch1 = 0xFE;
-uint8_t  CROMMapper009::m_latch0FD = 0;
-uint8_t  CROMMapper009::m_latch0FE = 1;
-uint8_t  CROMMapper009::m_latch1FD = 0;
-uint8_t  CROMMapper009::m_latch1FE = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch0 = 0xFE;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch1 = 0xFE;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch0FD = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch0FE = 1;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch1FD = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper009::m_latch1FE = 0;
 
 CROMMapper009::CROMMapper009()
 {
@@ -125,6 +125,24 @@ void CROMMapper009::RESET ( bool soft )
    m_pCHRmemory [ 7 ] = m_CHRmemory [ (m_latch1FE<<2)+3 ];
 }
 
+void CROMMapper009::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 6 );
+      state.Value ( m_latch0 );
+      state.Value ( m_latch1 );
+      state.Value ( m_latch0FD );
+      state.Value ( m_latch0FE );
+      state.Value ( m_latch1FD );
+      state.Value ( m_latch1FE );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper009::DEBUGINFO ( uint32_t addr )
 {
    switch ( addr&0xF000 )
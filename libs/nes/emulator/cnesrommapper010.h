@@ -10,6 +10,7 @@ public:
    ~CROMMapper010();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCPPU ( uint32_t ppuCycle, uint32_t ppuAddr );
    static uint32_t DEBUGINFO ( uint32_t addr );
@@ -43,13 +44,13 @@ public:
 
 protected:
    // MMC3
-   static uint8_t  m_reg [ 6 ];
-   static uint8_t  m_latch0;
-   static uint8_t  m_latch1;
-   static uint8_t  m_latch0FD;
-   static uint8_t  m_latch0FE;
-   static uint8_t  m_latch1FD;
-   static uint8_t  m_latch1FE;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 6 ];
+   static NES_THREAD_LOCAL uint8_t  m_latch0;
+   static NES_THREAD_LOCAL uint8_t  m_latch1;
+   static NES_THREAD_LOCAL uint8_t  m_latch0FD;
+   static NES_THREAD_LOCAL uint8_t  m_latch0FE;
+   static NES_THREAD_LOCAL uint8_t  m_latch1FD;
+   static NES_THREAD_LOCAL uint8_t  m_latch1FE;
 };
 
 #endif
@@ -42,7 +42,7 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,1,1,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper011::m_reg = 0x00;
+NES_THREAD_LOCAL uint8_t  CROMMapper011::m_reg = 0x00;
 
 CROMMapper011::CROMMapper011()
 {
@@ -68,6 +68,18 @@ void CROMMapper011::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper011::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Value ( m_reg );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper011::DEBUGINFO ( uint32_t addr )
 {
    return m_reg;
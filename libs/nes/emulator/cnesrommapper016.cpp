@@ -86,16 +86,16 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,14,14,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper016::m_reg [] = { 0x00, };
-uint16_t CROMMapper016::m_irqCounter = 0;
-bool     CROMMapper016::m_irqEnabled = false;
-bool     CROMMapper016::m_irqAsserted = false;
-uint8_t  CROMMapper016::m_eepromBitCounter = 0;
-uint8_t  CROMMapper016::m_eepromState = 0;
-uint8_t  CROMMapper016::m_eepromCmd;
-uint8_t  CROMMapper016::m_eepromAddr;
-uint8_t  CROMMapper016::m_eepromDataBuf;
-uint8_t  CROMMapper016::m_eepromRWBit;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint16_t CROMMapper016::m_irqCounter = 0;
+NES_THREAD_LOCAL bool     CROMMapper016::m_irqEnabled = false;
+NES_THREAD_LOCAL bool     CROMMapper016::m_irqAsserted = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromBitCounter = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromState = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromCmd;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromAddr;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromDataBuf;
+NES_THREAD_LOCAL uint8_t  CROMMapper016::m_eepromRWBit;
 
 CROMMapper016::CROMMapper016()
 {
@@ -150,6 +150,27 @@ void CROMMapper016::RESET159 ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper016::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 14 );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnabled );
+      state.Value ( m_irqAsserted );
+      state.Value ( m_eepromBitCounter );
+      state.Value ( m_eepromState );
+      state.Value ( m_eepromCmd );
+      state.Value ( m_eepromAddr );
+      state.Value ( m_eepromDataBuf );
+      state.Value ( m_eepromRWBit );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper016::SYNCCPU ( void )
 {
    if ( m_irqEnabled )
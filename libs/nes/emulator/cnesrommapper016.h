@@ -11,6 +11,7 @@ public:
 
    static void RESET016 ( bool soft );
    static void RESET159 ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t LMAPPER ( uint32_t addr );
    static void LMAPPER ( uint32_t addr, uint8_t data );
@@ -53,16 +54,16 @@ public:
    }
 
 protected:
-   static uint8_t  m_reg [ 14 ];
-   static uint16_t m_irqCounter;
-   static bool     m_irqEnabled;
-   static bool     m_irqAsserted;
-   static uint8_t  m_eepromBitCounter;
-   static uint8_t  m_eepromState;
-   static uint8_t  m_eepromCmd;
-   static uint8_t  m_eepromAddr;
-   static uint8_t  m_eepromDataBuf;
-   static uint8_t  m_eepromRWBit;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 14 ];
+   static NES_THREAD_LOCAL uint16_t m_irqCounter;
+   static NES_THREAD_LOCAL bool     m_irqEnabled;
+   static NES_THREAD_LOCAL bool     m_irqAsserted;
+   static NES_THREAD_LOCAL uint8_t  m_eepromBitCounter;
+   static NES_THREAD_LOCAL uint8_t  m_eepromState;
+   static NES_THREAD_LOCAL uint8_t  m_eepromCmd;
+   static NES_THREAD_LOCAL uint8_t  m_eepromAddr;
+   static NES_THREAD_LOCAL uint8_t  m_eepromDataBuf;
+   static NES_THREAD_LOCAL uint8_t  m_eepromRWBit;
    // We'll use the SRAM interface in CROM object to store
    // the EEPROM data so that it gets saved using the regular
    // save-state mechanics.
@@ -129,12 +129,12 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,29,29,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper018::m_reg [] = { 0x00, };
-uint8_t  CROMMapper018::m_prg [] = { 0x00, };
-uint8_t  CROMMapper018::m_chr [] = { 0x00, };
-uint16_t CROMMapper018::m_irqReload = 0;
-uint16_t CROMMapper018::m_irqCounter = 0;
-bool     CROMMapper018::m_irqEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper018::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper018::m_prg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper018::m_chr [] = { 0x00, };
+NES_THREAD_LOCAL uint16_t CROMMapper018::m_irqReload = 0;
+NES_THREAD_LOCAL uint16_t CROMMapper018::m_irqCounter = 0;
+NES_THREAD_LOCAL bool     CROMMapper018::m_irqEnabled = false;
 
 CROMMapper018::CROMMapper018()
 {
@@ -164,6 +164,23 @@ void CROMMapper018::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper018::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 29 );
+      state.Bytes ( m_prg, 3 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnabled );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper018::SYNCCPU ( void )
 {
    uint16_t counterMask;
@@ -104,14 +104,14 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,19,19,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper019::m_reg [] = { 0x00, };
-uint8_t  CROMMapper019::m_chr [];
-uint16_t CROMMapper019::m_irqCounter = 0;
-bool     CROMMapper019::m_irqEnabled = false;
-N106WaveChannel CROMMapper019::m_wave[8];
-uint8_t  CROMMapper019::m_soundRAM [];
-uint8_t  CROMMapper019::m_soundRAMAddr;
-uint8_t  CROMMapper019::m_soundChansEnabled = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper019::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper019::m_chr [];
+NES_THREAD_LOCAL uint16_t CROMMapper019::m_irqCounter = 0;
+NES_THREAD_LOCAL bool     CROMMapper019::m_irqEnabled = false;
+NES_THREAD_LOCAL N106WaveChannel CROMMapper019::m_wave[8];
+NES_THREAD_LOCAL uint8_t  CROMMapper019::m_soundRAM [];
+NES_THREAD_LOCAL uint8_t  CROMMapper019::m_soundRAMAddr;
+NES_THREAD_LOCAL uint8_t  CROMMapper019::m_soundChansEnabled = 0;
 
 CROMMapper019::CROMMapper019()
 {
@@ -150,6 +150,36 @@ void CROMMapper019::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper019::STATE ( CSaveState& state )
+{
+   int32_t idx;
+
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 19 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnabled );
+      for ( idx = 0; idx < 8; idx++ )
+      {
+         m_wave[idx].STATE ( state );
+      }
+      state.Bytes ( m_soundRAM, 128 );
+      state.Value ( m_soundRAMAddr );
+      state.Value ( m_soundChansEnabled );
+
+      // The extra CHR banks past the CHR-ROM serve as CHR-RAM.
+      for ( idx = 0; idx < NUM_CHR_RAM_BANKS; idx++ )
+      {
+         state.Bytes ( CHRRAMBANK(idx), MEM_1KB );
+      }
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper019::SYNCCPU ( void )
 {
    int32_t idx;
@@ -347,7 +377,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[0] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[0] = CHRRAMBANK(data);
       }
       break;
    case 0x8800:
@@ -360,7 +390,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[1] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[1] = CHRRAMBANK(data);
       }
       break;
    case 0x9000:
@@ -373,7 +403,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[2] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[2] = CHRRAMBANK(data);
       }
       break;
    case 0x9800:
@@ -386,7 +416,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[3] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[3] = CHRRAMBANK(data);
       }
       break;
    case 0xA000:
@@ -399,7 +429,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[4] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[4] = CHRRAMBANK(data);
       }
       break;
    case 0xA800:
@@ -412,7 +442,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[5] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[5] = CHRRAMBANK(data);
       }
       break;
    case 0xB000:
@@ -425,7 +455,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[6] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[6] = CHRRAMBANK(data);
       }
       break;
    case 0xB800:
@@ -438,7 +468,7 @@ void CROMMapper019::HMAPPER ( uint32_t addr, uint8_t data )
       {
          data &= 0x1F;
          // Shove this into unused CHR memory, we'll call it CHR-RAM.
-         m_pCHRmemory[7] = m_CHRmemory[0x100+data];
+         m_pCHRmemory[7] = CHRRAMBANK(data);
       }
       break;
    case 0xC000:
@@ -564,10 +594,10 @@ uint16_t CROMMapper019::AMPLITUDE()
    int16_t amp;
    int16_t delta;
    int16_t out[100] = { 0, };
-   static int16_t outLast = 0;
+   static NES_THREAD_LOCAL int16_t outLast = 0;
    uint8_t sample;
    uint8_t* wdacSamples[8];
-   static int32_t outDownsampled = 0;
+   static NES_THREAD_LOCAL int32_t outDownsampled = 0;
    int32_t idx;
 
    wdacSamples[0] = m_wave[0].GETDACSAMPLES();
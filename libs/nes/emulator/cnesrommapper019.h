@@ -81,6 +81,22 @@ struct N106WaveChannel
    {
       dacSamples = 0;
    }
+   void STATE(CSaveState& state)
+   {
+      state.Value(volume);
+      state.Value(period);
+      state.Value(periodCounter);
+      state.Value(instrumentLength);
+      state.Value(instrumentAddress);
+      state.Value(instrumentStep);
+      state.Value(dac);
+      state.Value(dacSamples);
+      if ( dacSamples > 100 )
+      {
+         dacSamples = 100;
+      }
+      state.Bytes(dacAverage,dacSamples);
+   }
 };
 
 class CROMMapper019 : public CROM
@@ -90,6 +106,7 @@ public:
    ~CROMMapper019();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static uint32_t LMAPPER ( uint32_t addr );
    static void LMAPPER ( uint32_t addr, uint8_t data );
    static void HMAPPER ( uint32_t addr, uint8_t data );
@@ -107,17 +124,17 @@ public:
 
 protected:
    // N106
-   static uint8_t  m_reg [ 19 ];
-   static uint8_t  m_chr [ 8 ];
-   static uint16_t m_irqCounter;
-   static bool     m_irqEnabled;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 19 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint16_t m_irqCounter;
+   static NES_THREAD_LOCAL bool     m_irqEnabled;
 
    // N106 sound
-   static N106WaveChannel m_wave[8];
+   static NES_THREAD_LOCAL N106WaveChannel m_wave[8];
 
-   static uint8_t m_soundRAM[128];
-   static uint8_t m_soundRAMAddr;
-   static uint8_t m_soundChansEnabled;
+   static NES_THREAD_LOCAL uint8_t m_soundRAM[128];
+   static NES_THREAD_LOCAL uint8_t m_soundRAMAddr;
+   static NES_THREAD_LOCAL uint8_t m_soundChansEnabled;
 };
 
 #endif
@@ -135,13 +135,13 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,2,24,48,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper021::m_reg [] = { 0x00, };
-uint8_t  CROMMapper021::m_chr [] = { 0, };
-uint8_t  CROMMapper021::m_irqReload = 0;
-uint8_t  CROMMapper021::m_irqCounter = 0;
-uint8_t  CROMMapper021::m_irqPrescaler = 0;
-uint8_t  CROMMapper021::m_irqPrescalerPhase = 0;
-bool     CROMMapper021::m_irqEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_chr [] = { 0, };
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_irqReload = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_irqCounter = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_irqPrescaler = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper021::m_irqPrescalerPhase = 0;
+NES_THREAD_LOCAL bool     CROMMapper021::m_irqEnabled = false;
 
 CROMMapper021::CROMMapper021()
 {
@@ -173,6 +173,24 @@ void CROMMapper021::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper021::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 24 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqPrescaler );
+      state.Value ( m_irqPrescalerPhase );
+      state.Value ( m_irqEnabled );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper021::SYNCCPU ( void )
 {
    uint8_t phases[3] = { 114, 114, 113 };
@@ -75,8 +75,8 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,19,19,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper022::m_reg [] = { 0x00, };
-uint8_t  CROMMapper022::m_chr [];
+NES_THREAD_LOCAL uint8_t  CROMMapper022::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper022::m_chr [];
 
 CROMMapper022::CROMMapper022()
 {
@@ -102,6 +102,19 @@ void CROMMapper022::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper022::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 19 );
+      state.Bytes ( m_chr, 8 );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper022::DEBUGINFO ( uint32_t addr )
 {
    switch ( addr )
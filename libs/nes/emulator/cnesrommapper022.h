@@ -10,13 +10,14 @@ public:
    ~CROMMapper022();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
    // VRC2
-   static uint8_t  m_reg [ 19 ];
-   static uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 19 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
 };
 
 #endif
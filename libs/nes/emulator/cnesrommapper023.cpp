@@ -126,13 +126,13 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,2,23,46,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper023::m_reg [] = { 0x00, };
-uint8_t  CROMMapper023::m_chr [];
-uint8_t  CROMMapper023::m_irqReload = 0;
-uint8_t  CROMMapper023::m_irqCounter = 0;
-uint8_t  CROMMapper023::m_irqPrescaler = 0;
-uint8_t  CROMMapper023::m_irqPrescalerPhase = 0;
-bool     CROMMapper023::m_irqEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_chr [];
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_irqReload = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_irqCounter = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_irqPrescaler = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper023::m_irqPrescalerPhase = 0;
+NES_THREAD_LOCAL bool     CROMMapper023::m_irqEnabled = false;
 
 CROMMapper023::CROMMapper023()
 {
@@ -164,6 +164,24 @@ void CROMMapper023::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper023::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 23 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqPrescaler );
+      state.Value ( m_irqPrescalerPhase );
+      state.Value ( m_irqEnabled );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper023::SYNCCPU ( void )
 {
    uint8_t phases[3] = { 114, 114, 113 };
@@ -127,15 +127,15 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,23,23,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper024::m_reg [] = { 0x00, };
-uint8_t  CROMMapper024::m_chr [];
-uint8_t  CROMMapper024::m_irqReload = 0;
-uint8_t  CROMMapper024::m_irqCounter = 0;
-uint8_t  CROMMapper024::m_irqPrescaler = 0;
-uint8_t  CROMMapper024::m_irqPrescalerPhase = 0;
-bool     CROMMapper024::m_irqEnabled = false;
-VRC6PulseChannel CROMMapper024::m_pulse[2];
-VRC6SawtoothChannel CROMMapper024::m_sawtooth;
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_chr [];
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_irqReload = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_irqCounter = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_irqPrescaler = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper024::m_irqPrescalerPhase = 0;
+NES_THREAD_LOCAL bool     CROMMapper024::m_irqEnabled = false;
+NES_THREAD_LOCAL VRC6PulseChannel CROMMapper024::m_pulse[2];
+NES_THREAD_LOCAL VRC6SawtoothChannel CROMMapper024::m_sawtooth;
 
 CROMMapper024::CROMMapper024()
 {
@@ -171,6 +171,27 @@ void CROMMapper024::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper024::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 23 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqPrescaler );
+      state.Value ( m_irqPrescalerPhase );
+      state.Value ( m_irqEnabled );
+      m_pulse[0].STATE ( state );
+      m_pulse[1].STATE ( state );
+      m_sawtooth.STATE ( state );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper024::SYNCCPU ( void )
 {
    uint8_t phases[3] = { 114, 114, 113 };
@@ -573,12 +594,12 @@ uint16_t CROMMapper024::AMPLITUDE()
    int16_t amp;
    int16_t delta;
    int16_t out[100] = { 0, };
-   static int16_t outLast = 0;
+   static NES_THREAD_LOCAL int16_t outLast = 0;
    uint8_t sample;
    uint8_t* p1dacSamples = m_pulse[0].GETDACSAMPLES();
    uint8_t* p2dacSamples = m_pulse[1].GETDACSAMPLES();
    uint8_t* sdacSamples = m_sawtooth.GETDACSAMPLES();
-   static int32_t outDownsampled = 0;
+   static NES_THREAD_LOCAL int32_t outDownsampled = 0;
 
    for ( sample = 0; sample < m_pulse[0].GETDACSAMPLECOUNT(); sample++ )
    {
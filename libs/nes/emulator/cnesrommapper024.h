@@ -72,6 +72,23 @@ struct VRC6PulseChannel
    {
       dacSamples = 0;
    }
+   void STATE(CSaveState& state)
+   {
+      state.Value(mode);
+      state.Value(dutyCycle);
+      state.Value(volume);
+      state.Value(period);
+      state.Value(periodCounter);
+      state.Value(sequencerStep);
+      state.Value(enabled);
+      state.Value(dac);
+      state.Value(dacSamples);
+      if ( dacSamples > 100 )
+      {
+         dacSamples = 100;
+      }
+      state.Bytes(dacAverage,dacSamples);
+   }
 };
 
 struct VRC6SawtoothChannel
@@ -141,6 +158,23 @@ struct VRC6SawtoothChannel
    {
       dacSamples = 0;
    }
+   void STATE(CSaveState& state)
+   {
+      state.Value(accumulator);
+      state.Value(accumulatorRate);
+      state.Value(accumulatorCount);
+      state.Value(accumulatorDivider);
+      state.Value(period);
+      state.Value(periodCounter);
+      state.Value(enabled);
+      state.Value(dac);
+      state.Value(dacSamples);
+      if ( dacSamples > 100 )
+      {
+         dacSamples = 100;
+      }
+      state.Bytes(dacAverage,dacSamples);
+   }
 };
 
 class CROMMapper024 : public CROM
@@ -150,6 +184,7 @@ public:
    ~CROMMapper024();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCCPU ( void );
    static uint32_t DEBUGINFO ( uint32_t addr );
@@ -163,17 +198,17 @@ public:
 
 protected:
    // VRC6
-   static uint8_t  m_reg [ 23 ];
-   static uint8_t  m_chr [ 8 ];
-   static uint8_t  m_irqReload;
-   static uint8_t  m_irqCounter;
-   static uint8_t  m_irqPrescaler;
-   static uint8_t  m_irqPrescalerPhase;
-   static bool     m_irqEnabled;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 23 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_irqReload;
+   static NES_THREAD_LOCAL uint8_t  m_irqCounter;
+   static NES_THREAD_LOCAL uint8_t  m_irqPrescaler;
+   static NES_THREAD_LOCAL uint8_t  m_irqPrescalerPhase;
+   static NES_THREAD_LOCAL bool     m_irqEnabled;
 
    // VRC6 sound
-   static VRC6PulseChannel m_pulse[2];
-   static VRC6SawtoothChannel m_sawtooth;
+   static NES_THREAD_LOCAL VRC6PulseChannel m_pulse[2];
+   static NES_THREAD_LOCAL VRC6SawtoothChannel m_sawtooth;
 };
 
 #endif
@@ -10,19 +10,20 @@ public:
    ~CROMMapper025();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCCPU ( void );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
    // VRC2
-   static uint8_t  m_reg [ 24 ];
-   static uint8_t  m_chr [ 8 ];
-   static uint8_t  m_irqReload;
-   static uint8_t  m_irqCounter;
-   static uint8_t  m_irqPrescaler;
-   static uint8_t  m_irqPrescalerPhase;
-   static bool     m_irqEnabled;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 24 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_irqReload;
+   static NES_THREAD_LOCAL uint8_t  m_irqCounter;
+   static NES_THREAD_LOCAL uint8_t  m_irqPrescaler;
+   static NES_THREAD_LOCAL uint8_t  m_irqPrescalerPhase;
+   static NES_THREAD_LOCAL bool     m_irqEnabled;
 };
 
 #endif
@@ -127,13 +127,13 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,23,23,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper026::m_reg [] = { 0x00, };
-uint8_t  CROMMapper026::m_chr [];
-uint8_t  CROMMapper026::m_irqReload = 0;
-uint8_t  CROMMapper026::m_irqCounter = 0;
-uint8_t  CROMMapper026::m_irqPrescaler = 0;
-uint8_t  CROMMapper026::m_irqPrescalerPhase = 0;
-bool     CROMMapper026::m_irqEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_chr [];
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_irqReload = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_irqCounter = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_irqPrescaler = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper026::m_irqPrescalerPhase = 0;
+NES_THREAD_LOCAL bool     CROMMapper026::m_irqEnabled = false;
 
 CROMMapper026::CROMMapper026()
 {
@@ -169,6 +169,29 @@ void CROMMapper026::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper026::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 23 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqPrescaler );
+      state.Value ( m_irqPrescalerPhase );
+      state.Value ( m_irqEnabled );
+
+      // The VRC6 sound channels are shared with mapper 24.
+      m_pulse[0].STATE ( state );
+      m_pulse[1].STATE ( state );
+      m_sawtooth.STATE ( state );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper026::SYNCCPU ( void )
 {
    uint8_t phases[3] = { 114, 114, 113 };
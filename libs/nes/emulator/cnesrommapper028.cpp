@@ -19,14 +19,14 @@
 #include "cnes6502.h"
 #include "cnesppu.h"
 
-uint8_t CROMMapper028::m_reg_sel = 0x00;
-uint8_t CROMMapper028::m_chr_bank = 0x00;
-uint8_t CROMMapper028::m_prg_inner_bank = 0x00;
-uint8_t CROMMapper028::m_prg_size = 0x00;
-uint8_t CROMMapper028::m_prg_mode = 0x00;
-uint8_t CROMMapper028::m_mirror = 0x00;
-uint8_t CROMMapper028::m_prg_outer_bank = 0x00;
-uint8_t CROMMapper028::m_bank_size_mask[4] = { 0x1, 0x3, 0x7, 0xF };
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_reg_sel = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_chr_bank = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_prg_inner_bank = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_prg_size = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_prg_mode = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_mirror = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_prg_outer_bank = 0x00;
+NES_THREAD_LOCAL uint8_t CROMMapper028::m_bank_size_mask[4] = { 0x1, 0x3, 0x7, 0xF };
 
 CROMMapper028::CROMMapper028()
 {
@@ -72,6 +72,25 @@ void CROMMapper028::RESET ( bool soft )
    }
 }
 
+void CROMMapper028::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Value ( m_reg_sel );
+      state.Value ( m_chr_bank );
+      state.Value ( m_prg_inner_bank );
+      state.Value ( m_prg_size );
+      state.Value ( m_prg_mode );
+      state.Value ( m_mirror );
+      state.Value ( m_prg_outer_bank );
+      state.Bytes ( m_bank_size_mask, 4 );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper028::SETCPU ( void )
 {
    uint8_t bank[2];
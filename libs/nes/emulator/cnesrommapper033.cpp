@@ -85,7 +85,7 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,8,8,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper033::m_reg[8] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper033::m_reg[8] = { 0x00, };
 
 CROMMapper033::CROMMapper033()
 {
@@ -111,6 +111,18 @@ void CROMMapper033::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper033::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 8 );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper033::DEBUGINFO ( uint32_t addr )
 {
    switch ( addr&0xA003 )
@@ -62,7 +62,7 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,4,4,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper034::m_reg[] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper034::m_reg[] = { 0x00, };
 
 CROMMapper034::CROMMapper034()
 {
@@ -88,6 +88,18 @@ void CROMMapper034::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper034::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 4 );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper034::LMAPPER ( uint32_t addr )
 {
    if ( (addr >= 0x7ffd) && (addr < 0x8000) )
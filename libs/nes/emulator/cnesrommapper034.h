@@ -10,13 +10,14 @@ public:
    ~CROMMapper034();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t LMAPPER ( uint32_t addr );
    static void LMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
-   static uint8_t  m_reg[4];
+   static NES_THREAD_LOCAL uint8_t  m_reg[4];
 };
 
 #endif
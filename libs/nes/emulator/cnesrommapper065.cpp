@@ -88,10 +88,10 @@ static const char* columnHeadings [] =
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,16,16,tblRegisters,rowHeadings,columnHeadings);
 
 // Irem H-3001 stuff
-uint8_t  CROMMapper065::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper065::m_irqCounter = 0x00;
-bool           CROMMapper065::m_irqEnable = false;
-uint16_t CROMMapper065::m_irqReload = 0;
+NES_THREAD_LOCAL uint8_t  CROMMapper065::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper065::m_irqCounter = 0x00;
+NES_THREAD_LOCAL bool           CROMMapper065::m_irqEnable = false;
+NES_THREAD_LOCAL uint16_t CROMMapper065::m_irqReload = 0;
 
 CROMMapper065::CROMMapper065()
 {
@@ -120,6 +120,21 @@ void CROMMapper065::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper065::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 16 );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnable );
+      state.Value ( m_irqReload );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper065::SYNCCPU ( void )
 {
    if ( m_irqEnable )
@@ -10,16 +10,17 @@ public:
    ~CROMMapper065();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCCPU ( void );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
    // Irem H-3001
-   static uint8_t  m_reg [ 16 ];
-   static uint8_t  m_irqCounter;
-   static bool           m_irqEnable;
-   static uint16_t m_irqReload;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 16 ];
+   static NES_THREAD_LOCAL uint8_t  m_irqCounter;
+   static NES_THREAD_LOCAL bool           m_irqEnable;
+   static NES_THREAD_LOCAL uint16_t m_irqReload;
 };
 
 #endif
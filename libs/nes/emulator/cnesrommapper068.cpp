@@ -65,7 +65,7 @@ static const char* columnHeadings [] =
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,8,8,tblRegisters,rowHeadings,columnHeadings);
 
 // Sunsoft Mapper #4 stuff
-uint8_t  CROMMapper068::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint8_t  CROMMapper068::m_reg [] = { 0x00, };
 
 CROMMapper068::CROMMapper068()
 {
@@ -98,6 +98,18 @@ void CROMMapper068::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper068::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 8 );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper068::DEBUGINFO ( uint32_t addr )
 {
    switch ( addr&0xF000 )
@@ -10,12 +10,13 @@ public:
    ~CROMMapper068();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
    // Sunsoft Mapper #4
-   static uint8_t  m_reg [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 8 ];
 };
 
 #endif
@@ -61,16 +61,16 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,4,4,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper069::m_reg [] = { 0x00, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper069::m_subReg [];
-bool           CROMMapper069::m_irqAsserted = false;
-uint16_t  CROMMapper069::m_irqCounter = 0x0000;
-bool           CROMMapper069::m_irqEnable = false;
-bool           CROMMapper069::m_irqCountEnable = false;
-uint8_t  CROMMapper069::m_prg [ 4 ] = { 0, 0, 0, 0 };
-uint8_t  CROMMapper069::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-bool     CROMMapper069::m_sramAreaIsSram = false;
-bool     CROMMapper069::m_sramAreaEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper069::m_reg [] = { 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper069::m_subReg [];
+NES_THREAD_LOCAL bool           CROMMapper069::m_irqAsserted = false;
+NES_THREAD_LOCAL uint16_t  CROMMapper069::m_irqCounter = 0x0000;
+NES_THREAD_LOCAL bool           CROMMapper069::m_irqEnable = false;
+NES_THREAD_LOCAL bool           CROMMapper069::m_irqCountEnable = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper069::m_prg [ 4 ] = { 0, 0, 0, 0 };
+NES_THREAD_LOCAL uint8_t  CROMMapper069::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+NES_THREAD_LOCAL bool     CROMMapper069::m_sramAreaIsSram = false;
+NES_THREAD_LOCAL bool     CROMMapper069::m_sramAreaEnabled = false;
 
 CROMMapper069::CROMMapper069()
 {
@@ -117,6 +117,27 @@ void CROMMapper069::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper069::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 4 );
+      state.Bytes ( m_subReg, 16 );
+      state.Value ( m_irqAsserted );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnable );
+      state.Value ( m_irqCountEnable );
+      state.Bytes ( m_prg, 4 );
+      state.Bytes ( m_chr, 8 );
+      state.Value ( m_sramAreaIsSram );
+      state.Value ( m_sramAreaEnabled );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper069::SYNCCPU ( void )
 {
    uint32_t prevCounter = m_irqCounter;
@@ -10,6 +10,7 @@ public:
    ~CROMMapper069();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static uint32_t LMAPPER ( uint32_t addr );
    static void LMAPPER ( uint32_t addr, uint8_t data );
@@ -59,16 +60,16 @@ public:
 
 protected:
    // MMC3
-   static uint8_t  m_reg [ 4 ];
-   static uint8_t  m_subReg [ 16 ];
-   static bool           m_irqAsserted;
-   static uint16_t  m_irqCounter;
-   static bool           m_irqEnable;
-   static bool           m_irqCountEnable;
-   static uint8_t  m_prg [ 4 ];
-   static uint8_t  m_chr [ 8 ];
-   static bool m_sramAreaIsSram;
-   static bool m_sramAreaEnabled;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 4 ];
+   static NES_THREAD_LOCAL uint8_t  m_subReg [ 16 ];
+   static NES_THREAD_LOCAL bool           m_irqAsserted;
+   static NES_THREAD_LOCAL uint16_t  m_irqCounter;
+   static NES_THREAD_LOCAL bool           m_irqEnable;
+   static NES_THREAD_LOCAL bool           m_irqCountEnable;
+   static NES_THREAD_LOCAL uint8_t  m_prg [ 4 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL bool m_sramAreaIsSram;
+   static NES_THREAD_LOCAL bool m_sramAreaEnabled;
 };
 
 #endif
@@ -81,10 +81,10 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,7,7,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper073::m_reg [] = { 0x00, };
-uint16_t CROMMapper073::m_irqReload = 0;
-uint16_t CROMMapper073::m_irqCounter = 0;
-bool     CROMMapper073::m_irqEnabled = false;
+NES_THREAD_LOCAL uint8_t  CROMMapper073::m_reg [] = { 0x00, };
+NES_THREAD_LOCAL uint16_t CROMMapper073::m_irqReload = 0;
+NES_THREAD_LOCAL uint16_t CROMMapper073::m_irqCounter = 0;
+NES_THREAD_LOCAL bool     CROMMapper073::m_irqEnabled = false;
 
 CROMMapper073::CROMMapper073()
 {
@@ -114,6 +114,21 @@ void CROMMapper073::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper073::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 7 );
+      state.Value ( m_irqReload );
+      state.Value ( m_irqCounter );
+      state.Value ( m_irqEnabled );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper073::SYNCCPU ( void )
 {
    uint16_t counterMask;
@@ -10,16 +10,17 @@ public:
    ~CROMMapper073();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SYNCCPU ( void );
    static uint32_t DEBUGINFO ( uint32_t addr );
 
 protected:
    // VRC3
-   static uint8_t  m_reg [ 7 ];
-   static uint16_t m_irqReload;
-   static uint16_t m_irqCounter;
-   static bool     m_irqEnabled;
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 7 ];
+   static NES_THREAD_LOCAL uint16_t m_irqReload;
+   static NES_THREAD_LOCAL uint16_t m_irqCounter;
+   static NES_THREAD_LOCAL bool     m_irqEnabled;
 };
 
 #endif
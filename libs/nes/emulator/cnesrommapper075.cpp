@@ -61,9 +61,9 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,4,4,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper075::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-uint8_t  CROMMapper075::m_prg [ 4 ] = { 0, 0, 0, 0 };
-uint8_t  CROMMapper075::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+NES_THREAD_LOCAL uint8_t  CROMMapper075::m_reg [] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+NES_THREAD_LOCAL uint8_t  CROMMapper075::m_prg [ 4 ] = { 0, 0, 0, 0 };
+NES_THREAD_LOCAL uint8_t  CROMMapper075::m_chr [ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
 
 CROMMapper075::CROMMapper075()
 {
@@ -106,6 +106,20 @@ void CROMMapper075::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper075::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Bytes ( m_reg, 6 );
+      state.Bytes ( m_prg, 4 );
+      state.Bytes ( m_chr, 8 );
+
+      state.EndChunk ();
+   }
+}
+
 void CROMMapper075::SETCPU ( void )
 {
    m_pPRGROMmemory [ 0 ] = m_PRGROMmemory [ m_prg[0] ];
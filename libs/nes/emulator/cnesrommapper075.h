@@ -10,6 +10,7 @@ public:
    ~CROMMapper075();
 
    static void RESET ( bool soft );
+   static void STATE ( CSaveState& state );
    static void HMAPPER ( uint32_t addr, uint8_t data );
    static void SETCPU ( void );
    static void SETPPU ( void );
@@ -17,9 +18,9 @@ public:
 
 protected:
    // VRC1
-   static uint8_t  m_reg [ 6 ];
-   static uint8_t  m_prg [ 4 ];
-   static uint8_t  m_chr [ 8 ];
+   static NES_THREAD_LOCAL uint8_t  m_reg [ 6 ];
+   static NES_THREAD_LOCAL uint8_t  m_prg [ 4 ];
+   static NES_THREAD_LOCAL uint8_t  m_chr [ 8 ];
 };
 
 #endif
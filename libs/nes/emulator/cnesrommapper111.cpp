@@ -45,7 +45,7 @@ static const char* columnHeadings [] =
 
 static CRegisterDatabase* dbRegisters = new CRegisterDatabase(eMemory_cartMapper,1,1,1,tblRegisters,rowHeadings,columnHeadings);
 
-uint8_t  CROMMapper111::m_reg = 0x00;
+NES_THREAD_LOCAL uint8_t  CROMMapper111::m_reg = 0x00;
 
 CROMMapper111::CROMMapper111()
 {
@@ -71,6 +71,18 @@ void CROMMapper111::RESET ( bool soft )
    // CHR ROM/RAM already set up in CROM::RESET()...
 }
 
+void CROMMapper111::STATE ( CSaveState& state )
+{
+   CROM::STATE ( state );
+
+   if ( state.BeginChunk(SAVESTATE_TAG('M','A','P','R'),1) )
+   {
+      state.Value ( m_reg );
+
+      state.EndChunk ();
+   }
+}
+
 uint32_t CROMMapper111::DEBUGINFO ( uint32_t addr )
 {
    return m_reg;
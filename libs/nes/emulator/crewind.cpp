@@ -0,0 +1,390 @@
+//    NESICIDE - an IDE for the 8-bit NES.
+//    Copyright (C) 2009  Christopher S. Pow
+
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "crewind.h"
+
+CRewind::CRewind()
+{
+   m_interval = 0;
+   m_framesSinceSnapshot = 0;
+
+   m_pSnapshot = NULL;
+   m_snapshotSize = 0;
+   m_snapshotFrame = 0;
+   m_pNextSnapshot = NULL;
+   m_pEncodeBuffer = NULL;
+   m_snapshotBufferSize = 0;
+
+   m_pDeltaMemory = NULL;
+   m_deltaMemorySize = 0;
+   m_deltaMemoryHead = 0;
+   m_pDeltas = NULL;
+   m_maxDeltas = 0;
+   m_oldestDelta = 0;
+   m_numDeltas = 0;
+   m_deltaBytes = 0;
+}
+
+CRewind::~CRewind()
+{
+   delete [] m_pSnapshot;
+   delete [] m_pNextSnapshot;
+   delete [] m_pEncodeBuffer;
+   delete [] m_pDeltaMemory;
+   delete [] m_pDeltas;
+}
+
+void CRewind::SetConfiguration ( uint32_t interval, uint32_t memory )
+{
+   m_interval = interval;
+
+   if ( (!interval) || (memory != m_deltaMemorySize) )
+   {
+      delete [] m_pDeltaMemory;
+      delete [] m_pDeltas;
+      m_pDeltaMemory = NULL;
+      m_pDeltas = NULL;
+      m_deltaMemorySize = 0;
+      m_maxDeltas = 0;
+
+      if ( interval )
+      {
+         m_pDeltaMemory = new uint8_t [ memory ];
+         m_deltaMemorySize = memory;
+
+         // Differences between snapshots taken a few frames apart are
+         // rarely smaller than this, so there's no point keeping track of
+         // more of them than would fit.
+         m_maxDeltas = (memory/128)+16;
+         m_pDeltas = new RewindDelta [ m_maxDeltas ];
+      }
+   }
+
+   if ( !interval )
+   {
+      delete [] m_pSnapshot;
+      delete [] m_pNextSnapshot;
+      delete [] m_pEncodeBuffer;
+      m_pSnapshot = NULL;
+      m_pNextSnapshot = NULL;
+      m_pEncodeBuffer = NULL;
+      m_snapshotBufferSize = 0;
+   }
+
+   Clear ();
+}
+
+void CRewind::Clear ( void )
+{
+   m_framesSinceSnapshot = 0;
+   m_snapshotSize = 0;
+   m_snapshotFrame = 0;
+   m_deltaMemoryHead = 0;
+   m_oldestDelta = 0;
+   m_numDeltas = 0;
+   m_deltaBytes = 0;
+
+   if ( m_pSnapshot )
+   {
+      memset ( m_pSnapshot, 0, m_snapshotBufferSize );
+   }
+}
+
+void CRewind::GrowSnapshotBuffers ( uint32_t size )
+{
+   uint8_t* pSnapshot;
+
+   if ( size > m_snapshotBufferSize )
+   {
+      // Leave some room since the state size varies a little from frame
+      // to frame.
+      size += (size>>3);
+
+      // The most recent snapshot has to survive, and everything past the
+      // end of it must be zero so it can be XORed with a larger snapshot.
+      pSnapshot = new uint8_t [ size ];
+      memset ( pSnapshot, 0, size );
+      if ( m_pSnapshot )
+      {
+         memcpy ( pSnapshot, m_pSnapshot, m_snapshotBufferSize );
+      }
+      delete [] m_pSnapshot;
+      m_pSnapshot = pSnapshot;
+
+      delete [] m_pNextSnapshot;
+      m_pNextSnapshot = new uint8_t [ size ];
+
+      // Worst case run-length encoding is a little under twice the input.
+      delete [] m_pEncodeBuffer;
+      m_pEncodeBuffer = new uint8_t [ (size<<1)+16 ];
+
+      m_snapshotBufferSize = size;
+   }
+}
+
+uint8_t* CRewind::GetSnapshotBuffer ( uint32_t size )
+{
+   GrowSnapshotBuffers ( size );
+
+   return m_pNextSnapshot;
+}
+
+void CRewind::CommitSnapshot ( uint32_t frame, uint32_t size )
+{
+   RewindDelta* pDelta;
+   uint8_t*     pDeltaMemory;
+   uint8_t*     pSwap;
+   uint32_t     length;
+
+   // Keep the snapshot zero-padded, see GrowSnapshotBuffers.
+   memset ( m_pNextSnapshot+size, 0, m_snapshotBufferSize-size );
+
+   if ( m_snapshotSize )
+   {
+      // Record how to get from the new snapshot back to the previous one.
+      length = EncodeDelta ( m_pEncodeBuffer, m_pSnapshot, m_snapshotSize, m_pNextSnapshot, size );
+
+      pDeltaMemory = AllocateDelta ( length );
+      if ( pDeltaMemory )
+      {
+         memcpy ( pDeltaMemory, m_pEncodeBuffer, length );
+
+         pDelta = m_pDeltas + ((m_oldestDelta+m_numDeltas)%m_maxDeltas);
+         pDelta->offset = pDeltaMemory-m_pDeltaMemory;
+         pDelta->length = length;
+         pDelta->frame = m_snapshotFrame;
+         pDelta->size = m_snapshotSize;
+         m_numDeltas++;
+         m_deltaBytes += length;
+      }
+      else
+      {
+         // The difference doesn't fit even in an empty history, so the
+         // history can't be continued past this snapshot.
+         m_deltaMemoryHead = 0;
+         m_oldestDelta = 0;
+         m_numDeltas = 0;
+         m_deltaBytes = 0;
+      }
+   }
+
+   pSwap = m_pSnapshot;
+   m_pSnapshot = m_pNextSnapshot;
+   m_pNextSnapshot = pSwap;
+   m_snapshotSize = size;
+   m_snapshotFrame = frame;
+   m_framesSinceSnapshot = 0;
+}
+
+bool CRewind::Rewind ( void )
+{
+   RewindDelta* pDelta;
+
+   if ( !m_snapshotSize )
+   {
+      return false;
+   }
+
+   // Going back to the most recent snapshot is free.
+   if ( m_framesSinceSnapshot )
+   {
+      m_framesSinceSnapshot = 0;
+      return true;
+   }
+
+   if ( !m_numDeltas )
+   {
+      return false;
+   }
+
+   pDelta = m_pDeltas + ((m_oldestDelta+m_numDeltas-1)%m_maxDeltas);
+
+   DecodeDelta ( m_pSnapshot, m_snapshotBufferSize, m_pDeltaMemory+pDelta->offset, pDelta->length );
+   m_snapshotSize = pDelta->size;
+   m_snapshotFrame = pDelta->frame;
+
+   // The newest difference was the last thing put in the ring, so its
+   // memory can be reused straight away.
+   m_deltaMemoryHead = pDelta->offset;
+   m_deltaBytes -= pDelta->length;
+   m_numDeltas--;
+
+   return true;
+}
+
+uint32_t CRewind::GetDepth ( void ) const
+{
+   return m_numDeltas+(m_snapshotSize?1:0);
+}
+
+uint32_t CRewind::GetMemoryUsed ( void ) const
+{
+   return m_deltaBytes+m_snapshotSize;
+}
+
+static inline uint8_t* putVarint ( uint8_t* pOut, uint32_t value )
+{
+   while ( value >= 0x80 )
+   {
+      (*pOut++) = (value&0x7F)|0x80;
+      value >>= 7;
+   }
+   (*pOut++) = value;
+
+   return pOut;
+}
+
+static inline const uint8_t* getVarint ( const uint8_t* pIn, const uint8_t* pEnd, uint32_t* value )
+{
+   int32_t shift = 0;
+
+   (*value) = 0;
+   while ( (pIn < pEnd) && (shift < 32) )
+   {
+      (*value) |= ((*pIn)&0x7F)<<shift;
+      if ( !((*pIn++)&0x80) )
+      {
+         break;
+      }
+      shift += 7;
+   }
+
+   return pIn;
+}
+
+uint32_t CRewind::EncodeDelta ( uint8_t* pDelta, const uint8_t* pOld, uint32_t oldSize, const uint8_t* pNew, uint32_t newSize )
+{
+   uint8_t* pOut = pDelta;
+   uint32_t size = (oldSize>newSize)?oldSize:newSize;
+   uint32_t idx = 0;
+   uint32_t start;
+   uint32_t zeros;
+
+   // Both snapshots are zero-padded to the larger size.  The difference is
+   // stored as pairs of a run of unchanged bytes and a run of changed bytes
+   // (the XOR of old and new).  A changed run only ends at two unchanged
+   // bytes in a row since one alone costs less to keep than to skip.
+   while ( idx < size )
+   {
+      start = idx;
+      while ( (idx < size) && (pOld[idx] == pNew[idx]) )
+      {
+         idx++;
+      }
+      zeros = idx-start;
+
+      start = idx;
+      while ( idx < size )
+      {
+         if ( (pOld[idx] == pNew[idx]) &&
+              ((idx+1 >= size) || (pOld[idx+1] == pNew[idx+1])) )
+         {
+            break;
+         }
+         idx++;
+      }
+
+      pOut = putVarint ( pOut, zeros );
+      pOut = putVarint ( pOut, idx-start );
+      for ( ; start < idx; start++ )
+      {
+         (*pOut++) = pOld[start]^pNew[start];
+      }
+   }
+
+   return pOut-pDelta;
+}
+
+void CRewind::DecodeDelta ( uint8_t* pState, uint32_t stateSize, const uint8_t* pDelta, uint32_t length )
+{
+   const uint8_t* pEnd = pDelta+length;
+   uint32_t idx = 0;
+   uint32_t zeros;
+   uint32_t changed;
+
+   while ( pDelta < pEnd )
+   {
+      pDelta = getVarint ( pDelta, pEnd, &zeros );
+      pDelta = getVarint ( pDelta, pEnd, &changed );
+
+      idx += zeros;
+      if ( (idx > stateSize) || (changed > stateSize-idx) || (changed > (uint32_t)(pEnd-pDelta)) )
+      {
+         break;
+      }
+      for ( ; changed; changed-- )
+      {
+         pState[idx++] ^= (*pDelta++);
+      }
+   }
+}
+
+void CRewind::DropOldestDelta ( void )
+{
+   m_deltaBytes -= m_pDeltas[m_oldestDelta].length;
+   m_oldestDelta = (m_oldestDelta+1)%m_maxDeltas;
+   m_numDeltas--;
+}
+
+uint8_t* CRewind::AllocateDelta ( uint32_t length )
+{
+   RewindDelta* pOldest;
+   uint32_t     start;
+
+   if ( length > m_deltaMemorySize )
+   {
+      return NULL;
+   }
+
+   if ( m_numDeltas == m_maxDeltas )
+   {
+      DropOldestDelta ();
+   }
+
+   // Differences are laid down one after another.  When the end of the ring
+   // is reached the oldest ones, which are the ones sitting past the
+   // newest, are dropped and laying down starts over at the beginning.
+   start = m_deltaMemoryHead;
+   if ( start+length > m_deltaMemorySize )
+   {
+      while ( m_numDeltas && (m_pDeltas[m_oldestDelta].offset >= m_deltaMemoryHead) )
+      {
+         DropOldestDelta ();
+      }
+      start = 0;
+   }
+
+   // Make room by dropping whatever is oldest until nothing is in the way.
+   while ( m_numDeltas )
+   {
+      pOldest = m_pDeltas+m_oldestDelta;
+      if ( (pOldest->offset >= start+length) ||
+           (pOldest->offset+pOldest->length <= start) )
+      {
+         break;
+      }
+      DropOldestDelta ();
+   }
+
+   if ( !m_numDeltas )
+   {
+      m_oldestDelta = 0;
+   }
+
+   m_deltaMemoryHead = start+length;
+
+   return m_pDeltaMemory+start;
+}
@@ -0,0 +1,129 @@
+#if !defined ( REWIND_H )
+#define REWIND_H
+
+#include <stdint.h>
+#include <string.h>
+
+// The CRewind class keeps a history of emulator snapshots for stepping
+// backwards in time.
+//
+// Only the most recent snapshot is kept whole.  Each older snapshot is kept
+// as the difference between it and the snapshot that followed it: the two
+// are XORed together, which leaves zero everywhere the state didn't change,
+// and the result is run-length encoded.  Consecutive snapshots of a NES are
+// nearly identical so each difference is a small fraction of the full state.
+//
+// The differences are stored oldest to newest in a fixed size ring.  When
+// the ring is full the oldest differences are dropped, which is always safe
+// because nothing newer depends on them.  Stepping back undoes the newest
+// difference against the whole snapshot.
+class CRewind
+{
+public:
+   CRewind();
+   ~CRewind();
+
+   // A snapshot is taken every 'interval' frames, and the history uses at
+   // most 'memory' bytes.  An interval of zero turns rewinding off and frees
+   // the history.
+   void SetConfiguration ( uint32_t interval, uint32_t memory );
+   inline uint32_t GetInterval ( void ) const
+   {
+      return m_interval;
+   }
+   inline bool IsEnabled ( void ) const
+   {
+      return m_interval != 0;
+   }
+
+   // Throw away the history, for instance when a new cartridge is loaded.
+   void Clear ( void );
+
+   // Snapshots are taken before a frame is emulated, so a snapshot is
+   // never of a frame that was stopped part way through at a breakpoint.
+   bool IsSnapshotDue ( void ) const
+   {
+      return m_interval && ((!m_snapshotSize) || (m_framesSinceSnapshot >= m_interval));
+   }
+   inline void FrameEmulated ( void )
+   {
+      m_framesSinceSnapshot++;
+   }
+
+   // The emulator state no longer matches the most recent snapshot without
+   // a frame having been emulated (a reset, or a state load).
+   inline void StateChanged ( void )
+   {
+      m_framesSinceSnapshot = m_interval;
+   }
+
+   // Taking a snapshot is done in two steps so the emulator can save its
+   // state straight into the history: get a buffer big enough for the state,
+   // save into it, then commit it.
+   uint8_t* GetSnapshotBuffer ( uint32_t size );
+   void CommitSnapshot ( uint32_t frame, uint32_t size );
+
+   // Step back.  If frames have been emulated since the most recent snapshot
+   // that snapshot is where the emulator goes back to, otherwise it is
+   // dropped and the one before it is rebuilt.  Returns false if there is
+   // nothing to go back to.
+   bool Rewind ( void );
+
+   // The most recent snapshot.  NULL if there isn't one.
+   inline uint8_t* GetSnapshot ( void ) const
+   {
+      return m_snapshotSize ? m_pSnapshot : NULL;
+   }
+   inline uint32_t GetSnapshotSize ( void ) const
+   {
+      return m_snapshotSize;
+   }
+   inline uint32_t GetSnapshotFrame ( void ) const
+   {
+      return m_snapshotFrame;
+   }
+
+   // Number of snapshots that can be stepped back to, and the memory held.
+   uint32_t GetDepth ( void ) const;
+   uint32_t GetMemoryUsed ( void ) const;
+
+protected:
+   typedef struct
+   {
+      uint32_t offset;
+      uint32_t length;
+      uint32_t frame;
+      uint32_t size;
+   } RewindDelta;
+
+   void GrowSnapshotBuffers ( uint32_t size );
+   uint32_t EncodeDelta ( uint8_t* pDelta, const uint8_t* pOld, uint32_t oldSize, const uint8_t* pNew, uint32_t newSize );
+   void DecodeDelta ( uint8_t* pState, uint32_t stateSize, const uint8_t* pDelta, uint32_t length );
+   uint8_t* AllocateDelta ( uint32_t length );
+   void DropOldestDelta ( void );
+
+   uint32_t m_interval;
+   uint32_t m_framesSinceSnapshot;
+
+   // The most recent snapshot and the buffer the next one is saved into.
+   // Both are m_snapshotBufferSize bytes.
+   uint8_t* m_pSnapshot;
+   uint32_t m_snapshotSize;
+   uint32_t m_snapshotFrame;
+   uint8_t* m_pNextSnapshot;
+   uint8_t* m_pEncodeBuffer;
+   uint32_t m_snapshotBufferSize;
+
+   // Ring of encoded differences and the ring of their descriptors, both
+   // ordered oldest to newest.
+   uint8_t*     m_pDeltaMemory;
+   uint32_t     m_deltaMemorySize;
+   uint32_t     m_deltaMemoryHead;
+   RewindDelta* m_pDeltas;
+   uint32_t     m_maxDeltas;
+   uint32_t     m_oldestDelta;
+   uint32_t     m_numDeltas;
+   uint32_t     m_deltaBytes;
+};
+
+#endif
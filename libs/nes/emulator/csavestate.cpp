@@ -0,0 +1,264 @@
+//    NESICIDE - an IDE for the 8-bit NES.
+//    Copyright (C) 2009  Christopher S. Pow
+
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "csavestate.h"
+
+CSaveState::CSaveState ( uint8_t* buffer, uint32_t size, bool loading )
+{
+   m_buffer = buffer;
+   m_size = size;
+   m_loading = loading;
+   m_ok = !(loading && (buffer == NULL));
+   m_pos = 0;
+   m_end = loading ? size : 0;
+   m_chunkStart = 0;
+   m_chunkEnd = 0;
+   m_chunkVersion = 0;
+}
+
+bool CSaveState::BeginChunk ( uint32_t tag, uint16_t version )
+{
+   uint32_t pos;
+   uint32_t length;
+
+   if ( m_loading )
+   {
+      // Walk the chunk headers looking for the tag.  Unknown chunks are
+      // simply skipped over.
+      pos = 0;
+      while ( pos+SAVESTATE_CHUNK_HEADER_SIZE <= m_size )
+      {
+         m_pos = pos;
+         length = Get(4);
+         if ( length == tag )
+         {
+            m_chunkVersion = Get(2);
+            length = Get(4);
+            m_chunkEnd = m_pos+length;
+            if ( m_chunkEnd > m_size )
+            {
+               m_ok = false;
+               return false;
+            }
+            return true;
+         }
+         m_pos += 2;
+         length = Get(4);
+         pos = m_pos+length;
+      }
+      // Every chunk is required, so a missing one fails the load.
+      m_chunkVersion = 0;
+      m_ok = false;
+      return false;
+   }
+
+   m_chunkStart = m_pos;
+   m_chunkVersion = version;
+   Put(tag,4);
+   Put(version,2);
+   Put(0,4); // Length is filled in by EndChunk.
+   return m_ok;
+}
+
+void CSaveState::EndChunk ( void )
+{
+   uint32_t pos;
+
+   if ( m_loading )
+   {
+      // Reading past the end of the chunk means the STATE method and
+      // the snapshot disagree.
+      if ( m_pos > m_chunkEnd )
+      {
+         m_ok = false;
+      }
+   }
+   else
+   {
+      pos = m_pos;
+      m_pos = m_chunkStart+6;
+      Put(pos-(m_chunkStart+SAVESTATE_CHUNK_HEADER_SIZE),4);
+      m_pos = pos;
+   }
+}
+
+void CSaveState::Put ( uint32_t value, int32_t bytes )
+{
+   int32_t idx;
+
+   if ( m_buffer )
+   {
+      if ( m_pos+bytes > m_size )
+      {
+         m_ok = false;
+         return;
+      }
+      for ( idx = 0; idx < bytes; idx++ )
+      {
+         m_buffer[m_pos+idx] = (value>>(idx<<3))&0xFF;
+      }
+   }
+   m_pos += bytes;
+   if ( m_pos > m_end )
+   {
+      m_end = m_pos;
+   }
+}
+
+uint32_t CSaveState::Get ( int32_t bytes )
+{
+   uint32_t value = 0;
+   int32_t  idx;
+
+   if ( m_pos+bytes > m_size )
+   {
+      m_ok = false;
+      return 0;
+   }
+   for ( idx = 0; idx < bytes; idx++ )
+   {
+      value |= ((uint32_t)m_buffer[m_pos+idx])<<(idx<<3);
+   }
+   m_pos += bytes;
+   return value;
+}
+
+void CSaveState::Value ( bool& value )
+{
+   if ( m_loading )
+   {
+      value = !!Get(1);
+   }
+   else
+   {
+      Put(value,1);
+   }
+}
+
+void CSaveState::Value ( uint8_t& value )
+{
+   if ( m_loading )
+   {
+      value = Get(1);
+   }
+   else
+   {
+      Put(value,1);
+   }
+}
+
+void CSaveState::Value ( int8_t& value )
+{
+   if ( m_loading )
+   {
+      value = (int8_t)Get(1);
+   }
+   else
+   {
+      Put((uint8_t)value,1);
+   }
+}
+
+void CSaveState::Value ( uint16_t& value )
+{
+   if ( m_loading )
+   {
+      value = Get(2);
+   }
+   else
+   {
+      Put(value,2);
+   }
+}
+
+void CSaveState::Value ( int16_t& value )
+{
+   if ( m_loading )
+   {
+      value = (int16_t)Get(2);
+   }
+   else
+   {
+      Put((uint16_t)value,2);
+   }
+}
+
+void CSaveState::Value ( uint32_t& value )
+{
+   if ( m_loading )
+   {
+      value = Get(4);
+   }
+   else
+   {
+      Put(value,4);
+   }
+}
+
+void CSaveState::Value ( int32_t& value )
+{
+   if ( m_loading )
+   {
+      value = (int32_t)Get(4);
+   }
+   else
+   {
+      Put((uint32_t)value,4);
+   }
+}
+
+void CSaveState::Value ( float& value )
+{
+   uint32_t bits;
+
+   if ( m_loading )
+   {
+      bits = Get(4);
+      memcpy(&value,&bits,4);
+   }
+   else
+   {
+      memcpy(&bits,&value,4);
+      Put(bits,4);
+   }
+}
+
+void CSaveState::Bytes ( uint8_t* data, uint32_t length )
+{
+   if ( m_loading )
+   {
+      if ( m_pos+length > m_size )
+      {
+         m_ok = false;
+         return;
+      }
+      memcpy(data,m_buffer+m_pos,length);
+   }
+   else if ( m_buffer )
+   {
+      if ( m_pos+length > m_size )
+      {
+         m_ok = false;
+         return;
+      }
+      memcpy(m_buffer+m_pos,data,length);
+   }
+   m_pos += length;
+   if ( m_pos > m_end )
+   {
+      m_end = m_pos;
+   }
+}
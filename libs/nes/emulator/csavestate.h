@@ -0,0 +1,86 @@
+#if !defined ( SAVE_STATE_H )
+#define SAVE_STATE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Build a chunk tag out of four characters.
+#define SAVESTATE_TAG(a,b,c,d) ( ((uint32_t)(a))|(((uint32_t)(b))<<8)|(((uint32_t)(c))<<16)|(((uint32_t)(d))<<24) )
+
+// Size of the header in front of each chunk: tag, version, length.
+#define SAVESTATE_CHUNK_HEADER_SIZE 10
+
+// The CSaveState class reads or writes a binary emulator snapshot.
+// A snapshot is a sequence of chunks, each of which is a four character
+// tag, a 16-bit version, a 32-bit length and the chunk data.  All values
+// are stored little-endian regardless of the host.
+//
+// Each emulator object describes its state once, in a STATE method, by
+// passing its members through Value() and Bytes().  The same method
+// both saves and restores the object depending on which way the
+// CSaveState is going, so the two can never get out of step.
+//
+// When saving with a NULL buffer nothing is written, only the size
+// that would be needed is counted.
+class CSaveState
+{
+public:
+   CSaveState ( uint8_t* buffer, uint32_t size, bool loading );
+
+   inline bool IsLoading ( void ) const
+   {
+      return m_loading;
+   }
+   inline bool IsOk ( void ) const
+   {
+      return m_ok;
+   }
+
+   // Bytes written so far, or bytes needed if counting.
+   inline uint32_t GetSize ( void ) const
+   {
+      return m_end;
+   }
+
+   // Start a chunk.  When loading this locates the chunk in the buffer
+   // and fails the load if there isn't one.  Chunk versions let STATE
+   // methods read older snapshots; the version found when loading is
+   // available from GetChunkVersion().
+   bool BeginChunk ( uint32_t tag, uint16_t version );
+   void EndChunk ( void );
+   inline uint16_t GetChunkVersion ( void ) const
+   {
+      return m_chunkVersion;
+   }
+
+   void Value ( bool& value );
+   void Value ( uint8_t& value );
+   void Value ( int8_t& value );
+   void Value ( uint16_t& value );
+   void Value ( int16_t& value );
+   void Value ( uint32_t& value );
+   void Value ( int32_t& value );
+   void Value ( float& value );
+   void Bytes ( uint8_t* data, uint32_t length );
+
+protected:
+   void Put ( uint32_t value, int32_t bytes );
+   uint32_t Get ( int32_t bytes );
+
+   uint8_t* m_buffer;
+   uint32_t m_size;
+   bool     m_loading;
+   bool     m_ok;
+
+   // Read/write cursor and the end of the data written so far.
+   uint32_t m_pos;
+   uint32_t m_end;
+
+   // Where the chunk being saved starts, and where the chunk being
+   // loaded ends.
+   uint32_t m_chunkStart;
+   uint32_t m_chunkEnd;
+   uint16_t m_chunkVersion;
+};
+
+#endif
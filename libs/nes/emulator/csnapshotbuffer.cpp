@@ -0,0 +1,136 @@
+//    NESICIDE - an IDE for the 8-bit NES.
+//    Copyright (C) 2009  Christopher S. Pow
+
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "csnapshotbuffer.h"
+
+CSnapshotBuffer::CSnapshotBuffer()
+{
+   int32_t idx;
+
+   m_enabled = false;
+   for ( idx = 0; idx < NUM_SNAPSHOT_BUFFERS; idx++ )
+   {
+      m_pBuffers[idx] = NULL;
+      m_readers[idx] = 0;
+   }
+   m_latest = -1;
+   m_writing = -1;
+}
+
+CSnapshotBuffer::~CSnapshotBuffer()
+{
+   int32_t idx;
+
+   for ( idx = 0; idx < NUM_SNAPSHOT_BUFFERS; idx++ )
+   {
+      delete m_pBuffers[idx];
+   }
+}
+
+void CSnapshotBuffer::SetEnabled ( bool enable )
+{
+   int32_t idx;
+
+   // The buffers are only allocated once they're needed, and are kept
+   // since a reader may be holding one.
+   if ( enable && (!m_pBuffers[0]) )
+   {
+      for ( idx = 0; idx < NUM_SNAPSHOT_BUFFERS; idx++ )
+      {
+         m_pBuffers[idx] = new NesStateSnapshot;
+      }
+   }
+
+   if ( !enable )
+   {
+      m_latest = -1;
+   }
+
+   m_enabled = enable;
+}
+
+NesStateSnapshot* CSnapshotBuffer::GetWriteBuffer ( void )
+{
+   int32_t latest = m_latest;
+   int32_t idx;
+
+   if ( !m_enabled )
+   {
+      return NULL;
+   }
+
+   // A reader only keeps hold of a buffer it has counted itself in on while
+   // that buffer was the latest.  Once a buffer is no longer the latest and
+   // has no readers, nobody can get hold of it.
+   for ( idx = 0; idx < NUM_SNAPSHOT_BUFFERS; idx++ )
+   {
+      if ( (idx != latest) && (m_readers[idx] == 0) )
+      {
+         m_writing = idx;
+         return m_pBuffers[idx];
+      }
+   }
+
+   m_writing = -1;
+   return NULL;
+}
+
+void CSnapshotBuffer::Publish ( void )
+{
+   if ( m_writing >= 0 )
+   {
+      m_latest = m_writing;
+      m_writing = -1;
+   }
+}
+
+const NesStateSnapshot* CSnapshotBuffer::Acquire ( void )
+{
+   int32_t latest;
+
+   for ( ;; )
+   {
+      latest = m_latest;
+      if ( latest < 0 )
+      {
+         return NULL;
+      }
+
+      // If the buffer is still the latest after counting in on it the
+      // emulator can't have started writing it.  Otherwise try again with
+      // the newer one.
+      m_readers[latest]++;
+      if ( m_latest == latest )
+      {
+         return m_pBuffers[latest];
+      }
+      m_readers[latest]--;
+   }
+}
+
+void CSnapshotBuffer::Release ( const NesStateSnapshot* pSnapshot )
+{
+   int32_t idx;
+
+   for ( idx = 0; idx < NUM_SNAPSHOT_BUFFERS; idx++ )
+   {
+      if ( pSnapshot && (pSnapshot == m_pBuffers[idx]) )
+      {
+         m_readers[idx]--;
+         break;
+      }
+   }
+}
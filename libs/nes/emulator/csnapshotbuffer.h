@@ -0,0 +1,56 @@
+#if !defined ( SNAPSHOTBUFFER_H )
+#define SNAPSHOTBUFFER_H
+
+#include <atomic>
+
+#include "nes_emulator_core.h"
+
+// The CSnapshotBuffer class hands snapshots of the whole NES from the
+// emulator thread to the debugger threads without copying or locking.
+//
+// The emulator saves a snapshot into a buffer nobody is reading and then
+// publishes it by making it the latest one.  A reader takes hold of the
+// latest snapshot by counting itself in on that buffer; the emulator never
+// writes a buffer that has readers, so a held snapshot stays the same until
+// it is released.  There are enough buffers for the emulator to always find
+// a free one with a couple of readers holding old snapshots.  If every
+// buffer is held the emulator skips publishing rather than waiting.
+class CSnapshotBuffer
+{
+public:
+   CSnapshotBuffer();
+   ~CSnapshotBuffer();
+
+   // Publishing is off until it is turned on since it costs a copy of the
+   // state every frame.  Turning it off drops the latest snapshot; buffers
+   // that readers still hold stay valid until released.
+   void SetEnabled ( bool enable );
+   inline bool IsEnabled ( void ) const
+   {
+      return m_enabled;
+   }
+
+   // Emulator thread only.  Get a buffer to save a snapshot into, then
+   // publish it.  GetWriteBuffer returns NULL if every buffer is held.
+   NesStateSnapshot* GetWriteBuffer ( void );
+   void Publish ( void );
+
+   // Any thread.  The latest snapshot, or NULL if there isn't one.  Every
+   // snapshot acquired must be released.
+   const NesStateSnapshot* Acquire ( void );
+   void Release ( const NesStateSnapshot* pSnapshot );
+
+protected:
+   enum
+   {
+      NUM_SNAPSHOT_BUFFERS = 4
+   };
+
+   bool              m_enabled;
+   NesStateSnapshot* m_pBuffers [ NUM_SNAPSHOT_BUFFERS ];
+   std::atomic<int32_t> m_readers [ NUM_SNAPSHOT_BUFFERS ];
+   std::atomic<int32_t> m_latest;
+   int32_t           m_writing;
+};
+
+#endif
@@ -0,0 +1,5 @@
+# Multi-instance variant of the NES emulator core with all of the debugging
+# support compiled out.  Used by the headless tools.
+CONFIG += nes_multi_instance nes_no_debug
+
+include(nes-emulator-lib.pro)
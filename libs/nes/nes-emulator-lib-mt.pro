@@ -0,0 +1,5 @@
+# Multi-instance variant of the NES emulator core.  Each thread that creates
+# a NesContext gets its own independent NES.  Used by the headless tools.
+CONFIG += nes_multi_instance
+
+include(nes-emulator-lib.pro)
@@ -0,0 +1,5 @@
+# Variant of the NES emulator core with all of the debugging support compiled
+# out.  Used by the standalone emulator.
+CONFIG += nes_no_debug
+
+include(nes-emulator-lib.pro)
@@ -27,13 +27,35 @@ CONFIG(release, debug|release) {
 
 # Remove crap we don't need!
 CONFIG -= rtti exceptions
-CONFIG += c++11
+CONFIG += c++11 thread
 
 OBJECTS_DIR = $$DESTDIR
 MOC_DIR = $$DESTDIR
 RCC_DIR = $$DESTDIR
 UI_DIR = $$DESTDIR
 
+# "qmake CONFIG+=nes_multi_instance" builds libnes-emulator-mt, a variant of the
+# core in which each thread owns an independent NES (see nesCreateContext).
+nes_multi_instance {
+   TARGET = "nes-emulator-mt"
+   DEFINES += NES_MULTI_INSTANCE
+   OBJECTS_DIR = $$DESTDIR/mt
+   unix:!mac {
+      # The library is always linked at load time so the fast TLS model is safe.
+      QMAKE_CXXFLAGS += -ftls-model=initial-exec
+   }
+}
+
+# "qmake CONFIG+=nes_no_debug" builds a variant of the core with the tracer,
+# code/data logger, breakpoints and scroll capture compiled out, for the
+# applications that have no debugger.  It can be combined with
+# nes_multi_instance.
+nes_no_debug {
+   TARGET = "$${TARGET}-nodebug"
+   DEFINES += NES_NO_DEBUG
+   OBJECTS_DIR = $$OBJECTS_DIR/nodebug
+}
+
 win32 {
    DEPENDENCYROOTPATH = $$TOP/deps
    DEPENDENCYPATH = $$DEPENDENCYROOTPATH/Windows
@@ -113,7 +135,12 @@ SOURCES += \
     emulator/cnesrommapper018.cpp \
     emulator/cnesrommapper073.cpp \
     emulator/cnesrommapper016.cpp \
-    emulator/cnesrommapper111.cpp
+    emulator/cnesrommapper111.cpp \
+    emulator/csavestate.cpp \
+    emulator/crewind.cpp \
+    emulator/csnapshotbuffer.cpp \
+    emulator/cblipbuffer.cpp \
+    emulator/cframedumper.cpp
 
 HEADERS +=\
    emulator/cnesrommapper068.h \
@@ -158,4 +185,9 @@ HEADERS +=\
     emulator/cnesrommapper018.h \
     emulator/cnesrommapper073.h \
     emulator/cnesrommapper016.h \
-    emulator/cnesrommapper111.h
+    emulator/cnesrommapper111.h \
+    emulator/csavestate.h \
+    emulator/crewind.h \
+    emulator/csnapshotbuffer.h \
+    emulator/cblipbuffer.h \
+    emulator/cframedumper.h
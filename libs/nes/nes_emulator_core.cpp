@@ -26,11 +26,75 @@ char* nesGetVersion()
 {
    return __emu_version__;
 }
-extern int32_t apuDataAvailable;
+extern NES_THREAD_LOCAL int32_t apuDataAvailable;
 
 const char* hex_char = "0123456789ABCDEF";
 
-bool __nesdebug = false;
+struct _NesContext
+{
+   CNES*  nes;
+   C6502* cpu;
+   CPPU*  ppu;
+   CAPU*  apu;
+   CROM*  rom;
+};
+
+#if defined ( NES_MULTI_INSTANCE )
+static NES_THREAD_LOCAL NesContext* __nescontext = NULL;
+#else
+// The emulator objects of the single NES are constructed statically.
+static NesContext __nesdefaultcontext = { NULL, NULL, NULL, NULL, NULL };
+static NesContext* __nescontext = &__nesdefaultcontext;
+#endif
+
+NesContext* nesCreateContext ( void )
+{
+#if defined ( NES_MULTI_INSTANCE )
+   if ( !__nescontext )
+   {
+      __nescontext = new NesContext;
+      __nescontext->nes = new CNES();
+      __nescontext->cpu = new C6502();
+      __nescontext->ppu = new CPPU();
+      __nescontext->apu = new CAPU();
+      __nescontext->rom = new CROM();
+   }
+#endif
+   return __nescontext;
+}
+
+void nesDestroyContext ( NesContext* pContext )
+{
+#if defined ( NES_MULTI_INSTANCE )
+   // Contexts can only be destroyed by the thread that owns them.
+   if ( pContext && (pContext == __nescontext) )
+   {
+      delete pContext->rom;
+      delete pContext->apu;
+      delete pContext->ppu;
+      delete pContext->cpu;
+      delete pContext->nes;
+      delete pContext;
+      __nescontext = NULL;
+   }
+#endif
+}
+
+NesContext* nesGetContext ( void )
+{
+   return __nescontext;
+}
+
+bool nesIsMultiInstance ( void )
+{
+#if defined ( NES_MULTI_INSTANCE )
+   return true;
+#else
+   return false;
+#endif
+}
+
+NES_THREAD_LOCAL bool __nesdebug = false;
 
 void nesEnableDebug ( void )
 {
@@ -47,14 +111,16 @@ void nesSetBreakOnKIL ( bool breakOnKIL )
    C6502::BREAKONKIL(breakOnKIL);
 }
 
-static void (*breakpointHook)(void) = NULL;
+static NES_THREAD_LOCAL void (*breakpointHook)(void) = NULL;
+
+static void nesPublishSnapshot ( void );
 
 void nesSetBreakpointHook ( void (*hook)(void) )
 {
    breakpointHook = hook;
 }
 
-static void (*audioHook)(void) = NULL;
+static NES_THREAD_LOCAL void (*audioHook)(void) = NULL;
 
 void nesSetAudioHook ( void (*hook)(void) )
 {
@@ -63,6 +129,11 @@ void nesSetAudioHook ( void (*hook)(void) )
 
 void nesBreak ( void )
 {
+   // Let the debuggers see the NES as it is at the breakpoint, including
+   // the part of the frame drawn so far.
+   CPPU::EXPANDTV();
+   nesPublishSnapshot();
+
    if ( breakpointHook )
    {
       breakpointHook();
@@ -191,14 +262,8 @@ CMarker* nesGetExecutionMarkerDatabase ( void )
 
 void nesClearCodeDataLoggerDatabases ( void )
 {
-   unsigned int addr;
-
    C6502::LOGGER()->ClearData();
-
-   for ( addr = 0; addr < nesGetPRGROMSize(); addr += MEM_8KB )
-   {
-      CROM::LOGGERPHYS(addr)->ClearData();
-   }
+   CROM::CLEARLOGGERS();
 }
 
 CCodeDataLogger* nesGetCpuCodeDataLoggerDatabase ( void )
@@ -404,11 +469,113 @@ void nesSetTVOut ( int8_t* tv )
    CPPU::TV ( tv );
 }
 
+// NES 2.0 ROM sizes with all ones in the upper nibble are 2^E*(M*2+1) bytes,
+// with the exponent and multiplier packed as EEEEEEMM in the lower byte.
+static uint32_t nesROMHeaderExponentSize ( uint8_t sizeLSB, uint32_t bankSize )
+{
+   uint32_t exponent = sizeLSB>>2;
+   uint64_t size;
+
+   if ( exponent > 32 )
+   {
+      return 0;
+   }
+   size = (((uint64_t)1)<<exponent)*(((sizeLSB&0x03)<<1)+1);
+
+   return (size+bankSize-1)/bankSize;
+}
+
+bool nesParseROMHeader ( const uint8_t* header, NesRomHeader* pHeader )
+{
+   uint8_t romCB1 = header[6];
+   uint8_t romCB2 = header[7];
+
+   if ( (header[0] != 'N') || (header[1] != 'E') || (header[2] != 'S') || (header[3] != 0x1A) )
+   {
+      return false;
+   }
+
+   pHeader->flags = romCB1&(FLAG_MIRROR|FLAG_SRAM|FLAG_TRAINER|FLAG_VRAM);
+   pHeader->nes20 = ((romCB2&0x0C) == 0x08);
+   pHeader->junk = false;
+
+   if ( pHeader->nes20 )
+   {
+      // Byte 9 holds the upper bits of the PRG-ROM (low nibble, in 16KB
+      // banks) and CHR-ROM (high nibble, in 8KB banks) sizes.  Byte 8 holds
+      // the upper mapper bits.
+      if ( (header[9]&0x0F) == 0x0F )
+      {
+         pHeader->numPrgRomBanks = nesROMHeaderExponentSize(header[4],MEM_8KB);
+      }
+      else
+      {
+         pHeader->numPrgRomBanks = (header[4]|((header[9]&0x0F)<<8))<<1;
+      }
+      if ( (header[9]&0xF0) == 0xF0 )
+      {
+         pHeader->numChrRomBanks = nesROMHeaderExponentSize(header[5],MEM_8KB);
+      }
+      else
+      {
+         pHeader->numChrRomBanks = header[5]|((header[9]&0xF0)<<4);
+      }
+      pHeader->mapper = ((romCB1>>4)&0x0F)|(romCB2&0xF0)|((header[8]&0x0F)<<8);
+   }
+   else
+   {
+      // Some old tools wrote their names into the reserved bytes, so the
+      // upper mapper bits can't be trusted if any of them are set.
+      if ( romCB2&0x0F )
+      {
+         romCB2 = 0x00;
+         pHeader->junk = true;
+      }
+      pHeader->numPrgRomBanks = header[4]<<1;
+      pHeader->numChrRomBanks = header[5];
+      pHeader->mapper = ((romCB1>>4)&0x0F)|(romCB2&0xF0);
+   }
+
+   pHeader->dataOffset = INES_HEADER_SIZE;
+   if ( romCB1&FLAG_TRAINER )
+   {
+      pHeader->dataOffset += INES_TRAINER_SIZE;
+   }
+
+   return true;
+}
+
+void nesBuildROMHeader ( const NesRomHeader* pHeader, uint8_t* header )
+{
+   uint32_t numPrgRomBanks = (pHeader->numPrgRomBanks+1)>>1;
+   uint32_t numChrRomBanks = pHeader->numChrRomBanks;
+
+   memset ( header, 0, INES_HEADER_SIZE );
+   header[0] = 'N';
+   header[1] = 'E';
+   header[2] = 'S';
+   header[3] = 0x1A;
+   header[4] = numPrgRomBanks&0xFF;
+   header[5] = numChrRomBanks&0xFF;
+   header[6] = (pHeader->flags&(FLAG_MIRROR|FLAG_SRAM|FLAG_TRAINER|FLAG_VRAM))|((pHeader->mapper&0x0F)<<4);
+   header[7] = pHeader->mapper&0xF0;
+
+   if ( (numPrgRomBanks > 0xFF) || (numChrRomBanks > 0xFF) || (pHeader->mapper > 0xFF) )
+   {
+      header[7] |= 0x08;
+      header[8] = (pHeader->mapper>>8)&0x0F;
+      header[9] = ((numPrgRomBanks>>8)&0x0F)|((numChrRomBanks>>4)&0xF0);
+   }
+}
+
 void nesUnloadROM ( void )
 {
    CROM::ClearPRGBanks ();
    CROM::ClearCHRBanks ();
    CROM::RESET(0);
+
+   // History of the previous cartridge is no use...
+   CNES::REWIND()->Clear();
 }
 
 void nesLoadPRGROMBank ( uint32_t bank, uint8_t* bankData )
@@ -449,16 +616,199 @@ void nesSetFourScreen ( void )
 void nesReset ( bool soft )
 {
    CNES::RESET(CROM::MAPPER(),soft);
+
+   CNES::REWIND()->StateChanged();
+
+   nesPublishSnapshot();
 }
 
 void nesResetInitial ( uint32_t mapper )
 {
    CNES::RESET(mapper,false);
+
+   CNES::REWIND()->Clear();
+
+   nesPublishSnapshot();
 }
 
 void nesRun ( uint32_t* joypads )
 {
+   CRewind* pRewind = CNES::REWIND();
+   uint32_t size;
+
+   // Add to the rewind history if it's time to.
+   if ( pRewind->IsSnapshotDue() )
+   {
+      size = nesGetStateSize();
+      size = nesSaveState(pRewind->GetSnapshotBuffer(size),size);
+      if ( size )
+      {
+         pRewind->CommitSnapshot(CNES::FRAME(),size);
+      }
+   }
+
    CNES::RUN(joypads);
+
+   pRewind->FrameEmulated();
+
+   // Skipped frames aren't shown so there's no point in the debuggers showing them either.
+   if ( !CNES::FRAMESKIP() )
+   {
+      nesPublishSnapshot();
+
+      if ( CNES::FRAMEDUMPER()->IsRunning() &&
+           ((CNES::FRAMEDUMPER()->GetFormat() != NES_FRAMEDUMP_RGBA) || CPPU::TV()) )
+      {
+         CNES::FRAMEDUMPER()->Submit(CPPU::TV(),CPPU::TVINDEX());
+      }
+   }
+}
+
+bool nesStartFrameDump ( const char* fileName, int32_t format, int32_t depth, bool dropWhenFull )
+{
+   return CNES::FRAMEDUMPER()->Start(fileName,format,depth,dropWhenFull);
+}
+
+void nesStopFrameDump ( void )
+{
+   CNES::FRAMEDUMPER()->Stop();
+}
+
+bool nesIsFrameDumping ( void )
+{
+   return CNES::FRAMEDUMPER()->IsRunning();
+}
+
+uint32_t nesGetFramesDumped ( void )
+{
+   return CNES::FRAMEDUMPER()->GetFramesWritten();
+}
+
+uint32_t nesGetFramesDumpDropped ( void )
+{
+   return CNES::FRAMEDUMPER()->GetFramesDropped();
+}
+
+void nesSetFrameSkip ( bool skip )
+{
+   CNES::FRAMESKIP(skip);
+}
+
+bool nesGetFrameSkip ( void )
+{
+   return CNES::FRAMESKIP();
+}
+
+void nesSetPPUScanlineBatching ( bool enable )
+{
+   CPPU::SCANLINEBATCHING(enable);
+}
+
+bool nesGetPPUScanlineBatching ( void )
+{
+   return CPPU::SCANLINEBATCHING();
+}
+
+static bool nesState ( CSaveState& state )
+{
+   uint32_t mapper = CROM::MAPPER();
+   uint32_t numPrgBanks = CROM::NUMPRGROMBANKS();
+   uint32_t numChrBanks = CROM::NUMCHRROMBANKS();
+   int32_t  videoMode = CNES::VIDEOMODE();
+
+   // The state of a NES only makes sense for the cartridge and system
+   // it was saved from, so those are checked before anything is loaded.
+   if ( state.BeginChunk(SAVESTATE_TAG('H','E','A','D'),1) )
+   {
+      state.Value ( mapper );
+      state.Value ( numPrgBanks );
+      state.Value ( numChrBanks );
+      state.Value ( videoMode );
+      state.EndChunk ();
+   }
+   if ( (!state.IsOk()) ||
+        (mapper != CROM::MAPPER()) ||
+        (numPrgBanks != CROM::NUMPRGROMBANKS()) ||
+        (numChrBanks != CROM::NUMCHRROMBANKS()) ||
+        (videoMode != CNES::VIDEOMODE()) )
+   {
+      return false;
+   }
+
+   CNES::STATE ( state );
+
+   return state.IsOk();
+}
+
+uint32_t nesGetStateSize ( void )
+{
+   CSaveState state ( NULL, 0, false );
+
+   nesState ( state );
+
+   return state.GetSize();
+}
+
+uint32_t nesSaveState ( uint8_t* buffer, uint32_t size )
+{
+   CSaveState state ( buffer, size, false );
+
+   return nesState(state) ? state.GetSize() : 0;
+}
+
+bool nesLoadState ( uint8_t* buffer, uint32_t size )
+{
+   CSaveState state ( buffer, size, true );
+
+   // A state from another cartridge or system mode is refused before
+   // anything is changed.
+   if ( nesState(state) )
+   {
+      CNES::REWIND()->StateChanged();
+      nesPublishSnapshot();
+      return true;
+   }
+   return false;
+}
+
+void nesSetRewind ( uint32_t interval, uint32_t memory )
+{
+   CNES::REWIND()->SetConfiguration(interval,memory);
+}
+
+uint32_t nesGetRewindInterval ( void )
+{
+   return CNES::REWIND()->GetInterval();
+}
+
+uint32_t nesGetRewindDepth ( void )
+{
+   return CNES::REWIND()->GetDepth();
+}
+
+uint32_t nesGetRewindMemoryUsed ( void )
+{
+   return CNES::REWIND()->GetMemoryUsed();
+}
+
+bool nesRewind ( void )
+{
+   CRewind* pRewind = CNES::REWIND();
+
+   if ( !pRewind->Rewind() )
+   {
+      return false;
+   }
+
+   // The snapshot came from this cartridge so it always loads.
+   CSaveState state ( pRewind->GetSnapshot(), pRewind->GetSnapshotSize(), true );
+   if ( !nesState(state) )
+   {
+      return false;
+   }
+
+   nesPublishSnapshot();
+   return true;
 }
 
 uint8_t* nesGetAudioSamples ( uint16_t samples )
@@ -466,6 +816,31 @@ uint8_t* nesGetAudioSamples ( uint16_t samples )
    return CAPU::PLAY(samples);
 }
 
+void nesSetAudioSampleRate ( uint32_t rate )
+{
+   CAPU::SAMPLERATE(rate);
+}
+
+uint32_t nesGetAudioSampleRate ( void )
+{
+   return CAPU::SAMPLERATE();
+}
+
+int32_t nesReadAudioSamples ( int16_t* samples, int32_t count )
+{
+   return CAPU::READ(samples,count);
+}
+
+void nesSetFrameSkipAudio ( bool keep )
+{
+   CAPU::KEEPSKIPPEDSAMPLES(keep);
+}
+
+bool nesGetFrameSkipAudio ( void )
+{
+   return CAPU::KEEPSKIPPEDSAMPLES();
+}
+
 int32_t nesGetAudioSamplesAvailable ( void )
 {
    return apuDataAvailable;
@@ -508,6 +883,11 @@ int8_t* nesGetTVOut ( void )
    return CPPU::TV();
 }
 
+const uint16_t* nesGetTVIndexOut ( void )
+{
+   return CPPU::TVINDEX();
+}
+
 void nesSetVRC6AudioChannelMask ( uint32_t mask )
 {
    _mapperfunc[24].soundenable(mask);
@@ -722,6 +1102,16 @@ void nesSetPPURegister ( uint32_t addr, uint32_t data )
    CPPU::_PPU(addr,data);
 }
 
+void nesSetScrollCapture ( bool enable )
+{
+   CPPU::SCROLLCAPTURE(enable);
+}
+
+bool nesGetScrollCapture ( void )
+{
+   return CPPU::SCROLLCAPTURE();
+}
+
 uint16_t nesGetScrollXAtXY ( int32_t x, int32_t y )
 {
    return CPPU::_SCROLLX(x,y);
@@ -849,6 +1239,9 @@ uint32_t nesMapperLowRead ( uint32_t addr )
 void nesMapperLowWrite ( uint32_t addr, uint32_t data )
 {
    MAPPERFUNC->lowwrite(addr,data);
+
+   // The write may have switched banks.
+   C6502::REMAP();
 }
 
 uint32_t nesMapperHighRead ( uint32_t addr )
@@ -859,6 +1252,9 @@ uint32_t nesMapperHighRead ( uint32_t addr )
 void nesMapperHighWrite ( uint32_t addr, uint32_t data )
 {
    MAPPERFUNC->highwrite(addr,data);
+
+   // The write may have switched banks.
+   C6502::REMAP();
 }
 
 uint32_t nesGetPPUOAM ( uint32_t addr )
@@ -1128,7 +1524,6 @@ void nesGetCpuSnapshot(NESCpuStateSnapshot* pSnapshot)
 void nesGetPpuSnapshot(PpuStateSnapshot* pSnapshot)
 {
    int idx;
-   int x,y;
    pSnapshot->frame = CPPU::_FRAME();
    pSnapshot->cycle = CPPU::_CYCLES();
    for ( idx = 0; idx < NUM_PPU_REGS; idx++ )
@@ -1147,16 +1542,24 @@ void nesGetPpuSnapshot(PpuStateSnapshot* pSnapshot)
    {
       *(pSnapshot->memory+idx) = CPPU::_MEM(idx);
    }
-   for ( y = 0; y < 240; y++ )
+   if ( CPPU::SCROLLCAPTURE() )
    {
-      for ( x = 0; x < 256; x++ )
-      {
-         *(*(pSnapshot->xOffset+x)+y) = CPPU::_SCROLLX(x,y);
-         *(*(pSnapshot->yOffset+x)+y) = CPPU::_SCROLLY(x,y);
-      }
+      // Part way through a frame the scanlines not drawn yet still refer
+      // to the last frame's runs so take all of them.
+      memcpy(pSnapshot->scrollRunStart,CPPU::SCROLLRUNSTART(),sizeof(pSnapshot->scrollRunStart));
+      memcpy(pSnapshot->scrollRun,CPPU::SCROLLRUNS(),sizeof(pSnapshot->scrollRun));
+   }
+   else
+   {
+      memset(pSnapshot->scrollRunStart,0,sizeof(pSnapshot->scrollRunStart));
    }
 }
 
+const PpuScrollRun* nesGetPpuSnapshotScrollRun(const PpuStateSnapshot* pSnapshot, int32_t x, int32_t y)
+{
+   return CPPU::SCROLLRUN(pSnapshot->scrollRunStart,pSnapshot->scrollRun,x,y);
+}
+
 void nesGetApuSnapshot(ApuStateSnapshot* pSnapshot)
 {
    int idx;
@@ -1188,3 +1591,39 @@ void nesGetNesSnapshot(NesStateSnapshot *pSnapshot)
    nesGetApuSnapshot(&pSnapshot->apu);
    nesGetPpuSnapshot(&pSnapshot->ppu);
 }
+
+static void nesPublishSnapshot ( void )
+{
+   CSnapshotBuffer* pSnapshots = CNES::SNAPSHOTS();
+   NesStateSnapshot* pSnapshot;
+
+   if ( pSnapshots->IsEnabled() )
+   {
+      pSnapshot = pSnapshots->GetWriteBuffer();
+      if ( pSnapshot )
+      {
+         nesGetNesSnapshot(pSnapshot);
+         pSnapshots->Publish();
+      }
+   }
+}
+
+void nesSetSnapshotPublishing(bool enable)
+{
+   CNES::SNAPSHOTS()->SetEnabled(enable);
+}
+
+bool nesGetSnapshotPublishing(void)
+{
+   return CNES::SNAPSHOTS()->IsEnabled();
+}
+
+const NesStateSnapshot* nesAcquireSnapshot(void)
+{
+   return CNES::SNAPSHOTS()->Acquire();
+}
+
+void nesReleaseSnapshot(const NesStateSnapshot* pSnapshot)
+{
+   CNES::SNAPSHOTS()->Release(pSnapshot);
+}
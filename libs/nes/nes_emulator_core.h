@@ -14,6 +14,18 @@ extern "C" {
 #include "cmarker.h"
 #include "cbreakpointinfo.h"
 
+// Emulator state storage class.
+// The emulator objects keep their state in static members.  When the core
+// is built with NES_MULTI_INSTANCE defined that state is thread-local, so each
+// thread that creates a NesContext drives its own independent NES.  Otherwise
+// the process has exactly one NES shared by all threads (which is what the IDE
+// wants, since its debugger inspectors read the core from the UI thread).
+#if defined ( NES_MULTI_INSTANCE )
+#define NES_THREAD_LOCAL thread_local
+#else
+#define NES_THREAD_LOCAL
+#endif
+
 // Common enumerations for emulated items.
 typedef enum
 {
@@ -90,6 +102,11 @@ enum
 #define MODE_PAL   1
 #define MODE_DENDY 2
 
+// Default rewind history settings: a snapshot every 6 frames kept in up
+// to 16MB, which holds several minutes of a typical game.
+#define REWIND_DEFAULT_INTERVAL 6
+#define REWIND_DEFAULT_MEMORY   (16*1024*1024)
+
 #define MAKE16(lo,hi) ((((lo)&0xFF)|(((hi)&0xFF)<<8)))
 
 // CPU interrupt vector memory addresses.
@@ -134,8 +151,13 @@ enum
 #define AM_RELATIVE             12
 #define NUM_ADDRESSING_MODES    13
 
-#define NUM_ROM_BANKS 128
-#define NUM_CHR_BANKS 256+32 // 32 extra banks for CHR-ROM+CHR-RAM mappers like N106.
+// PRG-ROM (8KB) and CHR (1KB) bank numbers any mapper can select.  Only the
+// banks actually in the ROM have memory behind them; bank numbers past the end
+// of the ROM mirror it, as the unconnected address lines would on a real board.
+// Bigger ROMs get as many bank numbers as they need.
+#define NUM_ROM_BANKS 512
+#define NUM_CHR_BANKS 1024
+#define NUM_CHR_RAM_BANKS 32 // CHR-RAM carts, and extra CHR-RAM for CHR-ROM mappers like N106.
 #define NUM_SRAM_BANKS 8
 
 #define PATTERN_SIZE 8
@@ -254,21 +276,30 @@ enum
 #define OAM_SIZE     4
 #define NUM_OAM_REGS (NUM_SPRITES*OAM_SIZE)
 
-// Samples per video frame for 44.1KHz audio output.
-// NTSC is 60Hz, PAL is 50Hz.  The number of samples
+// Samples per SDL audio callback.  The number of samples
 // drives the rate at which the SDL library will invoke
 // the callback method to retrieve more audio samples to
 // play.
 #define APU_SAMPLES           (1024)
 
+// Default audio output rate.  The rate can be changed with
+// nesSetAudioSampleRate() to anything between the minimum
+// and maximum.
 #define SDL_SAMPLE_RATE       (44100)
+#define APU_SAMPLE_RATE_MIN   (22050)
+#define APU_SAMPLE_RATE_MAX   (96000)
 
-#define APU_SAMPLE_SPACE_NTSC  ((89341.5/3.0)/(SDL_SAMPLE_RATE/60.0))
-#define APU_SAMPLE_SPACE_PAL   ((106392.0/3.2)/(SDL_SAMPLE_RATE/50.0))
-#define APU_SAMPLE_SPACE_DENDY ((106392.0/3.0)/(SDL_SAMPLE_RATE/50.0))
+// APU cycles per second.  NTSC is 60Hz, PAL and Dendy are 50Hz.
+#define APU_CLOCK_RATE_NTSC    ((89341.5/3.0)*60.0)
+#define APU_CLOCK_RATE_PAL     ((106392.0/3.2)*50.0)
+#define APU_CLOCK_RATE_DENDY   ((106392.0/3.0)*50.0)
 
 #define APU_BUFFER_PRERENDER           (APU_SAMPLES*2)   // How much rendering to do
 
+// Formats of the frames written by nesStartFrameDump().
+#define NES_FRAMEDUMP_RGBA    0
+#define NES_FRAMEDUMP_INDEXED 1
+
 #pragma pack(1)
 typedef struct
 {
@@ -354,6 +385,21 @@ enum
 };
 
 #define INES_HEADER_ID 0x1a53454e
+#define INES_HEADER_SIZE 16
+#define INES_TRAINER_SIZE 512
+
+// What a .nes file's iNES or NES 2.0 header says about the cartridge.  ROM sizes
+// are in the 8KB banks nesLoadPRGROMBank() and nesLoadCHRROMBank() take.
+typedef struct
+{
+   uint32_t numPrgRomBanks;
+   uint32_t numChrRomBanks;
+   uint32_t mapper;
+   uint8_t  flags;       // FLAG_MIRROR, FLAG_SRAM, FLAG_TRAINER and FLAG_VRAM.
+   uint32_t dataOffset;  // Where the PRG-ROM starts in the file.
+   bool     nes20;
+   bool     junk;        // Old iNES header with junk in the reserved bytes.
+} NesRomHeader;
 
 // Supported NES input (controller) types:
 // Standard joypad
@@ -475,11 +521,17 @@ char* nesGetVersion();
 // core and perform the necessary steps to emulate a NES game.  Those steps are:
 // 1. Set the NES system mode to MODE_NTSC or MODE_PAL using nesSetSystemMode().
 // 2. Provide a 256x256x3-byte chunk of memory to the emulator core for it to
-//    render the NES TV surface onto, using nesSetTVOut().
+//    render the NES TV surface onto, using nesSetTVOut().  The PPU draws palette
+//    indexes (see NES_FRAMEDUMP_INDEXED) which nesGetTVIndexOut() returns; they
+//    are turned into RGB on the TV surface in one go when the visible part of a
+//    frame is done, and when a breakpoint is hit.  The fourth byte of each pixel
+//    is left as it is.
 // 3. Clear any emulation state by using nesUnloadROM().
-// 4. Pass 16KB PRG-ROM banks in order and 8KB CHR-ROM banks in order to the emulation
+// 4. Pass 8KB PRG-ROM banks in order and 8KB CHR-ROM banks in order to the emulation
 //    core by using nesLoadPRGROMBank() and nesLoadCHRROMBank() respectively.  If no
-//    CHR-ROM banks are present, do not call nesLoadCHRROMBank().
+//    CHR-ROM banks are present, do not call nesLoadCHRROMBank().  How many there are
+//    in a .nes file, and the other steps' settings, can be read from its header
+//    with nesParseROMHeader().  The core only uses memory for the banks passed in.
 // 5. If the game has fixed mirroring, tell the emulator core which one it is by
 //    using nesSetHorizontalMirroring() or nesSetVerticalMirroring().
 // 6. Tell the emulator core you're done passing it ROM data by using
@@ -495,7 +547,58 @@ char* nesGetVersion();
 //    can be retrieved by using nesGetAudioSamplesAvailable().  A pointer to the
 //    next buffer of audio samples to play can be retrieved using nesGetAudioSamples().
 //    Once retrieved, the number of available audio samples should be reset using
-//    nesClearAudioSamplesAvailable.
+//    nesClearAudioSamplesAvailable.  Samples are produced at SDL_SAMPLE_RATE unless
+//    another rate is chosen with nesSetAudioSampleRate(), for instance to match the
+//    rate the audio device actually opened at.  Offline consumers that aren't fed
+//    by the SDL callback can instead copy out everything produced so far with
+//    nesReadAudioSamples().
+// 10. To run faster than real time, frames that won't be shown can be skipped by
+//    using nesSetFrameSkip() before nesRun().  A skipped frame is emulated completely
+//    but nothing is drawn to the TV surface and none of its audio samples are kept,
+//    unless nesSetFrameSkipAudio() was used to keep them for rendering audio offline.
+// 11. The complete state of the emulated NES can be saved between calls to nesRun()
+//    by using nesSaveState() into a buffer of at least nesGetStateSize() bytes, and
+//    restored later with nesLoadState().  A saved state can only be loaded with the
+//    same ROM and system mode.  The TV surface is not part of the state; it is redrawn
+//    by the next nesRun().
+// 12. To be able to step backwards in time, turn on the rewind history by using
+//    nesSetRewind().  A snapshot of the state is then kept every few frames, within
+//    a memory limit, and nesRewind() goes back one snapshot each time it is used.
+//    The first step back goes to the most recent snapshot if frames have been run
+//    since it was taken.  Like nesLoadState(), rewinding can only be done between
+//    calls to nesRun() and the TV surface is redrawn by the next nesRun().
+// 13. The PPU runs its cycles in spans of up to a scanline at a time by default.
+//    nesSetPPUScanlineBatching() with false goes back to working out the raster
+//    position on every PPU cycle.  The emulation is identical either way; the
+//    cycle-by-cycle way is there to check the other against.
+// 14. Every frame drawn can be streamed to a file or pipe by using nesStartFrameDump()
+//    until nesStopFrameDump().  Frames are queued at the end of nesRun() and written
+//    out by a thread of the dump's own, so emulation doesn't wait for the disk unless
+//    the queue of 'depth' frames is full and 'dropWhenFull' is false.  Frames are
+//    written back to back, 256x240 pixels each, either as the RGBA of the TV surface
+//    or as 16-bit little-endian palette indexes: the 6-bit color in bits 0-5, with
+//    greyscale already applied, and the PPUMASK emphasis bits in bits 6-8.
+
+// Emulator context interfaces.
+// A context is one complete NES.  Create one on a thread before using any other
+// interface on that thread, and destroy it on the same thread when done.  In a
+// NES_MULTI_INSTANCE build every thread has its own context, so several NESes
+// can run in parallel in one process.  In the default build there is a single
+// context which is created implicitly when the library loads, nesCreateContext()
+// returns it and nesDestroyContext() does nothing.
+typedef struct _NesContext NesContext;
+NesContext* nesCreateContext ( void );
+void nesDestroyContext ( NesContext* pContext );
+NesContext* nesGetContext ( void );
+bool nesIsMultiInstance ( void );
+
+// Cartridge header interfaces.
+// Returns false if the 16-byte header isn't an iNES or NES 2.0 header.  The upper
+// mapper bits of an old iNES header with junk in its reserved bytes are ignored.
+bool nesParseROMHeader ( const uint8_t* header, NesRomHeader* pHeader );
+// Fills in a 16-byte header for the cartridge.  An iNES header is written if it can
+// hold the ROM sizes and mapper, otherwise a NES 2.0 header is.
+void nesBuildROMHeader ( const NesRomHeader* pHeader, uint8_t* header );
 
 // Emulation interfaces.
 void nesSetSystemMode ( uint32_t mode );
@@ -511,17 +614,47 @@ void nesLoadROM ( void );
 void nesResetInitial ( uint32_t mapper );
 void nesReset ( bool soft );
 void nesRun ( uint32_t* joypads );
+void nesSetFrameSkip ( bool skip );
+bool nesGetFrameSkip ( void );
+void nesSetPPUScanlineBatching ( bool enable );
+bool nesGetPPUScanlineBatching ( void );
+uint32_t nesGetStateSize ( void );
+uint32_t nesSaveState ( uint8_t* buffer, uint32_t size );
+bool nesLoadState ( uint8_t* buffer, uint32_t size );
+void nesSetRewind ( uint32_t interval, uint32_t memory );
+uint32_t nesGetRewindInterval ( void );
+uint32_t nesGetRewindDepth ( void );
+uint32_t nesGetRewindMemoryUsed ( void );
+bool nesRewind ( void );
 int32_t nesGetAudioSamplesAvailable ( void );
 void nesClearAudioSamplesAvailable ( void );
 uint8_t* nesGetAudioSamples ( uint16_t samples );
+void nesSetAudioSampleRate ( uint32_t rate );
+uint32_t nesGetAudioSampleRate ( void );
+int32_t nesReadAudioSamples ( int16_t* samples, int32_t count );
+void nesSetFrameSkipAudio ( bool keep );
+bool nesGetFrameSkipAudio ( void );
+bool nesStartFrameDump ( const char* fileName, int32_t format, int32_t depth, bool dropWhenFull );
+void nesStopFrameDump ( void );
+bool nesIsFrameDumping ( void );
+uint32_t nesGetFramesDumped ( void );
+uint32_t nesGetFramesDumpDropped ( void );
 void nesSetControllerType ( int32_t port, int32_t type );
 void nesSetControllerScreenPosition ( int32_t port, int32_t px, int32_t py, int32_t wx1, int32_t wy1, int32_t wx2, int32_t wy2 );
 void nesSetControllerSpecial ( int32_t port, int32_t special );
 bool nesROMIsLoaded ( void );
 
 // Internal debug interfaces.
-extern bool __nesdebug;
+// When the core is built with NES_NO_DEBUG defined the tracer, code/data
+// logger, breakpoint checks and scroll capture are compiled out altogether,
+// and nesEnableDebug has no effect.  The IDE links the debuggable core; the
+// standalone emulator and the headless tools link the NES_NO_DEBUG one.
+extern NES_THREAD_LOCAL bool __nesdebug;
+#if defined ( NES_NO_DEBUG )
+#define nesIsDebuggable() ( false )
+#else
 #define nesIsDebuggable() ( __nesdebug )
+#endif
 void nesBreak ( void );
 void nesBreakAudio ( void );
 
@@ -564,6 +697,7 @@ void    nesSetPaletteGreenComponent(uint32_t idx,uint32_t g);
 void    nesSetPaletteBlueComponent(uint32_t idx,uint32_t b);
 void nesSetBreakOnKIL ( bool breakOnKIL );
 int8_t* nesGetTVOut ( void );
+const uint16_t* nesGetTVIndexOut ( void );
 void nesSetVRC6AudioChannelMask ( uint32_t mask );
 void nesSetN106AudioChannelMask ( uint32_t mask );
 void nesSetAudioChannelMask ( uint8_t mask );
@@ -636,6 +770,11 @@ uint8_t nesGetPPUPatternData ( uint16_t addr );
 uint8_t nesGetPPUPaletteData ( uint8_t addr );
 uint32_t nesGetPPUOAM ( uint32_t addr );
 void nesSetPPUOAM ( uint32_t addr, uint32_t data );
+// The scroll at each pixel is only kept while scroll capture is on, for instance
+// while the nametable visualizer shows the visible region.  It costs a little for
+// every pixel drawn so it is off by default.
+void nesSetScrollCapture ( bool enable );
+bool nesGetScrollCapture ( void );
 uint16_t nesGetScrollXAtXY ( int32_t x, int32_t y );
 uint16_t nesGetScrollYAtXY ( int32_t x, int32_t y );
 void nesGetLastSprite0Hit ( uint8_t* x, uint8_t* y );
@@ -713,6 +852,16 @@ typedef struct
 
 void nesGetCpuSnapshot(NESCpuStateSnapshot* pSnapshot);
 
+// Most runs of pixels sharing the same scroll that are kept for a frame.
+#define PPU_SCROLL_RUNS_MAX 2048
+
+typedef struct
+{
+   uint8_t x;          // First pixel of the run on its scanline.
+   uint16_t scrollX;   // PPUSCROLL X plus 256 for the right-hand nametables.
+   uint16_t scrollY;   // PPUSCROLL Y plus 240 for the lower nametables.
+} PpuScrollRun;
+
 typedef struct
 {
    uint32_t frame;
@@ -721,11 +870,14 @@ typedef struct
    uint8_t oamMemory[MEM_256B];
    uint8_t paletteMemory[MEM_32B];
    uint8_t reg[NUM_PPU_REGS];
-   uint16_t xOffset[256][240];
-   uint16_t yOffset[256][240];
+   // Only filled in while nesSetScrollCapture() is on.  The runs of scanline y
+   // are scrollRun[scrollRunStart[y]] up to scrollRun[scrollRunStart[y+1]].
+   uint16_t scrollRunStart[241];
+   PpuScrollRun scrollRun[PPU_SCROLL_RUNS_MAX];
 } PpuStateSnapshot;
 
 void nesGetPpuSnapshot(PpuStateSnapshot* pSnapshot);
+const PpuScrollRun* nesGetPpuSnapshotScrollRun(const PpuStateSnapshot* pSnapshot, int32_t x, int32_t y);
 
 typedef struct
 {
@@ -755,6 +907,20 @@ typedef struct
 
 void nesGetNesSnapshot(NesStateSnapshot* pSnapshot);
 
+// Published snapshot interfaces.
+// The functions above copy the state as it is at the moment, which is a mixture of
+// frames if the emulator is running on another thread.  With publishing turned on
+// the emulator saves a snapshot of the whole NES at the end of every frame it draws,
+// when it stops at a breakpoint, and when a reset, nesLoadState() or nesRewind()
+// changes the state between frames.  nesAcquireSnapshot() returns the most recent
+// one without copying or locking, or NULL if none has been published.  It doesn't
+// change until it is given back with nesReleaseSnapshot(), and any number of threads
+// can hold snapshots at once.
+void nesSetSnapshotPublishing(bool enable);
+bool nesGetSnapshotPublishing(void);
+const NesStateSnapshot* nesAcquireSnapshot(void);
+void nesReleaseSnapshot(const NesStateSnapshot* pSnapshot);
+
 // Mapper-specific debug interfaces
 typedef struct _nesMapper001Info
 {